@@ -0,0 +1,20 @@
+// Desenfoque de 3x3 y perdida de color para el menu de pausa
+uniform sampler2D texture;
+uniform vec2 textureSize;
+
+void main()
+{
+	vec2 pixel = 1.0 / textureSize;
+	vec4 color = vec4(0.0);
+	for (float x = -1.0; x <= 1.0; x += 1.0)
+	{
+		for (float y = -1.0; y <= 1.0; y += 1.0)
+		{
+			color += texture2D(texture, gl_TexCoord[0].xy + vec2(x, y) * pixel);
+		}
+	}
+	color /= 9.0;
+
+	float gray = dot(color.rgb, vec3(0.299, 0.587, 0.114));
+	gl_FragColor = vec4(mix(color.rgb, vec3(gray), 0.6), 1.0);
+}
@@ -1,7 +1,7 @@
 ////////////////////////////////////////////////////////////
 //
 // GGE - Generic Game Engine
-// Copyright (C) 2011-2012 Adrin Guerra (adrigm@razonartificial.com)
+// Copyright (C) 2011-2012 Adrián Guerra (adrigm@razonartificial.com)
 //
 ////////////////////////////////////////////////////////////
 
@@ -59,6 +59,15 @@
 #endif
 
 
+////////////////////////////////////////////////////////////
+// Define RAGE_TRACK_ALLOCATIONS in the project settings to count
+// the heap allocations made every frame and the live bytes of
+// every subsystem (see FrameMemory and MemoryTracker). It
+// replaces the global operator new and delete, so it is meant for
+// static builds
+////////////////////////////////////////////////////////////
+
+
 ////////////////////////////////////////////////////////////
 // Define helpers to create portable import / export macros for each module
 ////////////////////////////////////////////////////////////
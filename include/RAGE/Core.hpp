@@ -18,5 +18,26 @@
 #include <RAGE/Core/RectangleShape.hpp>
 #include <RAGE/Core/ConvexShape.hpp>
 #include <RAGE/Core/Camera.hpp>
+#include <RAGE/Core/ScreenCapture.hpp>
+#include <RAGE/Core/Input.hpp>
+#include <RAGE/Core/InputRecorder.hpp>
+#include <RAGE/Core/FileWatcher.hpp>
+#include <RAGE/Core/LinearArena.hpp>
+#include <RAGE/Core/ArenaAllocator.hpp>
+#include <RAGE/Core/FrameMemory.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+#include <RAGE/Core/GraphPool.hpp>
+#include <RAGE/Core/AnimationClip.hpp>
+#include <RAGE/Core/Animator.hpp>
+#include <RAGE/Core/ParticleSystem.hpp>
+#include <RAGE/Core/TweenManager.hpp>
+#include <RAGE/Core/CollisionWorld.hpp>
+#include <RAGE/Core/TileGrid.hpp>
+#include <RAGE/Core/PathFinder.hpp>
+#include <RAGE/Core/PhysicsWorld.hpp>
+#include <RAGE/Core/PostProcess.hpp>
+#include <RAGE/Core/LightLayer.hpp>
+#include <RAGE/Core/RenderStats.hpp>
 
 #endif // RAGE_CORE_HPP
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef RAGE_CORE_ANIMATION_CLIP_HPP
+#define RAGE_CORE_ANIMATION_CLIP_HPP
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Animación de una hoja de sprites: una secuencia de rectángulos de la
+ * textura con su duración y el modo de repetición.
+ *
+ * Las posiciones y coordenadas de textura de cada frame se calculan una
+ * vez al cargar el clip, así Animator las copia al sprite sin recalcular
+ * nada. Se define en un archivo de configuración:
+ *
+ *   [clip]
+ *   loop=repeat          ; once, repeat o pingpong
+ *   duration=100         ; milisegundos por frame
+ *   frames=6             ; frames de la rejilla
+ *   rect=0,0,32,48       ; rectángulo del primer frame
+ *   columns=3            ; frames por fila, por defecto todos en una
+ *
+ *   [frames]             ; opcional, sustituye a la rejilla
+ *   0=0,0,32,48
+ *
+ *   [durations]          ; opcional, milisegundos de frames concretos
+ *   2=250
+ */
+class RAGE_CORE_API AnimationClip
+{
+public:
+	/// Modos de repetición
+	enum LoopMode {
+		LoopOnce,     ///< Se detiene en el último frame
+		LoopRepeat,   ///< Vuelve al primer frame
+		LoopPingPong  ///< Avanza y retrocede alternativamente
+	};
+
+	/// Milisegundos por frame si el archivo no los indica
+	static const Uint32 DEFAULT_FRAME_DURATION = 100;
+
+	/// Frame precalculado
+	struct Frame
+	{
+		/// Rectángulo de la textura
+		sf::IntRect rect;
+		/// Posiciones de los cuatro vértices del sprite
+		sf::Vector2f positions[4];
+		/// Coordenadas de textura de los cuatro vértices
+		sf::Vector2f texCoords[4];
+	};
+
+	AnimationClip();
+
+	/**
+	 * Carga el clip desde un archivo de configuración
+	 *
+	 * @param theFilename Ruta completa del archivo
+	 * @return true si se ha cargado al menos un frame
+	 */
+	bool LoadFromFile(const std::string& theFilename);
+
+	/**
+	 * Carga el clip desde una configuración ya leída. Los nombres de la
+	 * sección [frames] deben ser números
+	 *
+	 * @return true si se ha cargado al menos un frame
+	 */
+	bool LoadFromConfig(const ra::ConfigReader& theConfig);
+
+	/**
+	 * Añade un frame al final del clip
+	 */
+	void AddFrame(const sf::IntRect& theRect, sf::Time theDuration);
+
+	/**
+	 * Elimina todos los frames
+	 */
+	void Clear();
+
+	void SetLoopMode(LoopMode theMode);
+	LoopMode GetLoopMode() const;
+
+	/**
+	 * Devuelve el número de frames
+	 */
+	size_t GetFrameCount() const;
+
+	/**
+	 * Devuelve un frame precalculado
+	 */
+	const Frame& GetFrame(size_t theIndex) const;
+
+	/**
+	 * Devuelve la duración de una pasada completa por los frames
+	 */
+	sf::Time GetDuration() const;
+
+	/**
+	 * Devuelve el frame que se muestra en un instante de una pasada. El
+	 * tiempo debe estar entre cero y GetDuration()
+	 */
+	size_t FindFrame(sf::Time theTime) const;
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Frames del clip
+	std::vector<Frame> m_frames;
+	/// Instante en el que termina cada frame, en microsegundos
+	std::vector<Int64> m_ends;
+	/// Modo de repetición
+	LoopMode m_loopMode;
+}; // class AnimationClip
+
+} // namespace ra
+
+#endif // RAGE_CORE_ANIMATION_CLIP_HPP
\ No newline at end of file
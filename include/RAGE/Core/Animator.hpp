@@ -0,0 +1,143 @@
+#ifndef RAGE_CORE_ANIMATOR_HPP
+#define RAGE_CORE_ANIMATOR_HPP
+
+#include <map>
+#include <vector>
+#include <SFML/System/Time.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/GraphPool.hpp>
+
+namespace ra
+{
+
+/**
+ * Reproduce clips de animación sobre sprites de un SpritePool.
+ *
+ * Las animaciones activas se guardan contiguas y Update() las avanza todas
+ * en una sola pasada. Cuando cambia el frame se copian al sprite la
+ * geometría y las coordenadas de textura precalculadas en el clip, sin
+ * pasar por Sprite::setTextureRect().
+ *
+ * Los sprites se guardan por su GraphHandle y se resuelven en cada
+ * Update(): si un sprite se destruye en su pool, su animación se descarta
+ * sin llamar a Stop(). Los clips deben existir mientras se reproducen.
+ * La escena que quiera animar sprites declara su Animator, igual que su
+ * TweenManager, y lo actualiza en su Update().
+ */
+class RAGE_CORE_API Animator
+{
+public:
+	Animator();
+
+	/**
+	 * Reproduce un clip desde el principio sobre un sprite. Si el sprite ya
+	 * tenía una animación la sustituye
+	 *
+	 * @param theSprite Handle de un sprite de un SpritePool
+	 * @param theClip Clip a reproducir
+	 * @param theSpeed Multiplicador de la velocidad del clip
+	 */
+	void Play(const ra::GraphHandle& theSprite, const ra::AnimationClip& theClip, float theSpeed = 1.f);
+
+	/**
+	 * Deja de animar un sprite, que conserva el frame actual
+	 */
+	void Stop(const ra::GraphHandle& theSprite);
+
+	/**
+	 * Detiene o reanuda la animación de un sprite
+	 */
+	void SetPaused(const ra::GraphHandle& theSprite, bool thePaused);
+
+	/**
+	 * Cambia el multiplicador de velocidad de la animación de un sprite
+	 */
+	void SetSpeed(const ra::GraphHandle& theSprite, float theSpeed);
+
+	/**
+	 * Devuelve true si el sprite tiene una animación que no ha terminado
+	 */
+	bool IsPlaying(const ra::GraphHandle& theSprite) const;
+
+	/**
+	 * Devuelve true si la animación del sprite se reproduce una sola vez y
+	 * ya ha llegado al último frame
+	 */
+	bool IsFinished(const ra::GraphHandle& theSprite) const;
+
+	/**
+	 * Devuelve el clip que se reproduce sobre el sprite o NULL
+	 */
+	const ra::AnimationClip* GetClip(const ra::GraphHandle& theSprite) const;
+
+	/**
+	 * Avanza todas las animaciones
+	 *
+	 * @param theElapsed Tiempo transcurrido desde la última llamada
+	 */
+	void Update(sf::Time theElapsed);
+
+	/**
+	 * Deja de animar todos los sprites
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de sprites animados
+	 */
+	size_t GetSize() const;
+
+private:
+	/// Animación de un sprite
+	struct Track
+	{
+		/// Sprite animado
+		ra::GraphHandle sprite;
+		/// Clip que se reproduce
+		const ra::AnimationClip* clip;
+		/// Tiempo reproducido en microsegundos
+		Int64 time;
+		/// Frame aplicado al sprite
+		size_t frame;
+		/// Multiplicador de la velocidad
+		float speed;
+		/// Verdadero si está detenida
+		bool paused;
+		/// Verdadero si ha terminado un clip que no se repite
+		bool finished;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Animaciones activas
+	std::vector<Track> m_tracks;
+	/// Posición en m_tracks de la animación de cada sprite
+	std::map<ra::GraphHandle, size_t> m_index;
+
+	/**
+	 * Devuelve la animación de un sprite o NULL
+	 */
+	Track* FindTrack(const ra::GraphHandle& theSprite);
+	const Track* FindTrack(const ra::GraphHandle& theSprite) const;
+
+	/**
+	 * Quita la animación de la posición theIndex de m_tracks
+	 */
+	void RemoveTrack(size_t theIndex);
+
+	/**
+	 * Devuelve el sprite de una animación o NULL si se ha destruido
+	 */
+	static ra::Sprite* GetSprite(const Track& theTrack);
+
+	/**
+	 * Copia un frame del clip al sprite
+	 */
+	static void ApplyFrame(Track& theTrack, ra::Sprite& theSprite, size_t theFrame);
+}; // class Animator
+
+} // namespace ra
+
+#endif // RAGE_CORE_ANIMATOR_HPP
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define RAGE_CORE_APP_HPP
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <SFML/Graphics.hpp>
 #include <RAGE/Core/Export.hpp>
@@ -21,53 +22,80 @@ public:
 	static const unsigned int DEFAULT_VIDEO_WIDTH = 640;
 	static const unsigned int DEFAULT_VIDEO_HEIGHT = 480;
 	static const unsigned int DEFAULT_VIDEO_BPP = 32;
+	/// Milisegundos por frame dedicados a registrar recursos cargados en segundo plano
+	static const unsigned int ASYNC_LOAD_BUDGET = 4;
+	/// Milisegundos por frame dedicados a la inicialización por etapas de las escenas
+	static const unsigned int INIT_STEP_BUDGET = 4;
+	/// Segundos entre informes de memoria en el log por defecto, 0 los desactiva
+	static const unsigned int MEMORY_REPORT_INTERVAL = 60;
 
 	// Variables
 	///////////////////////////////////////////////////////////////////////////
 	/// Log del Engine
 	std::ofstream log;
-	/// Ventana de la aplicacin
+	/// Ventana de la aplicación
 	sf::RenderWindow window;
 
 	/**
-	 * Devuelve un puntero a la instancia nica de la clase si existe,
+	 * Devuelve un puntero a la instancia única de la clase si existe,
 	 * si no, la crea y duevuelve el puntero.
 	 * 
-	 * @return Puntero a la instancia nica de App
+	 * @return Puntero a la instancia única de App
 	 */
 	static App* Instance();
 	 
 	/**
-	 * Elimina la instancia nica de la aplicacin.
+	 * Elimina la instancia única de la aplicación.
 	 */
 	static void Release();
 
 	/**
-	 * Establece la ruta del ejecutable de la aplicacin
+	 * Establece la ruta del ejecutable de la aplicación
 	 * 
-	 * @param argc Nmero de parmetros
-	 * @param argv[] Lista de parmetros
+	 * @param argc Número de parámetros
+	 * @param argv[] Lista de parámetros
 	 */
 	void RegisterExecutableDir(int argc, char** argv);
 
 	/**
-	 * Devuelve la ruta del ejecutable de la aplicacin
+	 * Interpreta las opciones de línea de comandos del engine:
+	 *  --record <archivo>  graba la entrada y los tiempos de cada frame
+	 *  --replay <archivo>  reproduce una grabación en lugar de la entrada real
+	 *  --headless          durante la reproducción no dibuja ni muestra la ventana
 	 *
-	 * @return string con la ruta de la aplicacin
+	 * @param argc Número de parámetros
+	 * @param argv[] Lista de parámetros
+	 */
+	void ParseArguments(int argc, char** argv);
+
+	/**
+	 * Devuelve true si se está reproduciendo una grabación de entrada
+	 */
+	bool IsReplaying() const;
+
+	/**
+	 * Devuelve true si la aplicación se ejecuta sin dibujar
+	 */
+	bool IsHeadless() const;
+
+	/**
+	 * Devuelve la ruta del ejecutable de la aplicación
+	 *
+	 * @return string con la ruta de la aplicación
 	 */
 	std::string GetExecutableDir() const;
 
 	/**
-	 * Devuelve verdadero si la aplicacin se est ejecutando
+	 * Devuelve verdadero si la aplicación se está ejecutando
 	 *
-	 * @return true si la apicacin se est ejecutando
+	 * @return true si la apicación se está ejecutando
 	 */
 	bool IsRunning(void) const;
 
 	/**
-	 * Detiene la aplicacion con el cdigo de salida indicado
+	 * Detiene la aplicacion con el código de salida indicado
 	 *
-	 * @param the_exit_code Cdigo de salida de la aplicacin
+	 * @param the_exit_code Código de salida de la aplicación
 	 */
 	void Quit(int the_exit_code);
 
@@ -86,12 +114,36 @@ public:
 
 	sf::Time GetTotalTime(void) const;
 
+	/**
+	 * Devuelve donde se dibuja la escena en el frame actual: la ventana o,
+	 * si hay efectos de postprocesado activos, la textura que luego se
+	 * procesa. Las escenas deben dibujar aquí y no en window
+	 *
+	 * @return Destino de dibujo del frame
+	 */
+	sf::RenderTarget& GetRenderTarget();
+
+	/**
+	 * Devuelve los contadores de dibujado del último frame: llamadas,
+	 * vértices, cambios de estado y objetos de la escena dibujados y
+	 * descartados
+	 */
+	const ra::RenderCounters& GetRenderStats() const;
+
+	/**
+	 * Muestra sobre el frame un panel con los contadores de dibujado. El
+	 * panel no se cuenta en las estadísticas ni aparece en las capturas
+	 *
+	 * @param theFont Fuente del panel o NULL para ocultarlo
+	 */
+	void ShowRenderStats(const sf::Font* theFont);
+
 	void EnableQuit(bool value);
 
 	/**
-	 * Ejecuta la aplicacin, pone en marcha el GameLoop
+	 * Ejecuta la aplicación, pone en marcha el GameLoop
 	 *
-	 * @return Devuelve el cdigo de salida de la aplicacin
+	 * @return Devuelve el código de salida de la aplicación
 	*/
 	int Run();
 
@@ -103,17 +155,33 @@ protected:
 	void GameLoop();
 
 	void Cleanup();
+
+	/**
+	 * Atiende un evento de la ventana o de la grabación que se reproduce
+	 */
+	void HandleEvent(const sf::Event& theEvent);
+
+	/**
+	 * Vuelve a leer window.cfg y aplica los cambios que no requieren
+	 * recrear la ventana (tamaño y sincronización vertical)
+	 */
+	void ReloadWindowConfig();
+
+	/**
+	 * Dibuja el panel de estadísticas con los contadores del último frame
+	 */
+	void DrawRenderStats();
 		 
 private:
 	// Variables
 	///////////////////////////////////////////////////////////////////////////
 	/// Almacena la ruta del ejecutable
 	std::string m_executableDir;
-	/// Comprueba si est activa o no la Aplicacin
+	/// Comprueba si está activa o no la Aplicación
 	bool m_running;
-	/// Cdigo de salida de la aplicacin
+	/// Código de salida de la aplicación
 	int m_exitCode;
-	/// Nombre de la aplicacin
+	/// Nombre de la aplicación
 	std::string m_title;
 	/// Bandera para el estilo de la ventana
 	ra::Uint32 m_windowStyle;
@@ -129,20 +197,48 @@ private:
 	sf::Clock m_updateClock;
 	/// Almacena el tiempo pasado en cada bucle
 	sf::Time m_updateTime;
-	/// Almacena el tiempo total de ejecucin
+	/// Almacena el tiempo total de ejecución
 	sf::Time m_totalTime;
-	/// Puntero a la cmara
+	/// Puntero a la cámara
 	ra::Camera* m_camera;
-	/// Controla si la aplicacin gestiona eventos de cierre
+	/// Puntero al servicio de capturas de pantalla
+	ra::ScreenCapture* m_screenCapture;
+	/// Puntero a la cadena de postprocesado
+	ra::PostProcess* m_postProcess;
+	/// Puntero al subsistema de entrada
+	ra::Input* m_input;
+	/// Puntero al grabador de entrada
+	ra::InputRecorder* m_recorder;
+	/// Archivo donde se graba la entrada
+	std::string m_recordFile;
+	/// Archivo de la grabación a reproducir
+	std::string m_replayFile;
+	/// Verdadero si no se dibuja ni se muestra la ventana
+	bool m_headless;
+	/// Eventos obtenidos en el frame actual
+	std::vector<sf::Event> m_frameEvents;
+	/// Puntero al vigilante de archivos para la recarga en caliente
+	ra::FileWatcher* m_fileWatcher;
+	/// Puntero a la memoria temporal por frame
+	ra::FrameMemory* m_frameMemory;
+	/// Panel de estadísticas de dibujado, NULL si está oculto
+	ra::Text* m_statsText;
+	/// Verdadero si se recargan en caliente los archivos modificados
+	bool m_hotReload;
+	/// Tiempo entre informes de memoria en el log, cero si no se escriben
+	sf::Time m_memoryReportInterval;
+	/// Tiempo total en el último informe de memoria
+	sf::Time m_memoryReportTime;
+	/// Controla si la aplicación gestiona eventos de cierre
 	bool m_quit;
 
 	/**
-	 * Constructor de la Aplicacin su nica funcin es crear el archivo log
+	 * Constructor de la Aplicación su única función es crear el archivo log
 	 */
 	App();
 
 	/**
-	 * Destructor de la aplicacin. Cierra el archivo de log.
+	 * Destructor de la aplicación. Cierra el archivo de log.
 	 */
 	virtual ~App();
 
@@ -0,0 +1,125 @@
+#ifndef RAGE_CORE_ARENA_ALLOCATOR_HPP
+#define RAGE_CORE_ARENA_ALLOCATOR_HPP
+
+#include <new>
+#include <cstddef>
+#include <RAGE/Core/LinearArena.hpp>
+
+namespace ra
+{
+
+/**
+ * Adaptador para usar una LinearArena como allocator de los contenedores
+ * de la STL.
+ *
+ * deallocate() no hace nada: la memoria se recupera en el Reset() de la
+ * reserva, por lo que el contenedor no debe vivir más que la reserva. Los
+ * contenedores que crecen dejan atrás sus bloques antiguos hasta el
+ * Reset(), conviene llamar a reserve() cuando se conoce el tamaño.
+ *
+ * \code
+ * ra::LinearArena& arena = ra::FrameMemory::Instance()->GetFrameArena();
+ * std::vector<int, ra::ArenaAllocator<int> > visible((ra::ArenaAllocator<int>(arena)));
+ * \endcode
+ */
+template <class TYPE>
+class ArenaAllocator
+{
+public:
+	typedef TYPE value_type;
+	typedef TYPE* pointer;
+	typedef const TYPE* const_pointer;
+	typedef TYPE& reference;
+	typedef const TYPE& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	/// Allocator del mismo tipo para otro tipo de elemento
+	template <class OTHER>
+	struct rebind
+	{
+		typedef ArenaAllocator<OTHER> other;
+	};
+
+	/**
+	 * Crea el allocator sobre theArena
+	 */
+	explicit ArenaAllocator(LinearArena& theArena)
+		: m_arena(&theArena)
+	{
+	}
+
+	/**
+	 * Copia el allocator para otro tipo de elemento, compartiendo la reserva
+	 */
+	template <class OTHER>
+	ArenaAllocator(const ArenaAllocator<OTHER>& theOther)
+		: m_arena(theOther.GetArena())
+	{
+	}
+
+	pointer address(reference theValue) const
+	{
+		return &theValue;
+	}
+
+	const_pointer address(const_reference theValue) const
+	{
+		return &theValue;
+	}
+
+	pointer allocate(size_type theCount, const void* = 0)
+	{
+		return static_cast<pointer>(m_arena->Allocate(theCount * sizeof(TYPE)));
+	}
+
+	void deallocate(pointer, size_type)
+	{
+		// Se libera en el Reset() de la reserva
+	}
+
+	size_type max_size() const
+	{
+		return static_cast<size_type>(-1) / sizeof(TYPE);
+	}
+
+	void construct(pointer thePointer, const TYPE& theValue)
+	{
+		new(static_cast<void*>(thePointer)) TYPE(theValue);
+	}
+
+	void destroy(pointer thePointer)
+	{
+		thePointer->~TYPE();
+	}
+
+	/**
+	 * Devuelve la reserva usada por el allocator
+	 */
+	LinearArena* GetArena() const
+	{
+		return m_arena;
+	}
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Reserva de la que se obtiene la memoria
+	LinearArena* m_arena;
+}; // class ArenaAllocator
+
+template <class LEFT, class RIGHT>
+bool operator==(const ArenaAllocator<LEFT>& theLeft, const ArenaAllocator<RIGHT>& theRight)
+{
+	return theLeft.GetArena() == theRight.GetArena();
+}
+
+template <class LEFT, class RIGHT>
+bool operator!=(const ArenaAllocator<LEFT>& theLeft, const ArenaAllocator<RIGHT>& theRight)
+{
+	return theLeft.GetArena() != theRight.GetArena();
+}
+
+} // namespace ra
+
+#endif // RAGE_CORE_ARENA_ALLOCATOR_HPP
\ No newline at end of file
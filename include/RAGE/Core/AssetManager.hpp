@@ -2,37 +2,54 @@
 #define RAGE_CORE_ASSET_MANAGER_HPP
 
 #include <map>
+#include <set>
+#include <deque>
 #include <string>
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <RAGE/Core/Export.hpp>
 #include <RAGE/Core/ConfigReader.hpp>
+#include <RAGE/Core/AnimationClip.hpp>
 #include <RAGE/Core/AssetManager.hpp>
 
 namespace ra
 {
 
+/// Tipos de recursos que se pueden cargar en segundo plano
+enum AssetType {
+	AssetTexture,     ///< sf::Texture, la imagen se decodifica en el hilo de carga
+	AssetFont,        ///< sf::Font
+	AssetSoundBuffer, ///< sf::SoundBuffer, el audio se decodifica en el hilo de carga
+	AssetConfig,      ///< ra::ConfigReader, se lee en el hilo principal
+	AssetAnimation    ///< ra::AnimationClip, se lee en el hilo principal
+};
+
 class RAGE_CORE_API AssetManager
 {
 	static AssetManager* ms_instance;
 
 public:
 	/**
-	 * Devuelve un puntero a la instancia nica de la clase si existe,
+	 * Devuelve un puntero a la instancia única de la clase si existe,
 	 * si no, la crea y duevuelve el puntero.
 	 * 
-	 * @return Puntero a la instancia nica de AssetManager
+	 * @return Puntero a la instancia única de AssetManager
 	 */
 	static AssetManager* Instance();
 	 
 	/**
-	 * Elimina la instancia nica de la clase.
+	 * Elimina la instancia única de la clase.
 	 */
 	static void Release();
 
 	void SetPath(const std::string& thePath);
 
+	/**
+	 * Devuelve el directorio maestro donde se buscan los recursos
+	 */
+	const std::string& GetPath() const;
+
 	sf::Texture* GetTexture(const std::string& theName);
 	sf::Texture* GetTexture(const std::string& theName, sf::Texture* theTexture);
 	sf::Texture* GetTextureFromImage(const std::string& theName, const sf::Image* theImage, const sf::IntRect& theRect = sf::IntRect());
@@ -66,9 +83,95 @@ public:
 	void DeleteConfig(const std::string& theName);
 	void DeleteConfig(const ra::ConfigReader* theConfig);
 
+	/**
+	 * Devuelve cuántas veces se ha recargado en caliente una configuración.
+	 * La recarga sustituye el contenido del mismo ConfigReader, así que los
+	 * KeyHandle y los punteros de GetValue() obtenidos antes dejan de ser
+	 * válidos: quien los guarde debe comparar este número cada frame y
+	 * volver a buscarlos cuando cambie
+	 *
+	 * @return Número de recargas, 0 si no se ha recargado o no está cargada
+	 */
+	ra::Uint32 GetConfigReloads(const std::string& theName) const;
+
+	/**
+	 * Devuelve el clip de animación definido en un archivo, cargándolo si
+	 * hace falta. Los sprites que lo comparten usan los mismos frames
+	 * precalculados
+	 */
+	ra::AnimationClip* GetAnimation(const std::string& theName);
+
+	void DeleteAnimation(const std::string& theName);
+	void DeleteAnimation(const ra::AnimationClip* theAnimation);
+
+	/**
+	 * Solicita la carga en segundo plano de un recurso. La lectura y
+	 * decodificación del archivo se hace en el hilo de carga y el registro
+	 * del recurso (y la subida a la GPU de las texturas) en UpdateAsync().
+	 * Si el recurso ya está cargado no hace nada.
+	 *
+	 * @param theType Tipo del recurso
+	 * @param theName Nombre del archivo relativo al directorio maestro
+	 */
+	void LoadAsync(AssetType theType, const std::string& theName);
+
+	/**
+	 * Devuelve true si el recurso está cargado y registrado
+	 */
+	bool IsLoaded(AssetType theType, const std::string& theName) const;
+
+	/**
+	 * Devuelve true si el recurso tiene una carga en segundo plano sin
+	 * terminar
+	 */
+	bool IsPending(AssetType theType, const std::string& theName) const;
+
+	/**
+	 * Registra los recursos que el hilo de carga ha terminado. Se llama una
+	 * vez por frame desde App y procesa resultados hasta agotar el tiempo
+	 * indicado (al menos uno por llamada)
+	 *
+	 * @param theBudget Tiempo máximo a emplear en este frame
+	 */
+	void UpdateAsync(sf::Time theBudget);
+
+	/**
+	 * Recarga en el sitio las texturas, configuraciones y animaciones cuyos
+	 * archivos han cambiado. Las texturas se decodifican en el hilo de carga
+	 * y se actualizan en UpdateAsync(), manteniendo el mismo sf::Texture*
+	 * para que quien las usa vea el nuevo contenido. Las configuraciones y
+	 * animaciones se leen en el momento y solo sustituyen a las anteriores
+	 * si la lectura tiene éxito. Una configuración recargada invalida sus
+	 * KeyHandle, ver GetConfigReloads()
+	 *
+	 * @param theFiles Rutas completas de los archivos modificados
+	 */
+	void ReloadFiles(const std::vector<std::string>& theFiles);
+
 	void Cleanup();
 
 private:
+	/// Petición o resultado de una carga en segundo plano
+	struct AsyncLoad
+	{
+		/// Tipo del recurso
+		AssetType type;
+		/// Nombre con el que se registra el recurso
+		std::string name;
+		/// Ruta completa del archivo
+		std::string path;
+		/// Imagen decodificada (texturas)
+		sf::Image* image;
+		/// Fuente cargada
+		sf::Font* font;
+		/// Buffer de sonido decodificado
+		sf::SoundBuffer* sound;
+		/// Verdadero si la carga en el hilo ha tenido éxito
+		bool success;
+		/// Verdadero si sustituye el contenido de un recurso ya cargado
+		bool reload;
+	};
+
 	// Variables
 	///////////////////////////////////////////////////////////////////////////
 	/// Puntero a app
@@ -77,18 +180,55 @@ private:
 	std::string m_masterDir;
 	/// Mapa de registro de todas las texturas
 	std::map<std::string, sf::Texture*> m_textures;
-	/// Mapa de registro de todas las imgenes
+	/// Mapa de registro de todas las imágenes
 	std::map<std::string, sf::Image*> m_images;
 	/// Mapa de registro de todas las fuentes
 	std::map<std::string, sf::Font*> m_fonts;
 	/// Mapa de registro de todos los buffers de sonido
 	std::map<std::string, sf::SoundBuffer*> m_sounds;
-	/// Mapa de registro de toda la msica
+	/// Mapa de registro de toda la música
 	std::map<std::string, sf::Music*> m_music;
 	/// Mapa de registro de todos los archivos de configuraciones
 	std::map<std::string, ra::ConfigReader*> m_configs;
+	/// Recargas en caliente de cada configuración
+	std::map<std::string, ra::Uint32> m_configReloads;
+	/// Mapa de registro de todos los clips de animación
+	std::map<std::string, ra::AnimationClip*> m_animations;
 	/// Mapa de registro de todos los Tmx Maps
 	//std::map<std::string, ra::TmxMap*> m_maps;
+	/// Cargas en segundo plano sin terminar (solo hilo principal)
+	std::set<std::pair<AssetType, std::string> > m_asyncPending;
+	/// Cola de peticiones para el hilo de carga
+	std::deque<AsyncLoad> m_asyncRequests;
+	/// Cola de resultados del hilo de carga
+	std::deque<AsyncLoad> m_asyncResults;
+	/// Protege las colas y el estado del hilo de carga
+	sf::Mutex m_asyncMutex;
+	/// Hilo de carga de recursos
+	sf::Thread m_asyncLoader;
+	/// Verdadero mientras el hilo de carga está activo
+	bool m_asyncRunning;
+
+	/**
+	 * Bucle del hilo de carga
+	 */
+	void AsyncLoop();
+
+	/**
+	 * Añade una petición a la cola del hilo de carga y lo lanza si no está
+	 * en marcha
+	 */
+	void QueueAsync(const AsyncLoad& theRequest);
+
+	/**
+	 * Registra el archivo de un recurso en el FileWatcher
+	 */
+	void WatchFile(const std::string& theName);
+
+	/**
+	 * Elimina el archivo de un recurso del FileWatcher
+	 */
+	void UnwatchFile(const std::string& theName);
 
 	AssetManager();
 
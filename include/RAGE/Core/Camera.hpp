@@ -8,6 +8,25 @@
 namespace ra
 {
 
+/**
+ * Cámara de la aplicación.
+ *
+ * Puede seguir a un objeto de la escena con una zona muerta: mientras el
+ * objeto no salga de ella la cámara no se mueve. El movimiento y el zoom se
+ * suavizan con un muelle críticamente amortiguado que depende del tiempo
+ * transcurrido y no de los fps. La cámara se puede limitar a los bordes de
+ * un mapa y sacudir durante un tiempo.
+ *
+ * App llama a Update() una vez por frame, después del Update() de la escena
+ * y antes de dibujar, y el rectángulo visible que devuelve GetRect() se
+ * calcula ahí una sola vez por frame.
+ *
+ * Instance() es la cámara principal y dibuja todas las escenas. Para
+ * pantalla partida o un minimapa se crean más cámaras, después de crear la
+ * ventana, se les asigna un viewport con SetViewport() y se añaden con
+ * Scene::AddCamera() a la escena que las usa; las escenas que se dibujan
+ * encima, como un menú de pausa, no las ven.
+ */
 class RAGE_CORE_API Camera : public sf::View
 {
 	static Camera* ms_instance;
@@ -16,15 +35,83 @@ public:
 	static Camera* Instance();
 	static void Release();
 
+	/**
+	 * Crea una cámara que ocupa toda la ventana. La ventana debe estar ya
+	 * creada; la cámara principal se vuelve a ajustar en App::Init()
+	 */
+	Camera();
+	virtual ~Camera();
+
+	/**
+	 * Aplica el seguimiento, el suavizado, los límites, el zoom y la
+	 * sacudida, y calcula el rectángulo visible del frame
+	 */
 	void Update();
 
 	void ConnectToGraph(ra::SceneGraph& theGraph);
 	void DisconnectToSprite();
 
-	//void LockToMap(GGE::Map& theMap);
+	/**
+	 * Establece el tamaño de la zona muerta alrededor del centro, en
+	 * píxeles de pantalla. (0, 0) centra siempre el objeto seguido
+	 */
+	void SetDeadZone(const sf::Vector2f& theSize);
+
+	/**
+	 * Establece el tiempo aproximado que tarda la cámara en alcanzar su
+	 * destino. Cero desactiva el suavizado
+	 */
+	void SetSmoothTime(sf::Time theTime);
+
+	/**
+	 * Impide que la cámara muestre nada fuera de los límites indicados
+	 */
+	void LockToBounds(const sf::FloatRect& theBounds);
+
+	/**
+	 * Impide que la cámara muestre nada fuera del mapa
+	 */
+	void LockToMap(const ra::TileGrid& theMap);
+
+	/**
+	 * Permite que la cámara se mueva libremente
+	 */
+	void Unlock();
+
+	/**
+	 * Establece el zoom de destino: 2 muestra la mitad de ancho y de alto y
+	 * 0.5 el doble. Se alcanza con el mismo suavizado que el movimiento
+	 */
+	void SetZoom(float theZoom);
+	float GetZoom() const;
+
+	/**
+	 * Sacude la cámara durante un tiempo, con una amplitud que se apaga
+	 * hasta cero
+	 *
+	 * @param theIntensity Desplazamiento máximo en píxeles
+	 * @param theDuration Duración de la sacudida
+	 */
+	void Shake(float theIntensity, sf::Time theDuration);
+
+	/**
+	 * Establece la zona de la ventana donde dibuja la cámara, en fracciones
+	 * de su tamaño. La vista se ajusta para mostrar el mundo a la misma
+	 * escala que la ventana completa, multiplicada por el zoom
+	 */
+	void SetViewport(const sf::FloatRect& theViewport);
 
 	void SetDefaultCamera();
 
+	/**
+	 * Devuelve el centro de la vista en su posición inicial, con zoom 1 y
+	 * la esquina superior izquierda en el origen del mundo
+	 */
+	sf::Vector2f GetDefaultCenter() const;
+
+	/**
+	 * Devuelve la zona del mundo visible en este frame
+	 */
 	sf::FloatRect GetRect() const;
 
 private:
@@ -32,15 +119,46 @@ private:
 	App* m_app;
 	/// Puntero al Sprite conectado
 	ra::SceneGraph* m_graph;
-	/// Puntero al Mapa conectado
-	//GGE::Map* mMap;
-	/// Dice si la Cmara est conectada a un Sprite
+	/// Dice si la Cámara está conectada a un Sprite
 	bool m_conectToGraph;
-	/// Dice si la Cmara est conectada a un mapa
-	//bool mConectToMap;
+	/// Dice si la Cámara está limitada a unos bordes
+	bool m_locked;
+	/// Bordes a los que está limitada
+	sf::FloatRect m_bounds;
+	/// Tamaño de la zona muerta
+	sf::Vector2f m_deadZone;
+	/// Segundos del suavizado
+	float m_smoothTime;
+	/// Posición a la que se dirige la cámara
+	sf::Vector2f m_goal;
+	/// Velocidad del suavizado del movimiento
+	sf::Vector2f m_velocity;
+	/// Tamaño de la vista con zoom 1
+	sf::Vector2f m_baseSize;
+	/// Zoom actual y de destino
+	float m_zoom;
+	float m_zoomGoal;
+	/// Velocidad del suavizado del zoom
+	float m_zoomVelocity;
+	/// Desplazamiento máximo de la sacudida
+	float m_shakeIntensity;
+	/// Duración total y restante de la sacudida
+	float m_shakeDuration;
+	float m_shakeTime;
+	/// Desplazamiento de la sacudida aplicado en el frame actual
+	sf::Vector2f m_shakeOffset;
+	/// Zona visible calculada en Update()
+	sf::FloatRect m_rect;
 
-	Camera();
-	virtual ~Camera();
+	/**
+	 * Calcula el centro más cercano que no muestra nada fuera de los bordes
+	 */
+	sf::Vector2f Clamp(const sf::Vector2f& theCenter) const;
+
+	/**
+	 * Recalcula la zona visible a partir de la vista
+	 */
+	void UpdateRect();
 
 }; // Class Camera
 
@@ -0,0 +1,273 @@
+#ifndef RAGE_CORE_COLLISION_WORLD_HPP
+#define RAGE_CORE_COLLISION_WORLD_HPP
+
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+
+namespace ra
+{
+
+/// Referencia a un cuerpo de un CollisionWorld
+typedef ra::Handle<CollisionWorld> CollisionHandle;
+
+/// Estado de un contacto entre dos cuerpos
+enum ContactState {
+	ContactBegin,  ///< Los cuerpos empiezan a solaparse este frame
+	ContactStay,   ///< Los cuerpos ya se solapaban el frame anterior
+	ContactEnd     ///< Los cuerpos han dejado de solaparse este frame
+};
+
+/// Contacto entre dos cuerpos
+struct Contact
+{
+	/// Cuerpos en contacto, first ocupa la posición menor del mundo
+	CollisionHandle first;
+	CollisionHandle second;
+	/// Estado del contacto
+	ContactState state;
+};
+
+/// Resultado de RayCast()
+struct RayHit
+{
+	/// Cuerpo alcanzado
+	CollisionHandle body;
+	/// Punto de entrada en el cuerpo
+	sf::Vector2f point;
+	/// Normal de la cara alcanzada
+	sf::Vector2f normal;
+	/// Posición del punto en el segmento, entre 0 y 1
+	float fraction;
+};
+
+/**
+ * Detección de colisiones de fase amplia entre rectángulos alineados con
+ * los ejes.
+ *
+ * Usa barrido y poda (sweep and prune): los cuerpos se guardan ordenados
+ * por su borde izquierdo en un array contiguo y cada Update() los reordena
+ * por inserción, que es casi lineal porque de un frame a otro apenas
+ * cambian de orden. El barrido solo compara cada cuerpo con los que se
+ * solapan con él en el eje X, así el coste depende de los pares cercanos y
+ * no del cuadrado del número de cuerpos.
+ *
+ * Los cuerpos añadidos o movidos con SetBounds() se colocan en su sitio en
+ * el siguiente Update(), que ordena aparte los nuevos y los mezcla con el
+ * resto. Los eliminados solo se marcan y se descartan entonces. Hasta ese
+ * Update() las consultas recorren el array entero.
+ *
+ * Los cuerpos pueden seguir los límites globales de un SceneGraph o tener
+ * un rectángulo propio. Dos cuerpos solo chocan si la capa de cada uno está
+ * en la máscara del otro. Normalmente cada escena tiene su CollisionWorld y
+ * llama a Update() después de mover sus objetos.
+ */
+class RAGE_CORE_API CollisionWorld
+{
+public:
+	/// Máscara que acepta todas las capas
+	static const Uint32 ALL_LAYERS = 0xFFFFFFFF;
+
+	CollisionWorld();
+
+	/**
+	 * Añade un cuerpo que sigue los límites globales de un objeto de la
+	 * escena. El objeto debe existir mientras el cuerpo esté en el mundo
+	 *
+	 * @param theGraph Objeto de la escena
+	 * @param theLayer Capas a las que pertenece el cuerpo
+	 * @param theMask Capas con las que choca
+	 */
+	CollisionHandle AddBody(ra::SceneGraph& theGraph, Uint32 theLayer = 1, Uint32 theMask = ALL_LAYERS);
+
+	/**
+	 * Añade un cuerpo con un rectángulo propio, se mueve con SetBounds()
+	 */
+	CollisionHandle AddBody(const sf::FloatRect& theBounds, Uint32 theLayer = 1, Uint32 theMask = ALL_LAYERS);
+
+	/**
+	 * Elimina un cuerpo. Sus contactos desaparecen sin informar del final
+	 */
+	void RemoveBody(const CollisionHandle& theBody);
+
+	/**
+	 * Cambia el rectángulo de un cuerpo que no sigue a un objeto
+	 */
+	void SetBounds(const CollisionHandle& theBody, const sf::FloatRect& theBounds);
+
+	/**
+	 * Cambia las capas y la máscara de un cuerpo
+	 */
+	void SetFilter(const CollisionHandle& theBody, Uint32 theLayer, Uint32 theMask);
+
+	/**
+	 * Devuelve el objeto de la escena que sigue un cuerpo o NULL
+	 */
+	ra::SceneGraph* GetGraph(const CollisionHandle& theBody) const;
+
+	/**
+	 * Devuelve true si el cuerpo sigue en el mundo
+	 */
+	bool IsValid(const CollisionHandle& theBody) const;
+
+	/**
+	 * Actualiza los límites de los cuerpos y calcula los contactos
+	 */
+	void Update();
+
+	/**
+	 * Devuelve los contactos calculados en el último Update()
+	 */
+	const std::vector<Contact>& GetContacts() const;
+
+	/**
+	 * Busca el primer cuerpo que corta un segmento. Los cuerpos que siguen
+	 * a un objeto se prueban con sus límites del último Update()
+	 *
+	 * @param theFrom Origen del segmento
+	 * @param theTo Final del segmento
+	 * @param theHit Resultado si se alcanza algún cuerpo
+	 * @param theMask Capas que se tienen en cuenta
+	 * @return true si el segmento alcanza algún cuerpo
+	 */
+	bool RayCast(const sf::Vector2f& theFrom, const sf::Vector2f& theTo, RayHit& theHit,
+		Uint32 theMask = ALL_LAYERS) const;
+
+	/**
+	 * Añade a theBodies los cuerpos que se solapan con un rectángulo. Los
+	 * cuerpos que siguen a un objeto se prueban con sus límites del último
+	 * Update()
+	 *
+	 * @return Número de cuerpos añadidos
+	 */
+	size_t QueryRect(const sf::FloatRect& theRect, std::vector<CollisionHandle>& theBodies,
+		Uint32 theMask = ALL_LAYERS) const;
+
+	/**
+	 * Elimina todos los cuerpos
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de cuerpos
+	 */
+	size_t GetSize() const;
+
+private:
+	/// Proxy de un cuerpo eliminado, se descarta en el siguiente Update()
+	static const Uint32 NO_BODY = 0xFFFFFFFF;
+
+	/// Cuerpo
+	struct Body
+	{
+		/// Objeto que sigue o NULL
+		ra::SceneGraph* graph;
+		/// Límites si no sigue a un objeto
+		sf::FloatRect bounds;
+		/// Capas a las que pertenece
+		Uint32 layer;
+		/// Capas con las que choca
+		Uint32 mask;
+		/// Posición de su proxy en m_proxies
+		Uint32 proxy;
+		/// Generación de la posición, cambia al liberarla
+		Uint32 generation;
+		/// Verdadero si la posición está ocupada
+		bool active;
+	};
+
+	/// Copia de los límites de un cuerpo en el array ordenado
+	struct Proxy
+	{
+		float minX;
+		float maxX;
+		float minY;
+		float maxY;
+		Uint32 layer;
+		Uint32 mask;
+		/// Posición del cuerpo en m_bodies o NO_BODY si se ha eliminado
+		Uint32 body;
+
+		bool operator<(const Proxy& theRight) const;
+	};
+
+	/// Par de cuerpos que se solapan, first < second
+	struct Pair
+	{
+		Uint32 first;
+		Uint32 second;
+
+		bool operator<(const Pair& theRight) const;
+		bool operator==(const Pair& theRight) const;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Cuerpos, ocupados y libres
+	std::vector<Body> m_bodies;
+	/// Posiciones libres de m_bodies
+	std::vector<Uint32> m_free;
+	/// Cuerpos ordenados por su borde izquierdo
+	std::vector<Proxy> m_proxies;
+	/// Proxies del principio de m_proxies que estaban en el último
+	/// Update(), los posteriores son de cuerpos añadidos después
+	size_t m_sortedCount;
+	/// Memoria para mezclar los cuerpos añadidos con los ordenados
+	std::vector<Proxy> m_merged;
+	/// Anchura del proxy más ancho en el último Update()
+	float m_maxWidth;
+	/// Pares que se solapan en el último Update(), ordenados
+	std::vector<Pair> m_pairs;
+	/// Pares del Update() anterior
+	std::vector<Pair> m_previousPairs;
+	/// Contactos del último Update()
+	std::vector<Contact> m_contacts;
+	/// Posiciones eliminadas desde el último Update()
+	std::vector<Uint32> m_removed;
+	/// Número de cuerpos en el mundo
+	size_t m_size;
+	/// Verdadero si m_proxies puede estar desordenado o tener proxies
+	/// eliminados desde el último Update()
+	bool m_dirty;
+
+	/**
+	 * Ocupa una posición libre para un cuerpo
+	 */
+	CollisionHandle CreateBody(ra::SceneGraph* theGraph, const sf::FloatRect& theBounds,
+		Uint32 theLayer, Uint32 theMask);
+
+	/**
+	 * Devuelve el cuerpo de un handle o NULL
+	 */
+	Body* Find(const CollisionHandle& theBody);
+	const Body* Find(const CollisionHandle& theBody) const;
+
+	/**
+	 * Devuelve el handle de la posición de un cuerpo
+	 */
+	CollisionHandle GetHandle(Uint32 theIndex) const;
+
+	/**
+	 * Devuelve el primer proxy que puede llegar a theLeft en el eje X, o el
+	 * primero del array si no está ordenado
+	 */
+	size_t FirstProxy(float theLeft) const;
+
+	/**
+	 * Copia a un proxy los límites de su cuerpo
+	 */
+	void Refresh(Proxy& theProxy) const;
+
+	/**
+	 * Anota en m_contacts los pares que empiezan, siguen y terminan
+	 */
+	void BuildContacts();
+}; // class CollisionWorld
+
+} // namespace ra
+
+#endif // RAGE_CORE_COLLISION_WORLD_HPP
\ No newline at end of file
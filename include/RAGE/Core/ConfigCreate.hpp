@@ -3,6 +3,7 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <RAGE/Core/Export.hpp>
 
 namespace ra
@@ -15,7 +16,12 @@ public:
 
 	~ConfigCreate();
 
-	void Open(const std::string& filename);
+	/**
+	 * Abre el archivo de configuración. En modo binario los valores se
+	 * guardan en memoria y Close() escribe el archivo con
+	 * ConfigReader::SaveToBinary
+	 */
+	void Open(const std::string& filename, bool binary = false);
 
 	void Close();
 
@@ -34,6 +40,15 @@ public:
 
 private:
 	std::ofstream file;
+	/// Texto acumulado en modo binario
+	std::ostringstream text;
+	/// Archivo binario a escribir en Close(), vacío en modo texto
+	std::string binaryFile;
+
+	/**
+	 * Devuelve el flujo en el que se escriben los valores
+	 */
+	std::ostream& Out();
 
 }; // class ConfigCreate
 
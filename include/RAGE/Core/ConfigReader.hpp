@@ -1,8 +1,9 @@
 #ifndef   RAGE_CORE_CONFIG_READER_HPP
 #define   RAGE_CORE_CONFIG_READER_HPP
 
-#include <map>
+#include <cstdio>
 #include <string>
+#include <vector>
 #include <RAGE/Core/Export.hpp>
 #include <RAGE/Core/Core_types.hpp>
 
@@ -13,6 +14,18 @@ namespace ra
 class RAGE_CORE_API ConfigReader
 {
 public:
+    /// Handle to a name, value pair returned by FindKey
+    typedef Uint32 KeyHandle;
+
+    /// Value returned by FindKey when the name, value pair does not exist
+    static const KeyHandle INVALID_KEY = 0xFFFFFFFF;
+
+    /// Version of the binary format written by SaveToBinary
+    static const Uint32 BINARY_VERSION = 1;
+
+    /// First bytes of every binary configuration file
+    static const char BINARY_MAGIC[4];
+
     /**
     * ConfigReader constructor
     */
@@ -31,12 +44,26 @@ public:
     virtual ~ConfigReader();
 
     /**
-    * IsSectionEmpty determines if theSection provided exists and has 1 or
-    * more name, value pairs to retrieve.
+    * IsSectionEmpty determines if theSection provided exists but has no
+    * name, value pairs to retrieve.
     * @param[in] theSection to check
-    * @return true if theSection provided exists
+    * @return true if theSection provided exists and is empty
     */
-    bool IsSectionEmpty(const std::string theSection) const;
+    bool IsSectionEmpty(const char* theSection) const;
+    bool IsSectionEmpty(const std::string& theSection) const;
+
+    /**
+    * FindKey will resolve theSection and theName into a handle that can be
+    * used to retrieve the value later without searching for it again.
+    * Handles remain valid until the next call to LoadFromFile or until
+    * another ConfigReader is assigned to this one, which is how
+    * AssetManager hot-reloads configs (see AssetManager::GetConfigReloads).
+    * @param[in] theSection to use for finding theName
+    * @param[in] theName to find
+    * @return the handle found or INVALID_KEY if it does not exist
+    */
+    KeyHandle FindKey(const char* theSection, const char* theName) const;
+    KeyHandle FindKey(const std::string& theSection, const std::string& theName) const;
 
     /**
     * GetBool will return the boolean value for theSection and theName
@@ -48,8 +75,11 @@ public:
     * @param[in] theDefault to use if the value is not found (optional)
     * @return the value found or theDefault if not found or correct
     */
-    bool GetBool(const std::string theSection, const std::string theName,
+    bool GetBool(const char* theSection, const char* theName,
+        const bool theDefault = false) const;
+    bool GetBool(const std::string& theSection, const std::string& theName,
         const bool theDefault = false) const;
+    bool GetBool(const KeyHandle theKey, const bool theDefault = false) const;
 
     /**
     * GetFloat will return a floating point number for theSection and
@@ -60,8 +90,11 @@ public:
     * @param[in] theDefault to use if the value is not found (optional)
     * @return the value found or theDefault if not found or correct
     */
-    float GetFloat(const std::string theSection, const std::string theName,
+    float GetFloat(const char* theSection, const char* theName,
         const float theDefault = 0.f) const;
+    float GetFloat(const std::string& theSection, const std::string& theName,
+        const float theDefault = 0.f) const;
+    float GetFloat(const KeyHandle theKey, const float theDefault = 0.f) const;
 
     /**
     * GetString will return the string value for theSection and theName
@@ -71,8 +104,28 @@ public:
     * @param[in] theDefault to use if the value is not found (optional)
     * @return the value found or theDefault if not found
     */
-    std::string GetString(const std::string theSection,
-        const std::string theName, const std::string theDefault = "") const;
+    std::string GetString(const char* theSection, const char* theName,
+        const char* theDefault = "") const;
+    std::string GetString(const std::string& theSection,
+        const std::string& theName, const std::string& theDefault = "") const;
+
+    /**
+    * GetValue will return the value for theKey provided without copying it.
+    * The pointer remains valid as long as the handles from FindKey do.
+    * @param[in] theKey returned by FindKey
+    * @return the value found or NULL if theKey is not valid
+    */
+    const char* GetValue(const KeyHandle theKey) const;
+
+    /**
+    * GetNames will fill theNames with the names found in theSection in
+    * alphabetical order.
+    * @param[in] theSection to retrieve the names from
+    * @param[out] theNames vector to fill with the names found
+    * @return true if theSection exists
+    */
+    bool GetNames(const std::string& theSection,
+        std::vector<std::string>& theNames) const;
 
     /**
     * GetUint32 will return an unsigned 32 bit number for theSection and
@@ -83,16 +136,42 @@ public:
     * @param[in] theDefault to use if the value is not found (optional)
     * @return the value found or theDefault if not found
     */
-    Uint32 GetUint32(const std::string theSection, const std::string theName,
+    Uint32 GetUint32(const char* theSection, const char* theName,
+        const Uint32 theDefault = 0) const;
+    Uint32 GetUint32(const std::string& theSection, const std::string& theName,
         const Uint32 theDefault = 0) const;
+    Uint32 GetUint32(const KeyHandle theKey, const Uint32 theDefault = 0) const;
 
     /**
-    * LoadFromFile will open and read the configuration file specified into
-    * internal maps that can be later retrieved using the Get* options above.
+    * LoadFromFile will read the whole configuration file specified into
+    * memory and parse it in place. Boolean and numeric values are parsed
+    * once here so the Get* options above do not need to convert them.
+    * Binary files written by SaveToBinary are detected by BINARY_MAGIC and
+    * read straight into the tables without any parsing.
     * @param[in] theFilename to use as the configuration file to read
     * @result true if theFilename was found and opened successfully
     */
-    bool LoadFromFile(const std::string theFilename);
+    bool LoadFromFile(const std::string& theFilename);
+
+    /**
+    * LoadFromMemory will read the configuration from theData provided in
+    * either the text or the binary format, see LoadFromFile above.
+    * @param[in] theData to read the configuration from
+    * @param[in] theSize of theData in bytes
+    * @result true if theData was read successfully
+    */
+    bool LoadFromMemory(const char* theData, const size_t theSize);
+
+    /**
+    * SaveToBinary will write the name, value pairs read into theFilename
+    * using the binary format. The file holds a header, the sorted entry
+    * table, the section table and a compact buffer with the strings, so
+    * loading it is just reading the tables back. Numbers are written in
+    * the byte order of the machine.
+    * @param[in] theFilename to write the binary configuration to
+    * @result true if theFilename was written successfully
+    */
+    bool SaveToBinary(const std::string& theFilename) const;
 
     /**
     * Assignment operator will duplicate the information found in theRight
@@ -105,37 +184,121 @@ public:
 private:
     // Constants
     ///////////////////////////////////////////////////////////////////////////
-    static const unsigned short MAX_CHARS = 100;
+    /// Entry flags set when the value was parsed successfully at load time
+    static const Uint32 FLAG_BOOL       = 0x01;
+    static const Uint32 FLAG_BOOL_TRUE  = 0x02;
+    static const Uint32 FLAG_FLOAT      = 0x04;
+    static const Uint32 FLAG_UINT32     = 0x08;
+
+    /// Name, value pair stored in the flat entry table. All strings are
+    /// offsets into the file buffer so the table can be copied as is.
+    struct Entry
+    {
+        /// Hash of the section and name used to sort the table
+        Uint32 hash;
+        /// Offset of the section name in the buffer
+        Uint32 section;
+        /// Offset of the name in the buffer
+        Uint32 name;
+        /// Offset of the value in the buffer
+        Uint32 value;
+        /// Value parsed as an unsigned 32 bit number
+        Uint32 uint32Value;
+        /// Value parsed as a floating point number
+        float floatValue;
+        /// FLAG_* values describing which parsed values are available
+        Uint32 flags;
+    };
+
+    /// Header at the start of a binary file, followed by the entry table,
+    /// the section table and the string buffer
+    struct BinaryHeader
+    {
+        /// BINARY_MAGIC
+        char magic[4];
+        /// BINARY_VERSION
+        Uint32 version;
+        /// Number of entries in the entry table
+        Uint32 entries;
+        /// Number of offsets in the section table
+        Uint32 sections;
+        /// Size in bytes of the string buffer
+        Uint32 buffer;
+    };
+
+    /// Compares entries by hash for sorting and searching the table
+    struct EntryLess
+    {
+        bool operator()(const Entry& theLeft, const Entry& theRight) const;
+        bool operator()(const Entry& theLeft, const Uint32 theHash) const;
+    };
 
     // Variables
     ///////////////////////////////////////////////////////////////////////////
     /// Point to app
 	ra::App *app;
-    /// Map to store all the sections and their corresponding name=value pairs
-    std::map<const std::string, typeNameValue*> mSections;
+    /// Contents of the file with the strings terminated in place
+    std::vector<char> mBuffer;
+    /// Name, value pairs sorted by hash
+    std::vector<Entry> mEntries;
+    /// Offsets of every section name found, including empty sections
+    std::vector<Uint32> mSections;
+
+    /**
+    * ParseBuffer will parse every line of the buffer read by LoadFromFile,
+    * terminating the names and values in place and adding them to the
+    * entry table.
+    */
+    void ParseBuffer();
+
+    /**
+    * StoreNameValue will parse theValue and add the name, value pair to
+    * the entry table.
+    * @param theSection offset of the section name in the buffer
+    * @param theName offset of the name in the buffer
+    * @param theValue offset of the value in the buffer
+    */
+    void StoreNameValue(const Uint32 theSection, const Uint32 theName,
+        const Uint32 theValue);
+
+    /**
+    * ReadBinary will check theHeader read from a binary file of theSize
+    * bytes and read the tables that follow it from theFile.
+    * @return true if the tables were read and are valid
+    */
+    bool ReadBinary(FILE* theFile, const BinaryHeader& theHeader, const size_t theSize);
+
+    /**
+    * ValidateBinary will check that every offset read from a binary file
+    * points inside the string buffer and the entries are sorted.
+    * @return true if the tables can be used as they are
+    */
+    bool ValidateBinary() const;
+
+    /**
+    * IsBinaryHeader will return true if theHeader belongs to a binary file
+    * of theSize bytes in the current version of the format.
+    */
+    static bool IsBinaryHeader(const BinaryHeader& theHeader, const size_t theSize);
+
+    /**
+    * SortEntries will sort the entry table by hash and remove duplicate
+    * name, value pairs keeping the first one found.
+    */
+    void SortEntries();
 
     /**
-    * ParseLine will parse the line provided by the Read method above.
-    * @param theLine to be parsed.
-    * @param theCount is the line number currently being processed
-    * @param theSection to be used if name, value pair is parsed
-    * @return string representing the new section name if section name was parsed
+    * Hash will return the FNV-1a hash of theSection and theName.
     */
-    std::string ParseLine(const char* theLine, const unsigned long theCount,
-        const std::string theSection);
+    static Uint32 Hash(const char* theSection, const char* theName);
 
     /**
-    * StoreNameValue will store theName and theValue pair into theSection.
-    * If theSection name value map doesn't yet exist, then it will be created.
-    * @param theSection is used to find the name, value pair map
-    * @param theName to be stored as the key for theValue below
-    * @param theValue to be stored in the current section name
+    * GetEntry will return the entry for theKey or NULL if not valid.
     */
-    void StoreNameValue(const std::string theSection,
-        const std::string theName, const std::string theValue);
+    const Entry* GetEntry(const KeyHandle theKey) const;
 
 }; // class ConfigReader
 
 } // namespace ra
 
-#endif // RAGE_CORE_CONFIG_READER_HPP
\ No newline at end of file
+#endif // RAGE_CORE_CONFIG_READER_HPP
@@ -42,13 +42,36 @@ class CircleShape;
 class RectangleShape;
 class ConvexShape;
 class Camera;
+class ScreenCapture;
+class Input;
+class InputRecorder;
+class FileWatcher;
+class LinearArena;
+class FrameMemory;
+class MemoryTracker;
+class MemoryScope;
+class SceneGraphPool;
+struct GraphHandle;
+class AnimationClip;
+class Animator;
+struct ParticleEmitter;
+class ParticleSystem;
+class TweenManager;
+class CollisionWorld;
+class TileGrid;
+class PathFinder;
+class PhysicsWorld;
+class PostProcess;
+class LightLayer;
+struct RenderCounters;
+class RenderStats;
 
 // Foward declare TmxMap
 
 
 // Foward declare Map
 
-/// ID nico de las escenas
+/// ID único de las escenas
 typedef std::string SceneID;
 
 /// Declare NameValue typedef which is used for config section maps
@@ -0,0 +1,154 @@
+#ifndef RAGE_CORE_FILE_WATCHER_HPP
+#define RAGE_CORE_FILE_WATCHER_HPP
+
+#include <map>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Vigila los archivos de recursos y configuración para recargarlos en
+ * caliente mientras se ejecuta la aplicación.
+ *
+ * Un hilo aparte detecta las modificaciones (con inotify en Linux y
+ * comprobando la fecha de modificación en el resto de sistemas) y las
+ * anota. Update() entrega en el hilo principal los archivos que llevan
+ * COALESCE_TIME milisegundos sin cambiar, así una ráfaga de guardados
+ * produce una sola recarga.
+ */
+class RAGE_CORE_API FileWatcher
+{
+	static FileWatcher* ms_instance;
+
+public:
+	/// Milisegundos sin cambios antes de entregar una modificación
+	static const unsigned int COALESCE_TIME = 200;
+	/// Milisegundos entre comprobaciones del hilo de vigilancia
+	static const unsigned int POLL_INTERVAL = 100;
+
+	/**
+	 * Devuelve un puntero a la instancia única de la clase si existe,
+	 * si no, la crea y duevuelve el puntero.
+	 *
+	 * @return Puntero a la instancia única de FileWatcher
+	 */
+	static FileWatcher* Instance();
+
+	/**
+	 * Elimina la instancia única de la clase.
+	 */
+	static void Release();
+
+	/**
+	 * Activa o desactiva la vigilancia. Desactivada, Watch() registra los
+	 * archivos pero no se detectan cambios
+	 */
+	void SetEnabled(bool theEnabled);
+
+	/**
+	 * Devuelve true si la vigilancia está activa
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * Comienza a vigilar un archivo
+	 *
+	 * @param theFilename Ruta completa del archivo
+	 */
+	void Watch(const std::string& theFilename);
+
+	/**
+	 * Deja de vigilar un archivo
+	 *
+	 * @param theFilename Ruta completa del archivo
+	 */
+	void Unwatch(const std::string& theFilename);
+
+	/**
+	 * Entrega las modificaciones que ya no reciben cambios. Se llama una vez
+	 * por frame desde App
+	 */
+	void Update();
+
+	/**
+	 * Devuelve los archivos modificados entregados en el último Update()
+	 */
+	const std::vector<std::string>& GetChanges() const;
+
+	/**
+	 * Devuelve true si el archivo está entre las modificaciones del último
+	 * Update()
+	 */
+	bool HasChanged(const std::string& theFilename) const;
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Archivos vigilados y su última fecha de modificación conocida
+	std::map<std::string, std::time_t> m_files;
+	/// Archivos modificados y el momento del último cambio detectado
+	std::map<std::string, sf::Time> m_pending;
+	/// Modificaciones entregadas en el último Update()
+	std::vector<std::string> m_changes;
+	/// Reloj para medir el tiempo desde el último cambio
+	sf::Clock m_clock;
+	/// Protege los archivos vigilados, los cambios y el estado del hilo
+	sf::Mutex m_mutex;
+	/// Hilo de vigilancia
+	sf::Thread m_thread;
+	/// Verdadero mientras la vigilancia está activa
+	bool m_enabled;
+#if defined(RAGE_SYSTEM_LINUX)
+	/// Descriptor de inotify
+	int m_inotify;
+	/// Rutas de los directorios vigilados por inotify, por descriptor de vigilancia
+	std::map<int, std::vector<std::string> > m_directories;
+#endif
+
+	/**
+	 * Bucle del hilo de vigilancia
+	 */
+	void WatchLoop();
+
+	/**
+	 * Comprueba la fecha de modificación de todos los archivos vigilados
+	 */
+	void PollFiles();
+
+	/**
+	 * Anota un cambio en un archivo. Debe llamarse con m_mutex bloqueado
+	 */
+	void NotifyChange(const std::string& theFilename);
+
+	/**
+	 * Devuelve la fecha de modificación de un archivo o 0 si no existe
+	 */
+	static std::time_t GetWriteTime(const std::string& theFilename);
+
+	FileWatcher();
+	virtual ~FileWatcher();
+
+	/**
+	 * FileWatcher copy constructor is private because we do not allow copies of
+	 * our Singleton class
+	 */
+	FileWatcher(const FileWatcher&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our Singleton class
+	 */
+	FileWatcher& operator=(const FileWatcher&);    // Intentionally undefined
+}; // class FileWatcher
+
+} // namespace ra
+
+#endif // RAGE_CORE_FILE_WATCHER_HPP
\ No newline at end of file
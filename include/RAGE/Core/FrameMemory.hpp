@@ -0,0 +1,126 @@
+#ifndef RAGE_CORE_FRAME_MEMORY_HPP
+#define RAGE_CORE_FRAME_MEMORY_HPP
+
+#include <cstddef>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/LinearArena.hpp>
+
+namespace ra
+{
+
+/**
+ * Memoria temporal por frame.
+ *
+ * Ofrece una LinearArena que App vacía al final de cada iteración del
+ * GameLoop y otra con doble búfer cuyos datos sobreviven al frame
+ * siguiente, para resultados que se calculan en un frame y se consumen en
+ * el próximo. Con ArenaAllocator los contenedores pueden usarlas.
+ *
+ * Si se compila con RAGE_TRACK_ALLOCATIONS, MemoryTracker cuenta las
+ * reservas en el heap y GetFrameHeapAllocations() devuelve las del último
+ * frame.
+ */
+class RAGE_CORE_API FrameMemory
+{
+	static FrameMemory* ms_instance;
+
+public:
+	/// Tamaño inicial de cada reserva en bytes
+	static const std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+	/**
+	 * Devuelve un puntero a la instancia única de la clase si existe,
+	 * si no, la crea y duevuelve el puntero.
+	 *
+	 * @return Puntero a la instancia única de FrameMemory
+	 */
+	static FrameMemory* Instance();
+
+	/**
+	 * Elimina la instancia única de la clase.
+	 */
+	static void Release();
+
+	/**
+	 * Reserva memoria válida hasta el final del frame actual
+	 */
+	void* Allocate(std::size_t theSize, std::size_t theAlignment = LinearArena::DEFAULT_ALIGNMENT);
+
+	/**
+	 * Reserva memoria válida hasta el final del frame siguiente
+	 */
+	void* AllocateDoubleBuffered(std::size_t theSize, std::size_t theAlignment = LinearArena::DEFAULT_ALIGNMENT);
+
+	/**
+	 * Devuelve la reserva que se vacía al final de cada frame
+	 */
+	LinearArena& GetFrameArena();
+
+	/**
+	 * Devuelve la reserva de doble búfer en la que se escribe este frame
+	 */
+	LinearArena& GetDoubleBufferedArena();
+
+	/**
+	 * Devuelve el número de reservas en el heap del último frame completo,
+	 * o 0 si no se compiló con RAGE_TRACK_ALLOCATIONS
+	 */
+	Uint32 GetFrameHeapAllocations() const;
+
+	/**
+	 * Devuelve true si se cuentan las reservas en el heap
+	 */
+	static bool IsTrackingAllocations();
+
+	/**
+	 * Devuelve el número total de reservas en el heap desde el inicio
+	 */
+	static Uint32 GetHeapAllocations();
+
+private:
+	friend class App;
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Reserva del frame actual
+	LinearArena m_frameArena;
+	/// Reservas del doble búfer
+	LinearArena m_bufferA;
+	LinearArena m_bufferB;
+	/// Reserva del doble búfer en la que se escribe este frame
+	LinearArena* m_current;
+	/// Reserva del doble búfer escrita el frame anterior
+	LinearArena* m_previous;
+	/// Reservas en el heap contadas al final del frame anterior
+	Uint32 m_heapAllocations;
+	/// Reservas en el heap del último frame completo
+	Uint32 m_frameHeapAllocations;
+
+	/**
+	 * Vacía la reserva del frame y alterna el doble búfer. App la llama al
+	 * final de cada iteración del GameLoop
+	 */
+	void EndFrame();
+
+	FrameMemory();
+	virtual ~FrameMemory();
+
+	/**
+	 * FrameMemory copy constructor is private because we do not allow copies of
+	 * our Singleton class
+	 */
+	FrameMemory(const FrameMemory&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our Singleton class
+	 */
+	FrameMemory& operator=(const FrameMemory&);    // Intentionally undefined
+}; // class FrameMemory
+
+} // namespace ra
+
+#endif // RAGE_CORE_FRAME_MEMORY_HPP
\ No newline at end of file
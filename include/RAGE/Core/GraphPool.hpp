@@ -0,0 +1,141 @@
+#ifndef RAGE_CORE_GRAPH_POOL_HPP
+#define RAGE_CORE_GRAPH_POOL_HPP
+
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+#include <RAGE/Core/SceneGraph.hpp>
+#include <RAGE/Core/Sprite.hpp>
+#include <RAGE/Core/Text.hpp>
+#include <RAGE/Core/CircleShape.hpp>
+#include <RAGE/Core/RectangleShape.hpp>
+#include <RAGE/Core/ConvexShape.hpp>
+
+namespace ra
+{
+
+/**
+ * Interfaz común de los GraphPool para que Scene pueda resolver los
+ * handles sin conocer el tipo de los objetos.
+ */
+class RAGE_CORE_API SceneGraphPool
+{
+public:
+	virtual ~SceneGraphPool()
+	{
+	}
+
+	/**
+	 * Devuelve el objeto de la posición theIndex si sigue en theGeneration,
+	 * o NULL si fue destruido
+	 */
+	virtual SceneGraph* GetGraph(Uint32 theIndex, Uint32 theGeneration) const = 0;
+
+	/**
+	 * Destruye el objeto de la posición theIndex si sigue en theGeneration
+	 */
+	virtual bool DestroyGraph(Uint32 theIndex, Uint32 theGeneration) = 0;
+}; // class SceneGraphPool
+
+/**
+ * Handle sin tipo a un objeto de un GraphPool, usado por Scene para
+ * guardar los objetos de la escena.
+ */
+struct GraphHandle
+{
+	/// Pool del objeto
+	SceneGraphPool* pool;
+	/// Posición del objeto en el pool
+	Uint32 index;
+	/// Generación de la posición
+	Uint32 generation;
+
+	GraphHandle()
+		: pool(NULL)
+		, index(0)
+		, generation(0)
+	{
+	}
+
+	GraphHandle(SceneGraphPool* thePool, Uint32 theIndex, Uint32 theGeneration)
+		: pool(thePool)
+		, index(theIndex)
+		, generation(theGeneration)
+	{
+	}
+
+	bool operator==(const GraphHandle& theRight) const
+	{
+		return pool == theRight.pool && index == theRight.index && generation == theRight.generation;
+	}
+
+	/// Orden para usarlo como clave de un std::map
+	bool operator<(const GraphHandle& theRight) const
+	{
+		if (pool != theRight.pool)
+		{
+			return pool < theRight.pool;
+		}
+		return (index != theRight.index) ? index < theRight.index : generation < theRight.generation;
+	}
+}; // struct GraphHandle
+
+/**
+ * ObjectPool de objetos dibujables que se pueden añadir a una Scene.
+ *
+ * \code
+ * // En la escena
+ * ra::SpritePool m_bullets;
+ *
+ * ra::Handle<ra::Sprite> bullet = m_bullets.Create();
+ * m_bullets.Get(bullet)->setTexture(texture);
+ * AddGraph(m_bullets.GetGraphHandle(bullet));
+ *
+ * // Destruirlo basta, la escena lo olvida en el siguiente Draw()
+ * m_bullets.Destroy(bullet);
+ * \endcode
+ *
+ * El pool debe vivir más que las escenas que usan sus objetos; lo normal es
+ * declararlo como miembro de la propia escena.
+ */
+template <class TYPE>
+class GraphPool : public ObjectPool<TYPE>, public SceneGraphPool
+{
+public:
+	/**
+	 * Crea el pool con sitio para theCapacity objetos
+	 */
+	explicit GraphPool(Uint32 theCapacity = ObjectPool<TYPE>::BLOCK_SIZE)
+		: ObjectPool<TYPE>(theCapacity)
+	{
+	}
+
+	/**
+	 * Devuelve el handle sin tipo de theHandle para añadirlo a una Scene
+	 */
+	GraphHandle GetGraphHandle(const Handle<TYPE>& theHandle)
+	{
+		return GraphHandle(this, theHandle.index, theHandle.generation);
+	}
+
+	virtual SceneGraph* GetGraph(Uint32 theIndex, Uint32 theGeneration) const
+	{
+		return this->Get(Handle<TYPE>(theIndex, theGeneration));
+	}
+
+	virtual bool DestroyGraph(Uint32 theIndex, Uint32 theGeneration)
+	{
+		return this->Destroy(Handle<TYPE>(theIndex, theGeneration));
+	}
+}; // class GraphPool
+
+/// Pools de los objetos dibujables del engine
+typedef GraphPool<ra::Sprite> SpritePool;
+typedef GraphPool<ra::Text> TextPool;
+typedef GraphPool<ra::CircleShape> CircleShapePool;
+typedef GraphPool<ra::RectangleShape> RectangleShapePool;
+typedef GraphPool<ra::ConvexShape> ConvexShapePool;
+
+} // namespace ra
+
+#endif // RAGE_CORE_GRAPH_POOL_HPP
\ No newline at end of file
@@ -0,0 +1,305 @@
+#ifndef RAGE_CORE_INPUT_HPP
+#define RAGE_CORE_INPUT_HPP
+
+#include <map>
+#include <bitset>
+#include <string>
+#include <vector>
+#include <SFML/Window.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/// Identificador de una acción registrada en Input
+typedef ra::Uint32 ActionID;
+
+/**
+ * Subsistema de entrada del engine.
+ *
+ * App vacía la cola de eventos de la ventana una vez por frame en Input,
+ * que guarda los eventos del frame y mantiene el estado de teclado, ratón
+ * y joysticks a partir de ellos, sin consultar al sistema operativo. Las
+ * consultas Is*Pressed/Is*Released detectan los cambios de este frame.
+ *
+ * Sobre el estado se define una capa de acciones: cada acción agrupa
+ * teclas, botones del ratón y botones de joystick, y se puede cargar de un
+ * archivo de configuración con una sección [actions]:
+ *
+ * \code
+ * [actions]
+ * left=Left,A,Joy0:14
+ * fire=Space,Mouse:Left
+ * \endcode
+ */
+class RAGE_CORE_API Input
+{
+	static Input* ms_instance;
+
+public:
+	/// Valor devuelto por GetActionID() si la acción no existe
+	static const ActionID INVALID_ACTION = 0xFFFFFFFF;
+
+	/**
+	 * Devuelve un puntero a la instancia única de la clase si existe,
+	 * si no, la crea y duevuelve el puntero.
+	 *
+	 * @return Puntero a la instancia única de Input
+	 */
+	static Input* Instance();
+
+	/**
+	 * Elimina la instancia única de la clase.
+	 */
+	static void Release();
+
+	/**
+	 * Devuelve los eventos recibidos en este frame, en orden de llegada
+	 */
+	const std::vector<sf::Event>& GetEvents() const;
+
+	/**
+	 * Devuelve true si la tecla está pulsada
+	 */
+	bool IsKeyDown(sf::Keyboard::Key theKey) const;
+
+	/**
+	 * Devuelve true si la tecla se ha pulsado en este frame
+	 */
+	bool IsKeyPressed(sf::Keyboard::Key theKey) const;
+
+	/**
+	 * Devuelve true si la tecla se ha soltado en este frame
+	 */
+	bool IsKeyReleased(sf::Keyboard::Key theKey) const;
+
+	/**
+	 * Devuelve true si el botón del ratón está pulsado
+	 */
+	bool IsMouseButtonDown(sf::Mouse::Button theButton) const;
+
+	/**
+	 * Devuelve true si el botón del ratón se ha pulsado en este frame
+	 */
+	bool IsMouseButtonPressed(sf::Mouse::Button theButton) const;
+
+	/**
+	 * Devuelve true si el botón del ratón se ha soltado en este frame
+	 */
+	bool IsMouseButtonReleased(sf::Mouse::Button theButton) const;
+
+	/**
+	 * Devuelve la posición del ratón relativa a la ventana
+	 */
+	sf::Vector2i GetMousePosition() const;
+
+	/**
+	 * Devuelve el movimiento de la rueda del ratón en este frame
+	 */
+	int GetMouseWheelDelta() const;
+
+	/**
+	 * Devuelve true si el joystick está conectado
+	 */
+	bool IsJoystickConnected(unsigned int theJoystick) const;
+
+	/**
+	 * Devuelve true si el botón del joystick está pulsado
+	 */
+	bool IsJoystickButtonDown(unsigned int theJoystick, unsigned int theButton) const;
+
+	/**
+	 * Devuelve true si el botón del joystick se ha pulsado en este frame
+	 */
+	bool IsJoystickButtonPressed(unsigned int theJoystick, unsigned int theButton) const;
+
+	/**
+	 * Devuelve true si el botón del joystick se ha soltado en este frame
+	 */
+	bool IsJoystickButtonReleased(unsigned int theJoystick, unsigned int theButton) const;
+
+	/**
+	 * Devuelve la posición del eje del joystick, entre -100 y 100
+	 */
+	float GetJoystickAxis(unsigned int theJoystick, sf::Joystick::Axis theAxis) const;
+
+	/**
+	 * Asocia una tecla a una acción, creando la acción si no existe
+	 *
+	 * @return Identificador de la acción o INVALID_ACTION si la tecla no
+	 * es válida
+	 */
+	ActionID MapKey(const std::string& theAction, sf::Keyboard::Key theKey);
+
+	/**
+	 * Asocia un botón del ratón a una acción, creando la acción si no existe
+	 *
+	 * @return Identificador de la acción o INVALID_ACTION si el botón no
+	 * es válido
+	 */
+	ActionID MapMouseButton(const std::string& theAction, sf::Mouse::Button theButton);
+
+	/**
+	 * Asocia un botón de joystick a una acción, creando la acción si no existe
+	 *
+	 * @return Identificador de la acción o INVALID_ACTION si el joystick o
+	 * el botón no son válidos
+	 */
+	ActionID MapJoystickButton(const std::string& theAction, unsigned int theJoystick, unsigned int theButton);
+
+	/**
+	 * Carga las acciones de la sección [actions] de un archivo de
+	 * configuración. Cada valor es una lista separada por comas de nombres
+	 * de tecla (como en sf::Keyboard), Mouse:<botón> o Joy<n>:<botón>
+	 *
+	 * @param theFilename Ruta del archivo de configuración
+	 * @return true si el archivo se ha podido leer
+	 */
+	bool LoadActions(const std::string& theFilename);
+
+	/**
+	 * Elimina todas las acciones
+	 */
+	void ClearActions();
+
+	/**
+	 * Devuelve el identificador de una acción para consultarla sin buscar
+	 * su nombre en cada frame
+	 *
+	 * @return Identificador o INVALID_ACTION si no existe
+	 */
+	ActionID GetActionID(const std::string& theAction) const;
+
+	/**
+	 * Devuelve true si alguna entrada de la acción está pulsada
+	 */
+	bool IsActionDown(ActionID theAction) const;
+	bool IsActionDown(const std::string& theAction) const;
+
+	/**
+	 * Devuelve true si la acción ha pasado a estar pulsada en este frame
+	 */
+	bool IsActionPressed(ActionID theAction) const;
+	bool IsActionPressed(const std::string& theAction) const;
+
+	/**
+	 * Devuelve true si la acción ha dejado de estar pulsada en este frame
+	 */
+	bool IsActionReleased(ActionID theAction) const;
+	bool IsActionReleased(const std::string& theAction) const;
+
+	/**
+	 * Convierte el nombre de una tecla en su código
+	 *
+	 * @return Código de la tecla o sf::Keyboard::Unknown
+	 */
+	static sf::Keyboard::Key ParseKey(const std::string& theName);
+
+private:
+	// Declaramos la clase App friend
+	friend class ra::App;
+
+	/// Tipo de entrada asociada a una acción
+	enum BindingType {
+		BindKey,
+		BindMouseButton,
+		BindJoystickButton
+	};
+
+	/// Entrada asociada a una acción
+	struct Binding
+	{
+		BindingType type;
+		unsigned int code;
+		unsigned int joystick;
+	};
+
+	/// Acción y sus entradas asociadas
+	struct Action
+	{
+		std::string name;
+		std::vector<Binding> bindings;
+	};
+
+	/// Estado de los dispositivos de entrada en un frame
+	struct State
+	{
+		std::bitset<sf::Keyboard::KeyCount> keys;
+		std::bitset<sf::Mouse::ButtonCount> mouseButtons;
+		std::bitset<sf::Joystick::Count * sf::Joystick::ButtonCount> joystickButtons;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Eventos del frame actual
+	std::vector<sf::Event> m_events;
+	/// Estado del frame actual
+	State m_current;
+	/// Estado del frame anterior
+	State m_previous;
+	/// Posición del ratón
+	sf::Vector2i m_mousePosition;
+	/// Movimiento de la rueda en este frame
+	int m_mouseWheel;
+	/// Joysticks conectados
+	std::bitset<sf::Joystick::Count> m_joystickConnected;
+	/// Posición de los ejes de los joysticks
+	float m_joystickAxis[sf::Joystick::Count][sf::Joystick::AxisCount];
+	/// Acciones registradas
+	std::vector<Action> m_actions;
+	/// Índice de las acciones por nombre
+	std::map<std::string, ActionID> m_actionIDs;
+
+	/**
+	 * Comienza un nuevo frame: el estado actual pasa a ser el anterior y se
+	 * vacía la cola de eventos
+	 */
+	void BeginFrame();
+
+	/**
+	 * Añade un evento a la cola del frame y actualiza el estado
+	 */
+	void PushEvent(const sf::Event& theEvent);
+
+	/**
+	 * Suelta todas las teclas y botones, se llama al perder el foco
+	 */
+	void ResetState();
+
+	/**
+	 * Devuelve la acción indicada creándola si no existe
+	 */
+	ActionID AddAction(const std::string& theAction);
+
+	/**
+	 * Devuelve true si alguna entrada de la acción está pulsada en el estado
+	 */
+	bool IsActionDown(const Action& theAction, const State& theState) const;
+
+	/**
+	 * Interpreta una entrada del archivo de acciones y la asocia a la acción
+	 */
+	bool ParseBinding(ActionID theAction, const std::string& theBinding);
+
+	Input();
+	virtual ~Input();
+
+	/**
+	 * Input copy constructor is private because we do not allow copies of
+	 * our Singleton class
+	 */
+	Input(const Input&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our Singleton class
+	 */
+	Input& operator=(const Input&);    // Intentionally undefined
+}; // class Input
+
+} // namespace ra
+
+#endif // RAGE_CORE_INPUT_HPP
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef RAGE_CORE_INPUT_RECORDER_HPP
+#define RAGE_CORE_INPUT_RECORDER_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <SFML/Window.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Graba y reproduce la entrada de la aplicación frame a frame.
+ *
+ * Por cada frame se guarda el tiempo transcurrido en microsegundos y los
+ * eventos obtenidos de la ventana, de forma que App puede repetir una
+ * ejecución exacta sin depender del reloj ni de la ventana. El formato es
+ * binario:
+ *
+ * - Cabecera: "RREC", versión (Uint32) y sizeof(sf::Event) (Uint32)
+ * - Por frame: tiempo en microsegundos (Int64), número de eventos (Uint32)
+ *   y los eventos tal cual están en memoria
+ *
+ * Los eventos se guardan en bruto, por lo que una grabación solo puede
+ * reproducirse con un ejecutable de la misma plataforma y versión de SFML.
+ */
+class RAGE_CORE_API InputRecorder
+{
+public:
+	/// Versión del formato de grabación
+	static const ra::Uint32 FORMAT_VERSION = 1;
+
+	InputRecorder();
+
+	~InputRecorder();
+
+	/**
+	 * Crea el archivo de grabación y escribe la cabecera
+	 *
+	 * @param theFilename Ruta del archivo de grabación
+	 * @return true si el archivo se ha podido crear
+	 */
+	bool StartRecording(const std::string& theFilename);
+
+	/**
+	 * Escribe un frame en la grabación
+	 *
+	 * @param theDelta Tiempo transcurrido en el frame
+	 * @param theEvents Eventos obtenidos de la ventana en el frame
+	 */
+	void RecordFrame(sf::Time theDelta, const std::vector<sf::Event>& theEvents);
+
+	/**
+	 * Cierra el archivo de grabación
+	 */
+	void StopRecording();
+
+	/**
+	 * Devuelve true si se está grabando
+	 */
+	bool IsRecording() const;
+
+	/**
+	 * Carga en memoria una grabación completa para reproducirla, sin
+	 * accesos a disco durante la reproducción
+	 *
+	 * @param theFilename Ruta del archivo de grabación
+	 * @return true si la grabación es válida
+	 */
+	bool StartReplay(const std::string& theFilename);
+
+	/**
+	 * Obtiene el siguiente frame de la reproducción
+	 *
+	 * @param theDelta Tiempo transcurrido en el frame grabado
+	 * @param theEvents Vector donde se copian los eventos del frame
+	 * @return false si la grabación ha terminado
+	 */
+	bool ReadFrame(sf::Time& theDelta, std::vector<sf::Event>& theEvents);
+
+	/**
+	 * Termina la reproducción y libera la grabación
+	 */
+	void StopReplay();
+
+	/**
+	 * Devuelve true si se está reproduciendo una grabación
+	 */
+	bool IsReplaying() const;
+
+	/**
+	 * Devuelve el número de frames grabados o reproducidos
+	 */
+	ra::Uint32 GetFrameCount() const;
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Archivo de grabación
+	std::ofstream m_file;
+	/// Contenido de la grabación que se está reproduciendo
+	std::vector<char> m_data;
+	/// Posición de lectura en m_data
+	size_t m_offset;
+	/// Frames grabados o reproducidos
+	ra::Uint32 m_frameCount;
+	/// Verdadero si se está grabando
+	bool m_recording;
+	/// Verdadero si se está reproduciendo
+	bool m_replaying;
+
+	/**
+	 * Copia theSize bytes de la grabación en theData
+	 *
+	 * @return false si no quedan suficientes datos
+	 */
+	bool Read(void* theData, size_t theSize);
+
+	/**
+	 * InputRecorder copy constructor is private because we do not allow
+	 * copies of the open recording
+	 */
+	InputRecorder(const InputRecorder&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of the open recording
+	 */
+	InputRecorder& operator=(const InputRecorder&);    // Intentionally undefined
+}; // class InputRecorder
+
+} // namespace ra
+
+#endif // RAGE_CORE_INPUT_RECORDER_HPP
\ No newline at end of file
@@ -0,0 +1,188 @@
+#ifndef RAGE_CORE_LIGHT_LAYER_HPP
+#define RAGE_CORE_LIGHT_LAYER_HPP
+
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+#include <RAGE/Core/PostProcess.hpp>
+#include <RAGE/Core/SceneGraph.hpp>
+
+namespace ra
+{
+
+/// Referencia a una luz de un LightLayer
+typedef ra::Handle<LightLayer> LightHandle;
+
+/**
+ * Capa de iluminación dinámica de una escena.
+ *
+ * Las luces puntuales se suman en un mapa de luces que cubre la vista de
+ * la cámara con un margen, a resolución reducida (un cuarto por defecto), y
+ * que parte del color ambiente. Al dibujar la capa el mapa se amplía con filtrado y se
+ * multiplica sobre lo que ya hay dibujado, así que debe tener una Z mayor
+ * que los objetos a iluminar.
+ *
+ * Las luces que proyectan sombras lanzan rayos contra las celdas sólidas de
+ * un TileGrid y solo iluminan hasta donde llegan. Las luces que quedan fuera
+ * del mapa se descartan y el mapa solo se vuelve a dibujar si cambia una
+ * luz visible o el color ambiente, o si la vista se sale del mapa.
+ *
+ * La posición de las luces está en coordenadas del mundo; la transformación
+ * del nodo no se aplica. Update() se llama desde el Update() de la escena.
+ */
+class RAGE_CORE_API LightLayer : public ra::SceneGraph
+{
+public:
+	/// Segmentos del contorno de una luz, y rayos si proyecta sombras
+	static const Uint32 LIGHT_SEGMENTS = 96;
+
+	LightLayer();
+	virtual ~LightLayer();
+
+	/**
+	 * Establece el color del mapa donde no llega ninguna luz
+	 */
+	void SetAmbientColor(const sf::Color& theColor);
+	const sf::Color& GetAmbientColor() const;
+
+	/**
+	 * Establece la resolución del mapa de luces respecto a la vista
+	 */
+	void SetResolution(ra::PassScale theScale);
+
+	/**
+	 * Establece la rejilla cuyas celdas sólidas bloquean la luz, o NULL para
+	 * no proyectar sombras. Debe existir mientras se use la capa
+	 */
+	void SetOccluders(const ra::TileGrid* theGrid);
+
+	/**
+	 * Añade una luz puntual
+	 *
+	 * @param thePosition Posición en el mundo
+	 * @param theRadius Distancia a la que la luz se apaga
+	 * @param theColor Color e intensidad en el centro
+	 * @param theShadows true si la luz se detiene en los oclusores
+	 */
+	LightHandle AddLight(const sf::Vector2f& thePosition, float theRadius, const sf::Color& theColor,
+		bool theShadows = false);
+
+	void RemoveLight(const LightHandle& theLight);
+
+	void SetLightPosition(const LightHandle& theLight, const sf::Vector2f& thePosition);
+	sf::Vector2f GetLightPosition(const LightHandle& theLight) const;
+	void SetLightRadius(const LightHandle& theLight, float theRadius);
+	void SetLightColor(const LightHandle& theLight, const sf::Color& theColor);
+	void SetLightShadows(const LightHandle& theLight, bool theShadows);
+
+	/**
+	 * Enciende o apaga una luz sin eliminarla
+	 */
+	void SetLightEnabled(const LightHandle& theLight, bool theEnabled);
+
+	/**
+	 * Devuelve true si la luz sigue en la capa
+	 */
+	bool IsValid(const LightHandle& theLight) const;
+
+	/**
+	 * Vuelve a dibujar el mapa de luces si ha cambiado algo visible
+	 */
+	void Update();
+
+	/**
+	 * Elimina todas las luces
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de luces
+	 */
+	size_t GetLightCount() const;
+
+	/**
+	 * Devuelve el número de luces dibujadas en el último mapa
+	 */
+	size_t GetVisibleCount() const;
+
+	/**
+	 * Devuelve la zona que cubre el mapa de luces
+	 */
+	virtual sf::FloatRect getLocalBounds() const;
+	virtual sf::FloatRect getGlobalBounds() const;
+
+private:
+	/// Luz puntual
+	struct Light
+	{
+		sf::Vector2f position;
+		float radius;
+		sf::Color color;
+		bool shadows;
+		bool enabled;
+		/// Generación de la posición, cambia al liberarla
+		Uint32 generation;
+		/// Verdadero si la posición está ocupada
+		bool active;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Luces, ocupadas y libres
+	std::vector<Light> m_lights;
+	/// Posiciones libres de m_lights
+	std::vector<Uint32> m_free;
+	/// Color del mapa sin luces
+	sf::Color m_ambient;
+	/// Divisor de la resolución del mapa
+	ra::PassScale m_scale;
+	/// Rejilla que bloquea la luz o NULL
+	const ra::TileGrid* m_occluders;
+	/// Zona del mundo que cubre el mapa
+	sf::FloatRect m_rect;
+	/// Verdadero si hay que volver a dibujar el mapa
+	bool m_dirty;
+	/// Luces dibujadas en el último mapa
+	size_t m_visible;
+	/// Triángulos de las luces visibles, se reutilizan entre mapas
+	std::vector<sf::Vertex> m_vertices;
+	/// Mapa de luces
+	sf::RenderTexture m_lightMap;
+	/// Sprite que dibuja el mapa sobre la vista
+	sf::Sprite m_sprite;
+
+	/**
+	 * Devuelve la luz de un handle o NULL
+	 */
+	Light* Find(const LightHandle& theLight);
+	const Light* Find(const LightHandle& theLight) const;
+
+	/**
+	 * Marca el mapa para dibujarlo de nuevo si la luz se ve
+	 */
+	void Touch(const Light& theLight);
+
+	/**
+	 * Devuelve true si la luz alcanza la zona del mapa
+	 */
+	bool IsVisible(const Light& theLight) const;
+
+	/**
+	 * Añade los triángulos de una luz a m_vertices
+	 */
+	void AddVertices(const Light& theLight);
+
+	virtual void draw(sf::RenderTarget& theTarget, sf::RenderStates theStates) const;
+}; // class LightLayer
+
+} // namespace ra
+
+#endif // RAGE_CORE_LIGHT_LAYER_HPP
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef RAGE_CORE_LINEAR_ARENA_HPP
+#define RAGE_CORE_LINEAR_ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Reserva lineal de memoria (bump allocator).
+ *
+ * Cada reserva avanza un puntero dentro de un único bloque y Reset() libera
+ * todo a la vez, sin llamar a ningún destructor: solo debe usarse para
+ * datos que no necesitan destruirse o cuyos destructores no hacen nada.
+ *
+ * Si el bloque se llena la reserva se pide al heap y se anota; en el
+ * siguiente Reset() el bloque crece para que quepa todo lo del frame, así
+ * tras unos frames de calentamiento no se vuelve a tocar el heap.
+ *
+ * No es segura entre hilos, se usa desde el hilo principal.
+ */
+class RAGE_CORE_API LinearArena
+{
+public:
+	/// Alineación por defecto de las reservas
+	static const std::size_t DEFAULT_ALIGNMENT = 8;
+
+	/**
+	 * Crea la reserva con un bloque de theCapacity bytes
+	 */
+	explicit LinearArena(std::size_t theCapacity);
+
+	~LinearArena();
+
+	/**
+	 * Reserva theSize bytes alineados a theAlignment, que debe ser potencia
+	 * de dos. La memoria es válida hasta el siguiente Reset()
+	 *
+	 * @return Puntero a la memoria reservada, nunca NULL
+	 */
+	void* Allocate(std::size_t theSize, std::size_t theAlignment = DEFAULT_ALIGNMENT);
+
+	/**
+	 * Reserva un array de theCount elementos de tipo TYPE sin construirlos
+	 */
+	template <class TYPE>
+	TYPE* AllocateArray(std::size_t theCount)
+	{
+		return static_cast<TYPE*>(Allocate(theCount * sizeof(TYPE)));
+	}
+
+	/**
+	 * Libera todas las reservas y hace crecer el bloque si se llenó
+	 */
+	void Reset();
+
+	/**
+	 * Devuelve los bytes reservados desde el último Reset(), incluidos los
+	 * pedidos al heap
+	 */
+	std::size_t GetUsed() const;
+
+	/**
+	 * Devuelve el tamaño del bloque
+	 */
+	std::size_t GetCapacity() const;
+
+	/**
+	 * Devuelve el máximo de bytes reservados entre dos Reset()
+	 */
+	std::size_t GetPeak() const;
+
+	/**
+	 * Devuelve el número de reservas pedidas al heap desde el último Reset()
+	 */
+	Uint32 GetOverflowCount() const;
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Bloque de memoria
+	char* m_buffer;
+	/// Tamaño del bloque
+	std::size_t m_capacity;
+	/// Posición de la siguiente reserva en el bloque
+	std::size_t m_offset;
+	/// Máximo de bytes reservados entre dos Reset()
+	std::size_t m_peak;
+	/// Reservas pedidas al heap porque el bloque estaba lleno
+	std::vector<char*> m_overflow;
+	/// Bytes pedidos al heap desde el último Reset()
+	std::size_t m_overflowBytes;
+
+	/**
+	 * LinearArena copy constructor is private because we do not allow copies
+	 * of our arenas
+	 */
+	LinearArena(const LinearArena&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our arenas
+	 */
+	LinearArena& operator=(const LinearArena&);    // Intentionally undefined
+}; // class LinearArena
+
+} // namespace ra
+
+#endif // RAGE_CORE_LINEAR_ARENA_HPP
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef RAGE_CORE_MEMORY_TRACKER_HPP
+#define RAGE_CORE_MEMORY_TRACKER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/// Subsistemas a los que se atribuye la memoria
+enum MemoryTag {
+	MemoryUntagged = 0,	///< Reservas fuera de cualquier MemoryScope
+	MemoryAssets,		///< Texturas e imágenes del AssetManager
+	MemoryScene,		///< Escenas y sus grafos
+	MemoryText,			///< Fuentes y geometría de los textos
+	MemoryAudio,		///< Buffers de sonido y música
+	MemoryConfig,		///< Archivos de configuración
+	MemoryTagCount		///< Número de etiquetas
+};
+
+/// Estadísticas de memoria de una etiqueta
+struct MemoryStats
+{
+	/// Bytes reservados en el heap que siguen vivos
+	Uint64 liveBytes;
+	/// Máximo de bytes vivos en el heap
+	Uint64 peakBytes;
+	/// Reservas en el heap que siguen vivas
+	Uint32 liveAllocations;
+	/// Reservas en el heap desde el inicio
+	Uint32 allocations;
+	/// Bytes estimados que residen fuera del heap (texturas en la GPU)
+	Uint64 residentBytes;
+	/// Máximo de bytes residentes
+	Uint64 residentPeak;
+};
+
+/**
+ * Contabiliza la memoria por subsistema.
+ *
+ * Si se compila con RAGE_TRACK_ALLOCATIONS se sustituyen los operadores
+ * new y delete globales: cada reserva guarda su tamaño y la etiqueta del
+ * MemoryScope activo en el hilo que la hace, y al liberarse se descuenta
+ * de esa misma etiqueta. Sin RAGE_TRACK_ALLOCATIONS solo se contabilizan
+ * los bytes residentes que anotan los subsistemas, como el tamaño estimado
+ * de las texturas en la GPU.
+ *
+ * App escribe un informe periódico en el log y, al terminar, las reservas
+ * etiquetadas que nadie ha liberado.
+ */
+class RAGE_CORE_API MemoryTracker
+{
+public:
+	/**
+	 * Devuelve true si se contabilizan las reservas en el heap
+	 */
+	static bool IsTracking();
+
+	/**
+	 * Devuelve las estadísticas de una etiqueta
+	 */
+	static MemoryStats GetStats(MemoryTag theTag);
+
+	/**
+	 * Devuelve el número total de reservas en el heap desde el inicio
+	 */
+	static Uint32 GetTotalAllocations();
+
+	/**
+	 * Anota bytes que residen fuera del heap, por ejemplo una textura
+	 * subida a la GPU
+	 */
+	static void AddResident(MemoryTag theTag, Uint64 theBytes);
+
+	/**
+	 * Descuenta bytes anotados con AddResident()
+	 */
+	static void RemoveResident(MemoryTag theTag, Uint64 theBytes);
+
+	/**
+	 * Devuelve el nombre de una etiqueta
+	 */
+	static const char* GetTagName(MemoryTag theTag);
+
+	/**
+	 * Escribe el uso de memoria de cada etiqueta
+	 */
+	static void Report(std::ostream& theStream);
+
+	/**
+	 * Escribe las etiquetas que conservan memoria. Se llama cuando todos
+	 * los subsistemas se han liberado
+	 *
+	 * @return true si se ha encontrado memoria sin liberar
+	 */
+	static bool ReportLeaks(std::ostream& theStream);
+
+private:
+	friend class MemoryScope;
+
+	/**
+	 * Establece la etiqueta del hilo actual y devuelve la anterior
+	 */
+	static MemoryTag SetThreadTag(MemoryTag theTag);
+
+	MemoryTracker();                                     // Intentionally undefined
+	MemoryTracker(const MemoryTracker&);                 // Intentionally undefined
+	MemoryTracker& operator=(const MemoryTracker&);      // Intentionally undefined
+}; // class MemoryTracker
+
+/**
+ * Atribuye a una etiqueta las reservas que hace el hilo actual mientras
+ * existe el objeto. Los ámbitos se pueden anidar, al destruirse se
+ * recupera la etiqueta anterior
+ */
+class RAGE_CORE_API MemoryScope
+{
+public:
+	explicit MemoryScope(MemoryTag theTag);
+	~MemoryScope();
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Etiqueta activa antes de este ámbito
+	MemoryTag m_previous;
+
+	MemoryScope(const MemoryScope&);               // Intentionally undefined
+	MemoryScope& operator=(const MemoryScope&);    // Intentionally undefined
+}; // class MemoryScope
+
+} // namespace ra
+
+#endif // RAGE_CORE_MEMORY_TRACKER_HPP
\ No newline at end of file
@@ -0,0 +1,287 @@
+#ifndef RAGE_CORE_OBJECT_POOL_HPP
+#define RAGE_CORE_OBJECT_POOL_HPP
+
+#include <new>
+#include <vector>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Referencia a un objeto de un ObjectPool.
+ *
+ * Guarda la posición del objeto y la generación de esa posición cuando se
+ * creó. Al destruir el objeto la generación cambia, así un handle antiguo
+ * se detecta en lugar de apuntar a otro objeto. Un handle creado por
+ * defecto es nulo.
+ */
+template <class TYPE>
+struct Handle
+{
+	/// Posición del objeto en el pool
+	Uint32 index;
+	/// Generación de la posición, 0 en un handle nulo
+	Uint32 generation;
+
+	Handle()
+		: index(0)
+		, generation(0)
+	{
+	}
+
+	Handle(Uint32 theIndex, Uint32 theGeneration)
+		: index(theIndex)
+		, generation(theGeneration)
+	{
+	}
+
+	/**
+	 * Devuelve true si el handle no se ha asignado
+	 */
+	bool IsNull() const
+	{
+		return generation == 0;
+	}
+
+	bool operator==(const Handle& theRight) const
+	{
+		return index == theRight.index && generation == theRight.generation;
+	}
+
+	bool operator!=(const Handle& theRight) const
+	{
+		return !(*this == theRight);
+	}
+}; // struct Handle
+
+/**
+ * Pool de objetos de un mismo tipo en bloques de tamaño fijo.
+ *
+ * Los objetos se construyen en su posición dentro de bloques de BLOCK_SIZE
+ * objetos que nunca se mueven, por lo que los punteros obtenidos con Get()
+ * son estables mientras el objeto vive. Las posiciones libres se reutilizan
+ * y los bloques solo se piden cuando el pool se queda sin sitio: reservando
+ * la capacidad necesaria en el constructor, crear y destruir objetos no
+ * llama al allocator.
+ */
+template <class TYPE>
+class ObjectPool
+{
+public:
+	/// Objetos por bloque
+	static const Uint32 BLOCK_SIZE = 256;
+
+	/**
+	 * Crea el pool con sitio para theCapacity objetos
+	 */
+	explicit ObjectPool(Uint32 theCapacity = BLOCK_SIZE)
+		: m_blocks()
+		, m_slots()
+		, m_free()
+		, m_size(0)
+	{
+		Reserve(theCapacity);
+	}
+
+	/**
+	 * Destruye los objetos vivos y libera los bloques
+	 */
+	~ObjectPool()
+	{
+		Clear();
+		for (size_t i = 0; i < m_blocks.size(); i++)
+		{
+			::operator delete(m_blocks[i]);
+		}
+	}
+
+	/**
+	 * Reserva bloques para al menos theCapacity objetos
+	 */
+	void Reserve(Uint32 theCapacity)
+	{
+		while (GetCapacity() < theCapacity)
+		{
+			AddBlock();
+		}
+	}
+
+	/**
+	 * Construye un objeto con el constructor por defecto
+	 */
+	Handle<TYPE> Create()
+	{
+		Uint32 index = AllocateSlot();
+		new(GetAddress(index)) TYPE();
+		return ActivateSlot(index);
+	}
+
+	/**
+	 * Construye un objeto copia de theObject
+	 */
+	Handle<TYPE> Create(const TYPE& theObject)
+	{
+		Uint32 index = AllocateSlot();
+		new(GetAddress(index)) TYPE(theObject);
+		return ActivateSlot(index);
+	}
+
+	/**
+	 * Destruye el objeto de theHandle y deja su posición libre
+	 *
+	 * @return false si el handle ya no era válido
+	 */
+	bool Destroy(const Handle<TYPE>& theHandle)
+	{
+		if (!IsValid(theHandle))
+		{
+			return false;
+		}
+
+		GetAddress(theHandle.index)->~TYPE();
+
+		// Cambiamos la generación para invalidar los handles existentes
+		Slot& slot = m_slots[theHandle.index];
+		slot.alive = false;
+		slot.generation++;
+		if (slot.generation == 0)
+		{
+			slot.generation = 1;
+		}
+		m_free.push_back(theHandle.index);
+		m_size--;
+
+		return true;
+	}
+
+	/**
+	 * Devuelve el objeto de theHandle o NULL si ya fue destruido
+	 */
+	TYPE* Get(const Handle<TYPE>& theHandle) const
+	{
+		if (!IsValid(theHandle))
+		{
+			return NULL;
+		}
+		return GetAddress(theHandle.index);
+	}
+
+	/**
+	 * Devuelve true si el objeto de theHandle sigue vivo
+	 */
+	bool IsValid(const Handle<TYPE>& theHandle) const
+	{
+		return theHandle.index < m_slots.size() && m_slots[theHandle.index].alive &&
+			m_slots[theHandle.index].generation == theHandle.generation;
+	}
+
+	/**
+	 * Destruye todos los objetos vivos, conservando los bloques
+	 */
+	void Clear()
+	{
+		for (Uint32 i = 0; i < m_slots.size(); i++)
+		{
+			if (m_slots[i].alive)
+			{
+				Destroy(Handle<TYPE>(i, m_slots[i].generation));
+			}
+		}
+	}
+
+	/**
+	 * Devuelve el número de objetos vivos
+	 */
+	Uint32 GetSize() const
+	{
+		return m_size;
+	}
+
+	/**
+	 * Devuelve el número de objetos que caben sin pedir más bloques
+	 */
+	Uint32 GetCapacity() const
+	{
+		return static_cast<Uint32>(m_slots.size());
+	}
+
+private:
+	/// Estado de cada posición del pool
+	struct Slot
+	{
+		/// Generación actual, empieza en 1
+		Uint32 generation;
+		/// Verdadero si la posición tiene un objeto construido
+		bool alive;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Bloques de memoria de BLOCK_SIZE objetos
+	std::vector<char*> m_blocks;
+	/// Estado de cada posición
+	std::vector<Slot> m_slots;
+	/// Posiciones libres, la última liberada se reutiliza primero
+	std::vector<Uint32> m_free;
+	/// Objetos vivos
+	Uint32 m_size;
+
+	void AddBlock()
+	{
+		m_blocks.push_back(static_cast<char*>(::operator new(BLOCK_SIZE * sizeof(TYPE))));
+
+		Uint32 first = static_cast<Uint32>(m_slots.size());
+		Slot slot;
+		slot.generation = 1;
+		slot.alive = false;
+		m_slots.resize(first + BLOCK_SIZE, slot);
+
+		// Las posiciones nuevas se usan en orden
+		m_free.reserve(m_slots.size());
+		for (Uint32 i = first + BLOCK_SIZE; i > first; i--)
+		{
+			m_free.push_back(i - 1);
+		}
+	}
+
+	Uint32 AllocateSlot()
+	{
+		if (m_free.empty())
+		{
+			AddBlock();
+		}
+		Uint32 index = m_free.back();
+		m_free.pop_back();
+		return index;
+	}
+
+	Handle<TYPE> ActivateSlot(Uint32 theIndex)
+	{
+		m_slots[theIndex].alive = true;
+		m_size++;
+		return Handle<TYPE>(theIndex, m_slots[theIndex].generation);
+	}
+
+	TYPE* GetAddress(Uint32 theIndex) const
+	{
+		return reinterpret_cast<TYPE*>(m_blocks[theIndex / BLOCK_SIZE] + (theIndex % BLOCK_SIZE) * sizeof(TYPE));
+	}
+
+	/**
+	 * ObjectPool copy constructor is private because we do not allow copies
+	 * of our pools
+	 */
+	ObjectPool(const ObjectPool&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our pools
+	 */
+	ObjectPool& operator=(const ObjectPool&);    // Intentionally undefined
+}; // class ObjectPool
+
+} // namespace ra
+
+#endif // RAGE_CORE_OBJECT_POOL_HPP
\ No newline at end of file
@@ -0,0 +1,257 @@
+#ifndef RAGE_CORE_PARTICLE_SYSTEM_HPP
+#define RAGE_CORE_PARTICLE_SYSTEM_HPP
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/SceneGraph.hpp>
+
+namespace sf
+{
+	class Texture;
+}
+
+namespace ra
+{
+
+/**
+ * Parámetros de un emisor de partículas. Se leen de la sección [emitter]
+ * de un archivo de configuración:
+ *
+ *   [emitter]
+ *   rate=200              ; partículas por segundo
+ *   max=2000              ; partículas vivas como máximo
+ *   lifetime=0.5,1.5      ; segundos de vida, mínimo y máximo
+ *   speed=40,120          ; velocidad inicial, mínima y máxima
+ *   angle=270             ; dirección en grados
+ *   spread=30             ; apertura en grados alrededor de angle
+ *   gravity=0,200         ; aceleración
+ *   area=0,0              ; semiancho y semialto de la zona de emisión
+ *   size=6,1              ; tamaño al nacer y al morir
+ *   colorstart=255,220,0,255
+ *   colorend=255,0,0,0
+ *   rect=0,0,8,8          ; rectángulo de la textura
+ */
+struct RAGE_CORE_API ParticleEmitter
+{
+	/// Partículas por segundo
+	float rate;
+	/// Partículas vivas como máximo
+	Uint32 maxParticles;
+	/// Segundos de vida mínimo y máximo
+	sf::Vector2f lifetime;
+	/// Velocidad inicial mínima y máxima
+	sf::Vector2f speed;
+	/// Dirección en grados
+	float angle;
+	/// Apertura en grados alrededor de angle
+	float spread;
+	/// Aceleración de todas las partículas
+	sf::Vector2f gravity;
+	/// Semiancho y semialto de la zona de emisión
+	sf::Vector2f area;
+	/// Tamaño al nacer y al morir
+	sf::Vector2f size;
+	/// Color al nacer
+	sf::Color colorStart;
+	/// Color al morir
+	sf::Color colorEnd;
+	/// Rectángulo de la textura
+	sf::IntRect textureRect;
+
+	ParticleEmitter();
+
+	/**
+	 * Lee los parámetros de la sección [emitter], los que falten conservan
+	 * su valor
+	 */
+	void LoadFromConfig(const ra::ConfigReader& theConfig);
+}; // struct ParticleEmitter
+
+/**
+ * Sistema de partículas de un emisor.
+ *
+ * El estado de las partículas se guarda como estructura de arrays (un
+ * vector por componente) para que la actualización recorra memoria
+ * contigua con bucles sencillos que el compilador puede vectorizar. Las
+ * partículas viven en coordenadas del mundo: el emisor está en la posición
+ * del nodo y moverlo no arrastra a las que ya se han emitido. Todas se
+ * dibujan con una sola llamada a partir de un array de vértices que se
+ * rellena en Update().
+ *
+ * Con SetThreadCount() la integración y el relleno de vértices se reparten
+ * entre varios hilos cuando hay al menos PARALLEL_THRESHOLD partículas.
+ * La emisión usa un generador propio con semilla fija, así las
+ * reproducciones de InputRecorder dan el mismo resultado.
+ */
+class RAGE_CORE_API ParticleSystem : public ra::SceneGraph
+{
+public:
+	/// Partículas a partir de las cuales se usan varios hilos
+	static const Uint32 PARALLEL_THRESHOLD = 8192;
+	/// Hilos como máximo
+	static const Uint32 MAX_THREADS = 8;
+
+	ParticleSystem();
+	virtual ~ParticleSystem();
+
+	/**
+	 * Establece los parámetros del emisor. Las partículas vivas conservan
+	 * su estado
+	 */
+	void SetEmitter(const ParticleEmitter& theEmitter);
+
+	/**
+	 * Devuelve los parámetros del emisor
+	 */
+	const ParticleEmitter& GetEmitter() const;
+
+	/**
+	 * Lee los parámetros del emisor de un archivo de configuración
+	 *
+	 * @return true si el archivo se ha podido leer
+	 */
+	bool LoadFromFile(const std::string& theFilename);
+
+	/**
+	 * Establece la textura de las partículas o NULL para dibujarlas sin
+	 * textura. Debe existir mientras se dibuja el sistema
+	 */
+	void SetTexture(const sf::Texture* theTexture);
+
+	/**
+	 * Activa o desactiva la emisión continua. Las partículas vivas siguen
+	 * su curso
+	 */
+	void SetEmitting(bool theEmitting);
+	bool IsEmitting() const;
+
+	/**
+	 * Emite partículas de golpe, por ejemplo para una explosión
+	 */
+	void Emit(Uint32 theCount);
+
+	/**
+	 * Establece cuántos hilos se usan en la actualización, entre 1 y
+	 * MAX_THREADS
+	 */
+	void SetThreadCount(Uint32 theCount);
+
+	/**
+	 * Avanza la simulación y prepara los vértices
+	 *
+	 * @param theElapsed Tiempo transcurrido desde la última llamada
+	 */
+	void Update(sf::Time theElapsed);
+
+	/**
+	 * Elimina todas las partículas
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de partículas vivas
+	 */
+	Uint32 GetParticleCount() const;
+
+	/**
+	 * Devuelve los límites de las partículas en coordenadas del mundo
+	 */
+	virtual sf::FloatRect getLocalBounds() const;
+	virtual sf::FloatRect getGlobalBounds() const;
+
+private:
+	/// Tramo de partículas que actualiza un hilo
+	struct Worker
+	{
+		/// Sistema al que pertenece
+		ParticleSystem* system;
+		/// Primera partícula del tramo
+		Uint32 first;
+		/// Una después de la última partícula del tramo
+		Uint32 last;
+		/// Límites de las partículas del tramo
+		sf::FloatRect bounds;
+		/// Hilo que ejecuta Run()
+		sf::Thread thread;
+
+		explicit Worker(ParticleSystem* theSystem);
+		void Run();
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Parámetros del emisor
+	ParticleEmitter m_emitter;
+	/// Textura de las partículas
+	const sf::Texture* m_texture;
+	/// Verdadero si se emiten partículas de forma continua
+	bool m_emitting;
+	/// Fracción de partícula pendiente de emitir
+	float m_emitAccumulator;
+	/// Estado del generador de números aleatorios
+	Uint32 m_random;
+	/// Segundos del paso de simulación en curso
+	float m_step;
+	/// Partículas vivas
+	Uint32 m_count;
+	/// Posición
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	/// Velocidad
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	/// Edad entre 0 (al nacer) y 1 (al morir)
+	std::vector<float> m_age;
+	/// Inverso de la vida en segundos, lo que avanza la edad por segundo
+	std::vector<float> m_ageRate;
+	/// Cuatro vértices por partícula viva
+	std::vector<sf::Vertex> m_vertices;
+	/// Límites de las partículas vivas
+	sf::FloatRect m_bounds;
+	/// Tramos de la actualización, el primero se ejecuta en el hilo que
+	/// llama a Update()
+	std::vector<Worker*> m_workers;
+
+	/**
+	 * Añade una partícula en la posición del emisor
+	 */
+	void Spawn();
+
+	/**
+	 * Elimina las partículas que han llegado al final de su vida
+	 */
+	void RemoveDead();
+
+	/**
+	 * Integra y rellena los vértices de un tramo de partículas
+	 */
+	void UpdateRange(Worker& theWorker);
+
+	/**
+	 * Devuelve un número aleatorio entre theMin y theMax
+	 */
+	float Random(float theMin, float theMax);
+
+	/**
+	 * Redimensiona los arrays de partículas
+	 */
+	void Reserve(Uint32 theCapacity);
+
+	virtual void draw(sf::RenderTarget& theTarget, sf::RenderStates theStates) const;
+
+	ParticleSystem(const ParticleSystem&);               // Intentionally undefined
+	ParticleSystem& operator=(const ParticleSystem&);    // Intentionally undefined
+}; // class ParticleSystem
+
+} // namespace ra
+
+#endif // RAGE_CORE_PARTICLE_SYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,352 @@
+#ifndef RAGE_CORE_PATH_FINDER_HPP
+#define RAGE_CORE_PATH_FINDER_HPP
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/// Identificador de una petición de camino
+typedef ra::Uint32 PathID;
+
+/// Estado de una petición de camino
+enum PathStatus {
+	PathPending,   ///< La petición está en cola o resolviéndose
+	PathFound,     ///< Hay un camino
+	PathNotFound,  ///< No hay camino entre las dos celdas
+	PathUnknown    ///< La petición no existe, ya se recogió o se canceló
+};
+
+/**
+ * Búsqueda de caminos sobre la rejilla de un mapa de tiles.
+ *
+ * Las celdas libres de un TileGrid son transitables y los movimientos
+ * pueden ser diagonales si no cortan una esquina. Como todas las celdas
+ * cuestan lo mismo se usa Jump Point Search, que salta los tramos rectos
+ * sin meterlos en la lista abierta.
+ *
+ * En mapas grandes el mapa se divide además en bloques de CLUSTER_SIZE
+ * celdas unidos por entradas en sus bordes (HPA*). Los caminos largos se
+ * buscan primero entre entradas y luego se refinan bloque a bloque, así que
+ * el coste depende de los bloques recorridos y no del área del mapa. Al
+ * final se vuelven a buscar por tramos para quitar los rodeos que dan las
+ * entradas; aun así no son siempre óptimos (en rejillas aleatorias hasta
+ * un 15% más largos).
+ *
+ * Request() encola la petición y la resuelve uno de los hilos de trabajo.
+ * Update() recoge los resultados, normalmente una vez por frame desde la
+ * escena, y GetPath() los entrega. Los caminos ya calculados se guardan en
+ * una caché hasta que cambia la rejilla.
+ */
+class RAGE_CORE_API PathFinder
+{
+public:
+	/// Petición nula
+	static const PathID INVALID_PATH = 0;
+
+	/// Máximo de hilos de trabajo
+	static const Uint32 MAX_THREADS = 8;
+
+	/// Lado de los bloques de la abstracción jerárquica
+	static const Int32 CLUSTER_SIZE = 16;
+
+	/// Caminos que se guardan en la caché
+	static const size_t MAX_CACHED_PATHS = 256;
+
+	PathFinder();
+	~PathFinder();
+
+	/**
+	 * Toma las celdas transitables de una rejilla de colisiones. Espera a
+	 * los hilos de trabajo, descarta las peticiones pendientes y vacía la
+	 * caché
+	 */
+	void SetGrid(const ra::TileGrid& theGrid);
+
+	/**
+	 * Cambia el número de hilos de trabajo, entre 1 y MAX_THREADS
+	 */
+	void SetThreadCount(Uint32 theCount);
+
+	/**
+	 * Devuelve true si la celda está dentro del mapa y es transitable
+	 */
+	bool IsWalkable(Int32 theX, Int32 theY) const;
+
+	/**
+	 * Busca un camino en el hilo que llama
+	 *
+	 * @param theStart Celda de origen
+	 * @param theGoal Celda de destino
+	 * @param thePath Celdas del camino, incluidos el origen y el destino
+	 * @return true si hay camino
+	 */
+	bool FindPath(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+		std::vector<sf::Vector2i>& thePath);
+
+	/**
+	 * Encola una petición de camino para los hilos de trabajo
+	 *
+	 * @return Identificador de la petición
+	 */
+	PathID Request(const sf::Vector2i& theStart, const sf::Vector2i& theGoal);
+
+	/**
+	 * Devuelve el estado de una petición
+	 */
+	PathStatus GetStatus(PathID theID) const;
+
+	/**
+	 * Entrega el camino de una petición terminada y la olvida
+	 *
+	 * @param thePath Celdas del camino si se ha encontrado
+	 * @return Estado de la petición
+	 */
+	PathStatus GetPath(PathID theID, std::vector<sf::Vector2i>& thePath);
+
+	/**
+	 * Descarta una petición, su resultado no se entregará
+	 */
+	void Cancel(PathID theID);
+
+	/**
+	 * Recoge los caminos que han terminado los hilos de trabajo
+	 */
+	void Update();
+
+	/**
+	 * Espera a los hilos de trabajo y descarta peticiones, resultados y
+	 * caché
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de caminos en la caché
+	 */
+	size_t GetCacheSize() const;
+
+private:
+	/// Entrada a la lista abierta, ordenada de menor a mayor coste
+	struct OpenNode
+	{
+		float score;
+		Int32 index;
+
+		bool operator<(const OpenNode& theRight) const;
+	};
+
+	/// Arista del grafo de entradas
+	struct Edge
+	{
+		Uint32 node;
+		float cost;
+	};
+
+	/// Entrada entre dos bloques
+	struct Entrance
+	{
+		/// Celda de la entrada
+		Int32 cell;
+		/// Bloque al que pertenece la celda
+		Int32 cluster;
+	};
+
+	/// Memoria de trabajo de una búsqueda, una por hilo
+	struct Scratch
+	{
+		/// Coste desde el origen de cada celda
+		std::vector<float> cost;
+		/// Celda desde la que se llega a cada celda
+		std::vector<Int32> parent;
+		/// Marca de la búsqueda que visitó la celda
+		std::vector<Uint32> visited;
+		/// Marca de la búsqueda que cerró la celda
+		std::vector<Uint32> closed;
+		/// Marca de la búsqueda en curso
+		Uint32 stamp;
+		/// Lista abierta, un montículo
+		std::vector<OpenNode> open;
+		/// Puntos de salto del último camino, del destino al origen
+		std::vector<Int32> points;
+		/// Lo mismo para el grafo de entradas
+		std::vector<float> nodeCost;
+		std::vector<Uint32> nodeParent;
+		std::vector<Uint32> nodeVisited;
+		std::vector<Uint32> nodeClosed;
+		Uint32 nodeStamp;
+		/// Aristas temporales del origen y hacia el destino
+		std::vector<Edge> startLinks;
+		std::vector<Edge> goalLinks;
+
+		Scratch();
+	};
+
+	/// Petición o resultado
+	struct Job
+	{
+		PathID id;
+		sf::Vector2i start;
+		sf::Vector2i goal;
+		std::vector<sf::Vector2i> path;
+		bool found;
+	};
+
+	/// Hilo de trabajo
+	struct Worker
+	{
+		/// Buscador al que pertenece
+		PathFinder* finder;
+		/// Memoria de sus búsquedas
+		Scratch scratch;
+		/// Verdadero mientras el hilo está activo
+		bool running;
+		/// Hilo que ejecuta Run()
+		sf::Thread thread;
+
+		explicit Worker(PathFinder* theFinder);
+		void Run();
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Ancho del mapa en celdas
+	Int32 m_width;
+	/// Alto del mapa en celdas
+	Int32 m_height;
+	/// 1 si la celda es transitable, fila a fila
+	std::vector<Uint8> m_walkable;
+	/// Bloques en cada eje
+	Int32 m_clustersX;
+	Int32 m_clustersY;
+	/// Entradas entre bloques
+	std::vector<Entrance> m_nodes;
+	/// Aristas de cada entrada
+	std::vector<std::vector<Edge> > m_edges;
+	/// Entradas de cada bloque
+	std::vector<std::vector<Uint32> > m_clusterNodes;
+	/// Memoria de FindPath()
+	Scratch m_scratch;
+	/// Caminos calculados por origen y destino
+	std::map<std::pair<Int32, Int32>, std::vector<sf::Vector2i> > m_cache;
+	/// Orden de entrada en la caché, para descartar los más antiguos
+	std::deque<std::pair<Int32, Int32> > m_cacheOrder;
+	/// Siguiente identificador de petición
+	PathID m_nextID;
+	/// Peticiones sin resultado (solo hilo principal)
+	std::set<PathID> m_pending;
+	/// Resultados listos para GetPath() (solo hilo principal)
+	std::map<PathID, Job> m_ready;
+	/// Cola de peticiones para los hilos de trabajo
+	std::deque<Job> m_requests;
+	/// Cola de resultados de los hilos de trabajo
+	std::deque<Job> m_results;
+	/// Protege las colas y el estado de los hilos
+	sf::Mutex m_mutex;
+	/// Hilos de trabajo
+	std::vector<Worker*> m_workers;
+
+	/**
+	 * Espera a que terminen todos los hilos de trabajo
+	 */
+	void WaitWorkers();
+
+	/**
+	 * Crea las entradas entre bloques y las aristas que las unen
+	 */
+	void BuildHierarchy();
+
+	/**
+	 * Crea dos entradas unidas a ambos lados de un borde
+	 */
+	void AddTransition(std::map<Int32, Uint32>& theNodes, Int32 theFrom, Int32 theTo);
+
+	/**
+	 * Devuelve la entrada de una celda, creándola si no existe
+	 */
+	Uint32 GetNode(std::map<Int32, Uint32>& theNodes, Int32 theCell);
+
+	/**
+	 * Busca un camino con la abstracción si compensa o con JPS si no
+	 */
+	bool Solve(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+		std::vector<sf::Vector2i>& thePath, Scratch& theScratch) const;
+
+	/**
+	 * Busca un camino entre entradas y lo refina bloque a bloque
+	 */
+	bool SolveHierarchical(Int32 theStart, Int32 theGoal,
+		std::vector<sf::Vector2i>& thePath, Scratch& theScratch) const;
+
+	/**
+	 * Jump Point Search dentro de un rectángulo. Deja los puntos de salto
+	 * en theScratch.points
+	 *
+	 * @param theCost Coste del camino encontrado
+	 */
+	bool Search(const sf::IntRect& theBounds, Int32 theStart, Int32 theGoal,
+		float& theCost, Scratch& theScratch) const;
+
+	/**
+	 * Avanza en una dirección hasta encontrar un punto de salto
+	 *
+	 * @return Celda del punto de salto o -1
+	 */
+	Int32 Jump(const sf::IntRect& theBounds, Int32 theX, Int32 theY,
+		Int32 theDX, Int32 theDY, Int32 theGoal) const;
+
+	/**
+	 * Vuelve a buscar por tramos un camino jerárquico, empezando en la celda
+	 * theOffset, y cambia cada tramo por uno más corto si lo encuentra
+	 */
+	void SmoothPath(std::vector<sf::Vector2i>& thePath, size_t theOffset, Scratch& theScratch) const;
+
+	/**
+	 * Añade al camino las celdas entre los puntos de salto de theScratch
+	 */
+	void AppendPoints(const Scratch& theScratch, std::vector<sf::Vector2i>& thePath) const;
+
+	/**
+	 * Devuelve true si la celda está dentro del rectángulo y es transitable
+	 */
+	bool IsWalkable(const sf::IntRect& theBounds, Int32 theX, Int32 theY) const;
+
+	/**
+	 * Devuelve el rectángulo del bloque de una celda
+	 */
+	sf::IntRect GetClusterBounds(Int32 theCell) const;
+
+	/**
+	 * Devuelve el bloque de una celda
+	 */
+	Int32 GetCluster(Int32 theCell) const;
+
+	/**
+	 * Distancia octil entre dos celdas
+	 */
+	float GetDistance(Int32 theFrom, Int32 theTo) const;
+
+	/**
+	 * Prepara la memoria de trabajo para una nueva búsqueda
+	 */
+	void Prepare(Scratch& theScratch) const;
+
+	/**
+	 * Guarda un camino en la caché
+	 */
+	void CachePath(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+		const std::vector<sf::Vector2i>& thePath);
+}; // class PathFinder
+
+} // namespace ra
+
+#endif // RAGE_CORE_PATH_FINDER_HPP
\ No newline at end of file
@@ -0,0 +1,421 @@
+#ifndef RAGE_CORE_PHYSICS_WORLD_HPP
+#define RAGE_CORE_PHYSICS_WORLD_HPP
+
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+
+namespace ra
+{
+
+/// Referencia a un cuerpo de un PhysicsWorld
+typedef ra::Handle<PhysicsWorld> BodyHandle;
+
+/// Tipo de cuerpo
+enum BodyType {
+	BodyStatic,     ///< No se mueve nunca
+	BodyKinematic,  ///< Se mueve con su velocidad pero no le afectan los choques
+	BodyDynamic     ///< Le afectan la gravedad, las fuerzas y los choques
+};
+
+/**
+ * Simulación de sólidos rígidos en 2D.
+ *
+ * Los cuerpos pueden ser círculos, cajas o polígonos convexos y se pueden
+ * crear directamente a partir de un CircleShape, RectangleShape o
+ * ConvexShape, que después siguen al cuerpo. Los choques se resuelven con
+ * impulsos secuenciales: varias pasadas sobre los puntos de contacto
+ * acumulando y limitando el impulso de cada uno. Cada punto que sigue en
+ * contacto empieza el paso con el impulso del anterior (warm starting),
+ * sin eso las pilas de más de tres o cuatro cuerpos no se sostienen.
+ *
+ * Update() avanza la simulación en pasos fijos (1/60 s por defecto) con
+ * el tiempo acumulado, así el resultado no depende de los fps. Las
+ * unidades son píxeles y segundos, y los ángulos se expresan en grados como
+ * en SFML.
+ *
+ * Los grupos de cuerpos en contacto (islas) que llevan un tiempo casi
+ * quietos se duermen: salen de la lista de cuerpos activos y solo se
+ * consultan cuando un cuerpo activo se acerca, momento en que despiertan.
+ * Normalmente cada escena tiene su PhysicsWorld y llama a Update() en su
+ * Update().
+ */
+class RAGE_CORE_API PhysicsWorld
+{
+public:
+	/// Vértices máximos de un polígono
+	static const Uint32 MAX_VERTICES = 16;
+
+	/// Pasos máximos por Update(), el resto del tiempo se descarta
+	static const Uint32 MAX_STEPS = 5;
+
+	PhysicsWorld();
+
+	void SetGravity(const sf::Vector2f& theGravity);
+	const sf::Vector2f& GetGravity() const;
+
+	/**
+	 * Cambia la duración del paso fijo
+	 */
+	void SetTimeStep(sf::Time theStep);
+	sf::Time GetTimeStep() const;
+
+	/**
+	 * Cambia las pasadas del solver por paso, más pasadas dan pilas más
+	 * estables
+	 */
+	void SetIterations(Uint32 theIterations);
+
+	/**
+	 * Añade un círculo
+	 *
+	 * @param theRadius Radio en píxeles
+	 * @param thePosition Posición del centro
+	 * @param theType Tipo de cuerpo
+	 */
+	BodyHandle AddCircle(float theRadius, const sf::Vector2f& thePosition, BodyType theType = BodyDynamic);
+
+	/**
+	 * Añade una caja centrada en thePosition
+	 */
+	BodyHandle AddBox(const sf::Vector2f& theSize, const sf::Vector2f& thePosition, BodyType theType = BodyDynamic);
+
+	/**
+	 * Añade un polígono convexo de como mucho MAX_VERTICES vértices
+	 *
+	 * @param thePoints Vértices relativos a thePosition, en cualquier sentido
+	 */
+	BodyHandle AddPolygon(const std::vector<sf::Vector2f>& thePoints, const sf::Vector2f& thePosition,
+		BodyType theType = BodyDynamic);
+
+	/**
+	 * Añaden un cuerpo con la forma, posición, rotación y escala actuales de
+	 * una figura, que a partir de ahora sigue al cuerpo. La figura debe
+	 * existir mientras el cuerpo esté en el mundo
+	 */
+	BodyHandle AddBody(ra::CircleShape& theShape, BodyType theType = BodyDynamic);
+	BodyHandle AddBody(ra::RectangleShape& theShape, BodyType theType = BodyDynamic);
+	BodyHandle AddBody(ra::ConvexShape& theShape, BodyType theType = BodyDynamic);
+
+	/**
+	 * Hace que un objeto de la escena siga al cuerpo: su posición será el
+	 * centro del cuerpo y su rotación la del cuerpo
+	 */
+	void Bind(const BodyHandle& theBody, ra::SceneGraph& theGraph);
+
+	/**
+	 * Elimina un cuerpo, el objeto que lo seguía se queda donde está
+	 */
+	void RemoveBody(const BodyHandle& theBody);
+
+	/**
+	 * Cambia la densidad (masa por píxel cuadrado), el rozamiento y el
+	 * rebote de un cuerpo
+	 */
+	void SetMaterial(const BodyHandle& theBody, float theDensity, float theFriction, float theRestitution);
+
+	/**
+	 * Impide que un cuerpo gire, útil para personajes con caja
+	 */
+	void SetFixedRotation(const BodyHandle& theBody, bool theFixed);
+
+	void SetPosition(const BodyHandle& theBody, const sf::Vector2f& thePosition);
+	sf::Vector2f GetPosition(const BodyHandle& theBody) const;
+	void SetRotation(const BodyHandle& theBody, float theAngle);
+	float GetRotation(const BodyHandle& theBody) const;
+	void SetVelocity(const BodyHandle& theBody, const sf::Vector2f& theVelocity);
+	sf::Vector2f GetVelocity(const BodyHandle& theBody) const;
+	void SetAngularVelocity(const BodyHandle& theBody, float theVelocity);
+	float GetAngularVelocity(const BodyHandle& theBody) const;
+
+	/**
+	 * Aplica una fuerza en el centro durante el siguiente paso
+	 */
+	void ApplyForce(const BodyHandle& theBody, const sf::Vector2f& theForce);
+
+	/**
+	 * Aplica un impulso en un punto del mundo
+	 */
+	void ApplyImpulse(const BodyHandle& theBody, const sf::Vector2f& theImpulse, const sf::Vector2f& thePoint);
+
+	/**
+	 * Despierta un cuerpo dormido
+	 */
+	void Wake(const BodyHandle& theBody);
+
+	bool IsAwake(const BodyHandle& theBody) const;
+
+	/**
+	 * Devuelve true si el cuerpo sigue en el mundo
+	 */
+	bool IsValid(const BodyHandle& theBody) const;
+
+	/**
+	 * Avanza la simulación los pasos fijos que quepan en el tiempo
+	 * acumulado y actualiza los objetos que siguen a los cuerpos
+	 *
+	 * @param theElapsed Tiempo transcurrido desde la última llamada
+	 */
+	void Update(sf::Time theElapsed);
+
+	/**
+	 * Avanza la simulación un paso fijo
+	 */
+	void Step();
+
+	/**
+	 * Elimina todos los cuerpos
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de cuerpos
+	 */
+	size_t GetSize() const;
+
+	/**
+	 * Devuelve el número de cuerpos despiertos
+	 */
+	size_t GetAwakeCount() const;
+
+private:
+	/// Forma de un cuerpo
+	enum ShapeType {
+		ShapeCircle,
+		ShapePolygon
+	};
+
+	/// Cuerpo rígido
+	struct Body
+	{
+		BodyType type;
+		ShapeType shape;
+		/// Radio de los círculos
+		float radius;
+		/// Vértices de los polígonos respecto al centro de masas
+		sf::Vector2f vertices[MAX_VERTICES];
+		/// Normal exterior de la cara que empieza en cada vértice
+		sf::Vector2f normals[MAX_VERTICES];
+		Uint32 count;
+		/// Centro de masas
+		sf::Vector2f position;
+		/// Rotación en radianes
+		float angle;
+		sf::Vector2f velocity;
+		float angularVelocity;
+		/// Fuerza acumulada hasta el siguiente paso
+		sf::Vector2f force;
+		float density;
+		float friction;
+		float restitution;
+		float inverseMass;
+		float inverseInertia;
+		bool fixedRotation;
+		/// Límites en el último paso
+		sf::FloatRect bounds;
+		/// Objeto que sigue al cuerpo o NULL
+		ra::SceneGraph* graph;
+		/// Centro del cuerpo en coordenadas locales del objeto, escalado
+		sf::Vector2f offset;
+		/// Segundos que lleva casi quieto
+		float sleepTime;
+		/// Raíz de su isla en el paso en curso
+		Uint32 island;
+		/// En la raíz, el menor sleepTime de la isla
+		float islandSleepTime;
+		bool awake;
+		/// Posición en m_awake mientras está despierto
+		Uint32 awakeIndex;
+		/// Generación de la posición, cambia al liberarla
+		Uint32 generation;
+		/// Verdadero si la posición está ocupada
+		bool active;
+	};
+
+	/// Punto de contacto entre dos cuerpos
+	struct Contact
+	{
+		Uint32 first;
+		Uint32 second;
+		/// Identifica el punto dentro de la pareja de un paso a otro
+		Uint32 feature;
+		/// Normal de first a second
+		sf::Vector2f normal;
+		sf::Vector2f point;
+		/// Negativa si los cuerpos aún no se tocan
+		float penetration;
+		/// Punto respecto al centro de cada cuerpo
+		sf::Vector2f offsetFirst;
+		sf::Vector2f offsetSecond;
+		float normalMass;
+		float tangentMass;
+		/// Rozamiento combinado de los dos cuerpos
+		float friction;
+		/// Velocidad objetivo por rebote y corrección de penetración
+		float bias;
+		/// Impulsos acumulados
+		float normalImpulse;
+		float tangentImpulse;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Cuerpos, ocupados y libres
+	std::vector<Body> m_bodies;
+	/// Posiciones libres de m_bodies
+	std::vector<Uint32> m_free;
+	/// Cuerpos despiertos
+	std::vector<Uint32> m_awake;
+	/// Cuerpos despiertos ordenados por su borde izquierdo
+	std::vector<Uint32> m_sorted;
+	/// Cuerpos estáticos y dormidos ordenados por su borde izquierdo
+	std::vector<Uint32> m_resting;
+	/// Verdadero si m_resting hay que reconstruirlo
+	bool m_restingDirty;
+	/// Ancho del cuerpo en reposo más ancho
+	float m_restingWidth;
+	/// Contactos del paso en curso
+	std::vector<Contact> m_contacts;
+	/// Contactos del paso anterior ordenados por pareja y característica
+	std::vector<Contact> m_previous;
+	/// Cuerpos que despiertan por un contacto en el paso en curso
+	std::vector<Uint32> m_woken;
+	sf::Vector2f m_gravity;
+	/// Segundos del paso fijo
+	float m_step;
+	/// Segundos acumulados sin simular
+	float m_accumulator;
+	Uint32 m_iterations;
+
+	/**
+	 * Ocupa una posición libre para un cuerpo
+	 */
+	BodyHandle CreateBody(ShapeType theShape, const sf::Vector2f& thePosition, BodyType theType);
+
+	/**
+	 * Libera la posición de un cuerpo y cambia su generación para que los
+	 * handles antiguos dejen de ser válidos
+	 */
+	void Release(Uint32 theIndex);
+
+	/**
+	 * Copia los vértices de un polígono centrándolos en su centro de masas
+	 *
+	 * @return Centro de masas de los puntos originales
+	 */
+	sf::Vector2f SetVertices(Body& theBody, const std::vector<sf::Vector2f>& thePoints);
+
+	/**
+	 * Coloca un cuerpo recién creado como una figura y hace que esta lo siga
+	 *
+	 * @param theCenter Centro del cuerpo respecto al origen de la figura,
+	 *                  escalado pero sin rotar
+	 */
+	BodyHandle Attach(const BodyHandle& theBody, ra::Shape& theShape, const sf::Vector2f& theCenter);
+
+	/**
+	 * Calcula la masa y la inercia a partir de la forma y la densidad
+	 */
+	void UpdateMass(Body& theBody);
+
+	/**
+	 * Devuelve el cuerpo de un handle o NULL
+	 */
+	Body* Find(const BodyHandle& theBody);
+	const Body* Find(const BodyHandle& theBody) const;
+
+	/**
+	 * Despierta un cuerpo por su posición
+	 */
+	void WakeBody(Uint32 theIndex);
+
+	/**
+	 * Calcula los límites de un cuerpo en su posición actual
+	 */
+	sf::FloatRect ComputeBounds(const Body& theBody) const;
+
+	/**
+	 * Busca los pares de cuerpos que se solapan y genera sus contactos
+	 */
+	void FindContacts();
+
+	/**
+	 * Añade los contactos entre dos cuerpos si se tocan
+	 */
+	void Collide(Uint32 theFirst, Uint32 theSecond);
+
+	void CollideCircles(Uint32 theFirst, Uint32 theSecond);
+	void CollidePolygonCircle(Uint32 thePolygon, Uint32 theCircle);
+	void CollidePolygons(Uint32 theFirst, Uint32 theSecond);
+
+	/**
+	 * Añade un contacto con la normal de theFirst a theSecond. Si en el paso
+	 * anterior había un contacto con la misma pareja y característica
+	 * empieza con sus impulsos
+	 *
+	 * @param theFeature Identifica el punto dentro de la pareja
+	 */
+	void AddContact(Uint32 theFirst, Uint32 theSecond, const sf::Vector2f& theNormal,
+		const sf::Vector2f& thePoint, float thePenetration, Uint32 theFeature = 0);
+
+	/**
+	 * Calcula las masas efectivas y el bias de los contactos
+	 */
+	void PrepareContacts();
+
+	/**
+	 * Una pasada del solver sobre todos los contactos
+	 */
+	void SolveContacts();
+
+	/**
+	 * Impulso normal de un contacto
+	 */
+	void SolveNormal(Contact& theContact);
+
+	/**
+	 * Impulsos normales de los dos puntos de una pareja a la vez
+	 *
+	 * @return false si la pareja hay que resolverla punto a punto
+	 */
+	bool SolveNormals(Contact& theFirst, Contact& theSecond);
+
+	/**
+	 * Impulso de rozamiento de un contacto
+	 */
+	void SolveFriction(Contact& theContact);
+
+	/**
+	 * Aplica un impulso de first a second en el punto de un contacto
+	 */
+	void ApplyContactImpulse(const Contact& theContact, const sf::Vector2f& theImpulse);
+
+	/**
+	 * Duerme las islas cuyos cuerpos llevan un tiempo casi quietos
+	 */
+	void UpdateSleep();
+
+	/**
+	 * Devuelve la raíz de la isla de un cuerpo
+	 */
+	Uint32 FindIsland(Uint32 theIndex);
+
+	/**
+	 * Reordena los cuerpos estáticos y dormidos
+	 */
+	void RebuildResting();
+
+	/**
+	 * Copia la posición y la rotación del cuerpo al objeto que lo sigue
+	 */
+	void WriteBack(const Body& theBody) const;
+}; // class PhysicsWorld
+
+} // namespace ra
+
+#endif // RAGE_CORE_PHYSICS_WORLD_HPP
\ No newline at end of file
@@ -0,0 +1,199 @@
+#ifndef RAGE_CORE_POST_PROCESS_HPP
+#define RAGE_CORE_POST_PROCESS_HPP
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/// Resolución a la que se dibuja un paso de postprocesado
+enum PassScale {
+	PassFull = 1,     ///< Tamaño de la ventana
+	PassHalf = 2,     ///< Mitad de ancho y de alto
+	PassQuarter = 4   ///< Cuarta parte de ancho y de alto
+};
+
+/**
+ * Cadena de efectos a pantalla completa del engine.
+ *
+ * Mientras haya algún paso activo las escenas no dibujan en la ventana sino
+ * en una textura (App::GetRenderTarget()). Al terminar el frame cada paso
+ * activo dibuja la salida del anterior con su shader en otra textura, y el
+ * último en la ventana. Las texturas salen de un pool y se alternan entre
+ * pasos, así que la cadena no reserva memoria en cada frame.
+ *
+ * Los pasos a media o cuarta resolución dibujan muchos menos píxeles, útil
+ * para desenfoques y efectos suaves; el paso siguiente o la ventana los
+ * amplía con filtrado. Los pasos desactivados no cuestan nada y, si no hay
+ * ninguno activo, las escenas dibujan directamente en la ventana.
+ *
+ * Los shaders reciben la textura de entrada en "texture" y su tamaño en
+ * píxeles en "textureSize". Las escenas con Scene::SetPostProcessed(false)
+ * y las que tienen encima se dibujan después de la cadena, sin efectos.
+ */
+class RAGE_CORE_API PostProcess
+{
+	static PostProcess* ms_instance;
+
+public:
+	/**
+	 * Devuelve un puntero a la instancia única de la clase si existe,
+	 * si no, la crea y duevuelve el puntero.
+	 *
+	 * @return Puntero a la instancia única de PostProcess
+	 */
+	static PostProcess* Instance();
+
+	/**
+	 * Elimina la instancia única de la clase.
+	 */
+	static void Release();
+
+	/**
+	 * Añade un paso al final de la cadena cargando su fragment shader. Si
+	 * ya existía un paso con ese nombre se sustituye su shader y su escala
+	 *
+	 * @param theName Nombre del paso
+	 * @param theFilename Ruta del fragment shader
+	 * @param theScale Resolución a la que se dibuja el paso
+	 * @return true si el shader se ha cargado
+	 */
+	bool AddPass(const std::string& theName, const std::string& theFilename, PassScale theScale = PassFull);
+
+	/**
+	 * Elimina un paso de la cadena
+	 */
+	void RemovePass(const std::string& theName);
+
+	/**
+	 * Activa o desactiva un paso sin sacarlo de la cadena
+	 */
+	void SetPassEnabled(const std::string& theName, bool theEnabled);
+
+	/**
+	 * Devuelve true si el paso existe y está activo
+	 */
+	bool IsPassEnabled(const std::string& theName) const;
+
+	/**
+	 * Cambia la resolución a la que se dibuja un paso
+	 */
+	void SetPassScale(const std::string& theName, PassScale theScale);
+
+	/**
+	 * Devuelve el shader de un paso para cambiar sus parámetros
+	 *
+	 * @return Puntero al shader o NULL si el paso no existe
+	 */
+	sf::Shader* GetShader(const std::string& theName);
+
+	/**
+	 * Devuelve true si hay algún paso activo
+	 */
+	bool IsActive() const;
+
+	/**
+	 * Devuelve donde deben dibujar las escenas en el frame actual: la
+	 * textura de la escena si hay pasos activos o la ventana si no
+	 */
+	sf::RenderTarget& GetRenderTarget();
+
+	/**
+	 * Prepara la textura de la escena con la vista de la ventana si hay
+	 * pasos activos. Debe llamarse una vez por frame, antes de dibujar
+	 */
+	void Begin();
+
+	/**
+	 * Ejecuta los pasos activos sobre la textura de la escena y deja el
+	 * resultado en la ventana, donde se dibuja a partir de entonces. Debe
+	 * llamarse después de dibujar y antes de las capturas y de
+	 * window.display(); SceneManager::DrawScene() puede llamarlo antes para
+	 * las escenas que no pasan por la cadena. Sin textura de la escena no
+	 * hace nada
+	 */
+	void End();
+
+	/**
+	 * Elimina todos los pasos y libera las texturas del pool
+	 */
+	void Cleanup();
+
+private:
+	/// Paso de la cadena
+	struct Pass
+	{
+		/// Nombre del paso
+		std::string name;
+		/// Shader del paso
+		sf::Shader* shader;
+		/// Resolución a la que se dibuja
+		PassScale scale;
+		/// Verdadero si el paso se ejecuta
+		bool enabled;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Pasos en orden de ejecución
+	std::vector<Pass> m_passes;
+	/// Texturas libres del pool, de cualquiera de los tamaños de los pasos
+	std::vector<sf::RenderTexture*> m_freeTargets;
+	/// Tamaño de la ventana para el que se crearon las texturas del pool
+	sf::Vector2u m_size;
+	/// Textura donde dibujan las escenas en el frame actual o NULL
+	sf::RenderTexture* m_scene;
+
+	/**
+	 * Devuelve el paso con el nombre indicado o NULL
+	 */
+	Pass* FindPass(const std::string& theName);
+	const Pass* FindPass(const std::string& theName) const;
+
+	/**
+	 * Obtiene una textura libre del tamaño indicado o crea una nueva
+	 *
+	 * @return La textura o NULL si no se ha podido crear
+	 */
+	sf::RenderTexture* AcquireTarget(const sf::Vector2u& theSize);
+
+	/**
+	 * Devuelve una textura al pool
+	 */
+	void RecycleTarget(sf::RenderTexture* theTarget);
+
+	/**
+	 * Libera las texturas libres del pool
+	 */
+	void ClearTargets();
+
+	/**
+	 * Dibuja una textura ocupando todo el destino, con un shader opcional
+	 */
+	void DrawTexture(const sf::Texture& theTexture, sf::RenderTarget& theTarget, sf::Shader* theShader);
+
+	PostProcess();
+	virtual ~PostProcess();
+
+	/**
+	 * PostProcess copy constructor is private because we do not allow copies of
+	 * our Singleton class
+	 */
+	PostProcess(const PostProcess&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our Singleton class
+	 */
+	PostProcess& operator=(const PostProcess&);    // Intentionally undefined
+}; // class PostProcess
+
+} // namespace ra
+
+#endif // RAGE_CORE_POST_PROCESS_HPP
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef RAGE_CORE_RENDER_STATS_HPP
+#define RAGE_CORE_RENDER_STATS_HPP
+
+#include <ostream>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+
+namespace sf
+{
+	class RenderTarget;
+	class Sprite;
+	class Vertex;
+	class VertexArray;
+	class View;
+}
+
+namespace ra
+{
+
+/// Contadores de dibujado de un frame
+struct RenderCounters
+{
+	/// Llamadas de dibujado enviadas a OpenGL
+	Uint32 drawCalls;
+	/// Vértices enviados
+	Uint32 vertices;
+	/// Puntos, líneas, triángulos o quads que forman esos vértices
+	Uint32 primitives;
+	/// Dibujados con una textura distinta a la del anterior
+	Uint32 textureBinds;
+	/// Cambios de vista en los destinos de dibujo
+	Uint32 viewChanges;
+	/// Dibujados con un shader distinto al del anterior
+	Uint32 shaderSwitches;
+	/// Objetos de la escena dibujados
+	Uint32 drawn;
+	/// Objetos de la escena descartados por estar ocultos o fuera de la vista
+	Uint32 culled;
+};
+
+/**
+ * Cuenta el trabajo de dibujado de cada frame.
+ *
+ * SFML no permite interceptar lo que se dibuja en un sf::RenderTarget, así
+ * que el motor dibuja y cambia de vista a través de Draw() y SetView(), que
+ * anotan la llamada y la pasan al destino. Los objetos de RAGE (Sprite,
+ * Shape, Text, ParticleSystem, LightLayer), la escena y el postprocesado ya
+ * lo hacen; lo que se dibuje directamente en el destino no se cuenta.
+ *
+ * App abre el frame antes de dibujar y lo cierra antes de presentarlo, de
+ * modo que el panel de estadísticas no se cuenta a sí mismo. Solo debe
+ * usarse desde el hilo que dibuja.
+ */
+class RAGE_CORE_API RenderStats
+{
+public:
+	/**
+	 * Dibuja vértices en theTarget y lo anota
+	 */
+	static void Draw(sf::RenderTarget& theTarget, const sf::Vertex* theVertices, unsigned int theCount,
+		sf::PrimitiveType theType, const sf::RenderStates& theStates = sf::RenderStates::Default);
+
+	/**
+	 * Dibuja un array de vértices en theTarget y lo anota
+	 */
+	static void Draw(sf::RenderTarget& theTarget, const sf::VertexArray& theVertices,
+		const sf::RenderStates& theStates = sf::RenderStates::Default);
+
+	/**
+	 * Dibuja un sf::Sprite, un quad con su textura, en theTarget y lo anota
+	 */
+	static void Draw(sf::RenderTarget& theTarget, const sf::Sprite& theSprite,
+		const sf::RenderStates& theStates = sf::RenderStates::Default);
+
+	/**
+	 * Establece la vista de theTarget. Solo se anota si es distinta de la
+	 * que ya tenía
+	 */
+	static void SetView(sf::RenderTarget& theTarget, const sf::View& theView);
+
+	/**
+	 * Anota objetos de la escena dibujados y descartados
+	 */
+	static void AddSceneObjects(Uint32 theDrawn, Uint32 theCulled);
+
+	/**
+	 * Empieza a contar un frame nuevo
+	 */
+	static void BeginFrame();
+
+	/**
+	 * Termina el frame actual, que pasa a ser el que devuelve GetFrame()
+	 */
+	static void EndFrame();
+
+	/**
+	 * Devuelve los contadores del último frame terminado
+	 */
+	static const RenderCounters& GetFrame();
+
+	/**
+	 * Devuelve el número de frames terminados desde el inicio o desde el
+	 * último Reset()
+	 */
+	static Uint32 GetFrameCount();
+
+	/**
+	 * Olvida los frames acumulados para el informe
+	 */
+	static void Reset();
+
+	/**
+	 * Escribe la media y el máximo por frame de cada contador
+	 */
+	static void Report(std::ostream& theStream);
+
+private:
+	RenderStats();                                   // Intentionally undefined
+	RenderStats(const RenderStats&);                 // Intentionally undefined
+	RenderStats& operator=(const RenderStats&);      // Intentionally undefined
+}; // class RenderStats
+
+} // namespace ra
+
+#endif // RAGE_CORE_RENDER_STATS_HPP
\ No newline at end of file
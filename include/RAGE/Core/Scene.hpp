@@ -5,7 +5,9 @@
 #include <RAGE/Core/Export.hpp>
 #include <RAGE/Core/Core_types.hpp>
 #include <RAGE/Core/App.hpp>
-#include <list>
+#include <RAGE/Core/AssetManager.hpp>
+#include <set>
+#include <vector>
 
 namespace ra
 {
@@ -19,7 +21,7 @@ public:
 	virtual ~Scene();
 
 	/**
-	 * Devuelve el identificador nico de la escena
+	 * Devuelve el identificador único de la escena
 	 *
 	 * @return GGE::SceneID el ID de la escena
 	 */
@@ -33,17 +35,84 @@ public:
 	void SetBackgroundColor(const sf::Color &theColor);
 
 	/**
-	 * Devuelve true si la escena est pausada
+	 * Devuelve true si la escena está pausada
 	 */
 	const bool IsPaused() const;
 
+	/**
+	 * Indica si la escena que está debajo en la pila se sigue dibujando.
+	 * Una escena que no dibuja por debajo tapa por completo a las
+	 * anteriores, que no se dibujan ni se actualizan. Por defecto false
+	 */
+	void SetDrawBelow(bool theValue);
+
+	/**
+	 * Devuelve true si la escena de debajo en la pila se dibuja
+	 */
+	const bool IsDrawingBelow() const;
+
+	/**
+	 * Indica si la escena que está debajo en la pila se sigue actualizando
+	 * mientras sea visible. Por defecto false
+	 */
+	void SetUpdateBelow(bool theValue);
+
+	/**
+	 * Devuelve true si la escena de debajo en la pila se actualiza
+	 */
+	const bool IsUpdatingBelow() const;
+
+	/**
+	 * Indica si la escena consume los eventos o los deja pasar a la escena
+	 * de debajo en la pila. Por defecto true
+	 */
+	void SetBlockInput(bool theValue);
+
+	/**
+	 * Devuelve true si la escena no deja pasar los eventos
+	 */
+	const bool IsBlockingInput() const;
+
+	/**
+	 * Indica si la escena pasa por la cadena de PostProcess. Con false la
+	 * cadena se aplica a las escenas de debajo y esta, y todas las de
+	 * encima, se dibujan después directamente en la ventana; así un menú de
+	 * pausa queda nítido sobre la escena desenfocada. Por defecto true
+	 */
+	void SetPostProcessed(bool theValue);
+
+	/**
+	 * Devuelve true si la escena pasa por la cadena de PostProcess
+	 */
+	bool IsPostProcessed() const;
+
+	/**
+	 * Declara los recursos que necesita la escena mediante PreloadAsset().
+	 * Se llama cuando la escena se precarga con SceneManager::PreloadScene()
+	 * y por defecto no declara ninguno
+	 */
+	virtual void Preload();
+
+	/**
+	 * Avanza la inicialización por etapas de la escena. Durante la precarga
+	 * se llama una vez por frame, con los recursos ya cargados, hasta que
+	 * devuelve 1; después se llama a Init(). Cada llamada debe limitarse al
+	 * trabajo que quepa en theBudget. Si la escena se activa antes de
+	 * terminar, los pasos restantes se dan seguidos. Por defecto no tiene
+	 * etapas y devuelve 1
+	 *
+	 * @param theBudget Tiempo disponible en este frame
+	 * @return Progreso de la inicialización entre 0 y 1
+	 */
+	virtual float InitStep(sf::Time theBudget);
+
 	virtual void Init();
 
 	virtual void Active() = 0;
 
 	virtual void Update() = 0;
 
-	virtual void Event(sf::Event theEvent) = 0;
+	virtual void Event(const sf::Event& theEvent) = 0;
 
 	virtual void Resume() = 0;
 
@@ -57,34 +126,236 @@ public:
 	void QuitGraph(ra::SceneGraph& theGraph);
 	void DeleteGraph(ra::SceneGraph& theGraph);
 
+	/**
+	 * Añade a la escena un objeto de un GraphPool. Si el objeto se destruye
+	 * en el pool sin quitarlo, la escena lo olvida en el siguiente Draw()
+	 */
+	void AddGraph(const ra::GraphHandle& theHandle);
+
+	/**
+	 * Quita de la escena un objeto de un GraphPool sin destruirlo
+	 */
+	void QuitGraph(const ra::GraphHandle& theHandle);
+
+	/**
+	 * Quita de la escena un objeto de un GraphPool y lo destruye en su pool
+	 */
+	void DeleteGraph(const ra::GraphHandle& theHandle);
+
+	/**
+	 * Define una capa de parallax. Los objetos con Z entre theMinZ y theMaxZ
+	 * se dibujan con una vista propia que se desplaza theParallax veces lo
+	 * que se desplaza la cámara: 0 la deja fija en pantalla y 1 la mueve
+	 * con la cámara. Los objetos fuera de las capas usan la vista de la
+	 * cámara. Las capas no deben solaparse; si ya existe una capa con ese
+	 * nombre se redefine
+	 *
+	 * @param theName Nombre de la capa
+	 * @param theMinZ Menor Z de la capa
+	 * @param theMaxZ Mayor Z de la capa
+	 * @param theParallax Factor de desplazamiento en cada eje
+	 */
+	void SetLayer(const std::string& theName, ra::Int32 theMinZ, ra::Int32 theMaxZ,
+		const sf::Vector2f& theParallax);
+
+	/**
+	 * Elimina una capa, sus objetos pasan a usar la vista de la cámara
+	 */
+	void RemoveLayer(const std::string& theName);
+
+	/**
+	 * Indica que el contenido de una capa no cambia. Sus objetos se dibujan
+	 * una vez en una textura que cubre la zona que ocupan y que todas las
+	 * cámaras copian con la vista de la capa, así que moverse o hacer zoom
+	 * no la vuelve a dibujar. Se redibuja cuando algún objeto cambia de
+	 * límites o de visibilidad; los demás cambios, como el color o el
+	 * rectángulo de la textura, necesitan InvalidateLayer()
+	 */
+	void SetLayerCached(const std::string& theName, bool theCached);
+
+	/**
+	 * Obliga a volver a dibujar una capa guardada en textura
+	 */
+	void InvalidateLayer(const std::string& theName);
+
+	/**
+	 * Añade una cámara con la que se dibuja esta escena, después de la
+	 * principal y de las que ya tenía. Solo la usa esta escena, las que se
+	 * dibujan encima o debajo en la pila no la ven. La cámara no pasa a ser
+	 * propiedad de la escena y se actualiza mientras la escena es visible
+	 *
+	 * @param theCamera Cámara con su viewport ya establecido
+	 */
+	void AddCamera(ra::Camera& theCamera);
+
+	/**
+	 * Quita una cámara añadida con AddCamera()
+	 */
+	void RemoveCamera(ra::Camera& theCamera);
+
 protected:
-	/// Puntero a la aplicacin padre
+	/// Puntero a la aplicación padre
 	ra::App* m_app;
 
 	/**
 	 * Constructor de la escena
 	 * 
-	 * @param m_id Cadena de texto que establece un identificador nico
+	 * @param m_id Cadena de texto que establece un identificador único
 	 */
 	Scene(SceneID theID);
 
+	/**
+	 * Añade un recurso a la lista de precarga de la escena. Debe llamarse
+	 * desde Preload()
+	 *
+	 * @param theType Tipo del recurso
+	 * @param theName Nombre del archivo del recurso
+	 */
+	void PreloadAsset(ra::AssetType theType, const std::string& theName);
+
 
 private:
+	// Declaramos la clase SceneManager friend
+	friend class ra::SceneManager;
 	// Puntero a la camara
 	ra::Camera *m_camera;
-	/// Representa el id nico de la escena
+	/// Representa el id único de la escena
 	const SceneID m_ID;
 	/// Comprueba si cleanup debe ser llamado
 	bool m_cleanup;
-	/// Comprueba si la escena est inicializada
+	/// Comprueba si la escena está inicializada
 	bool m_init;
-	/// Comprueba si la escena est pausada
+	/// Progreso de la inicialización por etapas, 1 cuando ha terminado
+	float m_initProgress;
+	/// Comprueba si la escena está pausada
 	bool m_paused;
 	/// Color de fondo de la escena
 	sf::Color m_colorBack;
+	/// La escena de debajo en la pila se dibuja
+	bool m_drawBelow;
+	/// La escena de debajo en la pila se actualiza
+	bool m_updateBelow;
+	/// La escena no deja pasar los eventos a la de debajo
+	bool m_blockInput;
+	/// La escena se dibuja antes de aplicar la cadena de PostProcess
+	bool m_postProcessed;
+	/// Objeto de la escena, con su pool si se añadió mediante un handle
+	struct GraphEntry
+	{
+		/// Objeto a dibujar, se resuelve en cada Draw() si tiene pool
+		ra::SceneGraph* graph;
+		/// Pool del objeto o NULL si se añadió por referencia
+		ra::SceneGraphPool* pool;
+		/// Posición del objeto en el pool
+		ra::Uint32 index;
+		/// Generación de la posición en el pool
+		ra::Uint32 generation;
+	};
+
+	/// Identifica un GraphEntry: su pool, posición y generación, o la
+	/// dirección del objeto si se añadió por referencia
+	struct GraphKey
+	{
+		const void* owner;
+		ra::Uint32 index;
+		ra::Uint32 generation;
+
+		bool operator<(const GraphKey& theRight) const;
+	};
+
+	/// Capa de parallax
+	struct Layer
+	{
+		/// Nombre de la capa
+		std::string name;
+		/// Rango de Z de sus objetos
+		ra::Int32 minZ;
+		ra::Int32 maxZ;
+		/// Desplazamiento respecto al de la cámara
+		sf::Vector2f parallax;
+		/// Verdadero si la capa se guarda en textura
+		bool cached;
+		/// Textura con los objetos de la capa o NULL
+		sf::RenderTexture* texture;
+		/// Zona del mundo que cubre la textura
+		sf::FloatRect textureRect;
+		/// Límites de cada objeto al dibujar la textura, vacíos si no se veía
+		std::vector<sf::FloatRect> bounds;
+		/// Verdadero si hay que volver a dibujar la textura
+		bool dirty;
+	};
+
 	/// Lista de Actores a dibujar
-	std::list<ra::SceneGraph*> m_sceneGraph;
+	std::vector<GraphEntry> m_sceneGraph;
+	/// Objetos de m_sceneGraph, para buscarlos sin recorrer la lista
+	std::set<GraphKey> m_graphKeys;
+	/// Objetos quitados que siguen en m_sceneGraph hasta el siguiente Draw()
+	std::set<GraphKey> m_quitGraphs;
+	/// Capas de parallax ordenadas por Z
+	std::vector<Layer> m_layers;
+	/// Cámaras propias de la escena, además de la principal
+	std::vector<ra::Camera*> m_cameras;
+	/// Recursos declarados en Preload()
+	std::vector<std::pair<ra::AssetType, std::string> > m_preloadAssets;
+
+
+	/**
+	 * Devuelve la clave de un objeto de la escena
+	 */
+	static GraphKey GetKey(const GraphEntry& theEntry);
+
+	/**
+	 * Añade un objeto a m_sceneGraph si no está ya en la escena
+	 */
+	void InsertGraph(const GraphEntry& theEntry);
+
+	/**
+	 * Quita un objeto de la escena, su entrada se descarta en el siguiente
+	 * Draw()
+	 */
+	void RemoveGraph(const GraphEntry& theEntry);
 
+	/**
+	 * Devuelve la capa con el nombre indicado o NULL
+	 */
+	Layer* FindLayer(const std::string& theName);
+
+	/**
+	 * Devuelve la capa a la que pertenece una Z o NULL
+	 */
+	Layer* GetLayerAt(ra::Int32 theZ);
+
+	/**
+	 * Calcula la vista de una capa a partir de la de una cámara
+	 */
+	sf::View GetLayerView(const Layer& theLayer, const ra::Camera& theCamera) const;
+
+	/**
+	 * Libera la textura de una capa
+	 */
+	void ClearCache(Layer& theLayer);
+
+	/**
+	 * Dibuja la lista de objetos ya ordenada con una cámara
+	 */
+	void DrawCamera(sf::RenderTarget& theTarget, const ra::Camera& theCamera);
+
+	/**
+	 * Devuelve la zona del mundo que muestra una vista
+	 */
+	sf::FloatRect GetViewRect(const sf::View& theView) const;
+
+	/**
+	 * Dibuja los objetos de un tramo de m_sceneGraph que se ven en theRect
+	 */
+	void DrawRange(sf::RenderTarget& theTarget, const sf::View& theView, const sf::FloatRect& theRect,
+		size_t theFirst, size_t theLast);
+
+	/**
+	 * Dibuja una capa guardada en textura, actualizándola si ha cambiado
+	 */
+	void DrawCached(sf::RenderTarget& theTarget, Layer& theLayer, const sf::View& theView,
+		size_t theFirst, size_t theLast);
 }; // class Scene
 
 } // namespace ra
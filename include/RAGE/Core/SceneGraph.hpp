@@ -27,7 +27,7 @@ public:
 	virtual sf::FloatRect getGlobalBounds() const = 0;
 
 private:
-	/// Representa el orden de dibujado entre mayor ms cerca de la cmara
+	/// Representa el orden de dibujado entre mayor más cerca de la cámara
 	ra::Int32 m_ZOrder;
 	/// Verdadero si el Objeto es visible
 	bool m_visible;
@@ -2,6 +2,8 @@
 #define RAGE_CORE_SCENE_MANAGER_HPP
 
 #include <map>
+#include <set>
+#include <vector>
 #include <SFML/Window.hpp>
 #include <RAGE/Core/Export.hpp>
 #include <RAGE/Core/Core_types.hpp>
@@ -19,11 +21,11 @@ public:
 	static void Release();
 
 /**
-	 * Aade una escena a la pila de escenas inactivas
+	 * Añade una escena a la pila de escenas inactivas
 	 *
-	 * Solo aade una escena a la pila, no la inicializa
+	 * Solo añade una escena a la pila, no la inicializa
 	 *
-	 * @param theScene Puntero a la escena que vamos a aadir
+	 * @param theScene Puntero a la escena que vamos a añadir
 	 */
 	void AddScene(Scene* theScene);
 
@@ -34,16 +36,34 @@ public:
 	 * Establece la escena como activa si se encuentra en la pila y llama a su
 	 * Init() si no ha sido llamado. Cambia la escena al final del ciclo
 	 *
-	 * @param theSceneID Cadena nica que identifica a la escena
+	 * @param theSceneID Cadena única que identifica a la escena
 	 */
 	void SetActiveScene(SceneID theSceneID);
 
+	/**
+	 * Apila la escena indicada sobre la escena activa al final del ciclo
+	 *
+	 * La escena apilada pasa a ser la activa y llama a su Init() si no ha
+	 * sido llamado. Las escenas de debajo se dibujan, actualizan y reciben
+	 * eventos según los indicadores de las escenas que tienen encima
+	 * (Scene::SetDrawBelow, SetUpdateBelow y SetBlockInput)
+	 *
+	 * @param theSceneID Cadena única que identifica a la escena
+	 */
+	void PushScene(SceneID theSceneID);
+
+	/**
+	 * Desapila la escena activa al final del ciclo. La escena de debajo
+	 * vuelve a ser la activa. La escena de la base no se puede desapilar
+	 */
+	void PopScene();
+
 	/**
 	 * Elimina una escena de la pila, no puede ser la escena activa
 	 *
-	 * Se encarga de llamar a su mtodo Cleanup y de eliminarla de la memoria
+	 * Se encarga de llamar a su método Cleanup y de eliminarla de la memoria
 	 *
-	 * @param theSceneID Cadena nica que identifica a la escena
+	 * @param theSceneID Cadena única que identifica a la escena
 	 */
 	void RemoveScene(SceneID theSceneID);
 
@@ -52,8 +72,37 @@ public:
 	 */
 	void RemoveAllInactiveScene();
 
+	/**
+	 * Comienza la precarga de una escena inactiva
+	 *
+	 * Llama a su Preload() y solicita la carga en segundo plano de los
+	 * recursos declarados. Cuando todos están cargados se llama a su
+	 * InitStep() una vez por frame hasta que termina y después a su Init(),
+	 * de forma que SetActiveScene() cambia de escena sin esperas
+	 *
+	 * @param theSceneID Cadena única que identifica a la escena
+	 */
+	void PreloadScene(SceneID theSceneID);
+
+	/**
+	 * Devuelve el progreso de la precarga de la escena entre 0 y 1. Cada
+	 * recurso cuenta como un paso y la inicialización por etapas como otro,
+	 * que avanza con lo que devuelve InitStep()
+	 *
+	 * @param theSceneID Cadena única que identifica a la escena
+	 */
+	float GetLoadProgress(SceneID theSceneID) const;
+
+	/**
+	 * Devuelve true si la escena tiene sus recursos cargados y su Init()
+	 * ya ha sido llamado
+	 *
+	 * @param theSceneID Cadena única que identifica a la escena
+	 */
+	bool IsSceneReady(SceneID theSceneID) const;
+
 protected:
-	// Puntero a la aplicacin
+	// Puntero a la aplicación
 	ra::App* m_app;
 
 private:
@@ -61,10 +110,18 @@ private:
 	friend class ra::App;
 	/// Escena actualmente activa
 	Scene* mActiveScene;
-	/// Prxima escena activa
+	/// Próxima escena activa
 	SceneID mNextScene;
 	// Lista de escenas inacticas
 	std::map<SceneID, Scene*> mInactivesScenes;
+	/// Escenas en proceso de precarga
+	std::set<SceneID> mLoadingScenes;
+	/// Pila de escenas en uso, la última es la escena activa
+	std::vector<Scene*> mSceneStack;
+	/// Escena a apilar al final del ciclo
+	SceneID mPushScene;
+	/// Número de escenas a desapilar al final del ciclo
+	unsigned int mPopCount;
 
 	/**
 	 * Cambia la escena activa inmediatamente. USAR SetActiveScene() para
@@ -78,39 +135,82 @@ private:
 	 * Elimina todas las escenas de la pila.
 	 *
 	 * Elimina todas las escenas incluso la escena activa, se encarga de llamar
-	 * a los mtodos Cleanup() de las escenas y de eleminarlas de la memoria
+	 * a los métodos Cleanup() de las escenas y de eleminarlas de la memoria
 	 */
 	void RemoveAllScene();
 
 	/**
-	 * Llama el mtodo Event() de la escena activa
+	 * Llama el método Event() de la escena activa y de las de debajo en la
+	 * pila mientras no bloqueen la entrada
 	 *
 	 * @param theEvent representa a un evento del sistema
 	 */
-	void EventScene(sf::Event theEvent);
+	void EventScene(const sf::Event& theEvent);
 
 	/**
-	 * Llama el mtodo Draw() de la escena activa
+	 * Llama el método Draw() de las escenas visibles de la pila, de abajo a
+	 * arriba. Antes de la primera que no pasa por el postprocesado aplica
+	 * la cadena de PostProcess a lo dibujado hasta entonces
 	 */
 	void DrawScene();
 
 	/**
-	 * Llama al mtodo Update() de la escena activa
+	 * Llama al método Update() de la escena activa y de las de debajo en la
+	 * pila que se actualicen y sean visibles
 	 */
 	void UpdateScene();
 
 	/**
-	 * Llama al mtodo Resume de la escena activa
+	 * Actualiza las cámaras propias de las escenas visibles de la pila,
+	 * después de su Update()
+	 */
+	void UpdateCameras();
+
+	/**
+	 * Llama al método Resume de la escena activa
 	 */
 	void ResumeScene();
 
 	/**
-	 * Llama al mtodo Pause de la escena activa
+	 * Llama al método Pause de la escena activa
 	 */
 	void PauseScene();
 
 	bool HandleChangeScene(); 
 
+	/**
+	 * Aplica las operaciones de apilar y desapilar pendientes
+	 */
+	void HandleStackChanges();
+
+	/**
+	 * Devuelve el índice de la escena más baja de la pila que es visible
+	 */
+	size_t GetFirstVisibleScene() const;
+
+	/**
+	 * Avanza la precarga de las escenas. Da como mucho un paso por frame, un
+	 * InitStep() o el Init() final, de la primera escena con todos sus
+	 * recursos cargados
+	 *
+	 * @param theBudget Tiempo disponible para el InitStep() de este frame
+	 */
+	void UpdatePreload(sf::Time theBudget);
+
+	/**
+	 * Termina de inicializar una escena que se va a usar ya: da seguidos y
+	 * sin límite de tiempo los pasos de InitStep() que falten, hasta que
+	 * termina o deja de avanzar, y llama a su Init()
+	 */
+	void CompleteInit(Scene* theScene);
+
+	/**
+	 * Busca una escena por su ID entre la activa y las inactivas
+	 *
+	 * @return Puntero a la escena o NULL si no existe
+	 */
+	Scene* FindScene(SceneID theSceneID) const;
+
 	SceneManager();
 	~SceneManager();
 
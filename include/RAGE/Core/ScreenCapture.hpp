@@ -0,0 +1,236 @@
+#ifndef RAGE_CORE_SCREEN_CAPTURE_HPP
+#define RAGE_CORE_SCREEN_CAPTURE_HPP
+
+#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/**
+ * Servicio de capturas de pantalla del engine.
+ *
+ * Las capturas se copian de la ventana a texturas en la GPU sin pasar por
+ * la CPU. Las texturas salen de un pool y se reciclan, por lo que capturar
+ * en cada pausa no reserva memoria nueva. La lectura a CPU (pantallazos y
+ * volcados de vídeo) se resuelve un frame después de la copia, cuando la
+ * GPU ya ha terminado, y la escritura a disco se hace en un hilo aparte.
+ *
+ * SFML 2.0 no ofrece pixel buffers ni fences, así que la lectura sigue
+ * siendo síncrona y bloquea el hilo principal mientras dura; el retraso de
+ * un frame solo evita esperar además a que la GPU termine la copia.
+ *
+ * Durante una grabación la cola del hilo de escritura está limitada: si el
+ * disco no da abasto los frames nuevos se descartan con un aviso en el log
+ * en lugar de acumular imágenes en memoria.
+ */
+class RAGE_CORE_API ScreenCapture
+{
+	static ScreenCapture* ms_instance;
+
+public:
+	/**
+	 * Devuelve un puntero a la instancia única de la clase si existe,
+	 * si no, la crea y duevuelve el puntero.
+	 *
+	 * @return Puntero a la instancia única de ScreenCapture
+	 */
+	static ScreenCapture* Instance();
+
+	/**
+	 * Elimina la instancia única de la clase.
+	 */
+	static void Release();
+
+	/**
+	 * Copia el contenido actual de la ventana a una textura del pool y la
+	 * registra con el nombre indicado. Si ya existía una captura con ese
+	 * nombre su textura se recicla.
+	 *
+	 * @param theName Nombre de la captura
+	 * @return Puntero a la textura con la captura
+	 */
+	const sf::Texture* Capture(const std::string& theName);
+
+	/**
+	 * Devuelve la captura registrada con el nombre indicado
+	 *
+	 * @param theName Nombre de la captura
+	 * @return Puntero a la textura o NULL si no existe
+	 */
+	const sf::Texture* GetCapture(const std::string& theName) const;
+
+	/**
+	 * Devuelve al pool la textura de la captura indicada
+	 *
+	 * @param theName Nombre de la captura
+	 */
+	void DeleteCapture(const std::string& theName);
+
+	/**
+	 * Solicita una lectura a CPU del contenido actual de la ventana. La
+	 * copia se hace ahora en la GPU y la imagen estará disponible a partir
+	 * del siguiente frame mediante GetReadback().
+	 *
+	 * @return Identificador de la petición
+	 */
+	ra::Uint32 RequestReadback();
+
+	/**
+	 * Obtiene la imagen de una petición de lectura si ya está lista. Una vez
+	 * obtenida la petición se elimina.
+	 *
+	 * @param theTicket Identificador devuelto por RequestReadback()
+	 * @param theImage Imagen donde se copia el resultado
+	 * @return true si la imagen estaba lista
+	 */
+	bool GetReadback(ra::Uint32 theTicket, sf::Image& theImage);
+
+	/**
+	 * Guarda en disco el contenido actual de la ventana sin bloquear el
+	 * frame: la lectura se hace en el siguiente frame y la escritura en el
+	 * hilo de escritura.
+	 *
+	 * @param theFilename Ruta del archivo de imagen
+	 */
+	void TakeScreenshot(const std::string& theFilename);
+
+	/**
+	 * Comienza a volcar todos los frames a disco como imágenes numeradas.
+	 * Los frames que no caben en la cola de escritura se descartan
+	 *
+	 * @param thePrefix Prefijo de ruta de los archivos (ej: "video/frame_")
+	 */
+	void StartRecording(const std::string& thePrefix);
+
+	/**
+	 * Detiene el volcado de frames
+	 */
+	void StopRecording();
+
+	/**
+	 * Devuelve true si se están volcando frames a disco
+	 */
+	bool IsRecording() const;
+
+	/**
+	 * Resuelve las lecturas pendientes de frames anteriores y captura el
+	 * frame actual si se está grabando. Debe llamarse una vez por frame,
+	 * después de dibujar y antes de window.display()
+	 */
+	void Update();
+
+	/**
+	 * Espera a que terminen las escrituras pendientes y libera todas las
+	 * texturas del pool
+	 */
+	void Cleanup();
+
+private:
+	/// Máximo de frames grabados pendientes de leer o de escribir a disco
+	static const unsigned int MAX_PENDING_FRAMES = 8;
+
+	/// Petición de lectura a CPU pendiente
+	struct Readback
+	{
+		/// Textura con la copia de la ventana
+		sf::Texture* texture;
+		/// Frame en el que se hizo la copia
+		ra::Uint64 frame;
+		/// Identificador de la petición (0 si es un pantallazo)
+		ra::Uint32 ticket;
+		/// Archivo de destino (vacío si no es un pantallazo)
+		std::string filename;
+	};
+
+	/// Trabajo pendiente para el hilo de escritura
+	struct WriteJob
+	{
+		/// Imagen a escribir
+		sf::Image* image;
+		/// Archivo de destino
+		std::string filename;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Puntero a App
+	App* m_app;
+	/// Texturas libres del pool
+	std::vector<sf::Texture*> m_freeTextures;
+	/// Capturas registradas por nombre
+	std::map<std::string, sf::Texture*> m_captures;
+	/// Lecturas a CPU pendientes
+	std::vector<Readback> m_readbacks;
+	/// Lecturas a CPU resueltas a la espera de ser recogidas
+	std::map<ra::Uint32, sf::Image*> m_images;
+	/// Contador de frames
+	ra::Uint64 m_frame;
+	/// Siguiente identificador de petición de lectura
+	ra::Uint32 m_nextTicket;
+	/// Prefijo de los archivos de grabación
+	std::string m_recordPrefix;
+	/// Número de frames grabados
+	ra::Uint32 m_recordCount;
+	/// Verdadero si se está grabando
+	bool m_recording;
+	/// Frames descartados en la grabación actual por tener la cola llena
+	ra::Uint32 m_droppedFrames;
+	/// Cola de trabajos del hilo de escritura
+	std::deque<WriteJob> m_writeJobs;
+	/// Protege la cola de trabajos y el estado del hilo
+	sf::Mutex m_writeMutex;
+	/// Hilo de escritura a disco
+	sf::Thread m_writer;
+	/// Verdadero mientras el hilo de escritura está activo
+	bool m_writerRunning;
+
+	/**
+	 * Obtiene una textura libre del tamaño de la ventana o crea una nueva
+	 */
+	sf::Texture* AcquireTexture();
+
+	/**
+	 * Devuelve una textura al pool
+	 */
+	void RecycleTexture(sf::Texture* theTexture);
+
+	/**
+	 * Copia la ventana a una textura del pool y encola su lectura
+	 */
+	void QueueReadback(ra::Uint32 theTicket, const std::string& theFilename);
+
+	/**
+	 * Devuelve el número de imágenes que esperan su lectura o su escritura
+	 */
+	size_t GetPendingWrites();
+
+	/**
+	 * Bucle del hilo de escritura a disco
+	 */
+	void WriterLoop();
+
+	ScreenCapture();
+	virtual ~ScreenCapture();
+
+	/**
+	 * ScreenCapture copy constructor is private because we do not allow copies of
+	 * our Singleton class
+	 */
+	ScreenCapture(const ScreenCapture&);               // Intentionally undefined
+
+	/**
+	 * Our assignment operator is private because we do not allow copies
+	 * of our Singleton class
+	 */
+	ScreenCapture& operator=(const ScreenCapture&);    // Intentionally undefined
+}; // class ScreenCapture
+
+} // namespace ra
+
+#endif // RAGE_CORE_SCREEN_CAPTURE_HPP
\ No newline at end of file
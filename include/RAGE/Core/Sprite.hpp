@@ -169,6 +169,12 @@ public :
 
 private :
 
+    ////////////////////////////////////////////////////////////
+    /// Animator copies the precomputed frames of its clips
+    /// straight into the vertices
+    ////////////////////////////////////////////////////////////
+    friend class Animator;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the sprite to a render target
     ///
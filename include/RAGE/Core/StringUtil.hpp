@@ -1,6 +1,7 @@
 #ifndef   RAGE_CORE_STRING_UTIL_HPP
 #define   RAGE_CORE_STRING_UTIL_HPP
 
+#include <cstddef>
 #include <string>
 #include <RAGE/Core/Export.hpp>
 #include <RAGE/Core/Core_types.hpp>
@@ -157,7 +158,7 @@ std::string RAGE_CORE_API ConvertVector3i(const sf::Vector3i theVector);
 * @param[in] theDefault value to return if not one of the above
 * @return the boolean value obtained
 */
-bool RAGE_CORE_API ParseBool(std::string theValue, const bool theDefault);
+bool RAGE_CORE_API ParseBool(const std::string& theValue, const bool theDefault);
 
 /**
 * ParseColor will parse theValue string to obtain the R,G,B,A color values
@@ -166,7 +167,7 @@ bool RAGE_CORE_API ParseBool(std::string theValue, const bool theDefault);
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Color RAGE_CORE_API ParseColor(const std::string theValue, const sf::Color theDefault);
+sf::Color RAGE_CORE_API ParseColor(const std::string& theValue, const sf::Color theDefault);
 
 /**
 * ParseDouble will parse theValue string to obtain the double value to
@@ -175,7 +176,7 @@ sf::Color RAGE_CORE_API ParseColor(const std::string theValue, const sf::Color t
 * @param[in] theDefault float value to use if the parser fails
 * @return the float value obtained or theDefault if not parsed
 */
-double RAGE_CORE_API ParseDouble(const std::string theValue, const double theDefault);
+double RAGE_CORE_API ParseDouble(const std::string& theValue, const double theDefault);
 
 /**
 * ParseFloat will parse theValue string to obtain the float value to
@@ -184,7 +185,7 @@ double RAGE_CORE_API ParseDouble(const std::string theValue, const double theDef
 * @param[in] theDefault float value to use if the parser fails
 * @return the float value obtained or theDefault if not parsed
 */
-float RAGE_CORE_API ParseFloat(const std::string theValue, const float theDefault);
+float RAGE_CORE_API ParseFloat(const std::string& theValue, const float theDefault);
 
 /**
 * ParseInt8 will parse theValue string to obtain a signed 8 bit value.
@@ -193,7 +194,7 @@ float RAGE_CORE_API ParseFloat(const std::string theValue, const float theDefaul
 * @param[in] theDefault signed 8 bit value to use if the parser fails
 * @return the signed 8 bit value obtained
 */
-Int8 RAGE_CORE_API ParseInt8(const std::string theValue, const Int8 theDefault);
+Int8 RAGE_CORE_API ParseInt8(const std::string& theValue, const Int8 theDefault);
 
 /**
 * ParseInt16 will parse theValue string to obtain a signed 16 bit value.
@@ -202,7 +203,7 @@ Int8 RAGE_CORE_API ParseInt8(const std::string theValue, const Int8 theDefault);
 * @param[in] theDefault signed 16 bit value to use if the parser fails
 * @return the signed 16 bit value obtained
 */
-Int16 RAGE_CORE_API ParseInt16(const std::string theValue, const Int16 theDefault);
+Int16 RAGE_CORE_API ParseInt16(const std::string& theValue, const Int16 theDefault);
 
 /**
 * ParseInt32 will parse theValue string to obtain a signed 32 bit value.
@@ -211,7 +212,7 @@ Int16 RAGE_CORE_API ParseInt16(const std::string theValue, const Int16 theDefaul
 * @param[in] theDefault signed 32 bit value to use if the parser fails
 * @return the signed 32 bit value obtained
 */
-Int32 RAGE_CORE_API ParseInt32(const std::string theValue, const Int32 theDefault);
+Int32 RAGE_CORE_API ParseInt32(const std::string& theValue, const Int32 theDefault);
 
 /**
 * ParseInt64 will parse theValue string to obtain a signed 64 bit value.
@@ -220,7 +221,7 @@ Int32 RAGE_CORE_API ParseInt32(const std::string theValue, const Int32 theDefaul
 * @param[in] theDefault signed 64 bit value to use if the parser fails
 * @return the signed 64 bit value obtained
 */
-Int64 RAGE_CORE_API ParseInt64(const std::string theValue, const Int64 theDefault);
+Int64 RAGE_CORE_API ParseInt64(const std::string& theValue, const Int64 theDefault);
 
 /**
 * ParseIntRect will parse theValue string to obtain a sf::IntRect value.
@@ -229,7 +230,7 @@ Int64 RAGE_CORE_API ParseInt64(const std::string theValue, const Int64 theDefaul
 * @param[in] theDefault sf::IntRect value to use if the parser fails
 * @return the sf::IntRect value obtained
 */
-sf::IntRect RAGE_CORE_API ParseIntRect(const std::string theValue, const sf::IntRect theDefault);
+sf::IntRect RAGE_CORE_API ParseIntRect(const std::string& theValue, const sf::IntRect theDefault);
 
 /**
 * ParseUint8 will parse theValue string to obtain a signed 8 bit value.
@@ -238,7 +239,7 @@ sf::IntRect RAGE_CORE_API ParseIntRect(const std::string theValue, const sf::Int
 * @param[in] theDefault signed 8 bit value to use if the parser fails
 * @return the signed 8 bit value obtained
 */
-Uint8 RAGE_CORE_API ParseUint8(const std::string theValue, const Uint8 theDefault);
+Uint8 RAGE_CORE_API ParseUint8(const std::string& theValue, const Uint8 theDefault);
 
 /**
 * ParseUint16 will parse theValue string to obtain an unsigned 16 bit
@@ -247,7 +248,7 @@ Uint8 RAGE_CORE_API ParseUint8(const std::string theValue, const Uint8 theDefaul
 * @param[in] theDefault unsigned 16 bit value to use if the parser fails
 * @return the unsigned 16 bit value obtained
 */
-Uint16 RAGE_CORE_API ParseUint16(const std::string theValue, const Uint16 theDefault);
+Uint16 RAGE_CORE_API ParseUint16(const std::string& theValue, const Uint16 theDefault);
 
 /**
 * ParseUint32 will parse theValue string to obtain an unsigned 32 bit
@@ -256,7 +257,7 @@ Uint16 RAGE_CORE_API ParseUint16(const std::string theValue, const Uint16 theDef
 * @param[in] theDefault unsigned 32 bit value to use if the parser fails
 * @return the unsigned 32 bit value obtained
 */
-Uint32 RAGE_CORE_API ParseUint32(const std::string theValue, const Uint32 theDefault);
+Uint32 RAGE_CORE_API ParseUint32(const std::string& theValue, const Uint32 theDefault);
 
 /**
 * ParseUint64 will parse theValue string to obtain an unsigned 64 bit
@@ -265,7 +266,7 @@ Uint32 RAGE_CORE_API ParseUint32(const std::string theValue, const Uint32 theDef
 * @param[in] theDefault unsigned 64 bit value to use if the parser fails
 * @return the unsigned 64 bit value obtained
 */
-Uint64 RAGE_CORE_API ParseUint64(const std::string theValue, const Uint64 theDefault);
+Uint64 RAGE_CORE_API ParseUint64(const std::string& theValue, const Uint64 theDefault);
 
 /**
 * ParseVector2f will parse theValue string to obtain the X,Y vector values
@@ -274,7 +275,7 @@ Uint64 RAGE_CORE_API ParseUint64(const std::string theValue, const Uint64 theDef
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Vector2f RAGE_CORE_API ParseVector2f(const std::string theValue, const sf::Vector2f theDefault);
+sf::Vector2f RAGE_CORE_API ParseVector2f(const std::string& theValue, const sf::Vector2f theDefault);
 
 /**
 * ParseVector2i will parse theValue string to obtain the X,Y vector values
@@ -283,7 +284,7 @@ sf::Vector2f RAGE_CORE_API ParseVector2f(const std::string theValue, const sf::V
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Vector2i RAGE_CORE_API ParseVector2i(const std::string theValue, const sf::Vector2i theDefault);
+sf::Vector2i RAGE_CORE_API ParseVector2i(const std::string& theValue, const sf::Vector2i theDefault);
 
 /**
 * ParseVector2u will parse theValue string to obtain the X,Y vector values
@@ -292,7 +293,7 @@ sf::Vector2i RAGE_CORE_API ParseVector2i(const std::string theValue, const sf::V
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Vector2u RAGE_CORE_API ParseVector2u(const std::string theValue, const sf::Vector2u theDefault);
+sf::Vector2u RAGE_CORE_API ParseVector2u(const std::string& theValue, const sf::Vector2u theDefault);
 
 /**
 * ParseVector3f will parse theValue string to obtain the X,Y,Z vector values
@@ -301,7 +302,7 @@ sf::Vector2u RAGE_CORE_API ParseVector2u(const std::string theValue, const sf::V
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Vector3f RAGE_CORE_API ParseVector3f(const std::string theValue, const sf::Vector3f theDefault);
+sf::Vector3f RAGE_CORE_API ParseVector3f(const std::string& theValue, const sf::Vector3f theDefault);
 
 /**
 * ParseVector3i will parse theValue string to obtain the X,Y,Z vector values
@@ -310,7 +311,148 @@ sf::Vector3f RAGE_CORE_API ParseVector3f(const std::string theValue, const sf::V
 * @param[in] theDefault color to use if the parser fails
 * @return the color object created with the values obtained
 */
-sf::Vector3i RAGE_CORE_API ParseVector3i(const std::string theValue, const sf::Vector3i theDefault);
+sf::Vector3i RAGE_CORE_API ParseVector3i(const std::string& theValue, const sf::Vector3i theDefault);
+
+///////////////////////////////////////////////////////////////////////////
+// Buffer Format Methods
+///////////////////////////////////////////////////////////////////////////
+/// Buffer size large enough for any value written by the Format methods
+const size_t FORMAT_BUFFER_SIZE = 32;
+
+/**
+* FormatInt32 will write theNumber into theBuffer provided as a null
+* terminated decimal string.  No memory is allocated and the result does
+* not depend on the current locale.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theNumber to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatInt32(char* theBuffer, const size_t theSize, const Int32 theNumber);
+
+/**
+* FormatInt64 will write theNumber into theBuffer provided as a null
+* terminated decimal string.  See FormatInt32 above.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theNumber to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatInt64(char* theBuffer, const size_t theSize, const Int64 theNumber);
+
+/**
+* FormatUint32 will write theNumber into theBuffer provided as a null
+* terminated decimal string.  See FormatInt32 above.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theNumber to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatUint32(char* theBuffer, const size_t theSize, const Uint32 theNumber);
+
+/**
+* FormatUint64 will write theNumber into theBuffer provided as a null
+* terminated decimal string.  See FormatInt32 above.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theNumber to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatUint64(char* theBuffer, const size_t theSize, const Uint64 theNumber);
+
+/**
+* FormatDouble will write the shortest string that parses back to the
+* exact same double value, using Grisu2 in a single pass.  In the rare
+* cases where Grisu2 cannot prove the shortest digits it writes one more
+* digit, which still parses back exactly.  The decimal point is always '.' whatever the
+* current locale is, and infinity and NaN are written as inf, -inf and nan.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theDouble to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatDouble(char* theBuffer, const size_t theSize, const double theDouble);
+
+/**
+* FormatFloat will write the shortest string that parses back to the
+* exact same float value.  See FormatDouble above.
+* @param[in] theBuffer to write the digits into
+* @param[in] theSize of theBuffer including room for the null terminator
+* @param[in] theFloat to write
+* @return the number of characters written or 0 if theBuffer is too small
+*/
+size_t RAGE_CORE_API FormatFloat(char* theBuffer, const size_t theSize, const float theFloat);
+
+///////////////////////////////////////////////////////////////////////////
+// Buffer Parse Methods
+///////////////////////////////////////////////////////////////////////////
+/**
+* ParseInt32 will parse the characters between theFirst and theLast for a
+* signed 32 bit value.  An optional '-' followed by decimal digits is
+* accepted, no whitespace is skipped and parsing stops at the first
+* character that is not part of the number.  No memory is allocated and
+* the result does not depend on the current locale.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst if no value was
+*         found or the value does not fit in the result type
+*/
+const char* RAGE_CORE_API ParseInt32(const char* theFirst, const char* theLast, Int32& theResult);
+
+/**
+* ParseInt64 will parse the characters between theFirst and theLast for a
+* signed 64 bit value.  See ParseInt32 above.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst on failure
+*/
+const char* RAGE_CORE_API ParseInt64(const char* theFirst, const char* theLast, Int64& theResult);
+
+/**
+* ParseUint32 will parse the characters between theFirst and theLast for
+* an unsigned 32 bit value.  Only decimal digits are accepted, see
+* ParseInt32 above.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst on failure
+*/
+const char* RAGE_CORE_API ParseUint32(const char* theFirst, const char* theLast, Uint32& theResult);
+
+/**
+* ParseUint64 will parse the characters between theFirst and theLast for
+* an unsigned 64 bit value.  See ParseUint32 above.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst on failure
+*/
+const char* RAGE_CORE_API ParseUint64(const char* theFirst, const char* theLast, Uint64& theResult);
+
+/**
+* ParseDouble will parse the characters between theFirst and theLast for
+* a double value.  An optional '-', digits with an optional '.' fraction
+* and an optional exponent are accepted, as well as inf, infinity and nan.
+* Values with few significant digits and small exponents are converted
+* exactly without help, the rest fall back to strtod.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst on failure
+*/
+const char* RAGE_CORE_API ParseDouble(const char* theFirst, const char* theLast, double& theResult);
+
+/**
+* ParseFloat will parse the characters between theFirst and theLast for a
+* float value.  See ParseDouble above.
+* @param[in] theFirst character to parse
+* @param[in] theLast character to parse (one past the end)
+* @param[out] theResult to store the value found, untouched on failure
+* @return one past the last character used or theFirst on failure
+*/
+const char* RAGE_CORE_API ParseFloat(const char* theFirst, const char* theLast, float& theResult);
 
 } // namespace ra
 
@@ -0,0 +1,168 @@
+#ifndef RAGE_CORE_TILE_GRID_HPP
+#define RAGE_CORE_TILE_GRID_HPP
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+
+namespace ra
+{
+
+/// Resultado de TileGrid::Sweep()
+struct TileSweep
+{
+	/// Desplazamiento que se puede hacer sin entrar en celdas sólidas
+	sf::Vector2f delta;
+	/// Verdadero si el movimiento horizontal se ha recortado
+	bool hitX;
+	/// Verdadero si el movimiento vertical se ha recortado
+	bool hitY;
+};
+
+/// Resultado de TileGrid::RayCast()
+struct TileRayHit
+{
+	/// Celda alcanzada
+	sf::Vector2i cell;
+	/// Punto de entrada en la celda
+	sf::Vector2f point;
+	/// Normal del borde atravesado, nula si el origen ya es sólido
+	sf::Vector2f normal;
+	/// Posición del punto en el segmento, entre 0 y 1
+	float fraction;
+};
+
+/**
+ * Rejilla de colisiones de un mapa de tiles.
+ *
+ * Cada celda ocupa un bit, así que un mapa de 1000x1000 tiles ocupa unos
+ * 120 KB. Las consultas solo recorren las celdas que tocan: Sweep() las
+ * filas o columnas que barre el rectángulo y RayCast() las que atraviesa el
+ * segmento (DDA), por lo que su coste no depende del tamaño del mapa.
+ *
+ * Se puede construir desde un fichero TMX: una capa de tiles (en CSV, XML o
+ * base64 sin comprimir) marca como sólidos los tiles con la propiedad
+ * solid=1 o, si el mapa no la usa, todos los que no están vacíos. Un grupo
+ * de objetos marca las celdas que cubren sus rectángulos. Fuera del mapa
+ * nada es sólido. Normalmente la escena tiene su TileGrid y llama a Sweep()
+ * en su Update() antes de mover cada objeto.
+ */
+class RAGE_CORE_API TileGrid
+{
+public:
+	TileGrid();
+
+	/**
+	 * Crea una rejilla vacía
+	 *
+	 * @param theWidth Ancho en tiles
+	 * @param theHeight Alto en tiles
+	 * @param theTileSize Tamaño de un tile en píxeles
+	 */
+	void Create(Uint32 theWidth, Uint32 theHeight, const sf::Vector2f& theTileSize);
+
+	/**
+	 * Crea la rejilla a partir de una capa o un grupo de objetos de un TMX
+	 *
+	 * @param theFilename Ruta del fichero TMX
+	 * @param theLayer Nombre de la capa o del grupo de objetos
+	 * @return true si se ha encontrado y leído la capa
+	 */
+	bool LoadFromTmx(const std::string& theFilename, const std::string& theLayer);
+
+	/**
+	 * Marca una celda como sólida o libre
+	 */
+	void SetSolid(Int32 theX, Int32 theY, bool theSolid);
+
+	/**
+	 * Marca todas las celdas que toca un rectángulo en píxeles
+	 */
+	void SetSolid(const sf::FloatRect& theRect, bool theSolid);
+
+	/**
+	 * Devuelve true si la celda es sólida
+	 */
+	bool IsSolid(Int32 theX, Int32 theY) const;
+
+	/**
+	 * Devuelve true si alguna celda que toca el rectángulo es sólida
+	 */
+	bool IsSolid(const sf::FloatRect& theRect) const;
+
+	/**
+	 * Devuelve la celda que contiene un punto en píxeles
+	 */
+	sf::Vector2i GetCell(const sf::Vector2f& thePoint) const;
+
+	/**
+	 * Mueve un rectángulo primero en horizontal y luego en vertical, y
+	 * recorta cada eje en la primera celda sólida que encuentra
+	 *
+	 * @param theBox Rectángulo en píxeles antes de moverlo
+	 * @param theDelta Desplazamiento deseado
+	 */
+	TileSweep Sweep(const sf::FloatRect& theBox, const sf::Vector2f& theDelta) const;
+
+	/**
+	 * Busca la primera celda sólida que atraviesa un segmento
+	 *
+	 * @param theFrom Origen del segmento
+	 * @param theTo Final del segmento
+	 * @param theHit Resultado si se alcanza alguna celda
+	 * @return true si el segmento alcanza alguna celda sólida
+	 */
+	bool RayCast(const sf::Vector2f& theFrom, const sf::Vector2f& theTo, TileRayHit& theHit) const;
+
+	/**
+	 * Devuelve true si ninguna celda sólida corta el segmento
+	 */
+	bool HasLineOfSight(const sf::Vector2f& theFrom, const sf::Vector2f& theTo) const;
+
+	Uint32 GetWidth() const;
+	Uint32 GetHeight() const;
+	const sf::Vector2f& GetTileSize() const;
+
+	/**
+	 * Devuelve los límites del mapa en píxeles
+	 */
+	sf::FloatRect GetBounds() const;
+
+	/**
+	 * Libera la rejilla
+	 */
+	void Clear();
+
+private:
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Ancho en tiles
+	Uint32 m_width;
+	/// Alto en tiles
+	Uint32 m_height;
+	/// Tamaño de un tile en píxeles
+	sf::Vector2f m_tileSize;
+	/// Un bit por celda, fila a fila
+	std::vector<Uint32> m_bits;
+
+	/**
+	 * Recorta el movimiento de un rectángulo en un eje
+	 *
+	 * @param theAxis 0 para el eje X, 1 para el eje Y
+	 */
+	float SweepAxis(const sf::FloatRect& theBox, float theDelta, int theAxis) const;
+
+	/**
+	 * Devuelve true si hay alguna celda sólida en una columna (eje 0) o
+	 * fila (eje 1) entre dos celdas del otro eje
+	 */
+	bool IsLineSolid(int theAxis, Int32 theLine, Int32 theFirst, Int32 theLast) const;
+}; // class TileGrid
+
+} // namespace ra
+
+#endif // RAGE_CORE_TILE_GRID_HPP
\ No newline at end of file
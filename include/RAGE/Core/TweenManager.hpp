@@ -0,0 +1,213 @@
+#ifndef RAGE_CORE_TWEEN_MANAGER_HPP
+#define RAGE_CORE_TWEEN_MANAGER_HPP
+
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <RAGE/Config.hpp>
+#include <RAGE/Core/Export.hpp>
+#include <RAGE/Core/Core_types.hpp>
+#include <RAGE/Core/ObjectPool.hpp>
+
+namespace sf
+{
+	class Transformable;
+}
+
+namespace ra
+{
+
+/// Curvas de interpolación
+enum Easing {
+	EaseLinear,
+	EaseInQuad,
+	EaseOutQuad,
+	EaseInOutQuad,
+	EaseInCubic,
+	EaseOutCubic,
+	EaseInOutCubic,
+	EaseInSine,
+	EaseOutSine,
+	EaseInOutSine,
+	EaseOutBack,     ///< Se pasa del destino y vuelve
+	EaseOutBounce,   ///< Rebota al llegar al destino
+	EaseOutElastic   ///< Oscila alrededor del destino
+};
+
+/// Referencia a una interpolación de un TweenManager
+typedef ra::Handle<TweenManager> TweenHandle;
+
+/**
+ * Interpola la posición, escala, rotación y color de los objetos de una
+ * escena.
+ *
+ * Las interpolaciones activas se guardan en un único vector y Update() las
+ * avanza todas en una pasada, con un switch por propiedad en lugar de
+ * llamadas virtuales. Las que terminan dejan su posición libre para la
+ * siguiente, así que una vez alcanzado el máximo de interpolaciones
+ * simultáneas no se reserva más memoria.
+ *
+ * El valor inicial se toma al empezar la interpolación (después del
+ * retardo), por lo que se pueden encadenar con SetDelay(). Normalmente
+ * cada escena tiene su TweenManager y lo actualiza en su Update(). Los
+ * objetos deben existir mientras se interpolan: hay que llamar a
+ * Cancel() antes de eliminarlos.
+ */
+class RAGE_CORE_API TweenManager
+{
+public:
+	/// Repeticiones para repetir sin fin
+	static const Int32 REPEAT_FOREVER = -1;
+
+	TweenManager();
+
+	TweenHandle MoveTo(sf::Transformable& theTarget, const sf::Vector2f& thePosition,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+	TweenHandle ScaleTo(sf::Transformable& theTarget, const sf::Vector2f& theScale,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+	TweenHandle RotateTo(sf::Transformable& theTarget, float theAngle,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+	TweenHandle ColorTo(ra::Sprite& theTarget, const sf::Color& theColor,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+	TweenHandle ColorTo(ra::Text& theTarget, const sf::Color& theColor,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+	TweenHandle ColorTo(ra::Shape& theTarget, const sf::Color& theColor,
+		sf::Time theDuration, Easing theEasing = EaseLinear);
+
+	/**
+	 * Retrasa el comienzo de una interpolación
+	 */
+	void SetDelay(const TweenHandle& theHandle, sf::Time theDelay);
+
+	/**
+	 * Repite una interpolación
+	 *
+	 * @param theCount Repeticiones después de la primera o REPEAT_FOREVER
+	 * @param theYoyo Si es true se alterna la ida y la vuelta
+	 */
+	void SetRepeat(const TweenHandle& theHandle, Int32 theCount, bool theYoyo = false);
+
+	/**
+	 * Detiene una interpolación, el objeto conserva su valor actual
+	 */
+	void Cancel(const TweenHandle& theHandle);
+
+	/**
+	 * Detiene todas las interpolaciones de un objeto
+	 */
+	void Cancel(const sf::Transformable& theTarget);
+
+	/**
+	 * Devuelve true si la interpolación no ha terminado
+	 */
+	bool IsActive(const TweenHandle& theHandle) const;
+
+	/**
+	 * Avanza todas las interpolaciones
+	 *
+	 * @param theElapsed Tiempo transcurrido desde la última llamada
+	 */
+	void Update(sf::Time theElapsed);
+
+	/**
+	 * Detiene todas las interpolaciones
+	 */
+	void Clear();
+
+	/**
+	 * Devuelve el número de interpolaciones activas
+	 */
+	size_t GetSize() const;
+
+	/**
+	 * Aplica una curva a un valor entre 0 y 1
+	 */
+	static float Ease(Easing theEasing, float theRatio);
+
+private:
+	/// Propiedades que se pueden interpolar
+	enum Property {
+		PropertyPosition,
+		PropertyScale,
+		PropertyRotation,
+		PropertySpriteColor,
+		PropertyTextColor,
+		PropertyShapeColor
+	};
+
+	/// Interpolación
+	struct Tween
+	{
+		/// Propiedad interpolada
+		Property property;
+		/// Objeto interpolado
+		sf::Transformable* target;
+		/// El mismo objeto si la propiedad es un color
+		ra::Sprite* sprite;
+		ra::Text* text;
+		ra::Shape* shape;
+		/// Valor inicial, se toma al empezar
+		float from[4];
+		/// Valor final
+		float to[4];
+		/// Segundos transcurridos, incluido el retardo
+		float elapsed;
+		/// Segundos de retardo
+		float delay;
+		/// Segundos de duración
+		float duration;
+		/// Curva
+		Easing easing;
+		/// Repeticiones pendientes o REPEAT_FOREVER
+		Int32 repeat;
+		/// Alterna la ida y la vuelta en cada repetición
+		bool yoyo;
+		/// Verdadero si ya se ha tomado el valor inicial
+		bool started;
+		/// Verdadero mientras la interpolación está en curso
+		bool active;
+		/// Generación de la posición, cambia al liberarla
+		Uint32 generation;
+	};
+
+	// Variables
+	///////////////////////////////////////////////////////////////////////////
+	/// Interpolaciones, activas y libres
+	std::vector<Tween> m_tweens;
+	/// Posiciones libres de m_tweens
+	std::vector<Uint32> m_free;
+	/// Interpolaciones activas
+	size_t m_active;
+
+	/**
+	 * Ocupa una posición libre y la prepara
+	 */
+	TweenHandle Start(Property theProperty, sf::Transformable& theTarget,
+		const float* theTo, sf::Time theDuration, Easing theEasing);
+
+	/**
+	 * Devuelve la interpolación activa de un handle o NULL
+	 */
+	Tween* Find(const TweenHandle& theHandle);
+	const Tween* Find(const TweenHandle& theHandle) const;
+
+	/**
+	 * Libera la posición de una interpolación
+	 */
+	void Release(Uint32 theIndex);
+
+	/**
+	 * Lee el valor actual de la propiedad
+	 */
+	static void Read(Tween& theTween);
+
+	/**
+	 * Escribe en el objeto el valor interpolado
+	 */
+	static void Apply(const Tween& theTween, float theRatio);
+}; // class TweenManager
+
+} // namespace ra
+
+#endif // RAGE_CORE_TWEEN_MANAGER_HPP
\ No newline at end of file
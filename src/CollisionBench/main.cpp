@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+#include <RAGE/Core.hpp>
+
+namespace
+{
+	/// Cuerpos dinámicos durante toda la prueba
+	const unsigned int BODY_COUNT = 10000;
+	/// Frames medidos
+	const unsigned int FRAME_COUNT = 300;
+	/// Consultas de cada tipo por frame
+	const unsigned int QUERY_COUNT = 100;
+	/// Cuerpos que se eliminan y se vuelven a añadir cada frame
+	const unsigned int CHURN_COUNT = 100;
+	/// Lado del área en la que se mueven los cuerpos
+	const float WORLD_SIZE = 4000.f;
+	/// Lado de los cuerpos y de los rectángulos de consulta
+	const float BODY_SIZE = 16.f;
+	const float QUERY_SIZE = 200.f;
+	/// Velocidad máxima de los cuerpos en píxeles por frame
+	const float MAX_SPEED = 4.f;
+
+	/// Generador congruencial, así cada ejecución mide lo mismo
+	ra::Uint32 gRandom = 0x2545F491;
+
+	float Random(float theMin, float theMax)
+	{
+		gRandom = gRandom * 1664525u + 1013904223u;
+		return theMin + (theMax - theMin) * (gRandom >> 8) * (1.f / 16777216.f);
+	}
+
+	/// Cuerpo de la prueba
+	struct Mover
+	{
+		ra::CollisionHandle handle;
+		sf::FloatRect bounds;
+		sf::Vector2f velocity;
+	};
+
+	/// Tiempos de los frames medidos
+	struct FrameTimes
+	{
+		sf::Int64 updateTotal;
+		sf::Int64 updateMax;
+		sf::Int64 queryTotal;
+		sf::Int64 rayTotal;
+		sf::Int64 churnTotal;
+		size_t contacts;
+	};
+
+	sf::FloatRect RandomBounds()
+	{
+		return sf::FloatRect(Random(0.f, WORLD_SIZE - BODY_SIZE), Random(0.f, WORLD_SIZE - BODY_SIZE),
+			BODY_SIZE, BODY_SIZE);
+	}
+
+	/// Mueve un cuerpo rebotando en los bordes del área
+	void Move(Mover& theMover)
+	{
+		theMover.bounds.left += theMover.velocity.x;
+		theMover.bounds.top += theMover.velocity.y;
+		if (theMover.bounds.left < 0.f || theMover.bounds.left > WORLD_SIZE - BODY_SIZE)
+		{
+			theMover.velocity.x = -theMover.velocity.x;
+		}
+		if (theMover.bounds.top < 0.f || theMover.bounds.top > WORLD_SIZE - BODY_SIZE)
+		{
+			theMover.velocity.y = -theMover.velocity.y;
+		}
+	}
+}
+
+int main()
+{
+	ra::CollisionWorld anWorld;
+	std::vector<Mover> anMovers(BODY_COUNT);
+	for (unsigned int i = 0; i < BODY_COUNT; i++)
+	{
+		// Las capas alternas solo chocan con la primera
+		const ra::Uint32 anLayer = (i % 2) ? 2 : 1;
+		anMovers[i].bounds = RandomBounds();
+		anMovers[i].velocity = sf::Vector2f(Random(-MAX_SPEED, MAX_SPEED), Random(-MAX_SPEED, MAX_SPEED));
+		anMovers[i].handle = anWorld.AddBody(anMovers[i].bounds, anLayer, (anLayer == 2) ? 1 : 3);
+	}
+	// El primer Update() ordena todos los cuerpos y no se mide
+	anWorld.Update();
+
+	std::cout << "CollisionBench: " << anWorld.GetSize() << " cuerpos, " << FRAME_COUNT << " frames, "
+		<< QUERY_COUNT << " consultas de cada tipo por frame, tiempos en us" << std::endl;
+
+	FrameTimes anTimes = FrameTimes();
+	std::vector<ra::CollisionHandle> anFound;
+	ra::RayHit anHit;
+	for (unsigned int f = 0; f < FRAME_COUNT; f++)
+	{
+		for (unsigned int i = 0; i < BODY_COUNT; i++)
+		{
+			Move(anMovers[i]);
+			anWorld.SetBounds(anMovers[i].handle, anMovers[i].bounds);
+		}
+
+		// Algunos cuerpos desaparecen y reaparecen en otro sitio
+		sf::Clock anClock;
+		for (unsigned int i = 0; i < CHURN_COUNT; i++)
+		{
+			Mover& anMover = anMovers[(f * CHURN_COUNT + i) % BODY_COUNT];
+			anWorld.RemoveBody(anMover.handle);
+			anMover.bounds = RandomBounds();
+			anMover.handle = anWorld.AddBody(anMover.bounds);
+		}
+		anTimes.churnTotal += anClock.restart().asMicroseconds();
+
+		anWorld.Update();
+		const sf::Int64 anUpdate = anClock.restart().asMicroseconds();
+		anTimes.updateTotal += anUpdate;
+		anTimes.updateMax = std::max(anTimes.updateMax, anUpdate);
+		anTimes.contacts += anWorld.GetContacts().size();
+
+		for (unsigned int i = 0; i < QUERY_COUNT; i++)
+		{
+			anFound.clear();
+			anWorld.QueryRect(sf::FloatRect(Random(0.f, WORLD_SIZE - QUERY_SIZE),
+				Random(0.f, WORLD_SIZE - QUERY_SIZE), QUERY_SIZE, QUERY_SIZE), anFound);
+		}
+		anTimes.queryTotal += anClock.restart().asMicroseconds();
+
+		for (unsigned int i = 0; i < QUERY_COUNT; i++)
+		{
+			const sf::Vector2f anFrom(Random(0.f, WORLD_SIZE), Random(0.f, WORLD_SIZE));
+			const sf::Vector2f anTo(anFrom.x + Random(-QUERY_SIZE, QUERY_SIZE),
+				anFrom.y + Random(-QUERY_SIZE, QUERY_SIZE));
+			anWorld.RayCast(anFrom, anTo, anHit);
+		}
+		anTimes.rayTotal += anClock.restart().asMicroseconds();
+	}
+
+	std::cout << "update (media / máx): " << (anTimes.updateTotal / FRAME_COUNT) << " / "
+		<< anTimes.updateMax << ", contactos por frame: " << (anTimes.contacts / FRAME_COUNT) << std::endl;
+	std::cout << "QueryRect por frame: " << (anTimes.queryTotal / FRAME_COUNT)
+		<< ", RayCast por frame: " << (anTimes.rayTotal / FRAME_COUNT)
+		<< ", " << CHURN_COUNT << " altas y bajas por frame: " << (anTimes.churnTotal / FRAME_COUNT) << std::endl;
+
+	return ra::StatusNoError;
+}
\ No newline at end of file
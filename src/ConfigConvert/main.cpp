@@ -0,0 +1,39 @@
+#include <iostream>
+#include <RAGE/Core.hpp>
+
+int main(int argc, char **argv)
+{
+	// Comprobamos los argumentos
+	if (argc != 3)
+	{
+		std::cerr << "Uso: " << argv[0] << " <entrada.cfg> <salida.bcfg>" << std::endl;
+		return ra::StatusError;
+	}
+
+	// Creamos la aplicación, solo se usa para el log
+	ra::App *anApp = ra::App::Instance();
+
+	// Creamos un código de error
+	int anExitCode = ra::StatusNoError;
+
+	{
+		// Leemos la configuración en formato texto y la guardamos en binario
+		ra::ConfigReader anReader;
+		if (!anReader.LoadFromFile(argv[1]))
+		{
+			std::cerr << "No se puede leer " << argv[1] << std::endl;
+			anExitCode = ra::StatusError;
+		}
+		else if (!anReader.SaveToBinary(argv[2]))
+		{
+			std::cerr << "No se puede escribir " << argv[2] << std::endl;
+			anExitCode = ra::StatusError;
+		}
+	}
+
+	// Eliminamos la aplicación
+	anApp->Release();
+	anApp = 0;
+
+	return anExitCode;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <iostream>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <RAGE/Core.hpp>
+
+namespace
+{
+	/// Partículas vivas durante toda la prueba
+	const ra::Uint32 PARTICLE_COUNT = 100000;
+	/// Frames medidos con cada número de hilos
+	const unsigned int FRAME_COUNT = 300;
+	/// Frames previos que no se miden
+	const unsigned int WARMUP_FRAMES = 10;
+	/// Tamaño del destino de dibujo
+	const unsigned int TARGET_WIDTH = 800;
+	const unsigned int TARGET_HEIGHT = 600;
+
+	/// Tiempos de los frames medidos
+	struct FrameTimes
+	{
+		sf::Int64 updateTotal;
+		sf::Int64 updateMax;
+		sf::Int64 drawTotal;
+		sf::Int64 drawMax;
+	};
+
+	/// Ejecuta los frames de la prueba con theThreads hilos. Si theTarget no
+	/// es NULL también se dibujan las partículas en él
+	FrameTimes RunFrames(ra::ParticleSystem& theSystem, ra::Uint32 theThreads, sf::RenderTexture* theTarget)
+	{
+		FrameTimes anTimes = FrameTimes();
+		const sf::Time anStep = sf::seconds(1.f / 60.f);
+
+		// Empezamos siempre con todas las partículas recién emitidas
+		theSystem.SetThreadCount(theThreads);
+		theSystem.Clear();
+		theSystem.Emit(PARTICLE_COUNT);
+
+		for (unsigned int i = 0; i < WARMUP_FRAMES + FRAME_COUNT; i++)
+		{
+			const bool anMeasured = (i >= WARMUP_FRAMES);
+
+			sf::Clock anClock;
+			theSystem.Update(anStep);
+			const sf::Int64 anUpdate = anClock.restart().asMicroseconds();
+
+			sf::Int64 anDraw = 0;
+			if (theTarget != NULL)
+			{
+				if (anMeasured)
+				{
+					ra::RenderStats::BeginFrame();
+				}
+				theTarget->clear();
+				theTarget->draw(theSystem);
+				theTarget->display();
+				anDraw = anClock.getElapsedTime().asMicroseconds();
+				if (anMeasured)
+				{
+					ra::RenderStats::EndFrame();
+				}
+			}
+
+			if (anMeasured)
+			{
+				anTimes.updateTotal += anUpdate;
+				anTimes.updateMax = std::max(anTimes.updateMax, anUpdate);
+				anTimes.drawTotal += anDraw;
+				anTimes.drawMax = std::max(anTimes.drawMax, anDraw);
+			}
+		}
+
+		return anTimes;
+	}
+}
+
+int main()
+{
+	// Emisor que mantiene todas las partículas vivas y repartidas por el
+	// destino de dibujo
+	ra::ParticleEmitter anEmitter;
+	anEmitter.rate = 0.f;
+	anEmitter.maxParticles = PARTICLE_COUNT;
+	anEmitter.lifetime = sf::Vector2f(1000.f, 1000.f);
+	anEmitter.speed = sf::Vector2f(10.f, 60.f);
+	anEmitter.spread = 360.f;
+	anEmitter.gravity = sf::Vector2f(0.f, 20.f);
+	anEmitter.area = sf::Vector2f(TARGET_WIDTH * 0.5f, TARGET_HEIGHT * 0.5f);
+	anEmitter.size = sf::Vector2f(2.f, 2.f);
+
+	ra::ParticleSystem anSystem;
+	anSystem.SetEmitter(anEmitter);
+	anSystem.SetEmitting(false);
+	anSystem.setPosition(TARGET_WIDTH * 0.5f, TARGET_HEIGHT * 0.5f);
+
+	// Sin contexto OpenGL solo se mide la actualización
+	sf::RenderTexture anTarget;
+	sf::RenderTexture* anTargetPtr = &anTarget;
+	if (!anTarget.create(TARGET_WIDTH, TARGET_HEIGHT))
+	{
+		std::cout << "ParticleBench: no se puede crear el destino de dibujo, solo se mide Update()" << std::endl;
+		anTargetPtr = NULL;
+	}
+
+	std::cout << "ParticleBench: " << PARTICLE_COUNT << " partículas, " << FRAME_COUNT
+		<< " frames de 1/60 s, tiempos en us" << std::endl;
+	std::cout << "hilos  update (media / máx)  draw (media / máx)  frame (media)" << std::endl;
+
+	// Medimos con un hilo y con cada potencia de dos hasta MAX_THREADS
+	for (ra::Uint32 anThreads = 1; anThreads <= ra::ParticleSystem::MAX_THREADS; anThreads *= 2)
+	{
+		const FrameTimes anTimes = RunFrames(anSystem, anThreads, anTargetPtr);
+		const sf::Int64 anUpdate = anTimes.updateTotal / FRAME_COUNT;
+		const sf::Int64 anDraw = anTimes.drawTotal / FRAME_COUNT;
+
+		std::cout << anThreads << "      " << anUpdate << " / " << anTimes.updateMax << "      "
+			<< anDraw << " / " << anTimes.drawMax << "      " << (anUpdate + anDraw) << std::endl;
+	}
+
+	// Contadores de dibujado de todos los frames medidos
+	if (anTargetPtr != NULL)
+	{
+		ra::RenderStats::Report(std::cout);
+	}
+
+	return ra::StatusNoError;
+}
\ No newline at end of file
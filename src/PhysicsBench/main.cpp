@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <iostream>
+#include <SFML/System/Clock.hpp>
+#include <RAGE/Core.hpp>
+
+namespace
+{
+	/// Pasos medidos en cada prueba, 10 s de simulación
+	const unsigned int STEP_COUNT = 600;
+	/// Pasos finales que se promedian aparte, cuando ya debería dormir todo
+	const unsigned int TAIL_STEPS = 60;
+
+	/// Pilas de cajas: columnas y cajas por columna
+	const unsigned int STACK_COLUMNS = 20;
+	const unsigned int STACK_HEIGHT = 10;
+	const float BOX_SIZE = 20.f;
+
+	/// Montón de círculos y cajas que caen en un recipiente
+	const unsigned int PILE_BODIES = 1000;
+	const float PILE_WIDTH = 1200.f;
+
+	/// Tiempos de una prueba
+	struct StepTimes
+	{
+		sf::Int64 total;
+		sf::Int64 max;
+		sf::Int64 tail;
+	};
+
+	/// Ejecuta STEP_COUNT pasos fijos midiendo cada uno
+	StepTimes RunSteps(ra::PhysicsWorld& theWorld)
+	{
+		StepTimes anTimes = StepTimes();
+		for (unsigned int i = 0; i < STEP_COUNT; i++)
+		{
+			sf::Clock anClock;
+			theWorld.Step();
+			const sf::Int64 anStep = anClock.getElapsedTime().asMicroseconds();
+
+			anTimes.total += anStep;
+			anTimes.max = std::max(anTimes.max, anStep);
+			if (i >= STEP_COUNT - TAIL_STEPS)
+			{
+				anTimes.tail += anStep;
+			}
+		}
+		return anTimes;
+	}
+
+	void Report(const char* theName, const ra::PhysicsWorld& theWorld, const StepTimes& theTimes)
+	{
+		std::cout << theName << "  " << theWorld.GetSize() << " cuerpos, " << theWorld.GetAwakeCount()
+			<< " despiertos al final" << std::endl;
+		std::cout << "  paso (media / máx): " << (theTimes.total / STEP_COUNT) << " / " << theTimes.max
+			<< " us, últimos " << TAIL_STEPS << " pasos: " << (theTimes.tail / TAIL_STEPS) << " us" << std::endl;
+	}
+
+	/// Columnas de cajas apoyadas en un suelo estático
+	void BuildStacks(ra::PhysicsWorld& theWorld)
+	{
+		const float anSpacing = BOX_SIZE * 2.f;
+		const float anWidth = STACK_COLUMNS * anSpacing;
+		theWorld.AddBox(sf::Vector2f(anWidth + 100.f, 20.f), sf::Vector2f(anWidth * 0.5f, 10.f), ra::BodyStatic);
+
+		for (unsigned int c = 0; c < STACK_COLUMNS; c++)
+		{
+			for (unsigned int r = 0; r < STACK_HEIGHT; r++)
+			{
+				theWorld.AddBox(sf::Vector2f(BOX_SIZE, BOX_SIZE),
+					sf::Vector2f(anSpacing * (c + 0.5f), -(BOX_SIZE * (r + 0.5f))));
+			}
+		}
+	}
+
+	/// Recipiente con cuerpos repartidos en filas que caen unos sobre otros
+	void BuildPile(ra::PhysicsWorld& theWorld)
+	{
+		theWorld.AddBox(sf::Vector2f(PILE_WIDTH, 20.f), sf::Vector2f(PILE_WIDTH * 0.5f, 10.f), ra::BodyStatic);
+		theWorld.AddBox(sf::Vector2f(20.f, 2000.f), sf::Vector2f(-10.f, -990.f), ra::BodyStatic);
+		theWorld.AddBox(sf::Vector2f(20.f, 2000.f), sf::Vector2f(PILE_WIDTH + 10.f, -990.f), ra::BodyStatic);
+
+		const unsigned int anPerRow = static_cast<unsigned int>(PILE_WIDTH / 24.f) - 1;
+		for (unsigned int i = 0; i < PILE_BODIES; i++)
+		{
+			// Desplazamos las filas impares para que no caigan en columna
+			const unsigned int anRow = i / anPerRow;
+			const float anX = 24.f * (i % anPerRow + 1) + ((anRow % 2) ? 6.f : 0.f);
+			const sf::Vector2f anPosition(anX, -30.f - 24.f * anRow);
+			if (i % 2)
+			{
+				theWorld.AddCircle(8.f, anPosition);
+			}
+			else
+			{
+				theWorld.AddBox(sf::Vector2f(16.f, 16.f), anPosition);
+			}
+		}
+	}
+}
+
+int main()
+{
+	std::cout << "PhysicsBench: " << STEP_COUNT << " pasos de 1/60 s por prueba" << std::endl;
+
+	ra::PhysicsWorld anWorld;
+
+	// Pilas altas: miden la estabilidad del solver y si acaban durmiendo
+	BuildStacks(anWorld);
+	StepTimes anTimes = RunSteps(anWorld);
+	Report("pilas", anWorld, anTimes);
+
+	// El mismo mundo, ya vacío, para el montón; Clear() conserva las
+	// generaciones y reaprovecha las posiciones
+	anWorld.Clear();
+	BuildPile(anWorld);
+	anTimes = RunSteps(anWorld);
+	Report("montón", anWorld, anTimes);
+
+	return ra::StatusNoError;
+}
\ No newline at end of file
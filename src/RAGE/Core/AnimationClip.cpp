@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/ConfigReader.hpp>
+#include <RAGE/Core/StringUtil.hpp>
+#include <RAGE/Core/AnimationClip.hpp>
+
+namespace ra
+{
+
+AnimationClip::AnimationClip()
+	: m_frames()
+	, m_ends()
+	, m_loopMode(LoopRepeat)
+{
+}
+
+bool AnimationClip::LoadFromFile(const std::string& theFilename)
+{
+	ra::ConfigReader config;
+	if (!config.LoadFromFile(theFilename))
+	{
+		ra::App::Instance()->log << "[error] AnimationClip::LoadFromFile() " << theFilename
+			<< " no se ha podido leer" << std::endl;
+		return false;
+	}
+
+	if (!LoadFromConfig(config))
+	{
+		ra::App::Instance()->log << "[error] AnimationClip::LoadFromFile() " << theFilename
+			<< " no define frames válidos" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool AnimationClip::LoadFromConfig(const ra::ConfigReader& theConfig)
+{
+	Clear();
+
+	std::string loop = theConfig.GetString("clip", "loop", "repeat");
+	if (loop == "once")
+	{
+		m_loopMode = LoopOnce;
+	}
+	else if (loop == "pingpong")
+	{
+		m_loopMode = LoopPingPong;
+	}
+	else
+	{
+		m_loopMode = LoopRepeat;
+	}
+
+	Uint32 duration = theConfig.GetUint32("clip", "duration", DEFAULT_FRAME_DURATION);
+
+	// Los frames explícitos sustituyen a la rejilla. GetNames() los devuelve
+	// en orden alfabético, el mapa los ordena por su número
+	std::vector<std::string> names;
+	std::map<Uint32, sf::IntRect> rects;
+	if (theConfig.GetNames("frames", names))
+	{
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			// Un nombre que no es un número no puede ordenarse: rechazamos el
+			// clip en lugar de mezclarlo con el frame 0
+			Uint32 index = 0;
+			const char* first = names[i].c_str();
+			const char* last = first + names[i].size();
+			if (names[i].empty() || ra::ParseUint32(first, last, index) != last)
+			{
+				ra::App::Instance()->log << "[error] AnimationClip::LoadFromConfig() el frame "
+					<< names[i] << " no es un número" << std::endl;
+				Clear();
+				return false;
+			}
+			rects[index] = ra::ParseIntRect(theConfig.GetString("frames", names[i]), sf::IntRect());
+		}
+	}
+	else
+	{
+		Uint32 frames = theConfig.GetUint32("clip", "frames", 1);
+		Uint32 columns = theConfig.GetUint32("clip", "columns", frames);
+		sf::IntRect rect = ra::ParseIntRect(theConfig.GetString("clip", "rect"), sf::IntRect());
+		if (columns == 0)
+		{
+			columns = 1;
+		}
+
+		for (Uint32 i = 0; i < frames; i++)
+		{
+			sf::IntRect frame = rect;
+			frame.left += static_cast<int>(i % columns) * rect.width;
+			frame.top += static_cast<int>(i / columns) * rect.height;
+			rects[i] = frame;
+		}
+	}
+
+	std::map<Uint32, sf::IntRect>::const_iterator it;
+	for (it = rects.begin(); it != rects.end(); it++)
+	{
+		std::string index = ra::ConvertUint32(it->first);
+		AddFrame(it->second, sf::milliseconds(static_cast<Int32>(
+			theConfig.GetUint32("durations", index, duration))));
+	}
+
+	return !m_frames.empty();
+}
+
+void AnimationClip::AddFrame(const sf::IntRect& theRect, sf::Time theDuration)
+{
+	// Igual que Sprite::updatePositions() y Sprite::updateTexCoords()
+	float width = static_cast<float>(std::abs(theRect.width));
+	float height = static_cast<float>(std::abs(theRect.height));
+	float left = static_cast<float>(theRect.left);
+	float right = left + theRect.width;
+	float top = static_cast<float>(theRect.top);
+	float bottom = top + theRect.height;
+
+	Frame frame;
+	frame.rect = theRect;
+	frame.positions[0] = sf::Vector2f(0.f, 0.f);
+	frame.positions[1] = sf::Vector2f(0.f, height);
+	frame.positions[2] = sf::Vector2f(width, height);
+	frame.positions[3] = sf::Vector2f(width, 0.f);
+	frame.texCoords[0] = sf::Vector2f(left, top);
+	frame.texCoords[1] = sf::Vector2f(left, bottom);
+	frame.texCoords[2] = sf::Vector2f(right, bottom);
+	frame.texCoords[3] = sf::Vector2f(right, top);
+	m_frames.push_back(frame);
+
+	// Un frame sin duración se mostraría como mínimo un microsegundo
+	Int64 duration = std::max<Int64>(theDuration.asMicroseconds(), 1);
+	m_ends.push_back((m_ends.empty() ? 0 : m_ends.back()) + duration);
+}
+
+void AnimationClip::Clear()
+{
+	m_frames.clear();
+	m_ends.clear();
+}
+
+void AnimationClip::SetLoopMode(LoopMode theMode)
+{
+	m_loopMode = theMode;
+}
+
+AnimationClip::LoopMode AnimationClip::GetLoopMode() const
+{
+	return m_loopMode;
+}
+
+size_t AnimationClip::GetFrameCount() const
+{
+	return m_frames.size();
+}
+
+const AnimationClip::Frame& AnimationClip::GetFrame(size_t theIndex) const
+{
+	return m_frames[theIndex];
+}
+
+sf::Time AnimationClip::GetDuration() const
+{
+	return sf::microseconds(m_ends.empty() ? 0 : m_ends.back());
+}
+
+size_t AnimationClip::FindFrame(sf::Time theTime) const
+{
+	// Primer frame que termina después del instante pedido
+	std::vector<Int64>::const_iterator it = std::upper_bound(m_ends.begin(), m_ends.end(),
+		theTime.asMicroseconds());
+	if (it == m_ends.end())
+	{
+		return m_frames.empty() ? 0 : m_frames.size() - 1;
+	}
+	return static_cast<size_t>(it - m_ends.begin());
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/Sprite.hpp>
+#include <RAGE/Core/AnimationClip.hpp>
+#include <RAGE/Core/Animator.hpp>
+
+namespace ra
+{
+
+Animator::Animator()
+	: m_tracks()
+	, m_index()
+{
+}
+
+void Animator::Play(const ra::GraphHandle& theSprite, const ra::AnimationClip& theClip, float theSpeed)
+{
+	ra::SceneGraph* graph = theSprite.pool ? theSprite.pool->GetGraph(theSprite.index, theSprite.generation) : NULL;
+	if (graph == NULL)
+	{
+		ra::App::Instance()->log << "[warn] Animator::Play() el sprite ya fue destruido" << std::endl;
+		return;
+	}
+	// El handle no tiene tipo: comprobamos una vez que viene de un SpritePool
+	ra::Sprite* sprite = dynamic_cast<ra::Sprite*>(graph);
+	if (sprite == NULL)
+	{
+		ra::App::Instance()->log << "[error] Animator::Play() el objeto no es un sprite" << std::endl;
+		return;
+	}
+
+	Track* track = FindTrack(theSprite);
+	if (track == 0)
+	{
+		m_index[theSprite] = m_tracks.size();
+		m_tracks.push_back(Track());
+		track = &m_tracks.back();
+		track->sprite = theSprite;
+	}
+
+	track->clip = &theClip;
+	track->time = 0;
+	track->speed = theSpeed;
+	track->paused = false;
+	track->finished = false;
+
+	// Sin frames, el primero se aplica cuando el clip se recargue con ellos
+	track->frame = static_cast<size_t>(-1);
+	if (theClip.GetFrameCount() > 0)
+	{
+		ApplyFrame(*track, *sprite, 0);
+	}
+}
+
+void Animator::Stop(const ra::GraphHandle& theSprite)
+{
+	std::map<ra::GraphHandle, size_t>::iterator it = m_index.find(theSprite);
+	if (it != m_index.end())
+	{
+		RemoveTrack(it->second);
+	}
+}
+
+void Animator::SetPaused(const ra::GraphHandle& theSprite, bool thePaused)
+{
+	Track* track = FindTrack(theSprite);
+	if (track)
+	{
+		track->paused = thePaused;
+	}
+}
+
+void Animator::SetSpeed(const ra::GraphHandle& theSprite, float theSpeed)
+{
+	Track* track = FindTrack(theSprite);
+	if (track)
+	{
+		track->speed = theSpeed;
+	}
+}
+
+bool Animator::IsPlaying(const ra::GraphHandle& theSprite) const
+{
+	const Track* track = FindTrack(theSprite);
+	return track && !track->paused && !track->finished;
+}
+
+bool Animator::IsFinished(const ra::GraphHandle& theSprite) const
+{
+	const Track* track = FindTrack(theSprite);
+	return track && track->finished;
+}
+
+const ra::AnimationClip* Animator::GetClip(const ra::GraphHandle& theSprite) const
+{
+	const Track* track = FindTrack(theSprite);
+	return track ? track->clip : NULL;
+}
+
+void Animator::Update(sf::Time theElapsed)
+{
+	Int64 elapsed = theElapsed.asMicroseconds();
+
+	size_t i = 0;
+	while (i < m_tracks.size())
+	{
+		Track& track = m_tracks[i];
+
+		// Los sprites destruidos en su pool se olvidan, la última animación
+		// ocupa su hueco y se procesa en esta misma posición
+		ra::Sprite* sprite = GetSprite(track);
+		if (sprite == NULL)
+		{
+			RemoveTrack(i);
+			continue;
+		}
+		i++;
+		if (track.paused || track.finished)
+		{
+			continue;
+		}
+
+		const ra::AnimationClip& clip = *track.clip;
+		Int64 duration = clip.GetDuration().asMicroseconds();
+		if (duration == 0)
+		{
+			continue;
+		}
+
+		track.time += static_cast<Int64>(elapsed * track.speed);
+		if (track.time < 0)
+		{
+			track.time = 0;
+		}
+
+		// Reducimos el tiempo a una pasada por los frames
+		Int64 time = track.time;
+		switch (clip.GetLoopMode())
+		{
+		case ra::AnimationClip::LoopOnce:
+			if (time >= duration)
+			{
+				time = duration - 1;
+				track.finished = true;
+			}
+			break;
+		case ra::AnimationClip::LoopRepeat:
+			track.time %= duration;
+			time = track.time;
+			break;
+		case ra::AnimationClip::LoopPingPong:
+			track.time %= 2 * duration;
+			time = (track.time < duration) ? track.time : 2 * duration - 1 - track.time;
+			break;
+		}
+
+		size_t frame = clip.FindFrame(sf::microseconds(time));
+		if (frame != track.frame)
+		{
+			ApplyFrame(track, *sprite, frame);
+		}
+	}
+}
+
+void Animator::Clear()
+{
+	m_tracks.clear();
+	m_index.clear();
+}
+
+size_t Animator::GetSize() const
+{
+	return m_tracks.size();
+}
+
+Animator::Track* Animator::FindTrack(const ra::GraphHandle& theSprite)
+{
+	std::map<ra::GraphHandle, size_t>::iterator it = m_index.find(theSprite);
+	return (it != m_index.end()) ? &m_tracks[it->second] : NULL;
+}
+
+const Animator::Track* Animator::FindTrack(const ra::GraphHandle& theSprite) const
+{
+	std::map<ra::GraphHandle, size_t>::const_iterator it = m_index.find(theSprite);
+	return (it != m_index.end()) ? &m_tracks[it->second] : NULL;
+}
+
+void Animator::RemoveTrack(size_t theIndex)
+{
+	// Movemos la última animación al hueco para mantenerlas contiguas
+	m_index.erase(m_tracks[theIndex].sprite);
+	if (theIndex != m_tracks.size() - 1)
+	{
+		m_tracks[theIndex] = m_tracks.back();
+		m_index[m_tracks[theIndex].sprite] = theIndex;
+	}
+	m_tracks.pop_back();
+}
+
+ra::Sprite* Animator::GetSprite(const Track& theTrack)
+{
+	// Play() ya comprobó que el handle es de un sprite
+	const ra::GraphHandle& handle = theTrack.sprite;
+	return static_cast<ra::Sprite*>(handle.pool->GetGraph(handle.index, handle.generation));
+}
+
+void Animator::ApplyFrame(Track& theTrack, ra::Sprite& theSprite, size_t theFrame)
+{
+	const ra::AnimationClip::Frame& frame = theTrack.clip->GetFrame(theFrame);
+
+	// El color de los vértices no cambia
+	theSprite.m_textureRect = frame.rect;
+	for (int i = 0; i < 4; i++)
+	{
+		theSprite.m_vertices[i].position = frame.positions[i];
+		theSprite.m_vertices[i].texCoords = frame.texCoords[i];
+	}
+	theTrack.frame = theFrame;
+}
+
+} // namespace ra
\ No newline at end of file
@@ -8,6 +8,15 @@
 #include <RAGE/Core/SceneManager.hpp>
 #include <RAGE/Core/Scene.hpp>
 #include <RAGE/Core/Camera.hpp>
+#include <RAGE/Core/ScreenCapture.hpp>
+#include <RAGE/Core/PostProcess.hpp>
+#include <RAGE/Core/Input.hpp>
+#include <RAGE/Core/InputRecorder.hpp>
+#include <RAGE/Core/FileWatcher.hpp>
+#include <RAGE/Core/FrameMemory.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
+#include <RAGE/Core/RenderStats.hpp>
+#include <RAGE/Core/Text.hpp>
 #include <RAGE/Core/App.hpp>
 
 namespace ra
@@ -28,6 +37,18 @@ App::App()
 	, m_updateClock()
 	, m_updateTime()
 	, m_totalTime()
+	, m_postProcess(0)
+	, m_recorder(0)
+	, m_recordFile("")
+	, m_replayFile("")
+	, m_headless(false)
+	, m_frameEvents()
+	, m_fileWatcher(0)
+	, m_frameMemory(0)
+	, m_statsText(0)
+	, m_hotReload(false)
+	, m_memoryReportInterval(sf::seconds(MEMORY_REPORT_INTERVAL))
+	, m_memoryReportTime()
 	, m_quit(true)
 {
 	// Se crea el archivo de log
@@ -77,6 +98,49 @@ void App::RegisterExecutableDir(int argc, char **argv)
 	}
 }
 
+void App::ParseArguments(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--record" && i + 1 < argc)
+		{
+			m_recordFile = argv[++i];
+		}
+		else if (arg == "--replay" && i + 1 < argc)
+		{
+			m_replayFile = argv[++i];
+		}
+		else if (arg == "--headless")
+		{
+			m_headless = true;
+		}
+	}
+
+	// Sin grabación que reproducir no hay entrada posible sin ventana
+	if (m_headless && m_replayFile.empty())
+	{
+		log << "[warn] App::ParseArguments() --headless solo se aplica junto a --replay" << std::endl;
+		m_headless = false;
+	}
+
+	if (!m_recordFile.empty() && !m_replayFile.empty())
+	{
+		log << "[warn] App::ParseArguments() no se puede grabar durante una reproducción, se ignora --record" << std::endl;
+		m_recordFile = "";
+	}
+}
+
+bool App::IsReplaying() const
+{
+	return m_recorder != 0 && m_recorder->IsReplaying();
+}
+
+bool App::IsHeadless() const
+{
+	return m_headless;
+}
+
 std::string App::GetExecutableDir() const
 {
 	return m_executableDir;
@@ -115,7 +179,7 @@ void App::SetFirstScene(ra::Scene* theScene)
 	}
 	else
 	{
-		log << "[warn]Ya se haba establecido una escena inicial" << std::endl;
+		log << "[warn]Ya se había establecido una escena inicial" << std::endl;
 	}
 }
 
@@ -129,6 +193,39 @@ sf::Time App::GetTotalTime() const
 	return m_totalTime;
 }
 
+sf::RenderTarget& App::GetRenderTarget()
+{
+	if (m_postProcess == 0)
+	{
+		return window;
+	}
+	return m_postProcess->GetRenderTarget();
+}
+
+const ra::RenderCounters& App::GetRenderStats() const
+{
+	return ra::RenderStats::GetFrame();
+}
+
+void App::ShowRenderStats(const sf::Font* theFont)
+{
+	if (theFont == 0)
+	{
+		delete m_statsText;
+		m_statsText = 0;
+		return;
+	}
+
+	if (m_statsText == 0)
+	{
+		m_statsText = new ra::Text();
+		m_statsText->setCharacterSize(14);
+		m_statsText->setColor(sf::Color::Yellow);
+		m_statsText->setPosition(8.f, 8.f);
+	}
+	m_statsText->setFont(*theFont);
+}
+
 void App::EnableQuit(bool value)
 {
 	m_quit = value;
@@ -167,7 +264,7 @@ void App::CreateWindow()
 
 	if (confFile.LoadFromFile(GetExecutableDir() + "window.cfg"))
 	{
-		// Si est activado fullScreen obtenemos la resolucin del escritorio
+		// Si está activado fullScreen obtenemos la resolución del escritorio
 		if (confFile.GetBool("window", "fullscreen", 0))
 		{
 			m_videoMode = sf::VideoMode::getDesktopMode();
@@ -180,6 +277,9 @@ void App::CreateWindow()
 			m_videoMode.bitsPerPixel = confFile.GetUint32("window", "bpp", DEFAULT_VIDEO_BPP);
 		}
 		vsync = (confFile.GetBool("window", "vsync", true));
+		m_hotReload = confFile.GetBool("debug", "hotreload", false);
+		m_memoryReportInterval = sf::seconds(static_cast<float>(
+			confFile.GetUint32("debug", "memoryreport", MEMORY_REPORT_INTERVAL)));
 	}
 	else
 	{
@@ -191,13 +291,23 @@ void App::CreateWindow()
 		conf.PutValue("bpp", DEFAULT_VIDEO_BPP);
 		conf.PutValue("fullscreen", false);
 		conf.PutValue("vsync", true);
+		conf.PutSection("debug");
+		conf.PutValue("hotreload", false);
+		conf.PutValue("memoryreport", MEMORY_REPORT_INTERVAL);
 		conf.Close();
 		vsync = true;
 	}
 
 	window.create(m_videoMode, m_title, m_windowStyle);
 
-	log << "App::CreateWindow() ventana creada resolucin (" << m_videoMode.width 
+	// Sin dibujar la ventana solo mantiene el contexto de OpenGL
+	if (m_headless)
+	{
+		window.setVisible(false);
+		vsync = false;
+	}
+
+	log << "App::CreateWindow() ventana creada resolución (" << m_videoMode.width 
 		<< ", " << m_videoMode.height << ", " << m_videoMode.bitsPerPixel << ")" 
 		<< std::endl;
 
@@ -211,16 +321,55 @@ void App::CreateWindow()
 
 void App::Init()
 {
+	// Creamos la memoria temporal por frame antes que el resto de
+	// subsistemas para que puedan usarla
+	m_frameMemory = ra::FrameMemory::Instance();
+
+	// Creamos el vigilante de archivos antes que los recursos para que
+	// registre los que se vayan cargando
+	m_fileWatcher = ra::FileWatcher::Instance();
+	m_fileWatcher->Watch(GetExecutableDir() + "window.cfg");
+	m_fileWatcher->SetEnabled(m_hotReload);
+
 	// Creamos el Asset Manager
 	m_assetManager = ra::AssetManager::Instance();
 
+	// Preparamos la grabación o la reproducción de la entrada
+	m_recorder = new ra::InputRecorder();
+	if (!m_replayFile.empty())
+	{
+		if (!m_recorder->StartReplay(m_replayFile))
+		{
+			Quit(ra::StatusAppInitFailed);
+		}
+	}
+	else if (!m_recordFile.empty())
+	{
+		m_recorder->StartRecording(m_recordFile);
+	}
+
+	// Creamos el subsistema de entrada, antes que las escenas para que
+	// puedan usarlo en su Init()
+	m_input = ra::Input::Instance();
+	if (boost::filesystem::exists(GetExecutableDir() + "input.cfg"))
+	{
+		m_input->LoadActions(GetExecutableDir() + "input.cfg");
+	}
+
+	// Creamos la cámara, antes que las escenas para que puedan añadir las
+	// suyas en su Init()
+	m_camera = ra::Camera::Instance();
+	m_camera->SetDefaultCamera();
+
 	// Creamos el Scene Manager
 	m_sceneManager = ra::SceneManager::Instance();
 
 	// Establecemos la escene inicial
 	if (m_initialScene != 0)
 	{
-		// Aadimos la primera escena
+		ra::MemoryScope scope(ra::MemoryScene);
+
+		// Añadimos la primera escena
 		m_sceneManager->AddScene(m_initialScene);
 		// La establecemos como escena activa
 		m_sceneManager->SetActiveScene(m_initialScene->GetID());
@@ -230,77 +379,271 @@ void App::Init()
 	{
 		log << "[error] App::Init() No se ha establecido escena inicial. LLamar a App::SetFirstScene() primero" 
 			<< std::endl;
-		// Salimos con cdigo -2
+		// Salimos con código -2
 		Quit(ra::StatusAppInitFailed);
 	}
 
-	// Creamos la cmara
-	m_camera = ra::Camera::Instance();
-	m_camera->SetDefaultCamera();
+	// Creamos el servicio de capturas
+	m_screenCapture = ra::ScreenCapture::Instance();
+
+	// Creamos la cadena de postprocesado
+	m_postProcess = ra::PostProcess::Instance();
 
 	log << "App::Init() Completado" << std::endl;
 }
 
 void App::GameLoop()
 {
-	// Bucle mientras se est ejecutando y la ventana est abierta
+	// Tiempos reales de los frames durante una reproducción
+	sf::Time replayTime;
+	sf::Time replayMaxFrame;
+
+	// Bucle mientras se esté ejecutando y la ventana esté abierta
 	while (IsRunning() && window.isOpen())
 	{
 		// Obtenemos el tiempo pasado en cada ciclo
 		m_updateTime = m_updateClock.restart();
+
+		// Al reproducir el tiempo y los eventos salen de la grabación
+		if (m_recorder->IsReplaying())
+		{
+			replayTime += m_updateTime;
+			if (m_updateTime > replayMaxFrame)
+			{
+				replayMaxFrame = m_updateTime;
+			}
+
+			if (!m_recorder->ReadFrame(m_updateTime, m_frameEvents))
+			{
+				ra::Uint32 frames = m_recorder->GetFrameCount();
+				log << "App::GameLoop() reproducción terminada: " << frames << " frames en "
+					<< replayTime.asMilliseconds() << " ms";
+				if (frames > 0)
+				{
+					log << " (media " << replayTime.asMicroseconds() / frames << " us, máximo "
+						<< replayMaxFrame.asMicroseconds() << " us)";
+				}
+				log << std::endl;
+				ra::RenderStats::Report(log);
+
+				m_recorder->StopReplay();
+				Quit(StatusAppOK);
+				break;
+			}
+		}
+
 		// Almacenamos el tiempo total
 		m_totalTime += m_updateTime;
 
-		// Actualizamos la cmara
+		// Llamamos al método Update() de la escena activa
+		{
+			ra::MemoryScope scope(ra::MemoryScene);
+			m_sceneManager->UpdateScene();
+		}
+
+		// Actualizamos la cámara después de la escena para que siga a los
+		// objetos en su posición de este frame
 		m_camera->Update();
+		m_sceneManager->UpdateCameras();
 		window.setView(*m_camera);
 
-		// Llamamos al mtodo Update() de la escena activa
-		m_sceneManager->UpdateScene();
+		if (!m_headless)
+		{
+			ra::RenderStats::BeginFrame();
 
-		// Llamamos al mtodo Draw() de la escena activa
-		m_sceneManager->DrawScene();
+			// Si hay efectos activos las escenas dibujan en una textura
+			m_postProcess->Begin();
 
-		// Actualizamos la ventana
-		window.display();
+			// Llamamos al método Draw() de la escena activa
+			{
+				ra::MemoryScope scope(ra::MemoryScene);
+				m_sceneManager->DrawScene();
+			}
+
+			// Aplicamos los efectos y dejamos el resultado en la ventana
+			m_postProcess->End();
 
-		// Manejamos los eventos de la ventana
+			// Resolvemos las capturas pendientes antes de presentar el frame
+			m_screenCapture->Update();
+
+			// El panel de estadísticas queda fuera de las capturas y de las
+			// propias estadísticas
+			ra::RenderStats::EndFrame();
+			if (m_statsText != 0)
+			{
+				DrawRenderStats();
+			}
+
+			// Actualizamos la ventana
+			window.display();
+		}
+
+		// Vaciamos la cola de eventos de la ventana en Input, que actualiza
+		// el estado de teclado, ratón y joysticks para el siguiente frame
+		m_input->BeginFrame();
 		sf::Event event;
-		while (window.pollEvent(event))
+		if (m_recorder->IsReplaying())
 		{
-			switch (event.type)
+			// De la ventana solo atendemos al cierre, el resto sale de la grabación
+			while (window.pollEvent(event))
 			{
-			case sf::Event::Closed:			// La ventana es cerrada
-				if (m_quit)
+				if (event.type == sf::Event::Closed)
 					Quit(StatusAppOK);
-				else
-					m_sceneManager->EventScene(event);
-				break;
-			case sf::Event::GainedFocus:	// La ventana obtiene el foco
-				m_sceneManager->ResumeScene();
-				break;
-			case sf::Event::LostFocus:		// La ventana pierde el foco
-				m_sceneManager->PauseScene();
-				break;
-			default:	// Otros eventos se los pasamos a la ecena activa
-				m_sceneManager->EventScene(event);
-			} // switch (event.Type)
-		} // while (window.GetEvent(event))
+			}
+
+			for (size_t i = 0; i < m_frameEvents.size(); i++)
+			{
+				HandleEvent(m_frameEvents[i]);
+			}
+		}
+		else
+		{
+			m_frameEvents.clear();
+			while (window.pollEvent(event))
+			{
+				m_frameEvents.push_back(event);
+				HandleEvent(event);
+			}
+
+			// Grabamos el tiempo y los eventos del frame
+			m_recorder->RecordFrame(m_updateTime, m_frameEvents);
+		}
+
+		// Pasamos los eventos del frame a la escena activa
+		const std::vector<sf::Event>& events = m_input->GetEvents();
+		{
+			ra::MemoryScope scope(ra::MemoryScene);
+			for (size_t i = 0; i < events.size(); i++)
+			{
+				m_sceneManager->EventScene(events[i]);
+			}
+		}
+
+		// Recargamos los archivos modificados, las texturas se actualizan
+		// en UpdateAsync() y las configuraciones en este momento
+		m_fileWatcher->Update();
+		if (!m_fileWatcher->GetChanges().empty())
+		{
+			m_assetManager->ReloadFiles(m_fileWatcher->GetChanges());
+			if (m_fileWatcher->HasChanged(GetExecutableDir() + "window.cfg"))
+			{
+				ReloadWindowConfig();
+			}
+		}
+
+		// Registramos los recursos cargados en segundo plano y avanzamos
+		// la precarga de escenas
+		m_assetManager->UpdateAsync(sf::milliseconds(ASYNC_LOAD_BUDGET));
+		{
+			// Las escenas se inicializan aquí y en los cambios de escena
+			ra::MemoryScope scope(ra::MemoryScene);
+			m_sceneManager->UpdatePreload(sf::milliseconds(INIT_STEP_BUDGET));
+
+			// Comprobamos cambios de escena
+			if (m_sceneManager->HandleChangeScene())
+			{
+				// Reseteamos la cámara antes de que la nueva escena la prepare
+				m_camera->SetDefaultCamera();
+				// Cambiamos el puntero de la escena activa
+				m_sceneManager->ChangeScene(m_sceneManager->mNextScene);
+			}
+
+			// Aplicamos los cambios en la pila de escenas
+			m_sceneManager->HandleStackChanges();
+		}
+
+		// Liberamos la memoria temporal del frame
+		m_frameMemory->EndFrame();
 
-		// Comprobamos cambios de escena
-		if (m_sceneManager->HandleChangeScene())
+		// Escribimos el uso de memoria cada cierto tiempo
+		if (m_memoryReportInterval > sf::Time::Zero &&
+			m_totalTime - m_memoryReportTime >= m_memoryReportInterval)
 		{
-			// Cambiamos el puntero de la escena activa
-			m_sceneManager->ChangeScene(m_sceneManager->mNextScene);
-			// Reseteamos la cmara
-			m_camera->SetDefaultCamera();
+			ra::MemoryTracker::Report(log);
+			m_memoryReportTime = m_totalTime;
 		}
 
 	} // while (IsRunning() && window.IsOpened())
 }
 
+void App::HandleEvent(const sf::Event& theEvent)
+{
+	switch (theEvent.type)
+	{
+	case sf::Event::Closed:			// La ventana es cerrada
+		if (m_quit)
+			Quit(StatusAppOK);
+		else
+			m_input->PushEvent(theEvent);
+		break;
+	case sf::Event::GainedFocus:	// La ventana obtiene el foco
+		m_sceneManager->ResumeScene();
+		break;
+	case sf::Event::LostFocus:		// La ventana pierde el foco
+		m_input->ResetState();
+		m_sceneManager->PauseScene();
+		break;
+	default:	// Otros eventos se encolan para la escena activa
+		m_input->PushEvent(theEvent);
+	} // switch (theEvent.type)
+}
+
+void App::ReloadWindowConfig()
+{
+	ra::ConfigReader confFile;
+	if (!confFile.LoadFromFile(GetExecutableDir() + "window.cfg"))
+	{
+		log << "[error] App::ReloadWindowConfig() no se ha podido leer window.cfg" << std::endl;
+		return;
+	}
+
+	bool fullscreen = confFile.GetBool("window", "fullscreen", 0);
+	if (fullscreen != (m_windowStyle == sf::Style::Fullscreen))
+	{
+		log << "[warn] App::ReloadWindowConfig() el cambio de pantalla completa requiere reiniciar" << std::endl;
+	}
+	else if (!fullscreen)
+	{
+		m_videoMode.width = confFile.GetUint32("window", "width", DEFAULT_VIDEO_WIDTH);
+		m_videoMode.height = confFile.GetUint32("window", "height", DEFAULT_VIDEO_HEIGHT);
+		window.setSize(sf::Vector2u(m_videoMode.width, m_videoMode.height));
+	}
+
+	if (!m_headless)
+	{
+		window.setVerticalSyncEnabled(confFile.GetBool("window", "vsync", true));
+	}
+
+	log << "App::ReloadWindowConfig() ventana actualizada (" << m_videoMode.width
+		<< ", " << m_videoMode.height << ")" << std::endl;
+}
+
+void App::DrawRenderStats()
+{
+	const ra::RenderCounters& stats = ra::RenderStats::GetFrame();
+
+	std::ostringstream text;
+	text << "llamadas: " << stats.drawCalls << "  vertices: " << stats.vertices
+		<< "  primitivas: " << stats.primitives << "\n"
+		<< "texturas: " << stats.textureBinds << "  vistas: " << stats.viewChanges
+		<< "  shaders: " << stats.shaderSwitches << "\n"
+		<< "objetos: " << stats.drawn << "  descartados: " << stats.culled;
+	m_statsText->setString(text.str());
+
+	// El panel se coloca en píxeles de la ventana, sea cual sea la cámara
+	sf::View view = window.getView();
+	window.setView(sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(window.getSize().x),
+		static_cast<float>(window.getSize().y))));
+	window.draw(*m_statsText);
+	window.setView(view);
+}
+
 void App::Cleanup()
 {
+	// Eliminamos el panel de estadísticas antes que su fuente
+	delete m_statsText;
+	m_statsText = 0;
+
 	// Eliminamos todas las escenas
 	m_sceneManager->RemoveAllScene();
 
@@ -313,12 +656,35 @@ void App::Cleanup()
 	// Eliminamos el AssetManager
 	ra::AssetManager::Release();
 
+	// Eliminamos el servicio de capturas
+	ra::ScreenCapture::Release();
+
+	// Eliminamos la cadena de postprocesado
+	ra::PostProcess::Release();
+
+	// Eliminamos el subsistema de entrada
+	ra::Input::Release();
+
+	// Detenemos el vigilante de archivos
+	ra::FileWatcher::Release();
+
+	// Cerramos la grabación de la entrada
+	delete m_recorder;
+	m_recorder = 0;
+
+	// Eliminamos la memoria temporal por frame
+	ra::FrameMemory::Release();
+
 	// Hacemos visible el cursor
 	window.setMouseCursorVisible(true);
 
 	// Cerramos la ventana
 	window.close();
 
+	// Con todos los subsistemas liberados, lo que quede etiquetado se ha perdido
+	ra::MemoryTracker::Report(log);
+	ra::MemoryTracker::ReportLeaks(log);
+
 	log << "App::Cleanup() Completado" << std::endl;
 }
 
@@ -1,9 +1,21 @@
 #include <boost/filesystem.hpp>
 #include <RAGE/Core/App.hpp>
+#include <RAGE/Core/FileWatcher.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
 #include <RAGE/Core/AssetManager.hpp>
 
 namespace fs = boost::filesystem;
 
+namespace
+{
+	/// Bytes estimados de una textura en la GPU, 4 por píxel (RGBA)
+	ra::Uint64 GetTextureBytes(const sf::Texture* theTexture)
+	{
+		sf::Vector2u size = theTexture->getSize();
+		return static_cast<ra::Uint64>(size.x) * size.y * 4;
+	}
+}
+
 namespace ra
 {
 
@@ -18,6 +30,14 @@ AssetManager::AssetManager()
 	, m_sounds()
 	, m_music()
 	, m_configs()
+	, m_configReloads()
+	, m_animations()
+	, m_asyncPending()
+	, m_asyncRequests()
+	, m_asyncResults()
+	, m_asyncMutex()
+	, m_asyncLoader(&AssetManager::AsyncLoop, this)
+	, m_asyncRunning(false)
 {
 }
 
@@ -68,6 +88,11 @@ void AssetManager::SetPath(const std::string& thePath)
 	}
 }
 
+const std::string& AssetManager::GetPath() const
+{
+	return m_masterDir;
+}
+
 sf::Texture* AssetManager::GetTexture(const std::string& theName)
 {
 	// Comprobamos si ya esta cargada
@@ -79,7 +104,8 @@ sf::Texture* AssetManager::GetTexture(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAssets);
 	sf::Texture *texture = new sf::Texture();
 
 	if(!texture->loadFromFile(m_masterDir + theName))
@@ -91,8 +117,12 @@ sf::Texture* AssetManager::GetTexture(const std::string& theName)
 
 	app->log << "AssetManager::GetTexture() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_textures[theName] = texture;
+	ra::MemoryTracker::AddResident(ra::MemoryAssets, GetTextureBytes(texture));
+
+	// Vigilamos el archivo para recargarlo en caliente
+	WatchFile(theName);
 
 	// Devolvemos el puntero
 	return texture;
@@ -109,12 +139,14 @@ sf::Texture* AssetManager::GetTexture(const std::string& theName, sf::Texture* t
 		return it->second;
 	}
 
+	ra::MemoryScope scope(ra::MemoryAssets);
 	sf::Texture* texture = new sf::Texture(*theTexture);
 
 	app->log << "AssetManager::GetTexture() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_textures[theName] = texture;
+	ra::MemoryTracker::AddResident(ra::MemoryAssets, GetTextureBytes(texture));
 
 	// Devolvemos el puntero
 	return texture;
@@ -131,7 +163,8 @@ sf::Texture* AssetManager::GetTextureFromImage(const std::string& theName, const
 		return it->second;
 	}
 
-	// Si no lo est, la creamos a partir de la Imagen
+	// Si no lo está, la creamos a partir de la Imagen
+	ra::MemoryScope scope(ra::MemoryAssets);
 	sf::Texture *texture = new sf::Texture();
 	if(!texture->loadFromImage(*theImage, theRect))
 	{
@@ -142,8 +175,9 @@ sf::Texture* AssetManager::GetTextureFromImage(const std::string& theName, const
 
 	app->log << "AssetManager::GetTextureFromImage() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_textures[theName] = texture;
+	ra::MemoryTracker::AddResident(ra::MemoryAssets, GetTextureBytes(texture));
 
 	// Devolvemos el puntero
 	return texture;
@@ -154,13 +188,15 @@ void AssetManager::DeleteTexture(const std::string& theName)
 	std::map<std::string, sf::Texture*>::const_iterator it = m_textures.find(theName);
 	if (it != m_textures.end())
 	{
+		ra::MemoryTracker::RemoveResident(ra::MemoryAssets, GetTextureBytes(it->second));
 		delete it->second;
 		m_textures.erase(it);
+		UnwatchFile(theName);
 		app->log << "AssetManager::DeleteTexture() " << theName << " archivo eliminado" << std::endl;
 		return;
 	}
 
-	app->log << "AssetManager::DeleteTexture() " << theName << " no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteTexture() " << theName << " no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteTexture(const sf::Texture* theTexture)
@@ -170,14 +206,16 @@ void AssetManager::DeleteTexture(const sf::Texture* theTexture)
 	{
 		if (theTexture == it->second)
 		{
+			ra::MemoryTracker::RemoveResident(ra::MemoryAssets, GetTextureBytes(it->second));
 			delete it->second;
 			app->log << "AssetManager::DeleteTexture() " << it->first << " archivo eliminado" << std::endl;
+			UnwatchFile(it->first);
 			m_textures.erase(it);
 			return;
 		}
 	}
 
-	app->log << "AssetManager::DeleteTexture() La direccin no corresponde a una textura cargada" << std::endl;
+	app->log << "AssetManager::DeleteTexture() La dirección no corresponde a una textura cargada" << std::endl;
 }
 
 sf::Image* AssetManager::GetImage(const std::string& theName)
@@ -191,7 +229,8 @@ sf::Image* AssetManager::GetImage(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAssets);
 	sf::Image *image = new sf::Image();
 
 	if(!image->loadFromFile(m_masterDir + theName))
@@ -203,7 +242,7 @@ sf::Image* AssetManager::GetImage(const std::string& theName)
 
 	app->log << "AssetManager::GetImage() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_images[theName] = image;
 
 	// Devolvemos el puntero
@@ -221,7 +260,8 @@ sf::Image* AssetManager::GetImageFromTexture(const std::string& theName, const s
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAssets);
 	sf::Image *image = new sf::Image();
 	*image = theTexture->copyToImage();
 
@@ -229,7 +269,7 @@ sf::Image* AssetManager::GetImageFromTexture(const std::string& theName, const s
 
 	app->log << "AssetManager::GetImageFromTexture() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_images[theName] = image;
 
 	// Devolvemos el puntero
@@ -247,7 +287,7 @@ void AssetManager::DeleteImage(const std::string& theName)
 		return;
 	}
 
-	app->log << "AssetManager::DeleteImage() " << theName << "no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteImage() " << theName << "no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteImage(const sf::Image* theImage)
@@ -264,7 +304,7 @@ void AssetManager::DeleteImage(const sf::Image* theImage)
 		}
 	}
 
-	app->log << "AssetManager::DeleteImage() La direccin no corresponde a una imagen cargada" << std::endl;
+	app->log << "AssetManager::DeleteImage() La dirección no corresponde a una imagen cargada" << std::endl;
 }
 
 sf::Font* AssetManager::GetFont(const std::string& theName)
@@ -278,7 +318,8 @@ sf::Font* AssetManager::GetFont(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryText);
 	sf::Font *font = new sf::Font();
 
 	if(!font->loadFromFile(m_masterDir + theName))
@@ -289,7 +330,7 @@ sf::Font* AssetManager::GetFont(const std::string& theName)
 
 	app->log << "AssetManager::GetFont() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_fonts[theName] = font;
 
 	// Devolvemos el puntero
@@ -307,7 +348,7 @@ void AssetManager::DeleteFont(const std::string& theName)
 		return;
 	}
 
-	app->log << "AssetManager::DeleteFont() " << theName << "no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteFont() " << theName << "no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteFont(const sf::Font* theFont)
@@ -324,7 +365,7 @@ void AssetManager::DeleteFont(const sf::Font* theFont)
 		}
 	}
 
-	app->log << "AssetManager::DeleteFont() La direccin no corresponde a una fuente cargada" << std::endl;
+	app->log << "AssetManager::DeleteFont() La dirección no corresponde a una fuente cargada" << std::endl;
 }
 
 sf::SoundBuffer* AssetManager::GetSoundBuffer(const std::string& theName)
@@ -338,7 +379,8 @@ sf::SoundBuffer* AssetManager::GetSoundBuffer(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAudio);
 	sf::SoundBuffer *sound = new sf::SoundBuffer();
 
 	if(!sound->loadFromFile(m_masterDir + theName))
@@ -349,7 +391,7 @@ sf::SoundBuffer* AssetManager::GetSoundBuffer(const std::string& theName)
 
 	app->log << "AssetManager::GetSoundBuffer() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_sounds[theName] = sound;
 
 	// Devolvemos el puntero
@@ -367,7 +409,7 @@ void AssetManager::DeleteSoundBuffer(const std::string& theName)
 		return;
 	}
 
-	app->log << "AssetManager::DeleteSoundBuffer() " << theName << "no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteSoundBuffer() " << theName << "no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteSoundBuffer(const sf::SoundBuffer* theSoundBuffer)
@@ -384,7 +426,7 @@ void AssetManager::DeleteSoundBuffer(const sf::SoundBuffer* theSoundBuffer)
 		}
 	}
 
-	app->log << "AssetManager::DeleteSoundBuffer() La direccin no corresponde a un sonido cargado" << std::endl;
+	app->log << "AssetManager::DeleteSoundBuffer() La dirección no corresponde a un sonido cargado" << std::endl;
 }
 
 sf::Music* AssetManager::GetMusic(const std::string& theName)
@@ -398,7 +440,8 @@ sf::Music* AssetManager::GetMusic(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAudio);
 	sf::Music *music = new sf::Music();
 
 	if(!music->openFromFile(m_masterDir + theName))
@@ -409,7 +452,7 @@ sf::Music* AssetManager::GetMusic(const std::string& theName)
 
 	app->log << "AssetManager::GetMusic() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_music[theName] = music;
 
 	// Devolvemos el puntero
@@ -427,7 +470,7 @@ void AssetManager::DeleteMusic(const std::string& theName)
 		return;
 	}
 
-	app->log << "AssetManager::DeleteMusic() " << theName << "no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteMusic() " << theName << "no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteMusic(const sf::Music* theMusic)
@@ -444,7 +487,7 @@ void AssetManager::DeleteMusic(const sf::Music* theMusic)
 		}
 	}
 
-	app->log << "AssetManager::DeleteMusic() La direccin no corresponde a una msica cargada" << std::endl;
+	app->log << "AssetManager::DeleteMusic() La dirección no corresponde a una música cargada" << std::endl;
 }
 
 ra::ConfigReader* AssetManager::GetConfig(const std::string& theName)
@@ -458,7 +501,8 @@ ra::ConfigReader* AssetManager::GetConfig(const std::string& theName)
 		return it->second;
 	}
 
-	// Si no lo est, la intentamos cargar
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryConfig);
 	ra::ConfigReader *config = new ra::ConfigReader();
 
 	if(!config->LoadFromFile(m_masterDir + theName))
@@ -469,9 +513,12 @@ ra::ConfigReader* AssetManager::GetConfig(const std::string& theName)
 
 	app->log << "AssetManager::GetConfig() " << theName << " cargado" << std::endl;
 
-	// La aadimos a la lista
+	// La añadimos a la lista
 	m_configs[theName] = config;
 
+	// Vigilamos el archivo para recargarlo en caliente
+	WatchFile(theName);
+
 	// Devolvemos el puntero
 	return config;
 }
@@ -483,11 +530,13 @@ void AssetManager::DeleteConfig(const std::string& theName)
 	{
 		delete it->second;
 		m_configs.erase(it);
+		m_configReloads.erase(theName);
+		UnwatchFile(theName);
 		app->log << "AssetManager::DeleteConfig() " << theName << "archivo eliminado" << std::endl;
 		return;
 	}
 
-	app->log << "AssetManager::DeleteConfig() " << theName << "no est cargado" << std::endl;
+	app->log << "AssetManager::DeleteConfig() " << theName << "no está cargado" << std::endl;
 }
 
 void AssetManager::DeleteConfig(const ra::ConfigReader* theConfig)
@@ -499,19 +548,420 @@ void AssetManager::DeleteConfig(const ra::ConfigReader* theConfig)
 		{
 			delete it->second;
 			app->log << "AssetManager::DeleteConfig() " << it->first << "archivo eliminado" << std::endl;
+			UnwatchFile(it->first);
+			m_configReloads.erase(it->first);
 			m_configs.erase(it);
 			return;
 		}
 	}
 
-	app->log << "AssetManager::DeleteConfig() La direccin no corresponde a una configuracin cargada" << std::endl;
+	app->log << "AssetManager::DeleteConfig() La dirección no corresponde a una configuración cargada" << std::endl;
+}
+
+ra::Uint32 AssetManager::GetConfigReloads(const std::string& theName) const
+{
+	std::map<std::string, ra::Uint32>::const_iterator it = m_configReloads.find(theName);
+	if (it != m_configReloads.end())
+	{
+		return it->second;
+	}
+	return 0;
+}
+
+ra::AnimationClip* AssetManager::GetAnimation(const std::string& theName)
+{
+	// Comprobamos si ya esta cargada
+	std::map<std::string, ra::AnimationClip*>::const_iterator it;
+	it = m_animations.find(theName);
+	if (it != m_animations.end())
+	{
+		app->log << "AssetManager::GetAnimation() " << theName << " usando archivo existente" << std::endl;
+		return it->second;
+	}
+
+	// Si no lo está, la intentamos cargar
+	ra::MemoryScope scope(ra::MemoryAssets);
+	ra::AnimationClip *animation = new ra::AnimationClip();
+
+	if(!animation->LoadFromFile(m_masterDir + theName))
+	{
+		app->log << "[error] AssetManager::GetAnimation() " << theName << " no se ha podido cargar" << std::endl;
+		return animation;
+	}
+
+	app->log << "AssetManager::GetAnimation() " << theName << " cargado" << std::endl;
+
+	// La añadimos a la lista
+	m_animations[theName] = animation;
+
+	// Vigilamos el archivo para recargarlo en caliente
+	WatchFile(theName);
+
+	// Devolvemos el puntero
+	return animation;
+}
+
+void AssetManager::DeleteAnimation(const std::string& theName)
+{
+	std::map<std::string, ra::AnimationClip*>::const_iterator it = m_animations.find(theName);
+	if (it != m_animations.end())
+	{
+		delete it->second;
+		m_animations.erase(it);
+		UnwatchFile(theName);
+		app->log << "AssetManager::DeleteAnimation() " << theName << " archivo eliminado" << std::endl;
+		return;
+	}
+
+	app->log << "AssetManager::DeleteAnimation() " << theName << " no está cargado" << std::endl;
+}
+
+void AssetManager::DeleteAnimation(const ra::AnimationClip* theAnimation)
+{
+	std::map<std::string, ra::AnimationClip*>::const_iterator it;
+	for (it = m_animations.begin(); it != m_animations.end(); it++)
+	{
+		if (theAnimation == it->second)
+		{
+			delete it->second;
+			app->log << "AssetManager::DeleteAnimation() " << it->first << " archivo eliminado" << std::endl;
+			UnwatchFile(it->first);
+			m_animations.erase(it);
+			return;
+		}
+	}
+
+	app->log << "AssetManager::DeleteAnimation() La dirección no corresponde a una animación cargada" << std::endl;
+}
+
+void AssetManager::LoadAsync(AssetType theType, const std::string& theName)
+{
+	if (IsLoaded(theType, theName) || IsPending(theType, theName))
+	{
+		return;
+	}
+
+	m_asyncPending.insert(std::make_pair(theType, theName));
+
+	// Los archivos de configuración y animaciones se leen en el hilo
+	// principal porque ConfigReader escribe en el log
+	if (theType == AssetConfig || theType == AssetAnimation)
+	{
+		AsyncLoad result;
+		result.type = theType;
+		result.name = theName;
+		result.image = NULL;
+		result.font = NULL;
+		result.sound = NULL;
+		result.success = true;
+		result.reload = false;
+
+		sf::Lock lock(m_asyncMutex);
+		m_asyncResults.push_back(result);
+		return;
+	}
+
+	AsyncLoad request;
+	request.type = theType;
+	request.name = theName;
+	request.path = m_masterDir + theName;
+	request.image = NULL;
+	request.font = NULL;
+	request.sound = NULL;
+	request.success = false;
+	request.reload = false;
+
+	QueueAsync(request);
+
+	app->log << "AssetManager::LoadAsync() " << theName << " en cola" << std::endl;
+}
+
+bool AssetManager::IsLoaded(AssetType theType, const std::string& theName) const
+{
+	switch (theType)
+	{
+	case AssetTexture:
+		return m_textures.find(theName) != m_textures.end();
+	case AssetFont:
+		return m_fonts.find(theName) != m_fonts.end();
+	case AssetSoundBuffer:
+		return m_sounds.find(theName) != m_sounds.end();
+	case AssetConfig:
+		return m_configs.find(theName) != m_configs.end();
+	case AssetAnimation:
+		return m_animations.find(theName) != m_animations.end();
+	}
+	return false;
+}
+
+bool AssetManager::IsPending(AssetType theType, const std::string& theName) const
+{
+	return m_asyncPending.find(std::make_pair(theType, theName)) != m_asyncPending.end();
+}
+
+void AssetManager::UpdateAsync(sf::Time theBudget)
+{
+	if (m_asyncPending.empty())
+	{
+		return;
+	}
+
+	sf::Clock clock;
+	do
+	{
+		AsyncLoad result;
+		{
+			sf::Lock lock(m_asyncMutex);
+			if (m_asyncResults.empty())
+			{
+				return;
+			}
+			result = m_asyncResults.front();
+			m_asyncResults.pop_front();
+		}
+
+		m_asyncPending.erase(std::make_pair(result.type, result.name));
+
+		// Si el recurso se cargó de forma síncrona mientras tanto, el
+		// resultado del hilo se descarta. Tampoco se recarga un recurso que
+		// se ha eliminado mientras tanto
+		if (IsLoaded(result.type, result.name) != result.reload)
+		{
+			delete result.image;
+			delete result.font;
+			delete result.sound;
+			continue;
+		}
+
+		if (!result.success)
+		{
+			app->log << "[error] AssetManager::UpdateAsync() " << result.name << " no se ha podido cargar" << std::endl;
+			delete result.image;
+			delete result.font;
+			delete result.sound;
+			continue;
+		}
+
+		// Al recargar se sustituye el contenido de la textura existente, así
+		// quien tenga su puntero ve el nuevo contenido en este frame
+		if (result.reload)
+		{
+			if (result.type == AssetTexture)
+			{
+				// El tamaño puede haber cambiado
+				sf::Texture* texture = m_textures[result.name];
+				ra::MemoryTracker::RemoveResident(ra::MemoryAssets, GetTextureBytes(texture));
+				texture->loadFromImage(*result.image);
+				ra::MemoryTracker::AddResident(ra::MemoryAssets, GetTextureBytes(texture));
+				app->log << "AssetManager::UpdateAsync() " << result.name << " recargado" << std::endl;
+			}
+			delete result.image;
+			delete result.font;
+			delete result.sound;
+			continue;
+		}
+
+		switch (result.type)
+		{
+		case AssetTexture:
+			// La subida a la GPU debe hacerse en el hilo principal
+			GetTextureFromImage(result.name, result.image);
+			WatchFile(result.name);
+			delete result.image;
+			break;
+		case AssetFont:
+			{
+				ra::MemoryScope scope(ra::MemoryText);
+				m_fonts[result.name] = result.font;
+			}
+			app->log << "AssetManager::UpdateAsync() " << result.name << " cargado" << std::endl;
+			break;
+		case AssetSoundBuffer:
+			{
+				ra::MemoryScope scope(ra::MemoryAudio);
+				m_sounds[result.name] = result.sound;
+			}
+			app->log << "AssetManager::UpdateAsync() " << result.name << " cargado" << std::endl;
+			break;
+		case AssetConfig:
+			GetConfig(result.name);
+			break;
+		case AssetAnimation:
+			GetAnimation(result.name);
+			break;
+		}
+	} while (clock.getElapsedTime() < theBudget);
+}
+
+void AssetManager::ReloadFiles(const std::vector<std::string>& theFiles)
+{
+	std::vector<std::string>::const_iterator it;
+	for (it = theFiles.begin(); it != theFiles.end(); it++)
+	{
+		// Solo atendemos a los archivos del directorio maestro
+		if (it->compare(0, m_masterDir.size(), m_masterDir) != 0)
+		{
+			continue;
+		}
+		std::string name = it->substr(m_masterDir.size());
+
+		if (m_textures.find(name) != m_textures.end() && !IsPending(AssetTexture, name))
+		{
+			m_asyncPending.insert(std::make_pair(AssetTexture, name));
+
+			AsyncLoad request;
+			request.type = AssetTexture;
+			request.name = name;
+			request.path = *it;
+			request.image = NULL;
+			request.font = NULL;
+			request.sound = NULL;
+			request.success = false;
+			request.reload = true;
+
+			QueueAsync(request);
+
+			app->log << "AssetManager::ReloadFiles() " << name << " en cola" << std::endl;
+		}
+
+		std::map<std::string, ra::ConfigReader*>::iterator config = m_configs.find(name);
+		if (config != m_configs.end())
+		{
+			// Si el archivo no se puede leer se conserva la configuración anterior
+			ra::MemoryScope scope(ra::MemoryConfig);
+			ra::ConfigReader reader;
+			if (reader.LoadFromFile(*it))
+			{
+				// Los KeyHandle de la configuración anterior dejan de valer,
+				// quien los guarde lo sabe por GetConfigReloads()
+				*config->second = reader;
+				m_configReloads[name]++;
+				app->log << "AssetManager::ReloadFiles() " << name << " recargado" << std::endl;
+			}
+			else
+			{
+				app->log << "[error] AssetManager::ReloadFiles() " << name << " no se ha podido recargar" << std::endl;
+			}
+		}
+
+		std::map<std::string, ra::AnimationClip*>::iterator animation = m_animations.find(name);
+		if (animation != m_animations.end())
+		{
+			// Se sustituye el contenido del clip para que los Animator que lo
+			// reproducen vean los nuevos frames
+			ra::MemoryScope scope(ra::MemoryAssets);
+			ra::AnimationClip clip;
+			if (clip.LoadFromFile(*it))
+			{
+				*animation->second = clip;
+				app->log << "AssetManager::ReloadFiles() " << name << " recargado" << std::endl;
+			}
+			else
+			{
+				app->log << "[error] AssetManager::ReloadFiles() " << name << " no se ha podido recargar" << std::endl;
+			}
+		}
+	}
+}
+
+void AssetManager::QueueAsync(const AsyncLoad& theRequest)
+{
+	sf::Lock lock(m_asyncMutex);
+	m_asyncRequests.push_back(theRequest);
+
+	// Lanzamos el hilo de carga si no está en marcha
+	if (!m_asyncRunning)
+	{
+		m_asyncRunning = true;
+		m_asyncLoader.launch();
+	}
+}
+
+void AssetManager::WatchFile(const std::string& theName)
+{
+	ra::FileWatcher::Instance()->Watch(m_masterDir + theName);
+}
+
+void AssetManager::UnwatchFile(const std::string& theName)
+{
+	ra::FileWatcher::Instance()->Unwatch(m_masterDir + theName);
+}
+
+void AssetManager::AsyncLoop()
+{
+	while (true)
+	{
+		AsyncLoad request;
+		{
+			sf::Lock lock(m_asyncMutex);
+			if (m_asyncRequests.empty())
+			{
+				// Sin peticiones el hilo termina, LoadAsync() lo relanza
+				m_asyncRunning = false;
+				return;
+			}
+			request = m_asyncRequests.front();
+			m_asyncRequests.pop_front();
+		}
+
+		// La lectura y decodificación se hace fuera del bloqueo. Desde este
+		// hilo no se escribe en el log
+		switch (request.type)
+		{
+		case AssetTexture:
+			{
+				ra::MemoryScope scope(ra::MemoryAssets);
+				request.image = new sf::Image();
+				request.success = request.image->loadFromFile(request.path);
+			}
+			break;
+		case AssetFont:
+			{
+				ra::MemoryScope scope(ra::MemoryText);
+				request.font = new sf::Font();
+				request.success = request.font->loadFromFile(request.path);
+			}
+			break;
+		case AssetSoundBuffer:
+			{
+				ra::MemoryScope scope(ra::MemoryAudio);
+				request.sound = new sf::SoundBuffer();
+				request.success = request.sound->loadFromFile(request.path);
+			}
+			break;
+		case AssetConfig:
+		case AssetAnimation:
+			break;
+		}
+
+		sf::Lock lock(m_asyncMutex);
+		m_asyncResults.push_back(request);
+	}
 }
 
 void AssetManager::Cleanup()
 {
+	// Esperamos al hilo de carga y descartamos lo que haya quedado en cola
+	{
+		sf::Lock lock(m_asyncMutex);
+		m_asyncRequests.clear();
+	}
+	m_asyncLoader.wait();
+
+	std::deque<AsyncLoad>::iterator asyncIt;
+	for (asyncIt = m_asyncResults.begin(); asyncIt != m_asyncResults.end(); asyncIt++)
+	{
+		delete asyncIt->image;
+		delete asyncIt->font;
+		delete asyncIt->sound;
+	}
+	m_asyncResults.clear();
+	m_asyncPending.clear();
+
 	std::map<std::string, sf::Texture*>::const_iterator textIt;
 	for (textIt = m_textures.begin(); textIt != m_textures.end(); textIt++)
 	{
+		ra::MemoryTracker::RemoveResident(ra::MemoryAssets, GetTextureBytes(textIt->second));
 		delete textIt->second;
 		app->log << "AssetManager::Cleanup() Eliminado archivo " << textIt->first << std::endl;
 	}
@@ -556,6 +1006,15 @@ void AssetManager::Cleanup()
 		app->log << "AssetManager::Cleanup() Eliminado archivo " << conIt->first << std::endl;
 	}
 	m_configs.clear();
+	m_configReloads.clear();
+
+	std::map<std::string, ra::AnimationClip*>::const_iterator aniIt;
+	for (aniIt = m_animations.begin(); aniIt != m_animations.end(); aniIt++)
+	{
+		delete aniIt->second;
+		app->log << "AssetManager::Cleanup() Eliminado archivo " << aniIt->first << std::endl;
+	}
+	m_animations.clear();
 }
 
 } // namespace ra
\ No newline at end of file
@@ -1,5 +1,34 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <RAGE/Core/SceneGraph.hpp>
+#include <RAGE/Core/TileGrid.hpp>
 #include <RAGE/Core/Camera.hpp>
 
+namespace
+{
+	/**
+	 * Acerca theCurrent a theGoal con un muelle críticamente amortiguado,
+	 * sin pasarse y con el mismo resultado para cualquier theElapsed
+	 */
+	float SmoothDamp(float theCurrent, float theGoal, float& theVelocity, float theSmoothTime, float theElapsed)
+	{
+		float omega = 2.0f / theSmoothTime;
+		float x = omega * theElapsed;
+		float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+		float change = theCurrent - theGoal;
+		float temp = (theVelocity + omega * change) * theElapsed;
+		theVelocity = (theVelocity - omega * temp) * decay;
+		return theGoal + (change + temp) * decay;
+	}
+
+	/// Número aleatorio entre -1 y 1
+	float RandomUnit()
+	{
+		return 2.0f * static_cast<float>(std::rand()) / RAND_MAX - 1.0f;
+	}
+}
+
 namespace ra
 {
 
@@ -25,8 +54,25 @@ void Camera::Release()
 
 Camera::Camera()
 	: m_app(ra::App::Instance())
+	, m_graph(0)
 	, m_conectToGraph(false)
+	, m_locked(false)
+	, m_bounds()
+	, m_deadZone(0.0f, 0.0f)
+	, m_smoothTime(0.0f)
+	, m_goal(0.0f, 0.0f)
+	, m_velocity(0.0f, 0.0f)
+	, m_baseSize(0.0f, 0.0f)
+	, m_zoom(1.0f)
+	, m_zoomGoal(1.0f)
+	, m_zoomVelocity(0.0f)
+	, m_shakeIntensity(0.0f)
+	, m_shakeDuration(0.0f)
+	, m_shakeTime(0.0f)
+	, m_shakeOffset(0.0f, 0.0f)
+	, m_rect()
 {
+	SetDefaultCamera();
 }
 
 Camera::~Camera()
@@ -35,12 +81,83 @@ Camera::~Camera()
 
 void Camera::Update()
 {
+	float elapsed = m_app->GetUpdateTime().asSeconds();
+
+	// Partimos del centro sin la sacudida del frame anterior, así se
+	// conservan los move() y setCenter() hechos desde la escena
+	sf::Vector2f center = this->getCenter() - m_shakeOffset;
+
+	// Zoom
+	if (m_zoom != m_zoomGoal)
+	{
+		if (m_smoothTime > 0.0f && elapsed > 0.0f)
+		{
+			m_zoom = SmoothDamp(m_zoom, m_zoomGoal, m_zoomVelocity, m_smoothTime, elapsed);
+			if (std::fabs(m_zoom - m_zoomGoal) < 0.001f)
+			{
+				m_zoom = m_zoomGoal;
+			}
+		}
+		else
+		{
+			m_zoom = m_zoomGoal;
+		}
+		this->setSize(m_baseSize / m_zoom);
+	}
+
+	// Seguimiento: el destino solo se mueve cuando el objeto sale de la zona
+	// muerta, y lo justo para que vuelva a su borde
+	if (m_conectToGraph && m_graph != 0)
+	{
+		sf::FloatRect bounds = m_graph->getGlobalBounds();
+		sf::Vector2f target(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+		sf::Vector2f half = m_deadZone / (2.0f * m_zoom);
+
+		if (target.x > m_goal.x + half.x)
+			m_goal.x = target.x - half.x;
+		else if (target.x < m_goal.x - half.x)
+			m_goal.x = target.x + half.x;
+
+		if (target.y > m_goal.y + half.y)
+			m_goal.y = target.y - half.y;
+		else if (target.y < m_goal.y - half.y)
+			m_goal.y = target.y + half.y;
+
+		m_goal = Clamp(m_goal);
+
+		if (m_smoothTime > 0.0f && elapsed > 0.0f)
+		{
+			center.x = SmoothDamp(center.x, m_goal.x, m_velocity.x, m_smoothTime, elapsed);
+			center.y = SmoothDamp(center.y, m_goal.y, m_velocity.y, m_smoothTime, elapsed);
+		}
+		else
+		{
+			center = m_goal;
+		}
+	}
+
+	center = Clamp(center);
+
+	// Sacudida, que se apaga con el cuadrado del tiempo restante
+	m_shakeOffset = sf::Vector2f(0.0f, 0.0f);
+	if (m_shakeTime > 0.0f)
+	{
+		m_shakeTime = std::max(m_shakeTime - elapsed, 0.0f);
+		float ratio = m_shakeTime / m_shakeDuration;
+		float amplitude = m_shakeIntensity * ratio * ratio;
+		m_shakeOffset = sf::Vector2f(RandomUnit() * amplitude, RandomUnit() * amplitude);
+	}
+
+	this->setCenter(center + m_shakeOffset);
+	UpdateRect();
 }
 
 void Camera::ConnectToGraph(ra::SceneGraph& theGraph)
 {
 	m_graph = &theGraph;
 	m_conectToGraph = true;
+	m_goal = this->getCenter() - m_shakeOffset;
+	m_velocity = sf::Vector2f(0.0f, 0.0f);
 }
 
 void Camera::DisconnectToSprite()
@@ -49,30 +166,129 @@ void Camera::DisconnectToSprite()
 	m_graph = 0;
 }
 
-/*void Camera::LockToMap(GGE::Map& theMap)
+void Camera::SetDeadZone(const sf::Vector2f& theSize)
 {
-	mMap = &theMap;
-	mConectToMap = true;
-}*/
+	m_deadZone = theSize;
+}
+
+void Camera::SetSmoothTime(sf::Time theTime)
+{
+	m_smoothTime = std::max(theTime.asSeconds(), 0.0f);
+}
+
+void Camera::LockToBounds(const sf::FloatRect& theBounds)
+{
+	m_bounds = theBounds;
+	m_locked = true;
+}
+
+void Camera::LockToMap(const ra::TileGrid& theMap)
+{
+	LockToBounds(theMap.GetBounds());
+}
+
+void Camera::Unlock()
+{
+	m_locked = false;
+}
+
+void Camera::SetZoom(float theZoom)
+{
+	if (theZoom <= 0.0f)
+	{
+		m_app->log << "[warn] Camera::SetZoom() zoom no válido " << theZoom << std::endl;
+		return;
+	}
+	m_zoomGoal = theZoom;
+}
+
+float Camera::GetZoom() const
+{
+	return m_zoom;
+}
+
+void Camera::Shake(float theIntensity, sf::Time theDuration)
+{
+	if (theDuration <= sf::Time::Zero)
+	{
+		return;
+	}
+	m_shakeIntensity = theIntensity;
+	m_shakeDuration = theDuration.asSeconds();
+	m_shakeTime = m_shakeDuration;
+}
+
+void Camera::SetViewport(const sf::FloatRect& theViewport)
+{
+	this->setViewport(theViewport);
+
+	m_baseSize.x = m_app->window.getSize().x * theViewport.width;
+	m_baseSize.y = m_app->window.getSize().y * theViewport.height;
+	this->setSize(m_baseSize / m_zoom);
+	this->setCenter(Clamp(this->getCenter()));
+	UpdateRect();
+}
 
 void Camera::SetDefaultCamera()
 {
 	this->reset(sf::FloatRect(
-				0, 
-				0, 
-				static_cast<float>(m_app->window.getSize().x), 
+				0,
+				0,
+				static_cast<float>(m_app->window.getSize().x),
 				static_cast<float>(m_app->window.getSize().y)));
+	this->setViewport(sf::FloatRect(0.0f, 0.0f, 1.0f, 1.0f));
 	this->DisconnectToSprite();
+
+	m_baseSize = this->getSize();
+	m_zoom = 1.0f;
+	m_zoomGoal = 1.0f;
+	m_zoomVelocity = 0.0f;
+	m_velocity = sf::Vector2f(0.0f, 0.0f);
+	m_shakeTime = 0.0f;
+	m_shakeOffset = sf::Vector2f(0.0f, 0.0f);
+	m_locked = false;
+	UpdateRect();
+}
+
+sf::Vector2f Camera::GetDefaultCenter() const
+{
+	return m_baseSize / 2.0f;
 }
 
 sf::FloatRect Camera::GetRect() const
 {
-	sf::FloatRect rect;
-	rect.left = this->getCenter().x - this->getSize().x / 2.0f;
-	rect.top = this->getCenter().y - this->getSize().y / 2.0f;
-	rect.width = this->getSize().x;
-	rect.height = this->getSize().y;
-	return rect;
+	return m_rect;
+}
+
+sf::Vector2f Camera::Clamp(const sf::Vector2f& theCenter) const
+{
+	if (!m_locked)
+	{
+		return theCenter;
+	}
+
+	// Si el mapa es más pequeño que la vista la centramos en él
+	sf::Vector2f half = this->getSize() / 2.0f;
+	sf::Vector2f center = theCenter;
+	if (m_bounds.width <= 2.0f * half.x)
+		center.x = m_bounds.left + m_bounds.width / 2.0f;
+	else
+		center.x = std::min(std::max(center.x, m_bounds.left + half.x), m_bounds.left + m_bounds.width - half.x);
+
+	if (m_bounds.height <= 2.0f * half.y)
+		center.y = m_bounds.top + m_bounds.height / 2.0f;
+	else
+		center.y = std::min(std::max(center.y, m_bounds.top + half.y), m_bounds.top + m_bounds.height - half.y);
+
+	return center;
+}
+
+void Camera::UpdateRect()
+{
+	m_rect.left = this->getCenter().x - this->getSize().x / 2.0f;
+	m_rect.top = this->getCenter().y - this->getSize().y / 2.0f;
+	m_rect.width = this->getSize().x;
+	m_rect.height = this->getSize().y;
 }
 
 } // Namespace GGE
\ No newline at end of file
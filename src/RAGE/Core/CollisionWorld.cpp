@@ -0,0 +1,463 @@
+#include <algorithm>
+#include <cmath>
+#include <RAGE/Core/SceneGraph.hpp>
+#include <RAGE/Core/CollisionWorld.hpp>
+
+namespace ra
+{
+
+bool CollisionWorld::Proxy::operator<(const Proxy& theRight) const
+{
+	return minX < theRight.minX;
+}
+
+bool CollisionWorld::Pair::operator<(const Pair& theRight) const
+{
+	return (first != theRight.first) ? first < theRight.first : second < theRight.second;
+}
+
+bool CollisionWorld::Pair::operator==(const Pair& theRight) const
+{
+	return first == theRight.first && second == theRight.second;
+}
+
+CollisionWorld::CollisionWorld()
+	: m_bodies()
+	, m_free()
+	, m_proxies()
+	, m_sortedCount(0)
+	, m_merged()
+	, m_maxWidth(0.f)
+	, m_pairs()
+	, m_previousPairs()
+	, m_contacts()
+	, m_removed()
+	, m_size(0)
+	, m_dirty(false)
+{
+}
+
+CollisionHandle CollisionWorld::AddBody(ra::SceneGraph& theGraph, Uint32 theLayer, Uint32 theMask)
+{
+	return CreateBody(&theGraph, theGraph.getGlobalBounds(), theLayer, theMask);
+}
+
+CollisionHandle CollisionWorld::AddBody(const sf::FloatRect& theBounds, Uint32 theLayer, Uint32 theMask)
+{
+	return CreateBody(NULL, theBounds, theLayer, theMask);
+}
+
+void CollisionWorld::RemoveBody(const CollisionHandle& theBody)
+{
+	Body* body = Find(theBody);
+	if (body == NULL)
+	{
+		return;
+	}
+
+	body->active = false;
+	body->graph = NULL;
+	// La generación 0 queda para los handles nulos
+	body->generation = (body->generation == 0xFFFFFFFF) ? 1 : body->generation + 1;
+	m_free.push_back(theBody.index);
+	m_size--;
+
+	// El proxy y los pares se descartan en el siguiente Update()
+	m_proxies[body->proxy].body = NO_BODY;
+	m_removed.push_back(theBody.index);
+	m_dirty = true;
+}
+
+void CollisionWorld::SetBounds(const CollisionHandle& theBody, const sf::FloatRect& theBounds)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->bounds = theBounds;
+		Refresh(m_proxies[body->proxy]);
+		m_dirty = true;
+	}
+}
+
+void CollisionWorld::SetFilter(const CollisionHandle& theBody, Uint32 theLayer, Uint32 theMask)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->layer = theLayer;
+		body->mask = theMask;
+		Refresh(m_proxies[body->proxy]);
+	}
+}
+
+ra::SceneGraph* CollisionWorld::GetGraph(const CollisionHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body ? body->graph : NULL;
+}
+
+bool CollisionWorld::IsValid(const CollisionHandle& theBody) const
+{
+	return Find(theBody) != NULL;
+}
+
+void CollisionWorld::Update()
+{
+	// Descartamos los proxies eliminados sin cambiar el orden del resto
+	size_t count = 0;
+	size_t sorted = 0;
+	m_maxWidth = 0.f;
+	for (size_t i = 0; i < m_proxies.size(); i++)
+	{
+		if (m_proxies[i].body != NO_BODY)
+		{
+			sorted += (i < m_sortedCount) ? 1 : 0;
+			m_proxies[count] = m_proxies[i];
+			Refresh(m_proxies[count]);
+			m_maxWidth = std::max(m_maxWidth, m_proxies[count].maxX - m_proxies[count].minX);
+			count++;
+		}
+	}
+	m_proxies.resize(count);
+
+	// Ordenación por inserción de los que ya estaban: casi lineal si el
+	// orden apenas cambia
+	for (size_t i = 1; i < sorted; i++)
+	{
+		if (m_proxies[i - 1].minX <= m_proxies[i].minX)
+		{
+			continue;
+		}
+		Proxy proxy = m_proxies[i];
+		size_t j = i;
+		while (j > 0 && m_proxies[j - 1].minX > proxy.minX)
+		{
+			m_proxies[j] = m_proxies[j - 1];
+			j--;
+		}
+		m_proxies[j] = proxy;
+	}
+
+	// Los nuevos pueden ir en cualquier sitio: se ordenan aparte y se mezclan
+	// en lugar de desplazarlos uno a uno
+	if (sorted < count)
+	{
+		std::sort(m_proxies.begin() + sorted, m_proxies.end());
+		m_merged.resize(count);
+		std::merge(m_proxies.begin(), m_proxies.begin() + sorted, m_proxies.begin() + sorted, m_proxies.end(),
+			m_merged.begin());
+		m_proxies.swap(m_merged);
+	}
+	m_sortedCount = count;
+	for (size_t i = 0; i < count; i++)
+	{
+		m_bodies[m_proxies[i].body].proxy = static_cast<Uint32>(i);
+	}
+	m_dirty = false;
+
+	// Si una posición eliminada se reutiliza, sus pares no deben parecer
+	// antiguos
+	m_previousPairs.swap(m_pairs);
+	if (!m_removed.empty())
+	{
+		std::sort(m_removed.begin(), m_removed.end());
+		size_t kept = 0;
+		for (size_t i = 0; i < m_previousPairs.size(); i++)
+		{
+			const Pair& pair = m_previousPairs[i];
+			if (!std::binary_search(m_removed.begin(), m_removed.end(), pair.first) &&
+				!std::binary_search(m_removed.begin(), m_removed.end(), pair.second))
+			{
+				m_previousPairs[kept++] = pair;
+			}
+		}
+		m_previousPairs.resize(kept);
+		m_removed.clear();
+	}
+
+	// Barrido: cada cuerpo solo se compara con los que empiezan antes de
+	// que él termine en el eje X
+	m_pairs.clear();
+	for (size_t i = 0; i < count; i++)
+	{
+		const Proxy& a = m_proxies[i];
+		for (size_t j = i + 1; j < count && m_proxies[j].minX < a.maxX; j++)
+		{
+			const Proxy& b = m_proxies[j];
+			// Casi todos los candidatos fallan en Y: evaluamos las cuatro
+			// condiciones juntas para que solo quede un salto predecible
+			const bool overlap = (b.minY < a.maxY) & (a.minY < b.maxY) &
+				((a.layer & b.mask) != 0) & ((b.layer & a.mask) != 0);
+			if (!overlap)
+			{
+				continue;
+			}
+
+			Pair pair;
+			pair.first = std::min(a.body, b.body);
+			pair.second = std::max(a.body, b.body);
+			m_pairs.push_back(pair);
+		}
+	}
+	std::sort(m_pairs.begin(), m_pairs.end());
+
+	BuildContacts();
+}
+
+const std::vector<Contact>& CollisionWorld::GetContacts() const
+{
+	return m_contacts;
+}
+
+bool CollisionWorld::RayCast(const sf::Vector2f& theFrom, const sf::Vector2f& theTo, RayHit& theHit,
+	Uint32 theMask) const
+{
+	const sf::Vector2f delta = theTo - theFrom;
+	const float left = std::min(theFrom.x, theTo.x);
+	const float right = std::max(theFrom.x, theTo.x);
+	bool found = false;
+	float best = 1.f;
+
+	for (size_t i = FirstProxy(left); i < m_proxies.size(); i++)
+	{
+		const Proxy& proxy = m_proxies[i];
+		if (proxy.minX > right)
+		{
+			// Con el array ordenado ningún proxy posterior puede cortarlo
+			if (!m_dirty)
+			{
+				break;
+			}
+			continue;
+		}
+		if (proxy.body == NO_BODY || proxy.maxX < left || (proxy.layer & theMask) == 0)
+		{
+			continue;
+		}
+
+		// Intersección del segmento con las dos franjas del rectángulo
+		float enter = 0.f;
+		float leave = best;
+		sf::Vector2f normal(0.f, 0.f);
+		const float origin[2] = { theFrom.x, theFrom.y };
+		const float direction[2] = { delta.x, delta.y };
+		const float minimum[2] = { proxy.minX, proxy.minY };
+		const float maximum[2] = { proxy.maxX, proxy.maxY };
+		bool miss = false;
+		for (int axis = 0; axis < 2 && !miss; axis++)
+		{
+			if (std::fabs(direction[axis]) < 1e-12f)
+			{
+				miss = origin[axis] < minimum[axis] || origin[axis] > maximum[axis];
+				continue;
+			}
+
+			float inverse = 1.f / direction[axis];
+			float first = (minimum[axis] - origin[axis]) * inverse;
+			float last = (maximum[axis] - origin[axis]) * inverse;
+			float side = -1.f;
+			if (first > last)
+			{
+				std::swap(first, last);
+				side = 1.f;
+			}
+			if (first > enter)
+			{
+				enter = first;
+				normal = (axis == 0) ? sf::Vector2f(side, 0.f) : sf::Vector2f(0.f, side);
+			}
+			leave = std::min(leave, last);
+			miss = enter > leave;
+		}
+
+		if (!miss && (!found || enter < best))
+		{
+			found = true;
+			best = enter;
+			theHit.body = GetHandle(proxy.body);
+			theHit.point = theFrom + delta * enter;
+			theHit.normal = normal;
+			theHit.fraction = enter;
+		}
+	}
+
+	return found;
+}
+
+size_t CollisionWorld::QueryRect(const sf::FloatRect& theRect, std::vector<CollisionHandle>& theBodies,
+	Uint32 theMask) const
+{
+	const float right = theRect.left + theRect.width;
+	const float bottom = theRect.top + theRect.height;
+	size_t count = 0;
+
+	for (size_t i = FirstProxy(theRect.left); i < m_proxies.size(); i++)
+	{
+		const Proxy& proxy = m_proxies[i];
+		if (proxy.minX >= right)
+		{
+			// Con el array ordenado ningún proxy posterior puede solaparse
+			if (!m_dirty)
+			{
+				break;
+			}
+			continue;
+		}
+		if (proxy.body == NO_BODY || proxy.maxX <= theRect.left || proxy.minY >= bottom || proxy.maxY <= theRect.top)
+		{
+			continue;
+		}
+		if ((proxy.layer & theMask) == 0)
+		{
+			continue;
+		}
+		theBodies.push_back(GetHandle(proxy.body));
+		count++;
+	}
+
+	return count;
+}
+
+void CollisionWorld::Clear()
+{
+	for (size_t i = 0; i < m_bodies.size(); i++)
+	{
+		if (m_bodies[i].active)
+		{
+			RemoveBody(GetHandle(static_cast<Uint32>(i)));
+		}
+	}
+	m_proxies.clear();
+	m_sortedCount = 0;
+	m_pairs.clear();
+	m_previousPairs.clear();
+	m_contacts.clear();
+	m_removed.clear();
+	m_dirty = false;
+}
+
+size_t CollisionWorld::GetSize() const
+{
+	return m_size;
+}
+
+CollisionHandle CollisionWorld::CreateBody(ra::SceneGraph* theGraph, const sf::FloatRect& theBounds,
+	Uint32 theLayer, Uint32 theMask)
+{
+	Uint32 index;
+	if (m_free.empty())
+	{
+		index = static_cast<Uint32>(m_bodies.size());
+		m_bodies.push_back(Body());
+		m_bodies.back().generation = 1;
+	}
+	else
+	{
+		index = m_free.back();
+		m_free.pop_back();
+	}
+
+	Body& body = m_bodies[index];
+	body.graph = theGraph;
+	body.bounds = theBounds;
+	body.layer = theLayer;
+	body.mask = theMask;
+	body.proxy = static_cast<Uint32>(m_proxies.size());
+	body.active = true;
+	m_size++;
+
+	// El siguiente Update() lo coloca en su sitio
+	Proxy proxy;
+	proxy.body = index;
+	Refresh(proxy);
+	m_proxies.push_back(proxy);
+	m_dirty = true;
+
+	return CollisionHandle(index, body.generation);
+}
+
+CollisionWorld::Body* CollisionWorld::Find(const CollisionHandle& theBody)
+{
+	if (theBody.index >= m_bodies.size())
+	{
+		return NULL;
+	}
+	Body& body = m_bodies[theBody.index];
+	return (body.active && body.generation == theBody.generation) ? &body : NULL;
+}
+
+const CollisionWorld::Body* CollisionWorld::Find(const CollisionHandle& theBody) const
+{
+	if (theBody.index >= m_bodies.size())
+	{
+		return NULL;
+	}
+	const Body& body = m_bodies[theBody.index];
+	return (body.active && body.generation == theBody.generation) ? &body : NULL;
+}
+
+CollisionHandle CollisionWorld::GetHandle(Uint32 theIndex) const
+{
+	return CollisionHandle(theIndex, m_bodies[theIndex].generation);
+}
+
+size_t CollisionWorld::FirstProxy(float theLeft) const
+{
+	if (m_dirty)
+	{
+		return 0;
+	}
+
+	// Ningún proxy que empiece antes de theLeft - m_maxWidth llega a theLeft
+	Proxy bound;
+	bound.minX = theLeft - m_maxWidth;
+	return std::lower_bound(m_proxies.begin(), m_proxies.end(), bound) - m_proxies.begin();
+}
+
+void CollisionWorld::Refresh(Proxy& theProxy) const
+{
+	const Body& body = m_bodies[theProxy.body];
+	sf::FloatRect bounds = body.graph ? body.graph->getGlobalBounds() : body.bounds;
+	theProxy.minX = bounds.left;
+	theProxy.maxX = bounds.left + bounds.width;
+	theProxy.minY = bounds.top;
+	theProxy.maxY = bounds.top + bounds.height;
+	theProxy.layer = body.layer;
+	theProxy.mask = body.mask;
+}
+
+void CollisionWorld::BuildContacts()
+{
+	// Mezcla de las dos listas ordenadas de pares
+	m_contacts.clear();
+	size_t previous = 0;
+	size_t current = 0;
+	while (previous < m_previousPairs.size() || current < m_pairs.size())
+	{
+		Contact contact;
+		const Pair* pair;
+		if (current == m_pairs.size() ||
+			(previous < m_previousPairs.size() && m_previousPairs[previous] < m_pairs[current]))
+		{
+			pair = &m_previousPairs[previous++];
+			contact.state = ContactEnd;
+		}
+		else if (previous == m_previousPairs.size() || m_pairs[current] < m_previousPairs[previous])
+		{
+			pair = &m_pairs[current++];
+			contact.state = ContactBegin;
+		}
+		else
+		{
+			pair = &m_pairs[current++];
+			previous++;
+			contact.state = ContactStay;
+		}
+
+		contact.first = GetHandle(pair->first);
+		contact.second = GetHandle(pair->second);
+		m_contacts.push_back(contact);
+	}
+}
+
+} // namespace ra
\ No newline at end of file
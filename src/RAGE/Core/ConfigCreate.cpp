@@ -1,4 +1,5 @@
 #include <RAGE/Core/ConfigCreate.hpp>
+#include <RAGE/Core/ConfigReader.hpp>
 
 namespace ra
 {
@@ -11,59 +12,92 @@ ConfigCreate::~ConfigCreate()
 {
 }
 
-void ConfigCreate::Open(const std::string& filename)
+void ConfigCreate::Open(const std::string& filename, bool binary)
 {
-	file.open(filename);
-	file.clear();
+	if (binary)
+	{
+		// El formato binario se genera de una vez al cerrar
+		binaryFile = filename;
+		text.str("");
+		text.clear();
+	}
+	else
+	{
+		binaryFile.clear();
+		file.open(filename);
+		file.clear();
+	}
 }
 
 void ConfigCreate::Close()
 {
-	file.close();
+	if (!binaryFile.empty())
+	{
+		// Reutilizamos el parser de texto para construir las tablas
+		std::string content = text.str();
+		ConfigReader reader;
+		reader.LoadFromMemory(content.c_str(), content.size());
+		reader.SaveToBinary(binaryFile);
+		binaryFile.clear();
+		text.str("");
+	}
+	else
+	{
+		file.close();
+	}
 }
 
 void ConfigCreate::PutSection(const std::string& section)
 {
-	file << "[" << section << "]" << std::endl;
+	Out() << "[" << section << "]" << std::endl;
 }
 
 void ConfigCreate::PutValue(const std::string& key, const std::string& value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 
 void ConfigCreate::PutValue(const std::string& key, bool value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 void ConfigCreate::PutValue(const std::string& key, float value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 
 void ConfigCreate::PutValue(const std::string& key, int value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 
 void ConfigCreate::PutValue(const std::string& key, unsigned int value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 
 void ConfigCreate::PutValue(const std::string& key, long value)
 {
-	file << key << "=" << value << std::endl;
+	Out() << key << "=" << value << std::endl;
 }
 
 void ConfigCreate::PutComment(const std::string& comment)
 {
-	file << "# " << comment << std::endl;
+	Out() << "# " << comment << std::endl;
 }
 
 void ConfigCreate::PutBlankLine()
 {
-	file << std::endl;
+	Out() << std::endl;
+}
+
+std::ostream& ConfigCreate::Out()
+{
+	if (!binaryFile.empty())
+	{
+		return text;
+	}
+	return file;
 }
 
 } // namespace ra
\ No newline at end of file
@@ -1,12 +1,43 @@
+#include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <map>
+#include <algorithm>
 #include <RAGE/Core/ConfigReader.hpp>
 #include <RAGE/Core/StringUtil.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
 #include <RAGE/Core/App.hpp>
 
 namespace ra
 {
 
+  const char ConfigReader::BINARY_MAGIC[4] = { 'R', 'C', 'F', 'G' };
+
+  /// Compares two strings ignoring the case of ASCII letters
+  static bool IsEqualNoCase(const char* theLeft, const char* theRight)
+  {
+    while(*theLeft != '\0' && tolower(static_cast<unsigned char>(*theLeft)) ==
+        tolower(static_cast<unsigned char>(*theRight)))
+    {
+      theLeft++;
+      theRight++;
+    }
+    return tolower(static_cast<unsigned char>(*theLeft)) ==
+      tolower(static_cast<unsigned char>(*theRight));
+  }
+
+  bool ConfigReader::EntryLess::operator()(const Entry& theLeft,
+      const Entry& theRight) const
+  {
+    return theLeft.hash < theRight.hash;
+  }
+
+  bool ConfigReader::EntryLess::operator()(const Entry& theLeft,
+      const Uint32 theHash) const
+  {
+    return theLeft.hash < theHash;
+  }
+
   ConfigReader::ConfigReader()
   {
 	  app = ra::App::Instance();
@@ -14,6 +45,9 @@ namespace ra
   }
 
   ConfigReader::ConfigReader(const ConfigReader& theCopy) :
+    app(theCopy.app),
+    mBuffer(theCopy.mBuffer),
+    mEntries(theCopy.mEntries),
     mSections(theCopy.mSections)
   {
   }
@@ -21,31 +55,34 @@ namespace ra
   ConfigReader::~ConfigReader()
   {
     app->log << "ConfigReader::dtor()" << std::endl;
-
-    // Delete all section name, value maps
-    std::map<const std::string, typeNameValue*>::iterator iter;
-    iter = mSections.begin();
-    while(iter != mSections.end())
-    {
-      typeNameValue* anMap = iter->second;
-      mSections.erase(iter++);
-      delete anMap;
-    }
   }
 
-  bool ConfigReader::IsSectionEmpty(const std::string theSection) const
+  bool ConfigReader::IsSectionEmpty(const char* theSection) const
   {
     bool anResult = false;
 
     // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    std::vector<Uint32>::const_iterator iter;
+    for(iter = mSections.begin(); iter != mSections.end(); ++iter)
+    {
+      if(strcmp(&mBuffer[*iter], theSection) == 0)
+      {
+        anResult = true;
+        break;
+      }
+    }
+
+    // Now make sure it has no name, value pairs
+    if(anResult)
     {
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      std::vector<Entry>::const_iterator iterEntry;
+      for(iterEntry = mEntries.begin(); iterEntry != mEntries.end(); ++iterEntry)
       {
-        anResult = anMap->empty();
+        if(strcmp(&mBuffer[iterEntry->section], theSection) == 0)
+        {
+          anResult = false;
+          break;
+        }
       }
     }
 
@@ -53,157 +90,257 @@ namespace ra
     return anResult;
   }
 
-  bool ConfigReader::GetBool(const std::string theSection,
-      const std::string theName, const bool theDefault) const
+  bool ConfigReader::IsSectionEmpty(const std::string& theSection) const
   {
-    bool anResult = theDefault;
+    return IsSectionEmpty(theSection.c_str());
+  }
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+  ConfigReader::KeyHandle ConfigReader::FindKey(const char* theSection,
+      const char* theName) const
+  {
+    KeyHandle anResult = INVALID_KEY;
+    Uint32 anHash = Hash(theSection, theName);
+
+    // Find the first entry with the same hash and compare the strings of
+    // every entry that shares it
+    std::vector<Entry>::const_iterator iter;
+    iter = std::lower_bound(mEntries.begin(), mEntries.end(), anHash, EntryLess());
+    while(iter != mEntries.end() && iter->hash == anHash)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      if(strcmp(&mBuffer[iter->name], theName) == 0 &&
+          strcmp(&mBuffer[iter->section], theSection) == 0)
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = ParseBool(iterNameValue->second, theDefault);
-        }
+        anResult = static_cast<KeyHandle>(iter - mEntries.begin());
+        break;
       }
+      ++iter;
+    }
+
+    // Return the handle found or INVALID_KEY assigned above
+    return anResult;
+  }
+
+  ConfigReader::KeyHandle ConfigReader::FindKey(const std::string& theSection,
+      const std::string& theName) const
+  {
+    return FindKey(theSection.c_str(), theName.c_str());
+  }
+
+  bool ConfigReader::GetBool(const char* theSection,
+      const char* theName, const bool theDefault) const
+  {
+    return GetBool(FindKey(theSection, theName), theDefault);
+  }
+
+  bool ConfigReader::GetBool(const std::string& theSection,
+      const std::string& theName, const bool theDefault) const
+  {
+    return GetBool(FindKey(theSection.c_str(), theName.c_str()), theDefault);
+  }
+
+  bool ConfigReader::GetBool(const KeyHandle theKey, const bool theDefault) const
+  {
+    bool anResult = theDefault;
+
+    // Use the value parsed at load time if it was a valid boolean
+    const Entry* anEntry = GetEntry(theKey);
+    if(NULL != anEntry && (anEntry->flags & FLAG_BOOL))
+    {
+      anResult = (anEntry->flags & FLAG_BOOL_TRUE) != 0;
     }
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  float ConfigReader::GetFloat(const std::string theSection,
-      const std::string theName, const float theDefault) const
+  float ConfigReader::GetFloat(const char* theSection,
+      const char* theName, const float theDefault) const
+  {
+    return GetFloat(FindKey(theSection, theName), theDefault);
+  }
+
+  float ConfigReader::GetFloat(const std::string& theSection,
+      const std::string& theName, const float theDefault) const
+  {
+    return GetFloat(FindKey(theSection.c_str(), theName.c_str()), theDefault);
+  }
+
+  float ConfigReader::GetFloat(const KeyHandle theKey, const float theDefault) const
   {
     float anResult = theDefault;
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    // Use the value parsed at load time if it was a valid number
+    const Entry* anEntry = GetEntry(theKey);
+    if(NULL != anEntry && (anEntry->flags & FLAG_FLOAT))
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
-      {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = ParseFloat(iterNameValue->second, theDefault);
-        }
-      }
+      anResult = anEntry->floatValue;
     }
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  std::string ConfigReader::GetString(const std::string theSection,
-      const std::string theName, const std::string theDefault) const
+  std::string ConfigReader::GetString(const char* theSection,
+      const char* theName, const char* theDefault) const
   {
-    std::string anResult = theDefault;
+    const char* anValue = GetValue(FindKey(theSection, theName));
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    // Return the value found or theDefault if not found
+    return std::string(NULL != anValue ? anValue : theDefault);
+  }
+
+  std::string ConfigReader::GetString(const std::string& theSection,
+      const std::string& theName, const std::string& theDefault) const
+  {
+    const char* anValue = GetValue(FindKey(theSection.c_str(), theName.c_str()));
+
+    // Return the value found or theDefault if not found
+    return NULL != anValue ? std::string(anValue) : theDefault;
+  }
+
+  const char* ConfigReader::GetValue(const KeyHandle theKey) const
+  {
+    const char* anResult = NULL;
+
+    const Entry* anEntry = GetEntry(theKey);
+    if(NULL != anEntry)
+    {
+      anResult = &mBuffer[anEntry->value];
+    }
+
+    // Return the value found or NULL if theKey is not valid
+    return anResult;
+  }
+
+  bool ConfigReader::GetNames(const std::string& theSection,
+      std::vector<std::string>& theNames) const
+  {
+    bool anResult = false;
+
+    // Collect every name found in theSection
+    std::vector<std::string> anNames;
+    std::vector<Entry>::const_iterator iter;
+    for(iter = mEntries.begin(); iter != mEntries.end(); ++iter)
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
+      if(theSection == &mBuffer[iter->section])
       {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = iterNameValue->second;
-        }
+        anNames.push_back(&mBuffer[iter->name]);
+        anResult = true;
       }
     }
 
-    // Return the result found or theDefault assigned above
+    // The table is sorted by hash, return the names in alphabetical order
+    std::sort(anNames.begin(), anNames.end());
+    theNames.insert(theNames.end(), anNames.begin(), anNames.end());
+
+    // Return true if theSection was found
     return anResult;
   }
 
-  Uint32 ConfigReader::GetUint32(const std::string theSection,
-      const std::string theName, const Uint32 theDefault) const
+  Uint32 ConfigReader::GetUint32(const char* theSection,
+      const char* theName, const Uint32 theDefault) const
+  {
+    return GetUint32(FindKey(theSection, theName), theDefault);
+  }
+
+  Uint32 ConfigReader::GetUint32(const std::string& theSection,
+      const std::string& theName, const Uint32 theDefault) const
+  {
+    return GetUint32(FindKey(theSection.c_str(), theName.c_str()), theDefault);
+  }
+
+  Uint32 ConfigReader::GetUint32(const KeyHandle theKey, const Uint32 theDefault) const
   {
     Uint32 anResult = theDefault;
 
-    // Check if theSection really exists
-    std::map<const std::string, typeNameValue*>::const_iterator iter;
-    iter = mSections.find(theSection);
-    if(iter != mSections.end())
+    // Use the value parsed at load time if it was a valid number
+    const Entry* anEntry = GetEntry(theKey);
+    if(NULL != anEntry && (anEntry->flags & FLAG_UINT32))
     {
-      // Try to obtain the name, value pair
-      typeNameValue* anMap = iter->second;
-      if(NULL != anMap)
-      {
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue != anMap->end())
-        {
-          anResult = ParseUint32(iterNameValue->second, theDefault);
-        }
-      }
+      anResult = anEntry->uint32Value;
     }
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-bool ConfigReader::LoadFromFile(const std::string theFilename)
+bool ConfigReader::LoadFromFile(const std::string& theFilename)
 {
 	bool anResult = false;
-	char anLine[MAX_CHARS];
-	std::string anSection;
-	unsigned long anCount = 1;
 
 	// Let the log know about the file we are about to read in
 	app->log << "ConfigReader:Read(" << theFilename << ") opening..." << std::endl;
 
+	// Whatever we read belongs to the Config subsystem
+	MemoryScope anScope(MemoryConfig);
+
+	// Forget any previous configuration read
+	mBuffer.clear();
+	mEntries.clear();
+	mSections.clear();
+
 	// Attempt to open the file
-	FILE* anFile = fopen(theFilename.c_str(), "r");
+	FILE* anFile = fopen(theFilename.c_str(), "rb");
 
 	// Read from the file if successful
 	if(NULL != anFile)
 	{
-		// Keep reading from configuration file until we reach the end of file marker
-		while(!feof(anFile))
+		fseek(anFile, 0, SEEK_END);
+		long anSize = ftell(anFile);
+		fseek(anFile, 0, SEEK_SET);
+
+		// Binary files start with a header describing the tables that follow
+		BinaryHeader anHeader;
+		if(anSize >= static_cast<long>(sizeof(anHeader)) &&
+			fread(&anHeader, sizeof(anHeader), 1, anFile) == 1 &&
+			memcmp(anHeader.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)
 		{
-			// Get the first line from the file
-			if(fgets(anLine, MAX_CHARS, anFile) == NULL)
+			anResult = ReadBinary(anFile, anHeader, static_cast<size_t>(anSize));
+			if(anResult)
 			{
-				// Log the failure to read a line from the file if not at the end of the file
-				if(!feof(anFile))
-				{
-					app->log << "[error] ConfigReader::Read(" << anFile << ") error reading line " << anCount << std::endl;
-				}
-				// Exit our while loop, were done!
-				break;
+				app->log << "ConfigReader::Read(" << theFilename << ") " << mEntries.size()
+					<< " name, value pairs in " << mSections.size() << " sections (binary)" << std::endl;
 			}
 			else
 			{
-				// Parse the line
-				anSection = ParseLine(anLine, anCount, anSection);
+				app->log << "[error] ConfigReader::Read(" << theFilename << ") invalid binary file" << std::endl;
 			}
 
-			// Increment our Line counter
-			anCount++;
+			fclose(anFile);
+			return anResult;
+		}
+		fseek(anFile, 0, SEEK_SET);
+
+		// Read the whole file at once, the strings will be parsed in place
+		if(anSize > 0)
+		{
+			// Leave room for the null terminator and the empty section name
+			mBuffer.resize(static_cast<size_t>(anSize) + 2);
+			size_t anRead = fread(&mBuffer[1], 1, static_cast<size_t>(anSize), anFile);
+			mBuffer.resize(anRead + 2);
+		}
+		else
+		{
+			mBuffer.resize(2);
+		}
+		mBuffer[0] = '\0';
+		mBuffer[mBuffer.size() - 1] = '\0';
+
+		if(ferror(anFile))
+		{
+			app->log << "[error] ConfigReader::Read(" << theFilename << ") error reading file" << std::endl;
 		}
 
 		// Don't forget to close the file
 		fclose(anFile);
 
+		// Parse every line and sort the name, value pairs found
+		ParseBuffer();
+		SortEntries();
+
+		app->log << "ConfigReader::Read(" << theFilename << ") " << mEntries.size()
+			<< " name, value pairs in " << mSections.size() << " sections" << std::endl;
+
 		// Set success result
 		anResult = true;
 	}
@@ -216,210 +353,488 @@ bool ConfigReader::LoadFromFile(const std::string theFilename)
 	return anResult;
 }
 
+  bool ConfigReader::LoadFromMemory(const char* theData, const size_t theSize)
+  {
+    bool anResult = true;
+
+    // Whatever we read belongs to the Config subsystem
+    MemoryScope anScope(MemoryConfig);
+
+    // Forget any previous configuration read
+    mBuffer.clear();
+    mEntries.clear();
+    mSections.clear();
+
+    BinaryHeader anHeader;
+    if(theSize >= sizeof(anHeader) &&
+        memcmp(theData, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)
+    {
+      // Copy the tables that follow the header as they are
+      memcpy(&anHeader, theData, sizeof(anHeader));
+      anResult = IsBinaryHeader(anHeader, theSize);
+      if(anResult)
+      {
+        const char* anData = theData + sizeof(anHeader);
+        mEntries.resize(anHeader.entries);
+        mSections.resize(anHeader.sections);
+        mBuffer.resize(anHeader.buffer);
+        if(!mEntries.empty())
+        {
+          memcpy(&mEntries[0], anData, mEntries.size() * sizeof(Entry));
+          anData += mEntries.size() * sizeof(Entry);
+        }
+        if(!mSections.empty())
+        {
+          memcpy(&mSections[0], anData, mSections.size() * sizeof(Uint32));
+          anData += mSections.size() * sizeof(Uint32);
+        }
+        memcpy(&mBuffer[0], anData, mBuffer.size());
+        anResult = ValidateBinary();
+      }
+
+      if(!anResult)
+      {
+        mBuffer.clear();
+        mEntries.clear();
+        mSections.clear();
+        app->log << "[error] ConfigReader::LoadFromMemory() invalid binary data" << std::endl;
+      }
+    }
+    else
+    {
+      // Leave room for the null terminator and the empty section name
+      mBuffer.resize(theSize + 2);
+      if(theSize > 0)
+      {
+        memcpy(&mBuffer[1], theData, theSize);
+      }
+      mBuffer[0] = '\0';
+      mBuffer[mBuffer.size() - 1] = '\0';
+
+      // Parse every line and sort the name, value pairs found
+      ParseBuffer();
+      SortEntries();
+    }
+
+    // Return anResult of true if successful, false otherwise
+    return anResult;
+  }
+
+  bool ConfigReader::SaveToBinary(const std::string& theFilename) const
+  {
+    bool anResult = false;
+
+    // Copy only the strings in use into a compact buffer, sharing repeated
+    // strings. Offset 0 keeps holding the empty section name
+    std::vector<char> anBuffer(1, '\0');
+    std::map<std::string, Uint32> anOffsets;
+    anOffsets[std::string()] = 0;
+
+    std::vector<Entry> anEntries(mEntries);
+    std::vector<Uint32> anSections(mSections);
+    for(size_t i = 0; i < anEntries.size() + anSections.size(); i++)
+    {
+      Uint32* anFields[3];
+      size_t anCount = 0;
+      if(i < anEntries.size())
+      {
+        anFields[anCount++] = &anEntries[i].section;
+        anFields[anCount++] = &anEntries[i].name;
+        anFields[anCount++] = &anEntries[i].value;
+      }
+      else
+      {
+        anFields[anCount++] = &anSections[i - anEntries.size()];
+      }
+
+      for(size_t j = 0; j < anCount; j++)
+      {
+        std::string anString(&mBuffer[*anFields[j]]);
+        std::map<std::string, Uint32>::iterator iter = anOffsets.find(anString);
+        if(iter == anOffsets.end())
+        {
+          iter = anOffsets.insert(std::make_pair(anString,
+            static_cast<Uint32>(anBuffer.size()))).first;
+          anBuffer.insert(anBuffer.end(), anString.c_str(), anString.c_str() + anString.size() + 1);
+        }
+        *anFields[j] = iter->second;
+      }
+    }
+
+    BinaryHeader anHeader;
+    memcpy(anHeader.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    anHeader.version = BINARY_VERSION;
+    anHeader.entries = static_cast<Uint32>(anEntries.size());
+    anHeader.sections = static_cast<Uint32>(anSections.size());
+    anHeader.buffer = static_cast<Uint32>(anBuffer.size());
+
+    FILE* anFile = fopen(theFilename.c_str(), "wb");
+    if(NULL != anFile)
+    {
+      anResult = fwrite(&anHeader, sizeof(anHeader), 1, anFile) == 1;
+      if(anResult && !anEntries.empty())
+      {
+        anResult = fwrite(&anEntries[0], sizeof(Entry), anEntries.size(), anFile) == anEntries.size();
+      }
+      if(anResult && !anSections.empty())
+      {
+        anResult = fwrite(&anSections[0], sizeof(Uint32), anSections.size(), anFile) == anSections.size();
+      }
+      if(anResult)
+      {
+        anResult = fwrite(&anBuffer[0], 1, anBuffer.size(), anFile) == anBuffer.size();
+      }
+      fclose(anFile);
+    }
+
+    if(anResult)
+    {
+      app->log << "ConfigReader::SaveToBinary(" << theFilename << ") " << anEntries.size()
+        << " name, value pairs in " << anSections.size() << " sections" << std::endl;
+    }
+    else
+    {
+      app->log << "[error] ConfigReader::SaveToBinary(" << theFilename << ") error writing file" << std::endl;
+    }
+
+    // Return anResult of true if successful, false otherwise
+    return anResult;
+  }
+
   ConfigReader& ConfigReader::operator=(const ConfigReader& theRight)
   {
     // Use copy constructor to duplicate theRight side
     ConfigReader temp(theRight);
 
     // Now swap my local copy with the copy from theRight
+    std::swap(mBuffer, temp.mBuffer);
+    std::swap(mEntries, temp.mEntries);
     std::swap(mSections, temp.mSections);
 
     // Return my pointer
     return *this;
   }
 
-  std::string ConfigReader::ParseLine(const char* theLine,
-      const unsigned long theCount, const std::string theSection)
+  void ConfigReader::ParseBuffer()
   {
-    std::string anResult = theSection;
-    size_t anLength = strlen(theLine);
-    if(anLength > 1)
+    // Offset 0 holds the empty section name used before the first section
+    Uint32 anSection = 0;
+    unsigned long anCount = 1;
+    char* anBuffer = &mBuffer[0];
+    size_t anLength = mBuffer.size() - 1;
+    size_t anOffset = 1;
+
+    while(anOffset < anLength)
     {
+      // Find the end of the current line and terminate it
+      size_t anEnd = anOffset;
+      while(anEnd < anLength && anBuffer[anEnd] != '\n')
+      {
+        anEnd++;
+      }
+      anBuffer[anEnd] = '\0';
+      if(anEnd > anOffset && anBuffer[anEnd-1] == '\r')
+      {
+        anBuffer[anEnd-1] = '\0';
+      }
+
       // Skip preceeding spaces at the begining of the line
-      size_t anOffset = 0;
-      while(anOffset < anLength && theLine[anOffset] == ' ')
+      size_t anStart = anOffset;
+      while(anBuffer[anStart] == ' ' || anBuffer[anStart] == '\t')
       {
-        anOffset++;
+        anStart++;
       }
 
-      // Now check for comments
-      if(theLine[anOffset] != '#' && theLine[anOffset] != ';')
+      // Skip empty lines and comments
+      if(anBuffer[anStart] != '\0' && anBuffer[anStart] != '#' && anBuffer[anStart] != ';')
       {
         // Next check for the start of a new section
-        if(theLine[anOffset] == '[')
+        if(anBuffer[anStart] == '[')
         {
-          // Skip over the begin section marker '['
-          anOffset++;
-
-          // Skip preceeding spaces of section name
-          while(anOffset < anLength && theLine[anOffset] == ' ')
+          // Skip over the begin section marker '[' and preceeding spaces
+          anStart++;
+          while(anBuffer[anStart] == ' ' || anBuffer[anStart] == '\t')
           {
-            anOffset++;
+            anStart++;
           }
 
-          // Retrieve the section name while looking for the section end marker ']'
-          size_t anIndex = 0;
-          char anSection[MAX_CHARS] = {0};
-          while((anOffset+anIndex) < anLength && theLine[anOffset+anIndex] != ']')
+          // Look for the section end marker ']'
+          size_t anIndex = anStart;
+          while(anBuffer[anIndex] != '\0' && anBuffer[anIndex] != ']')
           {
-            // Retrieve the section name from theLine
-            anSection[anIndex] = theLine[anOffset+anIndex];
-
-            // Increment anIndex
             anIndex++;
           }
-          // Add null terminator
-          anSection[anIndex] = '\0';
-          // Remove trailing spaces
-          while(anIndex > 0 && anSection[anIndex-1] == ' ')
-          {
-            // Put a null terminator at the end of the section name
-            anSection[--anIndex] = '\0';
-          }
 
-          // Only update the current section name if we found the section end
-          // marker before the end of the line
-          if((anOffset+anIndex) < anLength && anIndex > 0)
+          if(anBuffer[anIndex] == ']' && anIndex > anStart)
           {
-            // Change the return string to the newly parsed section name
-            anResult = anSection;
+            // Remove trailing spaces and terminate the section name in place
+            anBuffer[anIndex] = '\0';
+            while(anIndex > anStart && (anBuffer[anIndex-1] == ' ' || anBuffer[anIndex-1] == '\t'))
+            {
+              anBuffer[--anIndex] = '\0';
+            }
+
+            // Change the current section to the newly parsed section name
+            anSection = static_cast<Uint32>(anStart);
+            mSections.push_back(anSection);
           }
           else
           {
-           app->log << "[error] ConfigReader::ParseLine(" << theCount << ") missing section end marker ']'" << std::endl;
+           app->log << "[error] ConfigReader::ParseLine(" << anCount << ") missing section end marker ']'" << std::endl;
           }
         }
         // Just read the name=value pair into the current section
         else
         {
-          // Retrieve the name and value while looking for the comment flags ';' or '#'
-          size_t anNameIndex = 0;
-          char anName[MAX_CHARS];
-
           // First retrieve the name while looking for either the '=' or ':' delimiter
-          while((anOffset+anNameIndex) < anLength &&
-              theLine[(anOffset+anNameIndex)] != '=' &&
-              theLine[(anOffset+anNameIndex)] != ':')
+          size_t anIndex = anStart;
+          while(anBuffer[anIndex] != '\0' && anBuffer[anIndex] != '=' && anBuffer[anIndex] != ':')
           {
-            // Retrieve anName from theLine
-            anName[anNameIndex] = theLine[anOffset+anNameIndex];
-
-            // Increment anNameIndex
-            anNameIndex++;
+            anIndex++;
           }
-          // Assign our starting offset value
-          anOffset += anNameIndex;
-          // Put a null terminator at the end of the name
-          anName[anNameIndex] = '\0';
+
           // Remove trailing spaces from the name
-          while(anNameIndex > 0 && anName[anNameIndex-1] == ' ')
+          size_t anNameEnd = anIndex;
+          while(anNameEnd > anStart && (anBuffer[anNameEnd-1] == ' ' || anBuffer[anNameEnd-1] == '\t'))
           {
-            // Put a null terminator at the end of the name
-            anName[--anNameIndex] = '\0';
+            anNameEnd--;
           }
 
           // Only search for the value if we found the '=' or ':' delimiter
-          if(anOffset < anLength && anNameIndex > 0)
+          if(anBuffer[anIndex] != '\0' && anNameEnd > anStart)
           {
-            size_t anValueIndex = 0;
-            char anValue[MAX_CHARS];
-
-            // Skip over the delimiter between name and value '=' or ':'
-            anOffset++;
+            // Terminate the name in place and skip over the delimiter
+            anBuffer[anNameEnd] = '\0';
+            anIndex++;
 
             // Skip preceeding spaces
-            while(anOffset < anLength && theLine[anOffset] == ' ')
+            while(anBuffer[anIndex] == ' ' || anBuffer[anIndex] == '\t')
             {
-              anOffset++;
+              anIndex++;
             }
+
             // Next retrieve the value while looking for comments flags ';' or '#'
-            while((anOffset + anValueIndex) < anLength &&
-                theLine[(anOffset+anValueIndex)] != '\r' &&
-                theLine[(anOffset+anValueIndex)] != '\n' &&
-                theLine[(anOffset+anValueIndex)] != ';' &&
-                theLine[(anOffset+anValueIndex)] != '#')
+            size_t anValueEnd = anIndex;
+            while(anBuffer[anValueEnd] != '\0' && anBuffer[anValueEnd] != ';' && anBuffer[anValueEnd] != '#')
             {
-              // Retrieve anValue from theLine
-              anValue[anValueIndex] = theLine[anOffset+anValueIndex];
-
-              // Increment anValueIndex
-              anValueIndex++;
+              anValueEnd++;
             }
-            // Put a null terminator at the end of the section name
-            anValue[anValueIndex] = '\0';
-            // Remove trailing spaces from the name
-            while(anValueIndex > 0 && anValue[anValueIndex-1] == ' ')
+
+            // Remove trailing spaces and terminate the value in place
+            while(anValueEnd > anIndex && (anBuffer[anValueEnd-1] == ' ' || anBuffer[anValueEnd-1] == '\t'))
             {
-              // Put a null terminator at the end of the name
-              anValue[--anValueIndex] = '\0';
+              anValueEnd--;
             }
+            anBuffer[anValueEnd] = '\0';
 
             // Store the name,value pair obtained into the current section
-            StoreNameValue(theSection,anName,anValue);
+            StoreNameValue(anSection, static_cast<Uint32>(anStart), static_cast<Uint32>(anIndex));
           }
           else
           {
-           app->log << "[error] ConfigReader::ParseLine(" << theCount << ") missing name or value delimiter of '=' or ':'" << std::endl;
+           app->log << "[error] ConfigReader::ParseLine(" << anCount << ") missing name or value delimiter of '=' or ':'" << std::endl;
           }
         }
-      } // if(theLine[anOffset] != '#' && theLine[anOffset] != ';') // Not a comment
-    } // if(anLength > 1)
+      } // if not empty or a comment
 
-    // Return either the previous section name or the new section name found
-    return anResult;
+      // Move to the next line
+      anOffset = anEnd + 1;
+      anCount++;
+    }
   }
 
-  void ConfigReader::StoreNameValue(const std::string theSection,
-      const std::string theName, const std::string theValue)
+  void ConfigReader::StoreNameValue(const Uint32 theSection,
+      const Uint32 theName, const Uint32 theValue)
   {
-    // Check if the name, value map already exists for theSection
-    std::map<const std::string, typeNameValue*>::iterator iterSection;
-    iterSection = mSections.find(theSection);
-    if(iterSection == mSections.end())
+    const char* anValue = &mBuffer[theValue];
+
+    Entry anEntry;
+    anEntry.hash = Hash(&mBuffer[theSection], &mBuffer[theName]);
+    anEntry.section = theSection;
+    anEntry.name = theName;
+    anEntry.value = theValue;
+    anEntry.uint32Value = 0;
+    anEntry.floatValue = 0.f;
+    anEntry.flags = 0;
+
+    // Parse the boolean value (0,1,true,false,on,off)
+    if(strcmp(anValue, "1") == 0 || IsEqualNoCase(anValue, "true") || IsEqualNoCase(anValue, "on"))
+    {
+      anEntry.flags |= FLAG_BOOL | FLAG_BOOL_TRUE;
+    }
+    else if(strcmp(anValue, "0") == 0 || IsEqualNoCase(anValue, "false") || IsEqualNoCase(anValue, "off"))
     {
-      // First try to create a new name, value pair map for this new section
-      typeNameValue* anMap = new(std::nothrow) typeNameValue;
+      anEntry.flags |= FLAG_BOOL;
+    }
 
-      // Make sure we were able to create the map ok
-      if(NULL != anMap)
-      {
-        app->log << "ConfigReader::StoreNameValue(" << theSection << ") adding (" << theName << "," << theValue << ")" << std::endl;
+    // Parse the floating point value without depending on the locale
+    const char* anLast = anValue + strlen(anValue);
+    if(ParseFloat(anValue, anLast, anEntry.floatValue) != anValue)
+    {
+      anEntry.flags |= FLAG_FLOAT;
+    }
 
-        // Add the new name, value pair to this map
-        anMap->insert(std::pair<const std::string, const std::string>(theName,theValue));
+    // Parse the unsigned 32 bit value
+    if(ParseUint32(anValue, anLast, anEntry.uint32Value) != anValue)
+    {
+      anEntry.flags |= FLAG_UINT32;
+    }
+
+    mEntries.push_back(anEntry);
+  }
+
+  bool ConfigReader::ReadBinary(FILE* theFile, const BinaryHeader& theHeader,
+      const size_t theSize)
+  {
+    // Make sure the tables described fill the file before allocating them
+    if(!IsBinaryHeader(theHeader, theSize))
+    {
+      return false;
+    }
+
+    // Read every table straight into place
+    bool anResult = true;
+    mEntries.resize(theHeader.entries);
+    mSections.resize(theHeader.sections);
+    mBuffer.resize(theHeader.buffer);
+    if(!mEntries.empty())
+    {
+      anResult = fread(&mEntries[0], sizeof(Entry), mEntries.size(), theFile) == mEntries.size();
+    }
+    if(anResult && !mSections.empty())
+    {
+      anResult = fread(&mSections[0], sizeof(Uint32), mSections.size(), theFile) == mSections.size();
+    }
+    if(anResult)
+    {
+      anResult = fread(&mBuffer[0], 1, mBuffer.size(), theFile) == mBuffer.size();
+    }
+
+    // Never keep tables that could point outside the buffer
+    if(!anResult || !ValidateBinary())
+    {
+      mBuffer.clear();
+      mEntries.clear();
+      mSections.clear();
+      anResult = false;
+    }
+
+    return anResult;
+  }
+
+  bool ConfigReader::ValidateBinary() const
+  {
+    // The buffer must start with the empty section name and end terminated
+    const Uint32 anSize = static_cast<Uint32>(mBuffer.size());
+    if(anSize == 0 || mBuffer[0] != '\0' || mBuffer[anSize - 1] != '\0')
+    {
+      return false;
+    }
 
-        // Add the new name, value pair map for this new section
-        mSections.insert(std::pair<const std::string, typeNameValue*>(theSection, anMap));
+    for(size_t i = 0; i < mEntries.size(); i++)
+    {
+      const Entry& anEntry = mEntries[i];
+      if(anEntry.section >= anSize || anEntry.name >= anSize || anEntry.value >= anSize)
+      {
+        return false;
       }
-      else
+      if(i > 0 && mEntries[i - 1].hash > anEntry.hash)
       {
-       app->log << "[error] ConfigReader::StoreNameValue(" << theSection << ") unable to add (" << theName << "," << theValue << ") out of memory!" << std::endl;
+        return false;
       }
     }
-    else
+
+    for(size_t i = 0; i < mSections.size(); i++)
+    {
+      if(mSections[i] >= anSize)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool ConfigReader::IsBinaryHeader(const BinaryHeader& theHeader, const size_t theSize)
+  {
+    if(memcmp(theHeader.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 ||
+        theHeader.version != BINARY_VERSION)
     {
-      // Retrieve the existing name, value pair map
-      typeNameValue* anMap = iterSection->second;
+      return false;
+    }
+
+    // Compute in 64 bits so a corrupt header can not overflow the total
+    const Uint64 anExpected = sizeof(BinaryHeader) +
+      static_cast<Uint64>(theHeader.entries) * sizeof(Entry) +
+      static_cast<Uint64>(theHeader.sections) * sizeof(Uint32) +
+      static_cast<Uint64>(theHeader.buffer);
+    return anExpected == static_cast<Uint64>(theSize);
+  }
 
-      // Make sure we were able to retrieve the map ok
-      if(NULL != anMap)
+  void ConfigReader::SortEntries()
+  {
+    // Keep the file order between entries with the same hash so the first
+    // duplicate found wins
+    std::stable_sort(mEntries.begin(), mEntries.end(), EntryLess());
+
+    // Remove duplicate name, value pairs
+    std::vector<Entry>::iterator anWrite = mEntries.begin();
+    std::vector<Entry>::iterator iter;
+    for(iter = mEntries.begin(); iter != mEntries.end(); ++iter)
+    {
+      bool anDuplicate = false;
+      std::vector<Entry>::iterator iterPrevious = anWrite;
+      while(iterPrevious != mEntries.begin())
       {
-        // Make sure the name, value pair doesn't already in the map
-        typeNameValueIter iterNameValue;
-        iterNameValue = anMap->find(theName);
-        if(iterNameValue == anMap->end())
+        --iterPrevious;
+        if(iterPrevious->hash != iter->hash)
         {
-          app->log << "ConfigReader::StoreNameValue(" << theSection << ") adding (" << theName << "," << theValue << ")" << std::endl;
-
-          // Add the new name, value pair to this map
-          anMap->insert(std::pair<const std::string, const std::string>(theName,theValue));
+          break;
         }
-        else
+        if(strcmp(&mBuffer[iterPrevious->name], &mBuffer[iter->name]) == 0 &&
+            strcmp(&mBuffer[iterPrevious->section], &mBuffer[iter->section]) == 0)
         {
-         app->log << "[warn] ConfigReader::StoreNameValue(" << theSection << ") unable to add (" << theName << "," << theValue << ") already exists!" << std::endl;
+          anDuplicate = true;
+          break;
         }
       }
-    } // else(iterSection == mSections.end())
+
+      if(anDuplicate)
+      {
+        app->log << "[warn] ConfigReader::StoreNameValue(" << &mBuffer[iter->section] << ") unable to add ("
+          << &mBuffer[iter->name] << "," << &mBuffer[iter->value] << ") already exists!" << std::endl;
+      }
+      else
+      {
+        *anWrite++ = *iter;
+      }
+    }
+    mEntries.erase(anWrite, mEntries.end());
+  }
+
+  Uint32 ConfigReader::Hash(const char* theSection, const char* theName)
+  {
+    // FNV-1a of the section name, a separator and the name
+    Uint32 anHash = 2166136261u;
+    while(*theSection != '\0')
+    {
+      anHash = (anHash ^ static_cast<unsigned char>(*theSection++)) * 16777619u;
+    }
+    anHash = (anHash ^ 0xFF) * 16777619u;
+    while(*theName != '\0')
+    {
+      anHash = (anHash ^ static_cast<unsigned char>(*theName++)) * 16777619u;
+    }
+    return anHash;
+  }
+
+  const ConfigReader::Entry* ConfigReader::GetEntry(const KeyHandle theKey) const
+  {
+    if(theKey < mEntries.size())
+    {
+      return &mEntries[theKey];
+    }
+    return NULL;
   }
 
-} // namespace ra
\ No newline at end of file
+} // namespace ra
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/FileWatcher.hpp>
+
+#if defined(RAGE_SYSTEM_LINUX)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace fs = boost::filesystem;
+
+namespace ra
+{
+
+FileWatcher* FileWatcher::ms_instance = 0;
+
+FileWatcher::FileWatcher()
+	: m_app(ra::App::Instance())
+	, m_files()
+	, m_pending()
+	, m_changes()
+	, m_clock()
+	, m_mutex()
+	, m_thread(&FileWatcher::WatchLoop, this)
+	, m_enabled(false)
+#if defined(RAGE_SYSTEM_LINUX)
+	, m_inotify(-1)
+	, m_directories()
+#endif
+{
+	m_app->log << "FileWatcher::ctor()" << std::endl;
+}
+
+FileWatcher::~FileWatcher()
+{
+	SetEnabled(false);
+
+#if defined(RAGE_SYSTEM_LINUX)
+	if (m_inotify >= 0)
+	{
+		close(m_inotify);
+	}
+#endif
+
+	m_app->log << "FileWatcher::dtor()" << std::endl;
+}
+
+FileWatcher* FileWatcher::Instance()
+{
+	if(ms_instance == 0)
+	{
+		ms_instance = new FileWatcher();
+	}
+	return ms_instance;
+}
+
+void FileWatcher::Release()
+{
+	if(ms_instance)
+	{
+		delete ms_instance;
+	}
+	ms_instance = 0;
+}
+
+void FileWatcher::SetEnabled(bool theEnabled)
+{
+	if (theEnabled)
+	{
+		{
+			sf::Lock lock(m_mutex);
+			if (m_enabled)
+			{
+				return;
+			}
+			m_enabled = true;
+
+#if defined(RAGE_SYSTEM_LINUX)
+			// Vigilamos los directorios de los archivos ya registrados
+			if (m_inotify < 0)
+			{
+				m_inotify = inotify_init();
+				if (m_inotify < 0)
+				{
+					m_app->log << "[warn] FileWatcher::SetEnabled() inotify no disponible, se comprobarán las fechas de modificación" << std::endl;
+				}
+			}
+#endif
+		}
+
+		// Registramos los archivos con la vigilancia ya activa
+		std::vector<std::string> files;
+		{
+			sf::Lock lock(m_mutex);
+			std::map<std::string, std::time_t>::iterator it;
+			for (it = m_files.begin(); it != m_files.end(); it++)
+			{
+				files.push_back(it->first);
+			}
+		}
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			Watch(files[i]);
+		}
+
+		m_thread.launch();
+
+		m_app->log << "FileWatcher::SetEnabled() vigilancia activada" << std::endl;
+	}
+	else
+	{
+		{
+			sf::Lock lock(m_mutex);
+			if (!m_enabled)
+			{
+				return;
+			}
+			m_enabled = false;
+			m_pending.clear();
+		}
+
+		// El hilo termina en su siguiente comprobación
+		m_thread.wait();
+
+		m_app->log << "FileWatcher::SetEnabled() vigilancia desactivada" << std::endl;
+	}
+}
+
+bool FileWatcher::IsEnabled() const
+{
+	return m_enabled;
+}
+
+void FileWatcher::Watch(const std::string& theFilename)
+{
+	std::time_t writeTime = GetWriteTime(theFilename);
+
+	sf::Lock lock(m_mutex);
+	m_files[theFilename] = writeTime;
+
+#if defined(RAGE_SYSTEM_LINUX)
+	if (m_enabled && m_inotify >= 0)
+	{
+		// inotify vigila el directorio: los editores suelen guardar creando
+		// un archivo nuevo y renombrándolo sobre el original
+		std::string::size_type slash = theFilename.find_last_of('/');
+		std::string prefix = (slash == std::string::npos) ? "" : theFilename.substr(0, slash + 1);
+		std::string directory = prefix.empty() ? "." : prefix;
+
+		int watch = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (watch < 0)
+		{
+			m_app->log << "[warn] FileWatcher::Watch() no se puede vigilar " << directory << std::endl;
+			return;
+		}
+
+		std::vector<std::string>& prefixes = m_directories[watch];
+		if (std::find(prefixes.begin(), prefixes.end(), prefix) == prefixes.end())
+		{
+			prefixes.push_back(prefix);
+		}
+	}
+#endif
+}
+
+void FileWatcher::Unwatch(const std::string& theFilename)
+{
+	sf::Lock lock(m_mutex);
+	m_files.erase(theFilename);
+	m_pending.erase(theFilename);
+}
+
+void FileWatcher::Update()
+{
+	m_changes.clear();
+
+	{
+		sf::Lock lock(m_mutex);
+		if (m_pending.empty())
+		{
+			return;
+		}
+
+		// Solo entregamos los archivos que han dejado de cambiar
+		sf::Time now = m_clock.getElapsedTime();
+		std::map<std::string, sf::Time>::iterator it = m_pending.begin();
+		while (it != m_pending.end())
+		{
+			if (now - it->second >= sf::milliseconds(COALESCE_TIME))
+			{
+				m_changes.push_back(it->first);
+				m_pending.erase(it++);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+
+	std::vector<std::string>::iterator it;
+	for (it = m_changes.begin(); it != m_changes.end(); it++)
+	{
+		m_app->log << "FileWatcher::Update() " << *it << " modificado" << std::endl;
+	}
+}
+
+const std::vector<std::string>& FileWatcher::GetChanges() const
+{
+	return m_changes;
+}
+
+bool FileWatcher::HasChanged(const std::string& theFilename) const
+{
+	return std::find(m_changes.begin(), m_changes.end(), theFilename) != m_changes.end();
+}
+
+void FileWatcher::WatchLoop()
+{
+	// Desde este hilo no se escribe en el log
+	while (true)
+	{
+		{
+			sf::Lock lock(m_mutex);
+			if (!m_enabled)
+			{
+				return;
+			}
+		}
+
+#if defined(RAGE_SYSTEM_LINUX)
+		if (m_inotify >= 0)
+		{
+			pollfd descriptor;
+			descriptor.fd = m_inotify;
+			descriptor.events = POLLIN;
+			descriptor.revents = 0;
+			if (poll(&descriptor, 1, POLL_INTERVAL) <= 0 || !(descriptor.revents & POLLIN))
+			{
+				continue;
+			}
+
+			// La unión garantiza la alineación de los eventos
+			union
+			{
+				inotify_event event;
+				char data[4096];
+			} buffer;
+			ssize_t length = read(m_inotify, buffer.data, sizeof(buffer.data));
+
+			sf::Lock lock(m_mutex);
+			ssize_t offset = 0;
+			while (offset < length)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer.data + offset);
+				std::map<int, std::vector<std::string> >::const_iterator dir = m_directories.find(event->wd);
+				if (event->len > 0 && dir != m_directories.end())
+				{
+					for (size_t i = 0; i < dir->second.size(); i++)
+					{
+						std::string filename = dir->second[i] + event->name;
+						if (m_files.find(filename) != m_files.end())
+						{
+							NotifyChange(filename);
+						}
+					}
+				}
+				offset += sizeof(inotify_event) + event->len;
+			}
+			continue;
+		}
+#endif
+
+		PollFiles();
+		sf::sleep(sf::milliseconds(POLL_INTERVAL));
+	}
+}
+
+void FileWatcher::PollFiles()
+{
+	// Copiamos la lista para no bloquear mientras se accede al disco
+	std::map<std::string, std::time_t> files;
+	{
+		sf::Lock lock(m_mutex);
+		files = m_files;
+	}
+
+	std::map<std::string, std::time_t>::iterator it;
+	for (it = files.begin(); it != files.end(); it++)
+	{
+		std::time_t writeTime = GetWriteTime(it->first);
+		if (writeTime != 0 && writeTime != it->second)
+		{
+			sf::Lock lock(m_mutex);
+			std::map<std::string, std::time_t>::iterator file = m_files.find(it->first);
+			if (file != m_files.end())
+			{
+				file->second = writeTime;
+				NotifyChange(it->first);
+			}
+		}
+	}
+}
+
+void FileWatcher::NotifyChange(const std::string& theFilename)
+{
+	m_pending[theFilename] = m_clock.getElapsedTime();
+}
+
+std::time_t FileWatcher::GetWriteTime(const std::string& theFilename)
+{
+	boost::system::error_code error;
+	std::time_t writeTime = fs::last_write_time(theFilename, error);
+	if (error)
+	{
+		return 0;
+	}
+	return writeTime;
+}
+
+} // namespace ra
\ No newline at end of file
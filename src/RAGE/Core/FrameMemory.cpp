@@ -0,0 +1,101 @@
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/FrameMemory.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
+
+namespace ra
+{
+
+FrameMemory* FrameMemory::ms_instance = 0;
+
+FrameMemory::FrameMemory()
+	: m_app(ra::App::Instance())
+	, m_frameArena(DEFAULT_CAPACITY)
+	, m_bufferA(DEFAULT_CAPACITY)
+	, m_bufferB(DEFAULT_CAPACITY)
+	, m_current(&m_bufferA)
+	, m_previous(&m_bufferB)
+	, m_heapAllocations(GetHeapAllocations())
+	, m_frameHeapAllocations(0)
+{
+	m_app->log << "FrameMemory::ctor()" << std::endl;
+}
+
+FrameMemory::~FrameMemory()
+{
+	m_app->log << "FrameMemory::dtor() máximo por frame " << m_frameArena.GetPeak()
+		<< " bytes, doble búfer " << m_bufferA.GetPeak() << "/" << m_bufferB.GetPeak()
+		<< " bytes" << std::endl;
+}
+
+FrameMemory* FrameMemory::Instance()
+{
+	if(ms_instance == 0)
+	{
+		ms_instance = new FrameMemory();
+	}
+	return ms_instance;
+}
+
+void FrameMemory::Release()
+{
+	if(ms_instance)
+	{
+		delete ms_instance;
+	}
+	ms_instance = 0;
+}
+
+void* FrameMemory::Allocate(std::size_t theSize, std::size_t theAlignment)
+{
+	return m_frameArena.Allocate(theSize, theAlignment);
+}
+
+void* FrameMemory::AllocateDoubleBuffered(std::size_t theSize, std::size_t theAlignment)
+{
+	return m_current->Allocate(theSize, theAlignment);
+}
+
+LinearArena& FrameMemory::GetFrameArena()
+{
+	return m_frameArena;
+}
+
+LinearArena& FrameMemory::GetDoubleBufferedArena()
+{
+	return *m_current;
+}
+
+Uint32 FrameMemory::GetFrameHeapAllocations() const
+{
+	return m_frameHeapAllocations;
+}
+
+bool FrameMemory::IsTrackingAllocations()
+{
+	return MemoryTracker::IsTracking();
+}
+
+Uint32 FrameMemory::GetHeapAllocations()
+{
+	return MemoryTracker::GetTotalAllocations();
+}
+
+void FrameMemory::EndFrame()
+{
+	// Los bloques que crecen al vaciarse cuentan para el frame siguiente
+	Uint32 heapAllocations = GetHeapAllocations();
+	m_frameHeapAllocations = heapAllocations - m_heapAllocations;
+
+	m_frameArena.Reset();
+
+	// Lo escrito este frame sigue disponible el próximo, vaciamos lo de
+	// hace dos frames
+	LinearArena* written = m_current;
+	m_current = m_previous;
+	m_previous = written;
+	m_current->Reset();
+
+	m_heapAllocations = GetHeapAllocations();
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include <cctype>
+#include <algorithm>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/ConfigReader.hpp>
+#include <RAGE/Core/StringUtil.hpp>
+#include <RAGE/Core/Input.hpp>
+
+namespace ra
+{
+
+/// Nombres de las teclas en el orden de sf::Keyboard::Key
+static const char* gKeyNames[sf::Keyboard::KeyCount] = {
+	"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M",
+	"N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z",
+	"Num0", "Num1", "Num2", "Num3", "Num4", "Num5", "Num6", "Num7", "Num8", "Num9",
+	"Escape", "LControl", "LShift", "LAlt", "LSystem",
+	"RControl", "RShift", "RAlt", "RSystem", "Menu",
+	"LBracket", "RBracket", "SemiColon", "Comma", "Period", "Quote",
+	"Slash", "BackSlash", "Tilde", "Equal", "Dash",
+	"Space", "Return", "BackSpace", "Tab", "PageUp", "PageDown",
+	"End", "Home", "Insert", "Delete",
+	"Add", "Subtract", "Multiply", "Divide",
+	"Left", "Right", "Up", "Down",
+	"Numpad0", "Numpad1", "Numpad2", "Numpad3", "Numpad4",
+	"Numpad5", "Numpad6", "Numpad7", "Numpad8", "Numpad9",
+	"F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8",
+	"F9", "F10", "F11", "F12", "F13", "F14", "F15",
+	"Pause"
+};
+
+/// Nombres de los botones del ratón en el orden de sf::Mouse::Button
+static const char* gMouseButtonNames[sf::Mouse::ButtonCount] = {
+	"Left", "Right", "Middle", "XButton1", "XButton2"
+};
+
+Input* Input::ms_instance = 0;
+
+Input::Input()
+	: m_app(ra::App::Instance())
+	, m_events()
+	, m_current()
+	, m_previous()
+	, m_mousePosition(0, 0)
+	, m_mouseWheel(0)
+	, m_joystickConnected()
+	, m_actions()
+	, m_actionIDs()
+{
+	for (unsigned int i = 0; i < sf::Joystick::Count; i++)
+	{
+		for (unsigned int j = 0; j < sf::Joystick::AxisCount; j++)
+		{
+			m_joystickAxis[i][j] = 0.0f;
+		}
+	}
+
+	m_app->log << "Input::ctor()" << std::endl;
+}
+
+Input::~Input()
+{
+	m_app->log << "Input::dtor()" << std::endl;
+}
+
+Input* Input::Instance()
+{
+	if(ms_instance == 0)
+	{
+		ms_instance = new Input();
+	}
+	return ms_instance;
+}
+
+void Input::Release()
+{
+	if(ms_instance)
+	{
+		delete ms_instance;
+	}
+	ms_instance = 0;
+}
+
+const std::vector<sf::Event>& Input::GetEvents() const
+{
+	return m_events;
+}
+
+bool Input::IsKeyDown(sf::Keyboard::Key theKey) const
+{
+	if (theKey < 0 || theKey >= sf::Keyboard::KeyCount)
+		return false;
+
+	return m_current.keys[theKey];
+}
+
+bool Input::IsKeyPressed(sf::Keyboard::Key theKey) const
+{
+	if (theKey < 0 || theKey >= sf::Keyboard::KeyCount)
+		return false;
+
+	return m_current.keys[theKey] && !m_previous.keys[theKey];
+}
+
+bool Input::IsKeyReleased(sf::Keyboard::Key theKey) const
+{
+	if (theKey < 0 || theKey >= sf::Keyboard::KeyCount)
+		return false;
+
+	return !m_current.keys[theKey] && m_previous.keys[theKey];
+}
+
+bool Input::IsMouseButtonDown(sf::Mouse::Button theButton) const
+{
+	if (theButton < 0 || theButton >= sf::Mouse::ButtonCount)
+		return false;
+
+	return m_current.mouseButtons[theButton];
+}
+
+bool Input::IsMouseButtonPressed(sf::Mouse::Button theButton) const
+{
+	if (theButton < 0 || theButton >= sf::Mouse::ButtonCount)
+		return false;
+
+	return m_current.mouseButtons[theButton] && !m_previous.mouseButtons[theButton];
+}
+
+bool Input::IsMouseButtonReleased(sf::Mouse::Button theButton) const
+{
+	if (theButton < 0 || theButton >= sf::Mouse::ButtonCount)
+		return false;
+
+	return !m_current.mouseButtons[theButton] && m_previous.mouseButtons[theButton];
+}
+
+sf::Vector2i Input::GetMousePosition() const
+{
+	return m_mousePosition;
+}
+
+int Input::GetMouseWheelDelta() const
+{
+	return m_mouseWheel;
+}
+
+bool Input::IsJoystickConnected(unsigned int theJoystick) const
+{
+	if (theJoystick >= sf::Joystick::Count)
+		return false;
+
+	return m_joystickConnected[theJoystick];
+}
+
+bool Input::IsJoystickButtonDown(unsigned int theJoystick, unsigned int theButton) const
+{
+	if (theJoystick >= sf::Joystick::Count || theButton >= sf::Joystick::ButtonCount)
+		return false;
+
+	return m_current.joystickButtons[theJoystick * sf::Joystick::ButtonCount + theButton];
+}
+
+bool Input::IsJoystickButtonPressed(unsigned int theJoystick, unsigned int theButton) const
+{
+	if (theJoystick >= sf::Joystick::Count || theButton >= sf::Joystick::ButtonCount)
+		return false;
+
+	unsigned int index = theJoystick * sf::Joystick::ButtonCount + theButton;
+	return m_current.joystickButtons[index] && !m_previous.joystickButtons[index];
+}
+
+bool Input::IsJoystickButtonReleased(unsigned int theJoystick, unsigned int theButton) const
+{
+	if (theJoystick >= sf::Joystick::Count || theButton >= sf::Joystick::ButtonCount)
+		return false;
+
+	unsigned int index = theJoystick * sf::Joystick::ButtonCount + theButton;
+	return !m_current.joystickButtons[index] && m_previous.joystickButtons[index];
+}
+
+float Input::GetJoystickAxis(unsigned int theJoystick, sf::Joystick::Axis theAxis) const
+{
+	if (theJoystick >= sf::Joystick::Count || static_cast<unsigned int>(theAxis) >= sf::Joystick::AxisCount)
+		return 0.0f;
+
+	return m_joystickAxis[theJoystick][theAxis];
+}
+
+ActionID Input::MapKey(const std::string& theAction, sf::Keyboard::Key theKey)
+{
+	if (theKey < 0 || theKey >= sf::Keyboard::KeyCount)
+	{
+		m_app->log << "[warn] Input::MapKey() tecla no válida " << theKey << " para " << theAction << std::endl;
+		return INVALID_ACTION;
+	}
+
+	ActionID id = AddAction(theAction);
+
+	Binding binding;
+	binding.type = BindKey;
+	binding.code = theKey;
+	binding.joystick = 0;
+	m_actions[id].bindings.push_back(binding);
+
+	return id;
+}
+
+ActionID Input::MapMouseButton(const std::string& theAction, sf::Mouse::Button theButton)
+{
+	if (theButton < 0 || theButton >= sf::Mouse::ButtonCount)
+	{
+		m_app->log << "[warn] Input::MapMouseButton() botón no válido " << theButton << " para "
+			<< theAction << std::endl;
+		return INVALID_ACTION;
+	}
+
+	ActionID id = AddAction(theAction);
+
+	Binding binding;
+	binding.type = BindMouseButton;
+	binding.code = theButton;
+	binding.joystick = 0;
+	m_actions[id].bindings.push_back(binding);
+
+	return id;
+}
+
+ActionID Input::MapJoystickButton(const std::string& theAction, unsigned int theJoystick, unsigned int theButton)
+{
+	if (theJoystick >= sf::Joystick::Count || theButton >= sf::Joystick::ButtonCount)
+	{
+		m_app->log << "[warn] Input::MapJoystickButton() joystick " << theJoystick << " o botón " << theButton
+			<< " no válido para " << theAction << std::endl;
+		return INVALID_ACTION;
+	}
+
+	ActionID id = AddAction(theAction);
+
+	Binding binding;
+	binding.type = BindJoystickButton;
+	binding.code = theButton;
+	binding.joystick = theJoystick;
+	m_actions[id].bindings.push_back(binding);
+
+	return id;
+}
+
+bool Input::LoadActions(const std::string& theFilename)
+{
+	ra::ConfigReader config;
+	if (!config.LoadFromFile(theFilename))
+	{
+		m_app->log << "[error] Input::LoadActions() no se ha podido leer " << theFilename << std::endl;
+		return false;
+	}
+
+	std::vector<std::string> names;
+	if (!config.GetNames("actions", names))
+	{
+		m_app->log << "[warn] Input::LoadActions() " << theFilename << " no tiene sección [actions]" << std::endl;
+		return true;
+	}
+
+	std::vector<std::string>::iterator it;
+	for (it = names.begin(); it != names.end(); it++)
+	{
+		ActionID id = AddAction(*it);
+		std::string bindings = config.GetString("actions", *it);
+
+		// Recorremos la lista de entradas separadas por comas
+		std::string::size_type start = 0;
+		while (start <= bindings.size())
+		{
+			std::string::size_type end = bindings.find(',', start);
+			if (end == std::string::npos)
+				end = bindings.size();
+
+			std::string binding = bindings.substr(start, end - start);
+			std::string::size_type first = binding.find_first_not_of(" \t");
+			std::string::size_type last = binding.find_last_not_of(" \t");
+			if (first != std::string::npos)
+			{
+				binding = binding.substr(first, last - first + 1);
+				if (!ParseBinding(id, binding))
+				{
+					m_app->log << "[warn] Input::LoadActions() entrada desconocida " << binding
+						<< " en la acción " << *it << std::endl;
+				}
+			}
+
+			start = end + 1;
+		}
+	}
+
+	m_app->log << "Input::LoadActions() " << names.size() << " acciones cargadas de " << theFilename << std::endl;
+
+	return true;
+}
+
+void Input::ClearActions()
+{
+	m_actions.clear();
+	m_actionIDs.clear();
+}
+
+ActionID Input::GetActionID(const std::string& theAction) const
+{
+	std::map<std::string, ActionID>::const_iterator it = m_actionIDs.find(theAction);
+	if (it != m_actionIDs.end())
+	{
+		return it->second;
+	}
+
+	return INVALID_ACTION;
+}
+
+bool Input::IsActionDown(ActionID theAction) const
+{
+	if (theAction >= m_actions.size())
+		return false;
+
+	return IsActionDown(m_actions[theAction], m_current);
+}
+
+bool Input::IsActionDown(const std::string& theAction) const
+{
+	return IsActionDown(GetActionID(theAction));
+}
+
+bool Input::IsActionPressed(ActionID theAction) const
+{
+	if (theAction >= m_actions.size())
+		return false;
+
+	return IsActionDown(m_actions[theAction], m_current) &&
+		!IsActionDown(m_actions[theAction], m_previous);
+}
+
+bool Input::IsActionPressed(const std::string& theAction) const
+{
+	return IsActionPressed(GetActionID(theAction));
+}
+
+bool Input::IsActionReleased(ActionID theAction) const
+{
+	if (theAction >= m_actions.size())
+		return false;
+
+	return !IsActionDown(m_actions[theAction], m_current) &&
+		IsActionDown(m_actions[theAction], m_previous);
+}
+
+bool Input::IsActionReleased(const std::string& theAction) const
+{
+	return IsActionReleased(GetActionID(theAction));
+}
+
+sf::Keyboard::Key Input::ParseKey(const std::string& theName)
+{
+	std::string name = theName;
+	std::transform(name.begin(), name.end(), name.begin(), tolower);
+
+	for (int i = 0; i < sf::Keyboard::KeyCount; i++)
+	{
+		std::string keyName = gKeyNames[i];
+		std::transform(keyName.begin(), keyName.end(), keyName.begin(), tolower);
+		if (name == keyName)
+		{
+			return static_cast<sf::Keyboard::Key>(i);
+		}
+	}
+
+	return sf::Keyboard::Unknown;
+}
+
+void Input::BeginFrame()
+{
+	m_previous = m_current;
+	m_events.clear();
+	m_mouseWheel = 0;
+}
+
+void Input::PushEvent(const sf::Event& theEvent)
+{
+	m_events.push_back(theEvent);
+
+	switch (theEvent.type)
+	{
+	case sf::Event::KeyPressed:
+		if (theEvent.key.code >= 0 && theEvent.key.code < sf::Keyboard::KeyCount)
+			m_current.keys[theEvent.key.code] = true;
+		break;
+	case sf::Event::KeyReleased:
+		if (theEvent.key.code >= 0 && theEvent.key.code < sf::Keyboard::KeyCount)
+			m_current.keys[theEvent.key.code] = false;
+		break;
+	case sf::Event::MouseButtonPressed:
+		m_current.mouseButtons[theEvent.mouseButton.button] = true;
+		m_mousePosition.x = theEvent.mouseButton.x;
+		m_mousePosition.y = theEvent.mouseButton.y;
+		break;
+	case sf::Event::MouseButtonReleased:
+		m_current.mouseButtons[theEvent.mouseButton.button] = false;
+		m_mousePosition.x = theEvent.mouseButton.x;
+		m_mousePosition.y = theEvent.mouseButton.y;
+		break;
+	case sf::Event::MouseMoved:
+		m_mousePosition.x = theEvent.mouseMove.x;
+		m_mousePosition.y = theEvent.mouseMove.y;
+		break;
+	case sf::Event::MouseWheelMoved:
+		m_mouseWheel += theEvent.mouseWheel.delta;
+		break;
+	case sf::Event::JoystickButtonPressed:
+		if (theEvent.joystickButton.joystickId < sf::Joystick::Count &&
+			theEvent.joystickButton.button < sf::Joystick::ButtonCount)
+		{
+			m_current.joystickButtons[theEvent.joystickButton.joystickId * sf::Joystick::ButtonCount +
+				theEvent.joystickButton.button] = true;
+		}
+		break;
+	case sf::Event::JoystickButtonReleased:
+		if (theEvent.joystickButton.joystickId < sf::Joystick::Count &&
+			theEvent.joystickButton.button < sf::Joystick::ButtonCount)
+		{
+			m_current.joystickButtons[theEvent.joystickButton.joystickId * sf::Joystick::ButtonCount +
+				theEvent.joystickButton.button] = false;
+		}
+		break;
+	case sf::Event::JoystickMoved:
+		if (theEvent.joystickMove.joystickId < sf::Joystick::Count)
+		{
+			m_joystickAxis[theEvent.joystickMove.joystickId][theEvent.joystickMove.axis] =
+				theEvent.joystickMove.position;
+		}
+		break;
+	case sf::Event::JoystickConnected:
+		if (theEvent.joystickConnect.joystickId < sf::Joystick::Count)
+			m_joystickConnected[theEvent.joystickConnect.joystickId] = true;
+		break;
+	case sf::Event::JoystickDisconnected:
+		if (theEvent.joystickConnect.joystickId < sf::Joystick::Count)
+		{
+			unsigned int id = theEvent.joystickConnect.joystickId;
+			m_joystickConnected[id] = false;
+			for (unsigned int i = 0; i < sf::Joystick::ButtonCount; i++)
+			{
+				m_current.joystickButtons[id * sf::Joystick::ButtonCount + i] = false;
+			}
+			for (unsigned int i = 0; i < sf::Joystick::AxisCount; i++)
+			{
+				m_joystickAxis[id][i] = 0.0f;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void Input::ResetState()
+{
+	// Sin foco no recibimos las pulsaciones soltadas, así que soltamos todo
+	m_current.keys.reset();
+	m_current.mouseButtons.reset();
+	m_current.joystickButtons.reset();
+}
+
+ActionID Input::AddAction(const std::string& theAction)
+{
+	std::map<std::string, ActionID>::iterator it = m_actionIDs.find(theAction);
+	if (it != m_actionIDs.end())
+	{
+		return it->second;
+	}
+
+	ActionID id = static_cast<ActionID>(m_actions.size());
+	Action action;
+	action.name = theAction;
+	m_actions.push_back(action);
+	m_actionIDs[theAction] = id;
+
+	return id;
+}
+
+bool Input::IsActionDown(const Action& theAction, const State& theState) const
+{
+	std::vector<Binding>::const_iterator it;
+	for (it = theAction.bindings.begin(); it != theAction.bindings.end(); it++)
+	{
+		switch (it->type)
+		{
+		case BindKey:
+			if (theState.keys[it->code])
+				return true;
+			break;
+		case BindMouseButton:
+			if (theState.mouseButtons[it->code])
+				return true;
+			break;
+		case BindJoystickButton:
+			if (theState.joystickButtons[it->joystick * sf::Joystick::ButtonCount + it->code])
+				return true;
+			break;
+		}
+	}
+
+	return false;
+}
+
+bool Input::ParseBinding(ActionID theAction, const std::string& theBinding)
+{
+	std::string binding = theBinding;
+	std::transform(binding.begin(), binding.end(), binding.begin(), tolower);
+
+	// Botones del ratón: Mouse:<botón>
+	if (binding.compare(0, 6, "mouse:") == 0)
+	{
+		std::string button = binding.substr(6);
+		for (int i = 0; i < sf::Mouse::ButtonCount; i++)
+		{
+			std::string buttonName = gMouseButtonNames[i];
+			std::transform(buttonName.begin(), buttonName.end(), buttonName.begin(), tolower);
+			if (button == buttonName)
+			{
+				MapMouseButton(m_actions[theAction].name, static_cast<sf::Mouse::Button>(i));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Botones de joystick: Joy<n>:<botón>
+	if (binding.compare(0, 3, "joy") == 0)
+	{
+		std::string::size_type colon = binding.find(':');
+		if (colon == std::string::npos || colon == 3 || colon + 1 == binding.size())
+			return false;
+
+		unsigned int joystick = ra::ParseUint32(binding.substr(3, colon - 3), sf::Joystick::Count);
+		unsigned int button = ra::ParseUint32(binding.substr(colon + 1), sf::Joystick::ButtonCount);
+		if (joystick >= sf::Joystick::Count || button >= sf::Joystick::ButtonCount)
+			return false;
+
+		MapJoystickButton(m_actions[theAction].name, joystick, button);
+		return true;
+	}
+
+	// Teclas con el nombre de sf::Keyboard::Key
+	sf::Keyboard::Key key = ParseKey(theBinding);
+	if (key == sf::Keyboard::Unknown)
+		return false;
+
+	MapKey(m_actions[theAction].name, key);
+	return true;
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <cstring>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/InputRecorder.hpp>
+
+namespace ra
+{
+
+/// Identificador de los archivos de grabación
+static const char gRecordMagic[4] = { 'R', 'R', 'E', 'C' };
+
+InputRecorder::InputRecorder()
+	: m_app(ra::App::Instance())
+	, m_file()
+	, m_data()
+	, m_offset(0)
+	, m_frameCount(0)
+	, m_recording(false)
+	, m_replaying(false)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+	StopRecording();
+	StopReplay();
+}
+
+bool InputRecorder::StartRecording(const std::string& theFilename)
+{
+	StopRecording();
+
+	m_file.open(theFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		m_app->log << "[error] InputRecorder::StartRecording() no se ha podido crear " << theFilename << std::endl;
+		return false;
+	}
+
+	ra::Uint32 version = FORMAT_VERSION;
+	ra::Uint32 eventSize = sizeof(sf::Event);
+	m_file.write(gRecordMagic, sizeof(gRecordMagic));
+	m_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	m_file.write(reinterpret_cast<const char*>(&eventSize), sizeof(eventSize));
+
+	m_frameCount = 0;
+	m_recording = true;
+
+	m_app->log << "InputRecorder::StartRecording() grabando en " << theFilename << std::endl;
+
+	return true;
+}
+
+void InputRecorder::RecordFrame(sf::Time theDelta, const std::vector<sf::Event>& theEvents)
+{
+	if (!m_recording)
+		return;
+
+	ra::Int64 delta = theDelta.asMicroseconds();
+	ra::Uint32 count = static_cast<ra::Uint32>(theEvents.size());
+	m_file.write(reinterpret_cast<const char*>(&delta), sizeof(delta));
+	m_file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	if (count > 0)
+	{
+		m_file.write(reinterpret_cast<const char*>(&theEvents[0]), count * sizeof(sf::Event));
+	}
+
+	m_frameCount++;
+}
+
+void InputRecorder::StopRecording()
+{
+	if (m_recording)
+	{
+		m_file.close();
+		m_recording = false;
+
+		m_app->log << "InputRecorder::StopRecording() " << m_frameCount << " frames grabados" << std::endl;
+	}
+}
+
+bool InputRecorder::IsRecording() const
+{
+	return m_recording;
+}
+
+bool InputRecorder::StartReplay(const std::string& theFilename)
+{
+	StopReplay();
+
+	std::ifstream file(theFilename.c_str(), std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		m_app->log << "[error] InputRecorder::StartReplay() no se ha podido abrir " << theFilename << std::endl;
+		return false;
+	}
+
+	// Cargamos la grabación completa para no leer de disco durante la reproducción
+	file.seekg(0, std::ios::end);
+	std::streamoff size = file.tellg();
+	file.seekg(0, std::ios::beg);
+	if (size > 0)
+	{
+		m_data.resize(static_cast<size_t>(size));
+		file.read(&m_data[0], size);
+	}
+	file.close();
+	m_offset = 0;
+
+	char magic[4];
+	ra::Uint32 version = 0;
+	ra::Uint32 eventSize = 0;
+	if (!Read(magic, sizeof(magic)) || std::memcmp(magic, gRecordMagic, sizeof(magic)) != 0 ||
+		!Read(&version, sizeof(version)) || !Read(&eventSize, sizeof(eventSize)))
+	{
+		m_app->log << "[error] InputRecorder::StartReplay() " << theFilename << " no es una grabación" << std::endl;
+		m_data.clear();
+		return false;
+	}
+
+	if (version != FORMAT_VERSION || eventSize != sizeof(sf::Event))
+	{
+		m_app->log << "[error] InputRecorder::StartReplay() " << theFilename
+			<< " tiene un formato incompatible (versión " << version << ", evento " << eventSize << " bytes)" << std::endl;
+		m_data.clear();
+		return false;
+	}
+
+	m_frameCount = 0;
+	m_replaying = true;
+
+	m_app->log << "InputRecorder::StartReplay() reproduciendo " << theFilename << std::endl;
+
+	return true;
+}
+
+bool InputRecorder::ReadFrame(sf::Time& theDelta, std::vector<sf::Event>& theEvents)
+{
+	theEvents.clear();
+
+	if (!m_replaying)
+		return false;
+
+	ra::Int64 delta = 0;
+	ra::Uint32 count = 0;
+	if (!Read(&delta, sizeof(delta)) || !Read(&count, sizeof(count)))
+	{
+		return false;
+	}
+
+	if (count > 0)
+	{
+		theEvents.resize(count);
+		if (!Read(&theEvents[0], count * sizeof(sf::Event)))
+		{
+			m_app->log << "[error] InputRecorder::ReadFrame() grabación truncada en el frame " << m_frameCount << std::endl;
+			theEvents.clear();
+			return false;
+		}
+	}
+
+	theDelta = sf::microseconds(delta);
+	m_frameCount++;
+
+	return true;
+}
+
+void InputRecorder::StopReplay()
+{
+	if (m_replaying)
+	{
+		std::vector<char>().swap(m_data);
+		m_offset = 0;
+		m_replaying = false;
+
+		m_app->log << "InputRecorder::StopReplay() " << m_frameCount << " frames reproducidos" << std::endl;
+	}
+}
+
+bool InputRecorder::IsReplaying() const
+{
+	return m_replaying;
+}
+
+ra::Uint32 InputRecorder::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+bool InputRecorder::Read(void* theData, size_t theSize)
+{
+	if (m_data.size() - m_offset < theSize)
+		return false;
+
+	std::memcpy(theData, &m_data[m_offset], theSize);
+	m_offset += theSize;
+
+	return true;
+}
+
+} // namespace ra
\ No newline at end of file
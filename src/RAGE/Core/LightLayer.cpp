@@ -0,0 +1,369 @@
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/Camera.hpp>
+#include <RAGE/Core/RenderStats.hpp>
+#include <RAGE/Core/TileGrid.hpp>
+#include <RAGE/Core/LightLayer.hpp>
+
+namespace
+{
+	const float TWO_PI = 2.f * 3.14159265f;
+
+	/// Margen del mapa alrededor de la vista, en fracción de su tamaño
+	const float VIEW_MARGIN = 0.25f;
+
+	/// Color de la luz atenuado según la distancia recorrida
+	sf::Color Attenuate(const sf::Color& theColor, float theFraction)
+	{
+		float ratio = std::max(0.f, 1.f - theFraction);
+		return sf::Color(static_cast<sf::Uint8>(theColor.r * ratio), static_cast<sf::Uint8>(theColor.g * ratio),
+			static_cast<sf::Uint8>(theColor.b * ratio), theColor.a);
+	}
+}
+
+namespace ra
+{
+
+LightLayer::LightLayer()
+	: m_lights()
+	, m_free()
+	, m_ambient(40, 40, 60)
+	, m_scale(ra::PassQuarter)
+	, m_occluders(NULL)
+	, m_rect()
+	, m_dirty(true)
+	, m_visible(0)
+	, m_vertices()
+	, m_lightMap()
+	, m_sprite()
+{
+}
+
+LightLayer::~LightLayer()
+{
+}
+
+void LightLayer::SetAmbientColor(const sf::Color& theColor)
+{
+	m_ambient = theColor;
+	m_dirty = true;
+}
+
+const sf::Color& LightLayer::GetAmbientColor() const
+{
+	return m_ambient;
+}
+
+void LightLayer::SetResolution(ra::PassScale theScale)
+{
+	m_scale = theScale;
+	m_dirty = true;
+}
+
+void LightLayer::SetOccluders(const ra::TileGrid* theGrid)
+{
+	m_occluders = theGrid;
+	m_dirty = true;
+}
+
+LightHandle LightLayer::AddLight(const sf::Vector2f& thePosition, float theRadius, const sf::Color& theColor,
+	bool theShadows)
+{
+	Uint32 index;
+	if (m_free.empty())
+	{
+		index = static_cast<Uint32>(m_lights.size());
+		m_lights.push_back(Light());
+		m_lights.back().generation = 1;
+	}
+	else
+	{
+		index = m_free.back();
+		m_free.pop_back();
+	}
+
+	Light& light = m_lights[index];
+	light.position = thePosition;
+	light.radius = theRadius;
+	light.color = theColor;
+	light.shadows = theShadows;
+	light.enabled = true;
+	light.active = true;
+	Touch(light);
+
+	return LightHandle(index, light.generation);
+}
+
+void LightLayer::RemoveLight(const LightHandle& theLight)
+{
+	Light* light = Find(theLight);
+	if (light == NULL)
+	{
+		return;
+	}
+
+	Touch(*light);
+	light->active = false;
+	// La generación 0 queda para los handles nulos
+	light->generation = (light->generation == 0xFFFFFFFF) ? 1 : light->generation + 1;
+	m_free.push_back(theLight.index);
+}
+
+void LightLayer::SetLightPosition(const LightHandle& theLight, const sf::Vector2f& thePosition)
+{
+	Light* light = Find(theLight);
+	if (light != NULL && light->position != thePosition)
+	{
+		Touch(*light);
+		light->position = thePosition;
+		Touch(*light);
+	}
+}
+
+sf::Vector2f LightLayer::GetLightPosition(const LightHandle& theLight) const
+{
+	const Light* light = Find(theLight);
+	return (light != NULL) ? light->position : sf::Vector2f(0.f, 0.f);
+}
+
+void LightLayer::SetLightRadius(const LightHandle& theLight, float theRadius)
+{
+	Light* light = Find(theLight);
+	if (light != NULL && light->radius != theRadius)
+	{
+		Touch(*light);
+		light->radius = theRadius;
+		Touch(*light);
+	}
+}
+
+void LightLayer::SetLightColor(const LightHandle& theLight, const sf::Color& theColor)
+{
+	Light* light = Find(theLight);
+	if (light != NULL && light->color != theColor)
+	{
+		light->color = theColor;
+		Touch(*light);
+	}
+}
+
+void LightLayer::SetLightShadows(const LightHandle& theLight, bool theShadows)
+{
+	Light* light = Find(theLight);
+	if (light != NULL && light->shadows != theShadows)
+	{
+		light->shadows = theShadows;
+		Touch(*light);
+	}
+}
+
+void LightLayer::SetLightEnabled(const LightHandle& theLight, bool theEnabled)
+{
+	Light* light = Find(theLight);
+	if (light != NULL && light->enabled != theEnabled)
+	{
+		// Touch() ignora las luces apagadas, la marcamos mientras luce
+		if (light->enabled)
+		{
+			Touch(*light);
+		}
+		light->enabled = theEnabled;
+		Touch(*light);
+	}
+}
+
+bool LightLayer::IsValid(const LightHandle& theLight) const
+{
+	return Find(theLight) != NULL;
+}
+
+void LightLayer::Update()
+{
+	// El mapa cubre la vista con un margen: mientras la vista no se salga de
+	// él no hace falta volver a dibujarlo, y también cubre el frame de
+	// retraso entre el Update() de la escena y el de la cámara
+	sf::FloatRect view = ra::Camera::Instance()->GetRect();
+	sf::FloatRect rect(view.left - view.width * VIEW_MARGIN, view.top - view.height * VIEW_MARGIN,
+		view.width * (1.f + 2.f * VIEW_MARGIN), view.height * (1.f + 2.f * VIEW_MARGIN));
+	if (rect.width != m_rect.width || rect.height != m_rect.height ||
+		view.left < m_rect.left || view.top < m_rect.top ||
+		view.left + view.width > m_rect.left + m_rect.width || view.top + view.height > m_rect.top + m_rect.height)
+	{
+		m_rect = rect;
+		m_dirty = true;
+	}
+
+	if (!m_dirty || m_rect.width <= 0.f || m_rect.height <= 0.f)
+	{
+		return;
+	}
+
+	sf::Vector2u size(std::max(static_cast<unsigned int>(m_rect.width) / m_scale, 1u),
+		std::max(static_cast<unsigned int>(m_rect.height) / m_scale, 1u));
+	if (m_lightMap.getSize() != size)
+	{
+		if (!m_lightMap.create(size.x, size.y))
+		{
+			ra::App::Instance()->log << "[error] LightLayer::Update() no se ha podido crear el mapa de luces ("
+				<< size.x << ", " << size.y << ")" << std::endl;
+			return;
+		}
+		m_lightMap.setSmooth(true);
+	}
+
+	// Solo las luces que alcanzan la vista entran en el mapa
+	m_vertices.clear();
+	m_visible = 0;
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		const Light& light = m_lights[i];
+		if (light.active && light.enabled && IsVisible(light))
+		{
+			AddVertices(light);
+			m_visible++;
+		}
+	}
+
+	// El mapa cubre la vista en coordenadas del mundo, a menor resolución
+	ra::RenderStats::SetView(m_lightMap, sf::View(m_rect));
+	m_lightMap.clear(m_ambient);
+	if (!m_vertices.empty())
+	{
+		ra::RenderStats::Draw(m_lightMap, &m_vertices[0], static_cast<unsigned int>(m_vertices.size()), sf::Triangles,
+			sf::BlendAdd);
+	}
+	m_lightMap.display();
+
+	m_sprite.setTexture(m_lightMap.getTexture(), true);
+	m_sprite.setPosition(m_rect.left, m_rect.top);
+	m_sprite.setScale(m_rect.width / size.x, m_rect.height / size.y);
+
+	m_dirty = false;
+}
+
+void LightLayer::Clear()
+{
+	// Se liberan las posiciones en lugar de vaciar m_lights para conservar
+	// las generaciones y que los handles antiguos sigan siendo inválidos
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		if (m_lights[i].active)
+		{
+			RemoveLight(LightHandle(static_cast<Uint32>(i), m_lights[i].generation));
+		}
+	}
+	m_vertices.clear();
+	m_visible = 0;
+	m_dirty = true;
+}
+
+size_t LightLayer::GetLightCount() const
+{
+	return m_lights.size() - m_free.size();
+}
+
+size_t LightLayer::GetVisibleCount() const
+{
+	return m_visible;
+}
+
+sf::FloatRect LightLayer::getLocalBounds() const
+{
+	return m_rect;
+}
+
+sf::FloatRect LightLayer::getGlobalBounds() const
+{
+	return m_rect;
+}
+
+LightLayer::Light* LightLayer::Find(const LightHandle& theLight)
+{
+	if (theLight.index >= m_lights.size())
+	{
+		return NULL;
+	}
+	Light& light = m_lights[theLight.index];
+	return (light.active && light.generation == theLight.generation) ? &light : NULL;
+}
+
+const LightLayer::Light* LightLayer::Find(const LightHandle& theLight) const
+{
+	if (theLight.index >= m_lights.size())
+	{
+		return NULL;
+	}
+	const Light& light = m_lights[theLight.index];
+	return (light.active && light.generation == theLight.generation) ? &light : NULL;
+}
+
+void LightLayer::Touch(const Light& theLight)
+{
+	if (theLight.enabled && IsVisible(theLight))
+	{
+		m_dirty = true;
+	}
+}
+
+bool LightLayer::IsVisible(const Light& theLight) const
+{
+	sf::FloatRect bounds(theLight.position.x - theLight.radius, theLight.position.y - theLight.radius,
+		2.f * theLight.radius, 2.f * theLight.radius);
+	return bounds.intersects(m_rect);
+}
+
+void LightLayer::AddVertices(const Light& theLight)
+{
+	bool shadows = theLight.shadows && m_occluders != NULL;
+
+	// Un abanico de triángulos desde el centro: cada rayo llega hasta el
+	// radio o hasta la primera celda sólida, con la luz atenuada en el borde
+	sf::Vertex first;
+	sf::Vertex previous;
+	for (Uint32 i = 0; i < LIGHT_SEGMENTS; i++)
+	{
+		float angle = TWO_PI * i / LIGHT_SEGMENTS;
+		sf::Vector2f end = theLight.position + sf::Vector2f(std::cos(angle), std::sin(angle)) * theLight.radius;
+
+		sf::Vertex edge(end, Attenuate(theLight.color, 1.f));
+		ra::TileRayHit hit;
+		if (shadows && m_occluders->RayCast(theLight.position, end, hit))
+		{
+			edge.position = hit.point;
+			edge.color = Attenuate(theLight.color, hit.fraction);
+		}
+
+		if (i == 0)
+		{
+			first = edge;
+		}
+		else
+		{
+			m_vertices.push_back(sf::Vertex(theLight.position, theLight.color));
+			m_vertices.push_back(previous);
+			m_vertices.push_back(edge);
+		}
+		previous = edge;
+	}
+
+	m_vertices.push_back(sf::Vertex(theLight.position, theLight.color));
+	m_vertices.push_back(previous);
+	m_vertices.push_back(first);
+}
+
+void LightLayer::draw(sf::RenderTarget& theTarget, sf::RenderStates theStates) const
+{
+	if (m_lightMap.getSize().x == 0)
+	{
+		return;
+	}
+
+	// El mapa oscurece o tiñe lo que ya está dibujado debajo
+	theStates.blendMode = sf::BlendMultiply;
+	ra::RenderStats::Draw(theTarget, m_sprite, theStates);
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <RAGE/Core/LinearArena.hpp>
+
+namespace ra
+{
+
+LinearArena::LinearArena(std::size_t theCapacity)
+	: m_buffer(0)
+	, m_capacity(theCapacity)
+	, m_offset(0)
+	, m_peak(0)
+	, m_overflow()
+	, m_overflowBytes(0)
+{
+	if (m_capacity > 0)
+	{
+		m_buffer = new char[m_capacity];
+	}
+}
+
+LinearArena::~LinearArena()
+{
+	for (std::size_t i = 0; i < m_overflow.size(); i++)
+	{
+		delete[] m_overflow[i];
+	}
+	delete[] m_buffer;
+}
+
+void* LinearArena::Allocate(std::size_t theSize, std::size_t theAlignment)
+{
+	// Relleno necesario para alinear la siguiente posición libre
+	std::size_t address = reinterpret_cast<std::size_t>(m_buffer + m_offset);
+	std::size_t padding = (theAlignment - (address & (theAlignment - 1))) & (theAlignment - 1);
+
+	if (m_buffer != 0 && m_offset + padding + theSize <= m_capacity)
+	{
+		void* result = m_buffer + m_offset + padding;
+		m_offset += padding + theSize;
+		if (m_offset + m_overflowBytes > m_peak)
+		{
+			m_peak = m_offset + m_overflowBytes;
+		}
+		return result;
+	}
+
+	// El bloque está lleno, pedimos la memoria al heap hasta el Reset()
+	char* block = new char[theSize + theAlignment];
+	m_overflow.push_back(block);
+	m_overflowBytes += theSize + theAlignment;
+	if (m_offset + m_overflowBytes > m_peak)
+	{
+		m_peak = m_offset + m_overflowBytes;
+	}
+
+	address = reinterpret_cast<std::size_t>(block);
+	padding = (theAlignment - (address & (theAlignment - 1))) & (theAlignment - 1);
+	return block + padding;
+}
+
+void LinearArena::Reset()
+{
+	if (!m_overflow.empty())
+	{
+		for (std::size_t i = 0; i < m_overflow.size(); i++)
+		{
+			delete[] m_overflow[i];
+		}
+		m_overflow.clear();
+
+		// Crecemos para que lo reservado en este frame quepa en el bloque
+		std::size_t capacity = m_capacity;
+		while (capacity < m_offset + m_overflowBytes)
+		{
+			capacity = capacity > 0 ? capacity * 2 : m_overflowBytes;
+		}
+		delete[] m_buffer;
+		m_buffer = new char[capacity];
+		m_capacity = capacity;
+	}
+
+	m_offset = 0;
+	m_overflowBytes = 0;
+}
+
+std::size_t LinearArena::GetUsed() const
+{
+	return m_offset + m_overflowBytes;
+}
+
+std::size_t LinearArena::GetCapacity() const
+{
+	return m_capacity;
+}
+
+std::size_t LinearArena::GetPeak() const
+{
+	return m_peak;
+}
+
+Uint32 LinearArena::GetOverflowCount() const
+{
+	return static_cast<Uint32>(m_overflow.size());
+}
+
+} // namespace ra
\ No newline at end of file
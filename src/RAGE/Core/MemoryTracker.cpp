@@ -0,0 +1,321 @@
+#include <cstdlib>
+#include <new>
+#include <RAGE/Core/MemoryTracker.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RAGE_THREAD_LOCAL __declspec(thread)
+#else
+#define RAGE_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	/// Estadísticas por etiqueta, se inicializan a cero antes que cualquier
+	/// constructor estático para que el operador new pueda usarlas
+	ra::MemoryStats s_stats[ra::MemoryTagCount];
+	/// Reservas en el heap desde el inicio
+	ra::Uint32 s_totalAllocations = 0;
+	/// Cerrojo de las estadísticas. No puede ser un sf::Mutex porque este
+	/// reserva memoria con new
+	volatile long s_lock = 0;
+	/// Etiqueta del MemoryScope activo en cada hilo
+	RAGE_THREAD_LOCAL int s_threadTag = ra::MemoryUntagged;
+
+	void Lock()
+	{
+#if defined(_MSC_VER)
+		while (_InterlockedCompareExchange(&s_lock, 1, 0) != 0)
+		{
+		}
+#else
+		while (__sync_lock_test_and_set(&s_lock, 1) != 0)
+		{
+		}
+#endif
+	}
+
+	void Unlock()
+	{
+#if defined(_MSC_VER)
+		_InterlockedExchange(&s_lock, 0);
+#else
+		__sync_lock_release(&s_lock);
+#endif
+	}
+
+	void WriteStats(std::ostream& theStream, ra::MemoryTag theTag, const ra::MemoryStats& theStats)
+	{
+		theStream << "  " << ra::MemoryTracker::GetTagName(theTag) << ": ";
+		if (ra::MemoryTracker::IsTracking())
+		{
+			theStream << (theStats.liveBytes / 1024) << " KB en " << theStats.liveAllocations
+				<< " reservas (máx " << (theStats.peakBytes / 1024) << " KB, "
+				<< theStats.allocations << " reservas en total)";
+		}
+		if (theStats.residentPeak > 0)
+		{
+			theStream << (ra::MemoryTracker::IsTracking() ? ", " : "")
+				<< "residente " << (theStats.residentBytes / 1024) << " KB (máx "
+				<< (theStats.residentPeak / 1024) << " KB)";
+		}
+		theStream << std::endl;
+	}
+}
+
+#if defined(RAGE_TRACK_ALLOCATIONS)
+
+namespace
+{
+	/// Cabecera delante de cada reserva, ocupa 16 bytes para no perder la
+	/// alineación que da malloc
+	const std::size_t HEADER_SIZE = 16;
+
+	struct AllocationHeader
+	{
+		std::size_t size;
+		int tag;
+	};
+
+	void* TrackedAlloc(std::size_t theSize)
+	{
+		char* memory = static_cast<char*>(std::malloc(HEADER_SIZE + theSize));
+		if (memory == 0)
+		{
+			return 0;
+		}
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(memory);
+		header->size = theSize;
+		header->tag = s_threadTag;
+
+		Lock();
+		ra::MemoryStats& stats = s_stats[header->tag];
+		stats.liveBytes += theSize;
+		stats.liveAllocations++;
+		stats.allocations++;
+		if (stats.liveBytes > stats.peakBytes)
+		{
+			stats.peakBytes = stats.liveBytes;
+		}
+		s_totalAllocations++;
+		Unlock();
+
+		return memory + HEADER_SIZE;
+	}
+
+	void TrackedFree(void* thePointer)
+	{
+		if (thePointer == 0)
+		{
+			return;
+		}
+
+		char* memory = static_cast<char*>(thePointer) - HEADER_SIZE;
+		const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(memory);
+
+		Lock();
+		ra::MemoryStats& stats = s_stats[header->tag];
+		stats.liveBytes -= header->size;
+		stats.liveAllocations--;
+		Unlock();
+
+		std::free(memory);
+	}
+}
+
+void* operator new(std::size_t theSize) throw(std::bad_alloc)
+{
+	void* memory = TrackedAlloc(theSize);
+	if (memory == 0)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](std::size_t theSize) throw(std::bad_alloc)
+{
+	void* memory = TrackedAlloc(theSize);
+	if (memory == 0)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+// Las variantes nothrow también llevan cabecera, delete no distingue
+// de dónde viene la memoria
+void* operator new(std::size_t theSize, const std::nothrow_t&) throw()
+{
+	return TrackedAlloc(theSize);
+}
+
+void* operator new[](std::size_t theSize, const std::nothrow_t&) throw()
+{
+	return TrackedAlloc(theSize);
+}
+
+void operator delete(void* thePointer) throw()
+{
+	TrackedFree(thePointer);
+}
+
+void operator delete[](void* thePointer) throw()
+{
+	TrackedFree(thePointer);
+}
+
+void operator delete(void* thePointer, const std::nothrow_t&) throw()
+{
+	TrackedFree(thePointer);
+}
+
+void operator delete[](void* thePointer, const std::nothrow_t&) throw()
+{
+	TrackedFree(thePointer);
+}
+
+#endif // RAGE_TRACK_ALLOCATIONS
+
+namespace ra
+{
+
+bool MemoryTracker::IsTracking()
+{
+#if defined(RAGE_TRACK_ALLOCATIONS)
+	return true;
+#else
+	return false;
+#endif
+}
+
+MemoryStats MemoryTracker::GetStats(MemoryTag theTag)
+{
+	Lock();
+	MemoryStats stats = s_stats[theTag];
+	Unlock();
+	return stats;
+}
+
+Uint32 MemoryTracker::GetTotalAllocations()
+{
+	Lock();
+	Uint32 allocations = s_totalAllocations;
+	Unlock();
+	return allocations;
+}
+
+void MemoryTracker::AddResident(MemoryTag theTag, Uint64 theBytes)
+{
+	Lock();
+	MemoryStats& stats = s_stats[theTag];
+	stats.residentBytes += theBytes;
+	if (stats.residentBytes > stats.residentPeak)
+	{
+		stats.residentPeak = stats.residentBytes;
+	}
+	Unlock();
+}
+
+void MemoryTracker::RemoveResident(MemoryTag theTag, Uint64 theBytes)
+{
+	Lock();
+	MemoryStats& stats = s_stats[theTag];
+	stats.residentBytes -= (theBytes < stats.residentBytes) ? theBytes : stats.residentBytes;
+	Unlock();
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag theTag)
+{
+	switch (theTag)
+	{
+	case MemoryAssets:
+		return "Assets";
+	case MemoryScene:
+		return "Scene";
+	case MemoryText:
+		return "Text";
+	case MemoryAudio:
+		return "Audio";
+	case MemoryConfig:
+		return "Config";
+	default:
+		return "Sin etiqueta";
+	}
+}
+
+void MemoryTracker::Report(std::ostream& theStream)
+{
+	// Copiamos las estadísticas para no escribir con el cerrojo tomado, la
+	// escritura puede reservar memoria
+	MemoryStats stats[MemoryTagCount];
+	Lock();
+	for (int i = 0; i < MemoryTagCount; i++)
+	{
+		stats[i] = s_stats[i];
+	}
+	Unlock();
+
+	theStream << "MemoryTracker::Report() uso de memoria por subsistema" << std::endl;
+	for (int i = 0; i < MemoryTagCount; i++)
+	{
+		WriteStats(theStream, static_cast<MemoryTag>(i), stats[i]);
+	}
+}
+
+bool MemoryTracker::ReportLeaks(std::ostream& theStream)
+{
+	MemoryStats stats[MemoryTagCount];
+	Lock();
+	for (int i = 0; i < MemoryTagCount; i++)
+	{
+		stats[i] = s_stats[i];
+	}
+	Unlock();
+
+	// Lo que no tiene etiqueta incluye App, el log y la ventana, que aún
+	// siguen vivos
+	bool leaks = false;
+	for (int i = MemoryUntagged + 1; i < MemoryTagCount; i++)
+	{
+		if (stats[i].liveAllocations > 0)
+		{
+			theStream << "[warn] MemoryTracker::ReportLeaks() " << GetTagName(static_cast<MemoryTag>(i))
+				<< ": " << stats[i].liveAllocations << " reservas sin liberar ("
+				<< stats[i].liveBytes << " bytes)" << std::endl;
+			leaks = true;
+		}
+		if (stats[i].residentBytes > 0)
+		{
+			theStream << "[warn] MemoryTracker::ReportLeaks() " << GetTagName(static_cast<MemoryTag>(i))
+				<< ": " << stats[i].residentBytes << " bytes residentes sin liberar" << std::endl;
+			leaks = true;
+		}
+	}
+
+	if (!leaks)
+	{
+		theStream << "MemoryTracker::ReportLeaks() toda la memoria etiquetada se ha liberado" << std::endl;
+	}
+	return leaks;
+}
+
+MemoryTag MemoryTracker::SetThreadTag(MemoryTag theTag)
+{
+	MemoryTag previous = static_cast<MemoryTag>(s_threadTag);
+	s_threadTag = theTag;
+	return previous;
+}
+
+MemoryScope::MemoryScope(MemoryTag theTag)
+	: m_previous(MemoryTracker::SetThreadTag(theTag))
+{
+}
+
+MemoryScope::~MemoryScope()
+{
+	MemoryTracker::SetThreadTag(m_previous);
+}
+
+} // namespace ra
\ No newline at end of file
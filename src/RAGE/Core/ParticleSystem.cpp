@@ -0,0 +1,406 @@
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/ConfigReader.hpp>
+#include <RAGE/Core/RenderStats.hpp>
+#include <RAGE/Core/StringUtil.hpp>
+#include <RAGE/Core/ParticleSystem.hpp>
+
+namespace
+{
+	/// Grados a radianes
+	const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+
+	sf::Uint8 LerpChannel(sf::Uint8 theStart, sf::Uint8 theEnd, float theRatio)
+	{
+		return static_cast<sf::Uint8>(theStart + (theEnd - theStart) * theRatio);
+	}
+}
+
+namespace ra
+{
+
+ParticleEmitter::ParticleEmitter()
+	: rate(100.f)
+	, maxParticles(1000)
+	, lifetime(1.f, 1.f)
+	, speed(50.f, 100.f)
+	, angle(270.f)
+	, spread(360.f)
+	, gravity(0.f, 0.f)
+	, area(0.f, 0.f)
+	, size(4.f, 4.f)
+	, colorStart(255, 255, 255, 255)
+	, colorEnd(255, 255, 255, 0)
+	, textureRect()
+{
+}
+
+void ParticleEmitter::LoadFromConfig(const ra::ConfigReader& theConfig)
+{
+	rate = theConfig.GetFloat("emitter", "rate", rate);
+	maxParticles = theConfig.GetUint32("emitter", "max", maxParticles);
+	lifetime = ra::ParseVector2f(theConfig.GetString("emitter", "lifetime"), lifetime);
+	speed = ra::ParseVector2f(theConfig.GetString("emitter", "speed"), speed);
+	angle = theConfig.GetFloat("emitter", "angle", angle);
+	spread = theConfig.GetFloat("emitter", "spread", spread);
+	gravity = ra::ParseVector2f(theConfig.GetString("emitter", "gravity"), gravity);
+	area = ra::ParseVector2f(theConfig.GetString("emitter", "area"), area);
+	size = ra::ParseVector2f(theConfig.GetString("emitter", "size"), size);
+	colorStart = ra::ParseColor(theConfig.GetString("emitter", "colorstart"), colorStart);
+	colorEnd = ra::ParseColor(theConfig.GetString("emitter", "colorend"), colorEnd);
+	textureRect = ra::ParseIntRect(theConfig.GetString("emitter", "rect"), textureRect);
+}
+
+ParticleSystem::Worker::Worker(ParticleSystem* theSystem)
+	: system(theSystem)
+	, first(0)
+	, last(0)
+	, bounds()
+	, thread(&ParticleSystem::Worker::Run, this)
+{
+}
+
+void ParticleSystem::Worker::Run()
+{
+	system->UpdateRange(*this);
+}
+
+ParticleSystem::ParticleSystem()
+	: m_emitter()
+	, m_texture(NULL)
+	, m_emitting(true)
+	, m_emitAccumulator(0.f)
+	, m_random(0x2545F491)
+	, m_step(0.f)
+	, m_count(0)
+	, m_positionX()
+	, m_positionY()
+	, m_velocityX()
+	, m_velocityY()
+	, m_age()
+	, m_ageRate()
+	, m_vertices()
+	, m_bounds()
+	, m_workers()
+{
+	Reserve(m_emitter.maxParticles);
+	SetThreadCount(1);
+}
+
+ParticleSystem::~ParticleSystem()
+{
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		delete m_workers[i];
+	}
+}
+
+void ParticleSystem::SetEmitter(const ParticleEmitter& theEmitter)
+{
+	m_emitter = theEmitter;
+	Reserve(m_emitter.maxParticles);
+}
+
+const ParticleEmitter& ParticleSystem::GetEmitter() const
+{
+	return m_emitter;
+}
+
+bool ParticleSystem::LoadFromFile(const std::string& theFilename)
+{
+	ra::ConfigReader config;
+	if (!config.LoadFromFile(theFilename))
+	{
+		ra::App::Instance()->log << "[error] ParticleSystem::LoadFromFile() " << theFilename
+			<< " no se ha podido leer" << std::endl;
+		return false;
+	}
+
+	ParticleEmitter emitter = m_emitter;
+	emitter.LoadFromConfig(config);
+	SetEmitter(emitter);
+	return true;
+}
+
+void ParticleSystem::SetTexture(const sf::Texture* theTexture)
+{
+	m_texture = theTexture;
+}
+
+void ParticleSystem::SetEmitting(bool theEmitting)
+{
+	m_emitting = theEmitting;
+	m_emitAccumulator = 0.f;
+}
+
+bool ParticleSystem::IsEmitting() const
+{
+	return m_emitting;
+}
+
+void ParticleSystem::Emit(Uint32 theCount)
+{
+	for (Uint32 i = 0; i < theCount && m_count < m_emitter.maxParticles; i++)
+	{
+		Spawn();
+	}
+}
+
+void ParticleSystem::SetThreadCount(Uint32 theCount)
+{
+	theCount = std::max<Uint32>(1, std::min<Uint32>(theCount, MAX_THREADS));
+
+	while (m_workers.size() > theCount)
+	{
+		delete m_workers.back();
+		m_workers.pop_back();
+	}
+	while (m_workers.size() < theCount)
+	{
+		m_workers.push_back(new Worker(this));
+	}
+}
+
+void ParticleSystem::Update(sf::Time theElapsed)
+{
+	m_step = theElapsed.asSeconds();
+
+	// Las que murieron en el paso anterior ya se han dibujado por última vez
+	RemoveDead();
+
+	if (m_emitting)
+	{
+		m_emitAccumulator += m_emitter.rate * m_step;
+		Uint32 count = static_cast<Uint32>(m_emitAccumulator);
+		m_emitAccumulator -= count;
+		Emit(count);
+	}
+
+	// Repartimos las partículas entre los hilos, el primer tramo se
+	// actualiza en este
+	size_t workers = (m_count >= PARALLEL_THRESHOLD) ? m_workers.size() : 1;
+	Uint32 chunk = static_cast<Uint32>((m_count + workers - 1) / workers);
+	for (size_t i = 0; i < workers; i++)
+	{
+		m_workers[i]->first = std::min<Uint32>(static_cast<Uint32>(i) * chunk, m_count);
+		m_workers[i]->last = std::min<Uint32>(m_workers[i]->first + chunk, m_count);
+	}
+	for (size_t i = 1; i < workers; i++)
+	{
+		m_workers[i]->thread.launch();
+	}
+	UpdateRange(*m_workers[0]);
+	for (size_t i = 1; i < workers; i++)
+	{
+		m_workers[i]->thread.wait();
+	}
+
+	// Unimos los límites de todos los tramos
+	m_bounds = m_workers[0]->bounds;
+	for (size_t i = 1; i < workers; i++)
+	{
+		const sf::FloatRect& bounds = m_workers[i]->bounds;
+		if (bounds.width <= 0.f && bounds.height <= 0.f)
+		{
+			continue;
+		}
+		float left = std::min(m_bounds.left, bounds.left);
+		float top = std::min(m_bounds.top, bounds.top);
+		float right = std::max(m_bounds.left + m_bounds.width, bounds.left + bounds.width);
+		float bottom = std::max(m_bounds.top + m_bounds.height, bounds.top + bounds.height);
+		m_bounds = sf::FloatRect(left, top, right - left, bottom - top);
+	}
+}
+
+void ParticleSystem::Clear()
+{
+	m_count = 0;
+	m_emitAccumulator = 0.f;
+	m_bounds = sf::FloatRect();
+}
+
+Uint32 ParticleSystem::GetParticleCount() const
+{
+	return m_count;
+}
+
+sf::FloatRect ParticleSystem::getLocalBounds() const
+{
+	return m_bounds;
+}
+
+sf::FloatRect ParticleSystem::getGlobalBounds() const
+{
+	return m_bounds;
+}
+
+void ParticleSystem::Spawn()
+{
+	Uint32 i = m_count++;
+
+	// La zona, la dirección y el origen siguen la transformación del nodo
+	sf::Vector2f offset(Random(-m_emitter.area.x, m_emitter.area.x),
+		Random(-m_emitter.area.y, m_emitter.area.y));
+	sf::Vector2f position = getTransform().transformPoint(offset);
+	float angle = (m_emitter.angle + getRotation() +
+		Random(-m_emitter.spread, m_emitter.spread) * 0.5f) * DEGREES_TO_RADIANS;
+	float speed = Random(m_emitter.speed.x, m_emitter.speed.y);
+	float lifetime = Random(m_emitter.lifetime.x, m_emitter.lifetime.y);
+
+	m_positionX[i] = position.x;
+	m_positionY[i] = position.y;
+	m_velocityX[i] = std::cos(angle) * speed;
+	m_velocityY[i] = std::sin(angle) * speed;
+	m_age[i] = 0.f;
+	m_ageRate[i] = (lifetime > 0.f) ? 1.f / lifetime : 1e6f;
+}
+
+void ParticleSystem::RemoveDead()
+{
+	// Cubrimos cada hueco con la última partícula viva
+	Uint32 i = 0;
+	while (i < m_count)
+	{
+		if (m_age[i] < 1.f)
+		{
+			i++;
+			continue;
+		}
+
+		Uint32 last = --m_count;
+		m_positionX[i] = m_positionX[last];
+		m_positionY[i] = m_positionY[last];
+		m_velocityX[i] = m_velocityX[last];
+		m_velocityY[i] = m_velocityY[last];
+		m_age[i] = m_age[last];
+		m_ageRate[i] = m_ageRate[last];
+	}
+}
+
+void ParticleSystem::UpdateRange(Worker& theWorker)
+{
+	const Uint32 first = theWorker.first;
+	const Uint32 last = theWorker.last;
+	const float step = m_step;
+
+	// Cada bucle recorre un solo componente para que se pueda vectorizar
+	float* positionX = m_positionX.empty() ? 0 : &m_positionX[0];
+	float* positionY = m_positionY.empty() ? 0 : &m_positionY[0];
+	float* velocityX = m_velocityX.empty() ? 0 : &m_velocityX[0];
+	float* velocityY = m_velocityY.empty() ? 0 : &m_velocityY[0];
+	float* age = m_age.empty() ? 0 : &m_age[0];
+	const float* ageRate = m_ageRate.empty() ? 0 : &m_ageRate[0];
+
+	const float gravityX = m_emitter.gravity.x * step;
+	const float gravityY = m_emitter.gravity.y * step;
+	for (Uint32 i = first; i < last; i++)
+	{
+		velocityX[i] += gravityX;
+	}
+	for (Uint32 i = first; i < last; i++)
+	{
+		velocityY[i] += gravityY;
+	}
+	for (Uint32 i = first; i < last; i++)
+	{
+		positionX[i] += velocityX[i] * step;
+	}
+	for (Uint32 i = first; i < last; i++)
+	{
+		positionY[i] += velocityY[i] * step;
+	}
+	for (Uint32 i = first; i < last; i++)
+	{
+		age[i] += ageRate[i] * step;
+	}
+
+	// Rellenamos los vértices y calculamos los límites del tramo
+	const sf::Color& start = m_emitter.colorStart;
+	const sf::Color& end = m_emitter.colorEnd;
+	const sf::IntRect& rect = m_emitter.textureRect;
+	const float texLeft = static_cast<float>(rect.left);
+	const float texTop = static_cast<float>(rect.top);
+	const float texRight = texLeft + rect.width;
+	const float texBottom = texTop + rect.height;
+	float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+
+	for (Uint32 i = first; i < last; i++)
+	{
+		float ratio = std::min(age[i], 1.f);
+		float half = (m_emitter.size.x + (m_emitter.size.y - m_emitter.size.x) * ratio) * 0.5f;
+		sf::Color color(LerpChannel(start.r, end.r, ratio), LerpChannel(start.g, end.g, ratio),
+			LerpChannel(start.b, end.b, ratio), LerpChannel(start.a, end.a, ratio));
+		float left = positionX[i] - half;
+		float top = positionY[i] - half;
+		float right = positionX[i] + half;
+		float bottom = positionY[i] + half;
+
+		sf::Vertex* quad = &m_vertices[i * 4];
+		quad[0].position = sf::Vector2f(left, top);
+		quad[1].position = sf::Vector2f(left, bottom);
+		quad[2].position = sf::Vector2f(right, bottom);
+		quad[3].position = sf::Vector2f(right, top);
+		quad[0].texCoords = sf::Vector2f(texLeft, texTop);
+		quad[1].texCoords = sf::Vector2f(texLeft, texBottom);
+		quad[2].texCoords = sf::Vector2f(texRight, texBottom);
+		quad[3].texCoords = sf::Vector2f(texRight, texTop);
+		quad[0].color = color;
+		quad[1].color = color;
+		quad[2].color = color;
+		quad[3].color = color;
+
+		if (i == first)
+		{
+			minX = left;
+			minY = top;
+			maxX = right;
+			maxY = bottom;
+		}
+		else
+		{
+			minX = std::min(minX, left);
+			minY = std::min(minY, top);
+			maxX = std::max(maxX, right);
+			maxY = std::max(maxY, bottom);
+		}
+	}
+
+	theWorker.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+float ParticleSystem::Random(float theMin, float theMax)
+{
+	// Generador congruencial lineal, con 24 bits basta para un float
+	m_random = m_random * 1664525u + 1013904223u;
+	return theMin + (theMax - theMin) * (m_random >> 8) * (1.f / 16777216.f);
+}
+
+void ParticleSystem::Reserve(Uint32 theCapacity)
+{
+	m_count = std::min(m_count, theCapacity);
+	m_positionX.resize(theCapacity);
+	m_positionY.resize(theCapacity);
+	m_velocityX.resize(theCapacity);
+	m_velocityY.resize(theCapacity);
+	m_age.resize(theCapacity);
+	m_ageRate.resize(theCapacity);
+	m_vertices.resize(theCapacity * 4);
+}
+
+void ParticleSystem::draw(sf::RenderTarget& theTarget, sf::RenderStates theStates) const
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	// Las partículas ya están en coordenadas del mundo, la transformación
+	// del nodo solo se aplica al emitirlas
+	theStates.texture = m_texture;
+	ra::RenderStats::Draw(theTarget, &m_vertices[0], m_count * 4, sf::Quads, theStates);
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,1002 @@
+#include <algorithm>
+#include <cstdlib>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/TileGrid.hpp>
+#include <RAGE/Core/PathFinder.hpp>
+
+namespace
+{
+	/// Coste de un paso diagonal
+	const float DIAGONAL_COST = 1.41421356f;
+
+	/// Los bordes libres a partir de esta longitud tienen dos entradas
+	const ra::Int32 ENTRANCE_SPLIT = 6;
+
+	/// Celdas de cada tramo que se vuelve a buscar al suavizar un camino
+	/// jerárquico y margen alrededor de él
+	const size_t SMOOTH_SPAN = 2 * ra::PathFinder::CLUSTER_SIZE;
+	const ra::Int32 SMOOTH_MARGIN = ra::PathFinder::CLUSTER_SIZE / 2;
+
+	/// Hilos de trabajo al crear el buscador
+	const ra::Uint32 DEFAULT_THREADS = 2;
+
+	ra::Int32 Sign(ra::Int32 theValue)
+	{
+		return (theValue > 0) - (theValue < 0);
+	}
+}
+
+namespace ra
+{
+
+bool PathFinder::OpenNode::operator<(const OpenNode& theRight) const
+{
+	// std::push_heap deja arriba el mayor, así sale primero el de menor coste
+	return score > theRight.score;
+}
+
+PathFinder::Scratch::Scratch()
+	: cost()
+	, parent()
+	, visited()
+	, closed()
+	, stamp(0)
+	, open()
+	, points()
+	, nodeCost()
+	, nodeParent()
+	, nodeVisited()
+	, nodeClosed()
+	, nodeStamp(0)
+	, startLinks()
+	, goalLinks()
+{
+}
+
+PathFinder::Worker::Worker(PathFinder* theFinder)
+	: finder(theFinder)
+	, scratch()
+	, running(false)
+	, thread(&PathFinder::Worker::Run, this)
+{
+}
+
+void PathFinder::Worker::Run()
+{
+	while (true)
+	{
+		Job job;
+		{
+			sf::Lock lock(finder->m_mutex);
+			if (finder->m_requests.empty())
+			{
+				// Sin peticiones el hilo termina, Request() lo relanza
+				running = false;
+				return;
+			}
+			job = finder->m_requests.front();
+			finder->m_requests.pop_front();
+		}
+
+		// La rejilla no cambia mientras hay hilos activos, se lee sin bloqueo
+		job.found = finder->Solve(job.start, job.goal, job.path, scratch);
+
+		sf::Lock lock(finder->m_mutex);
+		finder->m_results.push_back(job);
+	}
+}
+
+PathFinder::PathFinder()
+	: m_width(0)
+	, m_height(0)
+	, m_walkable()
+	, m_clustersX(0)
+	, m_clustersY(0)
+	, m_nodes()
+	, m_edges()
+	, m_clusterNodes()
+	, m_scratch()
+	, m_cache()
+	, m_cacheOrder()
+	, m_nextID(INVALID_PATH + 1)
+	, m_pending()
+	, m_ready()
+	, m_requests()
+	, m_results()
+	, m_mutex()
+	, m_workers()
+{
+	SetThreadCount(DEFAULT_THREADS);
+}
+
+PathFinder::~PathFinder()
+{
+	Clear();
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		delete m_workers[i];
+	}
+}
+
+void PathFinder::SetGrid(const ra::TileGrid& theGrid)
+{
+	Clear();
+
+	m_width = static_cast<Int32>(theGrid.GetWidth());
+	m_height = static_cast<Int32>(theGrid.GetHeight());
+	m_walkable.resize(m_width * m_height);
+	for (Int32 y = 0; y < m_height; y++)
+	{
+		for (Int32 x = 0; x < m_width; x++)
+		{
+			m_walkable[y * m_width + x] = theGrid.IsSolid(x, y) ? 0 : 1;
+		}
+	}
+
+	BuildHierarchy();
+
+	ra::App::Instance()->log << "PathFinder " << m_width << "x" << m_height
+		<< " entradas=" << m_nodes.size() << std::endl;
+}
+
+void PathFinder::SetThreadCount(Uint32 theCount)
+{
+	theCount = std::max<Uint32>(1, std::min<Uint32>(theCount, MAX_THREADS));
+
+	// Los hilos terminan solos al vaciar la cola
+	WaitWorkers();
+	while (m_workers.size() > theCount)
+	{
+		delete m_workers.back();
+		m_workers.pop_back();
+	}
+	while (m_workers.size() < theCount)
+	{
+		m_workers.push_back(new Worker(this));
+	}
+}
+
+bool PathFinder::IsWalkable(Int32 theX, Int32 theY) const
+{
+	if (theX < 0 || theY < 0 || theX >= m_width || theY >= m_height)
+	{
+		return false;
+	}
+	return m_walkable[theY * m_width + theX] != 0;
+}
+
+bool PathFinder::FindPath(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+	std::vector<sf::Vector2i>& thePath)
+{
+	thePath.clear();
+	if (!IsWalkable(theStart.x, theStart.y) || !IsWalkable(theGoal.x, theGoal.y))
+	{
+		return false;
+	}
+
+	std::map<std::pair<Int32, Int32>, std::vector<sf::Vector2i> >::const_iterator it;
+	it = m_cache.find(std::make_pair(theStart.y * m_width + theStart.x, theGoal.y * m_width + theGoal.x));
+	if (it != m_cache.end())
+	{
+		thePath = it->second;
+		return true;
+	}
+
+	if (!Solve(theStart, theGoal, thePath, m_scratch))
+	{
+		return false;
+	}
+	CachePath(theStart, theGoal, thePath);
+	return true;
+}
+
+PathID PathFinder::Request(const sf::Vector2i& theStart, const sf::Vector2i& theGoal)
+{
+	PathID id = m_nextID++;
+	if (m_nextID == INVALID_PATH)
+	{
+		m_nextID++;
+	}
+
+	Job job;
+	job.id = id;
+	job.start = theStart;
+	job.goal = theGoal;
+	job.found = false;
+
+	// Los extremos imposibles y los caminos de la caché no pasan por los
+	// hilos, se entregan directamente
+	if (!IsWalkable(theStart.x, theStart.y) || !IsWalkable(theGoal.x, theGoal.y))
+	{
+		m_ready[id] = job;
+		return id;
+	}
+	std::map<std::pair<Int32, Int32>, std::vector<sf::Vector2i> >::const_iterator it;
+	it = m_cache.find(std::make_pair(theStart.y * m_width + theStart.x, theGoal.y * m_width + theGoal.x));
+	if (it != m_cache.end())
+	{
+		job.path = it->second;
+		job.found = true;
+		m_ready[id] = job;
+		return id;
+	}
+
+	m_pending.insert(id);
+
+	sf::Lock lock(m_mutex);
+	m_requests.push_back(job);
+
+	// Lanzamos un hilo parado si hay más peticiones que hilos activos
+	size_t running = 0;
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		running += m_workers[i]->running ? 1 : 0;
+	}
+	for (size_t i = 0; i < m_workers.size() && running < m_requests.size(); i++)
+	{
+		if (!m_workers[i]->running)
+		{
+			m_workers[i]->running = true;
+			m_workers[i]->thread.launch();
+			running++;
+		}
+	}
+
+	return id;
+}
+
+PathStatus PathFinder::GetStatus(PathID theID) const
+{
+	if (m_pending.find(theID) != m_pending.end())
+	{
+		return PathPending;
+	}
+	std::map<PathID, Job>::const_iterator it = m_ready.find(theID);
+	if (it != m_ready.end())
+	{
+		return it->second.found ? PathFound : PathNotFound;
+	}
+	return PathUnknown;
+}
+
+PathStatus PathFinder::GetPath(PathID theID, std::vector<sf::Vector2i>& thePath)
+{
+	std::map<PathID, Job>::iterator it = m_ready.find(theID);
+	if (it == m_ready.end())
+	{
+		return GetStatus(theID);
+	}
+
+	PathStatus status = it->second.found ? PathFound : PathNotFound;
+	thePath.swap(it->second.path);
+	m_ready.erase(it);
+	return status;
+}
+
+void PathFinder::Cancel(PathID theID)
+{
+	m_ready.erase(theID);
+	if (m_pending.erase(theID) == 0)
+	{
+		return;
+	}
+
+	// Si ya se está resolviendo, Update() descartará el resultado
+	sf::Lock lock(m_mutex);
+	for (std::deque<Job>::iterator it = m_requests.begin(); it != m_requests.end(); it++)
+	{
+		if (it->id == theID)
+		{
+			m_requests.erase(it);
+			break;
+		}
+	}
+}
+
+void PathFinder::Update()
+{
+	if (m_pending.empty())
+	{
+		return;
+	}
+
+	std::deque<Job> results;
+	{
+		sf::Lock lock(m_mutex);
+		results.swap(m_results);
+	}
+
+	for (std::deque<Job>::iterator it = results.begin(); it != results.end(); it++)
+	{
+		if (m_pending.erase(it->id) == 0)
+		{
+			continue;
+		}
+		if (it->found)
+		{
+			CachePath(it->start, it->goal, it->path);
+		}
+		m_ready[it->id] = *it;
+	}
+}
+
+void PathFinder::Clear()
+{
+	{
+		sf::Lock lock(m_mutex);
+		m_requests.clear();
+	}
+	WaitWorkers();
+
+	m_results.clear();
+	m_pending.clear();
+	m_ready.clear();
+	m_cache.clear();
+	m_cacheOrder.clear();
+}
+
+size_t PathFinder::GetCacheSize() const
+{
+	return m_cache.size();
+}
+
+void PathFinder::WaitWorkers()
+{
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i]->thread.wait();
+	}
+}
+
+void PathFinder::BuildHierarchy()
+{
+	m_nodes.clear();
+	m_edges.clear();
+	m_clusterNodes.clear();
+	m_clustersX = (m_width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	m_clustersY = (m_height + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	if (m_clustersX * m_clustersY <= 1)
+	{
+		return;
+	}
+	m_clusterNodes.resize(m_clustersX * m_clustersY);
+
+	// Cada tramo libre de un borde entre dos bloques es una entrada: una
+	// transición en el centro o, si es largo, una en cada extremo
+	std::map<Int32, Uint32> nodes;
+	for (int rows = 0; rows < 2; rows++)
+	{
+		// Bordes entre columnas de bloques y después entre filas
+		const Int32 across = rows ? m_height : m_width;
+		const Int32 along = rows ? m_width : m_height;
+		for (Int32 border = CLUSTER_SIZE; border < across; border += CLUSTER_SIZE)
+		{
+			for (Int32 spanStart = 0; spanStart < along; spanStart += CLUSTER_SIZE)
+			{
+				Int32 spanEnd = std::min(spanStart + CLUSTER_SIZE, along);
+				Int32 start = -1;
+				for (Int32 i = spanStart; i <= spanEnd; i++)
+				{
+					bool open = i < spanEnd && (rows ?
+						IsWalkable(i, border - 1) && IsWalkable(i, border) :
+						IsWalkable(border - 1, i) && IsWalkable(border, i));
+					if (open && start < 0)
+					{
+						start = i;
+					}
+					else if (!open && start >= 0)
+					{
+						Int32 end = i - 1;
+						Int32 positions[2] = { start, end };
+						Int32 count = 2;
+						if (end - start + 1 < ENTRANCE_SPLIT)
+						{
+							positions[0] = (start + end) / 2;
+							count = 1;
+						}
+						for (Int32 j = 0; j < count; j++)
+						{
+							Int32 p = positions[j];
+							if (rows)
+							{
+								AddTransition(nodes, (border - 1) * m_width + p, border * m_width + p);
+							}
+							else
+							{
+								AddTransition(nodes, p * m_width + border - 1, p * m_width + border);
+							}
+						}
+						start = -1;
+					}
+				}
+			}
+		}
+	}
+
+	// Dentro de cada bloque se unen las entradas que se alcanzan entre sí
+	Scratch scratch;
+	for (size_t cluster = 0; cluster < m_clusterNodes.size(); cluster++)
+	{
+		const std::vector<Uint32>& clusterNodes = m_clusterNodes[cluster];
+		for (size_t i = 0; i < clusterNodes.size(); i++)
+		{
+			for (size_t j = i + 1; j < clusterNodes.size(); j++)
+			{
+				Int32 from = m_nodes[clusterNodes[i]].cell;
+				Int32 to = m_nodes[clusterNodes[j]].cell;
+				float cost;
+				if (Search(GetClusterBounds(from), from, to, cost, scratch))
+				{
+					Edge edge = { clusterNodes[j], cost };
+					m_edges[clusterNodes[i]].push_back(edge);
+					edge.node = clusterNodes[i];
+					m_edges[clusterNodes[j]].push_back(edge);
+				}
+			}
+		}
+	}
+}
+
+void PathFinder::AddTransition(std::map<Int32, Uint32>& theNodes, Int32 theFrom, Int32 theTo)
+{
+	Uint32 from = GetNode(theNodes, theFrom);
+	Uint32 to = GetNode(theNodes, theTo);
+	Edge edge = { to, 1.f };
+	m_edges[from].push_back(edge);
+	edge.node = from;
+	m_edges[to].push_back(edge);
+}
+
+Uint32 PathFinder::GetNode(std::map<Int32, Uint32>& theNodes, Int32 theCell)
+{
+	std::map<Int32, Uint32>::const_iterator it = theNodes.find(theCell);
+	if (it != theNodes.end())
+	{
+		return it->second;
+	}
+
+	Uint32 node = static_cast<Uint32>(m_nodes.size());
+	Entrance entrance = { theCell, GetCluster(theCell) };
+	m_nodes.push_back(entrance);
+	m_edges.push_back(std::vector<Edge>());
+	m_clusterNodes[entrance.cluster].push_back(node);
+	theNodes[theCell] = node;
+	return node;
+}
+
+bool PathFinder::Solve(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+	std::vector<sf::Vector2i>& thePath, Scratch& theScratch) const
+{
+	thePath.clear();
+	if (!IsWalkable(theStart.x, theStart.y) || !IsWalkable(theGoal.x, theGoal.y))
+	{
+		return false;
+	}
+
+	Int32 start = theStart.y * m_width + theStart.x;
+	Int32 goal = theGoal.y * m_width + theGoal.x;
+	if (start == goal)
+	{
+		thePath.push_back(theStart);
+		return true;
+	}
+
+	// La abstracción solo compensa si el camino cruza varios bloques
+	if (!m_nodes.empty() && GetCluster(start) != GetCluster(goal) &&
+		GetDistance(start, goal) > 2 * CLUSTER_SIZE)
+	{
+		return SolveHierarchical(start, goal, thePath, theScratch);
+	}
+
+	float cost;
+	if (!Search(sf::IntRect(0, 0, m_width, m_height), start, goal, cost, theScratch))
+	{
+		return false;
+	}
+	AppendPoints(theScratch, thePath);
+	return true;
+}
+
+bool PathFinder::SolveHierarchical(Int32 theStart, Int32 theGoal,
+	std::vector<sf::Vector2i>& thePath, Scratch& theScratch) const
+{
+	// Unimos temporalmente el origen y el destino a las entradas de su
+	// bloque, sin tocar el grafo que comparten los hilos
+	theScratch.startLinks.clear();
+	theScratch.goalLinks.clear();
+	const std::vector<Uint32>& startNodes = m_clusterNodes[GetCluster(theStart)];
+	for (size_t i = 0; i < startNodes.size(); i++)
+	{
+		float cost;
+		if (Search(GetClusterBounds(theStart), theStart, m_nodes[startNodes[i]].cell, cost, theScratch))
+		{
+			Edge edge = { startNodes[i], cost };
+			theScratch.startLinks.push_back(edge);
+		}
+	}
+	const std::vector<Uint32>& goalNodes = m_clusterNodes[GetCluster(theGoal)];
+	for (size_t i = 0; i < goalNodes.size(); i++)
+	{
+		float cost;
+		if (Search(GetClusterBounds(theGoal), m_nodes[goalNodes[i]].cell, theGoal, cost, theScratch))
+		{
+			Edge edge = { goalNodes[i], cost };
+			theScratch.goalLinks.push_back(edge);
+		}
+	}
+	if (theScratch.startLinks.empty() || theScratch.goalLinks.empty())
+	{
+		return false;
+	}
+
+	// A* sobre el grafo de entradas, el origen y el destino son los dos
+	// nodos siguientes al último
+	const Uint32 count = static_cast<Uint32>(m_nodes.size());
+	const Uint32 startNode = count;
+	const Uint32 goalNode = count + 1;
+	if (theScratch.nodeCost.size() != count + 2)
+	{
+		theScratch.nodeCost.assign(count + 2, 0.f);
+		theScratch.nodeParent.assign(count + 2, 0);
+		theScratch.nodeVisited.assign(count + 2, 0);
+		theScratch.nodeClosed.assign(count + 2, 0);
+		theScratch.nodeStamp = 0;
+	}
+	if (++theScratch.nodeStamp == 0)
+	{
+		std::fill(theScratch.nodeVisited.begin(), theScratch.nodeVisited.end(), 0);
+		std::fill(theScratch.nodeClosed.begin(), theScratch.nodeClosed.end(), 0);
+		theScratch.nodeStamp = 1;
+	}
+	const Uint32 stamp = theScratch.nodeStamp;
+
+	std::vector<OpenNode>& open = theScratch.open;
+	open.clear();
+	theScratch.nodeCost[startNode] = 0.f;
+	theScratch.nodeVisited[startNode] = stamp;
+	OpenNode first = { GetDistance(theStart, theGoal), static_cast<Int32>(startNode) };
+	open.push_back(first);
+
+	bool found = false;
+	while (!open.empty())
+	{
+		std::pop_heap(open.begin(), open.end());
+		Uint32 node = static_cast<Uint32>(open.back().index);
+		open.pop_back();
+		if (theScratch.nodeClosed[node] == stamp)
+		{
+			continue;
+		}
+		theScratch.nodeClosed[node] = stamp;
+		if (node == goalNode)
+		{
+			found = true;
+			break;
+		}
+
+		// Tras las aristas del nodo se prueban los enlaces temporales con el
+		// destino, que solo sirven si salen de este nodo
+		const std::vector<Edge>& edges = (node == startNode) ? theScratch.startLinks : m_edges[node];
+		const size_t links = (node == startNode) ? 0 : theScratch.goalLinks.size();
+		for (size_t i = 0; i < edges.size() + links; i++)
+		{
+			Edge edge = Edge();
+			if (i < edges.size())
+			{
+				edge = edges[i];
+			}
+			else
+			{
+				const Edge& link = theScratch.goalLinks[i - edges.size()];
+				if (link.node != node)
+				{
+					continue;
+				}
+				edge.node = goalNode;
+				edge.cost = link.cost;
+			}
+
+			if (theScratch.nodeClosed[edge.node] == stamp)
+			{
+				continue;
+			}
+			float cost = theScratch.nodeCost[node] + edge.cost;
+			if (theScratch.nodeVisited[edge.node] == stamp && cost >= theScratch.nodeCost[edge.node])
+			{
+				continue;
+			}
+			theScratch.nodeVisited[edge.node] = stamp;
+			theScratch.nodeCost[edge.node] = cost;
+			theScratch.nodeParent[edge.node] = node;
+			Int32 cell = (edge.node == goalNode) ? theGoal : m_nodes[edge.node].cell;
+			OpenNode next = { cost + GetDistance(cell, theGoal), static_cast<Int32>(edge.node) };
+			open.push_back(next);
+			std::push_heap(open.begin(), open.end());
+		}
+	}
+	if (!found)
+	{
+		return false;
+	}
+
+	// Celdas de las entradas del camino, del origen al destino
+	std::vector<Int32> cells;
+	for (Uint32 node = goalNode; node != startNode; node = theScratch.nodeParent[node])
+	{
+		cells.push_back((node == goalNode) ? theGoal : m_nodes[node].cell);
+	}
+	cells.push_back(theStart);
+	std::reverse(cells.begin(), cells.end());
+
+	// Refinamos cada tramo: las transiciones son pasos rectos entre bloques
+	// y el resto se busca dentro de su bloque
+	thePath.push_back(sf::Vector2i(theStart % m_width, theStart / m_width));
+	for (size_t i = 1; i < cells.size(); i++)
+	{
+		Int32 from = cells[i - 1];
+		Int32 to = cells[i];
+		if (from == to)
+		{
+			continue;
+		}
+		if (GetCluster(from) != GetCluster(to))
+		{
+			thePath.push_back(sf::Vector2i(to % m_width, to / m_width));
+			continue;
+		}
+		float cost;
+		if (!Search(GetClusterBounds(from), from, to, cost, theScratch))
+		{
+			thePath.clear();
+			return false;
+		}
+		std::vector<sf::Vector2i> segment;
+		AppendPoints(theScratch, segment);
+		thePath.insert(thePath.end(), segment.begin() + 1, segment.end());
+	}
+
+	// Pasar por las entradas da rodeos: repasamos el camino en dos pasadas
+	// desfasadas para que ningún rodeo quede siempre en el borde de un tramo
+	SmoothPath(thePath, 0, theScratch);
+	SmoothPath(thePath, SMOOTH_SPAN / 2, theScratch);
+	return true;
+}
+
+void PathFinder::SmoothPath(std::vector<sf::Vector2i>& thePath, size_t theOffset, Scratch& theScratch) const
+{
+	std::vector<sf::Vector2i> smooth(thePath.begin(), thePath.begin() + std::min(theOffset + 1, thePath.size()));
+	std::vector<sf::Vector2i> segment;
+	for (size_t first = theOffset; first + 1 < thePath.size(); first += SMOOTH_SPAN)
+	{
+		const size_t last = std::min(first + SMOOTH_SPAN, thePath.size() - 1);
+
+		// Coste del tramo y rectángulo que lo contiene, ampliado para que la
+		// búsqueda pueda salirse del camino actual
+		float cost = 0.f;
+		sf::Vector2i low = thePath[first];
+		sf::Vector2i high = thePath[first];
+		for (size_t i = first + 1; i <= last; i++)
+		{
+			const sf::Vector2i& cell = thePath[i];
+			cost += (cell.x != thePath[i - 1].x && cell.y != thePath[i - 1].y) ? DIAGONAL_COST : 1.f;
+			low = sf::Vector2i(std::min(low.x, cell.x), std::min(low.y, cell.y));
+			high = sf::Vector2i(std::max(high.x, cell.x), std::max(high.y, cell.y));
+		}
+		low = sf::Vector2i(std::max(low.x - SMOOTH_MARGIN, 0), std::max(low.y - SMOOTH_MARGIN, 0));
+		high = sf::Vector2i(std::min(high.x + SMOOTH_MARGIN, m_width - 1), std::min(high.y + SMOOTH_MARGIN, m_height - 1));
+		const sf::IntRect bounds(low.x, low.y, high.x - low.x + 1, high.y - low.y + 1);
+
+		float shorter;
+		const Int32 from = thePath[first].y * m_width + thePath[first].x;
+		const Int32 to = thePath[last].y * m_width + thePath[last].x;
+		if (Search(bounds, from, to, shorter, theScratch) && shorter < cost - 1e-3f)
+		{
+			segment.clear();
+			AppendPoints(theScratch, segment);
+			smooth.insert(smooth.end(), segment.begin() + 1, segment.end());
+		}
+		else
+		{
+			smooth.insert(smooth.end(), thePath.begin() + first + 1, thePath.begin() + last + 1);
+		}
+	}
+	thePath.swap(smooth);
+}
+
+bool PathFinder::Search(const sf::IntRect& theBounds, Int32 theStart, Int32 theGoal,
+	float& theCost, Scratch& theScratch) const
+{
+	Prepare(theScratch);
+	const Uint32 stamp = theScratch.stamp;
+	std::vector<OpenNode>& open = theScratch.open;
+	open.clear();
+	theScratch.points.clear();
+
+	theScratch.cost[theStart] = 0.f;
+	theScratch.parent[theStart] = -1;
+	theScratch.visited[theStart] = stamp;
+	OpenNode first = { GetDistance(theStart, theGoal), theStart };
+	open.push_back(first);
+
+	while (!open.empty())
+	{
+		std::pop_heap(open.begin(), open.end());
+		Int32 current = open.back().index;
+		open.pop_back();
+		if (theScratch.closed[current] == stamp)
+		{
+			continue;
+		}
+		theScratch.closed[current] = stamp;
+
+		if (current == theGoal)
+		{
+			theCost = theScratch.cost[current];
+			for (Int32 cell = current; cell >= 0; cell = theScratch.parent[cell])
+			{
+				theScratch.points.push_back(cell);
+			}
+			return true;
+		}
+
+		const Int32 x = current % m_width;
+		const Int32 y = current / m_width;
+
+		// Vecinos podados según la dirección de llegada: solo los que
+		// continúan el movimiento y los forzados por un obstáculo
+		Int32 directions[8][2];
+		Int32 count = 0;
+		Int32 parent = theScratch.parent[current];
+		if (parent < 0)
+		{
+			for (Int32 dy = -1; dy <= 1; dy++)
+			{
+				for (Int32 dx = -1; dx <= 1; dx++)
+				{
+					if ((dx != 0 || dy != 0) && IsWalkable(theBounds, x + dx, y + dy) &&
+						(dx == 0 || dy == 0 || (IsWalkable(theBounds, x + dx, y) && IsWalkable(theBounds, x, y + dy))))
+					{
+						directions[count][0] = dx;
+						directions[count][1] = dy;
+						count++;
+					}
+				}
+			}
+		}
+		else
+		{
+			Int32 dx = Sign(x - parent % m_width);
+			Int32 dy = Sign(y - parent / m_width);
+			if (dx != 0 && dy != 0)
+			{
+				bool vertical = IsWalkable(theBounds, x, y + dy);
+				bool horizontal = IsWalkable(theBounds, x + dx, y);
+				if (vertical)
+				{
+					directions[count][0] = 0;
+					directions[count][1] = dy;
+					count++;
+				}
+				if (horizontal)
+				{
+					directions[count][0] = dx;
+					directions[count][1] = 0;
+					count++;
+				}
+				if (vertical && horizontal && IsWalkable(theBounds, x + dx, y + dy))
+				{
+					directions[count][0] = dx;
+					directions[count][1] = dy;
+					count++;
+				}
+			}
+			else
+			{
+				// Perpendiculares a la dirección de avance
+				Int32 px = dy;
+				Int32 py = dx;
+				bool next = IsWalkable(theBounds, x + dx, y + dy);
+				bool sideA = IsWalkable(theBounds, x + px, y + py);
+				bool sideB = IsWalkable(theBounds, x - px, y - py);
+				if (next)
+				{
+					directions[count][0] = dx;
+					directions[count][1] = dy;
+					count++;
+					if (sideA && IsWalkable(theBounds, x + dx + px, y + dy + py))
+					{
+						directions[count][0] = dx + px;
+						directions[count][1] = dy + py;
+						count++;
+					}
+					if (sideB && IsWalkable(theBounds, x + dx - px, y + dy - py))
+					{
+						directions[count][0] = dx - px;
+						directions[count][1] = dy - py;
+						count++;
+					}
+				}
+				if (sideA)
+				{
+					directions[count][0] = px;
+					directions[count][1] = py;
+					count++;
+				}
+				if (sideB)
+				{
+					directions[count][0] = -px;
+					directions[count][1] = -py;
+					count++;
+				}
+			}
+		}
+
+		for (Int32 i = 0; i < count; i++)
+		{
+			Int32 jump = Jump(theBounds, x, y, directions[i][0], directions[i][1], theGoal);
+			if (jump < 0 || theScratch.closed[jump] == stamp)
+			{
+				continue;
+			}
+			float cost = theScratch.cost[current] + GetDistance(current, jump);
+			if (theScratch.visited[jump] == stamp && cost >= theScratch.cost[jump])
+			{
+				continue;
+			}
+			theScratch.visited[jump] = stamp;
+			theScratch.cost[jump] = cost;
+			theScratch.parent[jump] = current;
+			OpenNode next = { cost + GetDistance(jump, theGoal), jump };
+			open.push_back(next);
+			std::push_heap(open.begin(), open.end());
+		}
+	}
+
+	return false;
+}
+
+Int32 PathFinder::Jump(const sf::IntRect& theBounds, Int32 theX, Int32 theY,
+	Int32 theDX, Int32 theDY, Int32 theGoal) const
+{
+	Int32 x = theX;
+	Int32 y = theY;
+	while (true)
+	{
+		x += theDX;
+		y += theDY;
+		if (!IsWalkable(theBounds, x, y))
+		{
+			return -1;
+		}
+		Int32 cell = y * m_width + x;
+		if (cell == theGoal)
+		{
+			return cell;
+		}
+
+		if (theDX != 0 && theDY != 0)
+		{
+			// En diagonal es punto de salto si lo hay en alguna de sus rectas
+			if (Jump(theBounds, x, y, theDX, 0, theGoal) >= 0 || Jump(theBounds, x, y, 0, theDY, theGoal) >= 0)
+			{
+				return cell;
+			}
+			// Sin cortar esquinas
+			if (!IsWalkable(theBounds, x + theDX, y) || !IsWalkable(theBounds, x, y + theDY))
+			{
+				return -1;
+			}
+		}
+		else if (theDX != 0)
+		{
+			if ((IsWalkable(theBounds, x, y - 1) && !IsWalkable(theBounds, x - theDX, y - 1)) ||
+				(IsWalkable(theBounds, x, y + 1) && !IsWalkable(theBounds, x - theDX, y + 1)))
+			{
+				return cell;
+			}
+		}
+		else
+		{
+			if ((IsWalkable(theBounds, x - 1, y) && !IsWalkable(theBounds, x - 1, y - theDY)) ||
+				(IsWalkable(theBounds, x + 1, y) && !IsWalkable(theBounds, x + 1, y - theDY)))
+			{
+				return cell;
+			}
+		}
+	}
+}
+
+void PathFinder::AppendPoints(const Scratch& theScratch, std::vector<sf::Vector2i>& thePath) const
+{
+	const std::vector<Int32>& points = theScratch.points;
+	if (points.empty())
+	{
+		return;
+	}
+
+	// Los puntos están del destino al origen y entre dos seguidos el camino
+	// es recto o diagonal
+	sf::Vector2i cell(points.back() % m_width, points.back() / m_width);
+	thePath.push_back(cell);
+	for (size_t i = points.size() - 1; i > 0; i--)
+	{
+		sf::Vector2i target(points[i - 1] % m_width, points[i - 1] / m_width);
+		sf::Vector2i step(Sign(target.x - cell.x), Sign(target.y - cell.y));
+		while (cell != target)
+		{
+			cell += step;
+			thePath.push_back(cell);
+		}
+	}
+}
+
+bool PathFinder::IsWalkable(const sf::IntRect& theBounds, Int32 theX, Int32 theY) const
+{
+	if (theX < theBounds.left || theY < theBounds.top ||
+		theX >= theBounds.left + theBounds.width || theY >= theBounds.top + theBounds.height)
+	{
+		return false;
+	}
+	return IsWalkable(theX, theY);
+}
+
+sf::IntRect PathFinder::GetClusterBounds(Int32 theCell) const
+{
+	Int32 left = (theCell % m_width) / CLUSTER_SIZE * CLUSTER_SIZE;
+	Int32 top = (theCell / m_width) / CLUSTER_SIZE * CLUSTER_SIZE;
+	return sf::IntRect(left, top, CLUSTER_SIZE, CLUSTER_SIZE);
+}
+
+Int32 PathFinder::GetCluster(Int32 theCell) const
+{
+	return (theCell / m_width) / CLUSTER_SIZE * m_clustersX + (theCell % m_width) / CLUSTER_SIZE;
+}
+
+float PathFinder::GetDistance(Int32 theFrom, Int32 theTo) const
+{
+	Int32 dx = std::abs(theFrom % m_width - theTo % m_width);
+	Int32 dy = std::abs(theFrom / m_width - theTo / m_width);
+	Int32 diagonal = std::min(dx, dy);
+	return diagonal * DIAGONAL_COST + (std::max(dx, dy) - diagonal);
+}
+
+void PathFinder::Prepare(Scratch& theScratch) const
+{
+	const size_t size = m_walkable.size();
+	if (theScratch.cost.size() != size)
+	{
+		theScratch.cost.assign(size, 0.f);
+		theScratch.parent.assign(size, -1);
+		theScratch.visited.assign(size, 0);
+		theScratch.closed.assign(size, 0);
+		theScratch.stamp = 0;
+	}
+
+	// Las marcas evitan limpiar los arrays en cada búsqueda
+	if (++theScratch.stamp == 0)
+	{
+		std::fill(theScratch.visited.begin(), theScratch.visited.end(), 0);
+		std::fill(theScratch.closed.begin(), theScratch.closed.end(), 0);
+		theScratch.stamp = 1;
+	}
+}
+
+void PathFinder::CachePath(const sf::Vector2i& theStart, const sf::Vector2i& theGoal,
+	const std::vector<sf::Vector2i>& thePath)
+{
+	std::pair<Int32, Int32> key(theStart.y * m_width + theStart.x, theGoal.y * m_width + theGoal.x);
+	if (m_cache.find(key) != m_cache.end())
+	{
+		return;
+	}
+
+	if (m_cache.size() >= MAX_CACHED_PATHS)
+	{
+		m_cache.erase(m_cacheOrder.front());
+		m_cacheOrder.pop_front();
+	}
+	m_cache[key] = thePath;
+	m_cacheOrder.push_back(key);
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,1426 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/CircleShape.hpp>
+#include <RAGE/Core/RectangleShape.hpp>
+#include <RAGE/Core/ConvexShape.hpp>
+#include <RAGE/Core/PhysicsWorld.hpp>
+
+namespace
+{
+	const float PI = 3.14159265f;
+
+	/// Penetración que se tolera sin corregir, en píxeles
+	const float PENETRATION_SLOP = 0.5f;
+
+	/// Distancia a la que dos cuerpos ya se consideran en contacto. Así los
+	/// que se tocan sin solaparse se sostienen desde el primer paso en lugar
+	/// de hundirse uno en otro hasta que la corrección los separa
+	const float CONTACT_MARGIN = 1.f;
+
+	/// Fracción de la penetración que se corrige en cada paso
+	const float BAUMGARTE = 0.2f;
+
+	/// Por debajo de esta velocidad de choque no se rebota
+	const float RESTITUTION_THRESHOLD = 30.f;
+
+	/// Velocidades por debajo de las que un cuerpo se considera quieto
+	const float SLEEP_LINEAR_VELOCITY = 5.f;
+	const float SLEEP_ANGULAR_VELOCITY = 0.035f;
+
+	/// Segundos que una isla tiene que estar quieta para dormirse
+	const float TIME_TO_SLEEP = 0.5f;
+	float Dot(const sf::Vector2f& theA, const sf::Vector2f& theB)
+	{
+		return theA.x * theB.x + theA.y * theB.y;
+	}
+
+	float Cross(const sf::Vector2f& theA, const sf::Vector2f& theB)
+	{
+		return theA.x * theB.y - theA.y * theB.x;
+	}
+
+	/// Velocidad lineal de un punto a theOffset de un cuerpo que gira
+	sf::Vector2f Cross(float theAngular, const sf::Vector2f& theOffset)
+	{
+		return sf::Vector2f(-theAngular * theOffset.y, theAngular * theOffset.x);
+	}
+
+	float LengthSquared(const sf::Vector2f& theVector)
+	{
+		return Dot(theVector, theVector);
+	}
+
+	sf::Vector2f Normalize(const sf::Vector2f& theVector)
+	{
+		float length = std::sqrt(LengthSquared(theVector));
+		return (length > FLT_EPSILON) ? theVector / length : sf::Vector2f(0.f, 0.f);
+	}
+
+	sf::Vector2f Rotate(const sf::Vector2f& theVector, float theCos, float theSin)
+	{
+		return sf::Vector2f(theCos * theVector.x - theSin * theVector.y, theSin * theVector.x + theCos * theVector.y);
+	}
+
+	sf::Vector2f Unrotate(const sf::Vector2f& theVector, float theCos, float theSin)
+	{
+		return sf::Vector2f(theCos * theVector.x + theSin * theVector.y, -theSin * theVector.x + theCos * theVector.y);
+	}
+
+	sf::Vector2f Scale(const sf::Vector2f& theVector, const sf::Vector2f& theScale)
+	{
+		return sf::Vector2f(theVector.x * theScale.x, theVector.y * theScale.y);
+	}
+
+	/// Ordena índices de cuerpos por el borde izquierdo de sus límites
+	template <typename T>
+	struct LeftEdgeLess
+	{
+		const std::vector<T>* bodies;
+
+		bool operator()(ra::Uint32 theA, ra::Uint32 theB) const
+		{
+			return (*bodies)[theA].bounds.left < (*bodies)[theB].bounds.left;
+		}
+
+		bool operator()(ra::Uint32 theA, float theLeft) const
+		{
+			return (*bodies)[theA].bounds.left < theLeft;
+		}
+
+		bool operator()(float theLeft, ra::Uint32 theB) const
+		{
+			return theLeft < (*bodies)[theB].bounds.left;
+		}
+	};
+
+	/// Ordena contactos por pareja de cuerpos y característica
+	template <typename T>
+	struct ContactLess
+	{
+		bool operator()(const T& theA, const T& theB) const
+		{
+			if (theA.first != theB.first)
+			{
+				return theA.first < theB.first;
+			}
+			if (theA.second != theB.second)
+			{
+				return theA.second < theB.second;
+			}
+			return theA.feature < theB.feature;
+		}
+	};
+
+	/// Vértice de un polígono más alejado en una dirección (en sus
+	/// coordenadas locales)
+	template <typename T>
+	sf::Vector2f GetSupport(const T& theBody, const sf::Vector2f& theDirection)
+	{
+		float best = -FLT_MAX;
+		sf::Vector2f support;
+		for (ra::Uint32 i = 0; i < theBody.count; i++)
+		{
+			float projection = Dot(theBody.vertices[i], theDirection);
+			if (projection > best)
+			{
+				best = projection;
+				support = theBody.vertices[i];
+			}
+		}
+		return support;
+	}
+
+	/**
+	 * Cara de theA con menor penetración en theB. Si es positiva las caras
+	 * de theA separan los dos polígonos
+	 */
+	template <typename T>
+	float FindAxisLeastPenetration(const T& theA, const T& theB, ra::Uint32& theFace)
+	{
+		const float cosA = std::cos(theA.angle);
+		const float sinA = std::sin(theA.angle);
+		const float cosB = std::cos(theB.angle);
+		const float sinB = std::sin(theB.angle);
+
+		float best = -FLT_MAX;
+		theFace = 0;
+		for (ra::Uint32 i = 0; i < theA.count; i++)
+		{
+			// Normal y vértice de la cara en coordenadas locales de theB
+			sf::Vector2f normal = Unrotate(Rotate(theA.normals[i], cosA, sinA), cosB, sinB);
+			sf::Vector2f vertex = Rotate(theA.vertices[i], cosA, sinA) + theA.position - theB.position;
+			vertex = Unrotate(vertex, cosB, sinB);
+
+			float distance = Dot(normal, GetSupport(theB, -normal) - vertex);
+			if (distance > best)
+			{
+				best = distance;
+				theFace = i;
+			}
+		}
+		return best;
+	}
+
+	/**
+	 * Cara de theIncident más opuesta a la cara de referencia, en
+	 * coordenadas del mundo
+	 */
+	template <typename T>
+	void FindIncidentFace(const T& theReference, const T& theIncident, ra::Uint32 theFace, sf::Vector2f* theVertices)
+	{
+		const float cosI = std::cos(theIncident.angle);
+		const float sinI = std::sin(theIncident.angle);
+		sf::Vector2f normal = Rotate(theReference.normals[theFace], std::cos(theReference.angle),
+			std::sin(theReference.angle));
+		normal = Unrotate(normal, cosI, sinI);
+
+		ra::Uint32 face = 0;
+		float lowest = FLT_MAX;
+		for (ra::Uint32 i = 0; i < theIncident.count; i++)
+		{
+			float projection = Dot(normal, theIncident.normals[i]);
+			if (projection < lowest)
+			{
+				lowest = projection;
+				face = i;
+			}
+		}
+
+		theVertices[0] = Rotate(theIncident.vertices[face], cosI, sinI) + theIncident.position;
+		face = (face + 1) % theIncident.count;
+		theVertices[1] = Rotate(theIncident.vertices[face], cosI, sinI) + theIncident.position;
+	}
+
+	/**
+	 * Recorta un segmento por el semiplano dot(theNormal, p) <= theOffset
+	 *
+	 * @return Puntos que quedan
+	 */
+	int Clip(const sf::Vector2f& theNormal, float theOffset, sf::Vector2f* theFace)
+	{
+		sf::Vector2f out[2] = { theFace[0], theFace[1] };
+		int count = 0;
+		float first = Dot(theNormal, theFace[0]) - theOffset;
+		float second = Dot(theNormal, theFace[1]) - theOffset;
+
+		if (first <= 0.f)
+		{
+			out[count++] = theFace[0];
+		}
+		if (second <= 0.f)
+		{
+			out[count++] = theFace[1];
+		}
+		if (first * second < 0.f && count < 2)
+		{
+			float alpha = first / (first - second);
+			out[count++] = theFace[0] + alpha * (theFace[1] - theFace[0]);
+		}
+
+		theFace[0] = out[0];
+		theFace[1] = out[1];
+		return count;
+	}
+}
+
+namespace ra
+{
+
+PhysicsWorld::PhysicsWorld()
+	: m_bodies()
+	, m_free()
+	, m_awake()
+	, m_sorted()
+	, m_resting()
+	, m_restingDirty(false)
+	, m_restingWidth(0.f)
+	, m_contacts()
+	, m_previous()
+	, m_woken()
+	, m_gravity(0.f, 980.f)
+	, m_step(1.f / 60.f)
+	, m_accumulator(0.f)
+	, m_iterations(10)
+{
+}
+
+void PhysicsWorld::SetGravity(const sf::Vector2f& theGravity)
+{
+	m_gravity = theGravity;
+}
+
+const sf::Vector2f& PhysicsWorld::GetGravity() const
+{
+	return m_gravity;
+}
+
+void PhysicsWorld::SetTimeStep(sf::Time theStep)
+{
+	m_step = std::max(theStep.asSeconds(), 0.001f);
+}
+
+sf::Time PhysicsWorld::GetTimeStep() const
+{
+	return sf::seconds(m_step);
+}
+
+void PhysicsWorld::SetIterations(Uint32 theIterations)
+{
+	m_iterations = std::max<Uint32>(theIterations, 1);
+}
+
+BodyHandle PhysicsWorld::AddCircle(float theRadius, const sf::Vector2f& thePosition, BodyType theType)
+{
+	BodyHandle handle = CreateBody(ShapeCircle, thePosition, theType);
+	Body& body = m_bodies[handle.index];
+	body.radius = theRadius;
+	UpdateMass(body);
+	return handle;
+}
+
+BodyHandle PhysicsWorld::AddBox(const sf::Vector2f& theSize, const sf::Vector2f& thePosition, BodyType theType)
+{
+	std::vector<sf::Vector2f> points(4);
+	points[0] = sf::Vector2f(-theSize.x / 2.f, -theSize.y / 2.f);
+	points[1] = sf::Vector2f(theSize.x / 2.f, -theSize.y / 2.f);
+	points[2] = sf::Vector2f(theSize.x / 2.f, theSize.y / 2.f);
+	points[3] = sf::Vector2f(-theSize.x / 2.f, theSize.y / 2.f);
+	return AddPolygon(points, thePosition, theType);
+}
+
+BodyHandle PhysicsWorld::AddPolygon(const std::vector<sf::Vector2f>& thePoints, const sf::Vector2f& thePosition,
+	BodyType theType)
+{
+	if (thePoints.size() < 3 || thePoints.size() > MAX_VERTICES)
+	{
+		ra::App::Instance()->log << "[error] PhysicsWorld::AddPolygon() el polígono tiene "
+			<< thePoints.size() << " vértices, debe tener entre 3 y " << MAX_VERTICES << std::endl;
+		return BodyHandle();
+	}
+
+	BodyHandle handle = CreateBody(ShapePolygon, thePosition, theType);
+	Body& body = m_bodies[handle.index];
+	body.position += SetVertices(body, thePoints);
+	UpdateMass(body);
+	return handle;
+}
+
+BodyHandle PhysicsWorld::AddBody(ra::CircleShape& theShape, BodyType theType)
+{
+	float radius = theShape.getRadius();
+	sf::Vector2f center = Scale(sf::Vector2f(radius, radius) - theShape.getOrigin(), theShape.getScale());
+	return Attach(AddCircle(radius * theShape.getScale().x, theShape.getPosition(), theType), theShape, center);
+}
+
+BodyHandle PhysicsWorld::AddBody(ra::RectangleShape& theShape, BodyType theType)
+{
+	std::vector<sf::Vector2f> points(theShape.getPointCount());
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		points[i] = Scale(theShape.getPoint(static_cast<unsigned int>(i)) - theShape.getOrigin(), theShape.getScale());
+	}
+	BodyHandle handle = AddPolygon(points, theShape.getPosition(), theType);
+	if (handle.IsNull())
+	{
+		return handle;
+	}
+	return Attach(handle, theShape, m_bodies[handle.index].position - theShape.getPosition());
+}
+
+BodyHandle PhysicsWorld::AddBody(ra::ConvexShape& theShape, BodyType theType)
+{
+	std::vector<sf::Vector2f> points(theShape.getPointCount());
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		points[i] = Scale(theShape.getPoint(static_cast<unsigned int>(i)) - theShape.getOrigin(), theShape.getScale());
+	}
+	BodyHandle handle = AddPolygon(points, theShape.getPosition(), theType);
+	if (handle.IsNull())
+	{
+		return handle;
+	}
+	return Attach(handle, theShape, m_bodies[handle.index].position - theShape.getPosition());
+}
+
+void PhysicsWorld::Bind(const BodyHandle& theBody, ra::SceneGraph& theGraph)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->graph = &theGraph;
+		body->offset = sf::Vector2f(0.f, 0.f);
+		WriteBack(*body);
+	}
+}
+
+void PhysicsWorld::RemoveBody(const BodyHandle& theBody)
+{
+	Body* body = Find(theBody);
+	if (body == NULL)
+	{
+		return;
+	}
+
+	// Lo que descansaba sobre el cuerpo tiene que despertar para caer
+	sf::FloatRect bounds = ComputeBounds(*body);
+	for (size_t i = 0; i < m_resting.size(); i++)
+	{
+		Body& resting = m_bodies[m_resting[i]];
+		if (resting.type != BodyStatic && resting.bounds.intersects(bounds))
+		{
+			WakeBody(m_resting[i]);
+		}
+	}
+
+	// Sacamos el cuerpo de los despiertos poniendo el último en su lugar
+	if (body->awake)
+	{
+		Uint32 last = m_awake.back();
+		m_awake[body->awakeIndex] = last;
+		m_bodies[last].awakeIndex = body->awakeIndex;
+		m_awake.pop_back();
+	}
+	else
+	{
+		m_restingDirty = true;
+	}
+
+	// Los contactos del último paso no pueden seguir apuntando al cuerpo
+	size_t count = 0;
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		if (m_contacts[i].first != theBody.index && m_contacts[i].second != theBody.index)
+		{
+			m_contacts[count++] = m_contacts[i];
+		}
+	}
+	m_contacts.resize(count);
+
+	Release(theBody.index);
+}
+
+void PhysicsWorld::SetMaterial(const BodyHandle& theBody, float theDensity, float theFriction, float theRestitution)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->density = theDensity;
+		body->friction = theFriction;
+		body->restitution = theRestitution;
+		UpdateMass(*body);
+		WakeBody(theBody.index);
+	}
+}
+
+void PhysicsWorld::SetFixedRotation(const BodyHandle& theBody, bool theFixed)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->fixedRotation = theFixed;
+		body->angularVelocity = 0.f;
+		UpdateMass(*body);
+		WakeBody(theBody.index);
+	}
+}
+
+void PhysicsWorld::SetPosition(const BodyHandle& theBody, const sf::Vector2f& thePosition)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->position = thePosition;
+		m_restingDirty = m_restingDirty || !body->awake;
+		WakeBody(theBody.index);
+		WriteBack(*body);
+	}
+}
+
+sf::Vector2f PhysicsWorld::GetPosition(const BodyHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body ? body->position : sf::Vector2f(0.f, 0.f);
+}
+
+void PhysicsWorld::SetRotation(const BodyHandle& theBody, float theAngle)
+{
+	Body* body = Find(theBody);
+	if (body)
+	{
+		body->angle = theAngle * PI / 180.f;
+		m_restingDirty = m_restingDirty || !body->awake;
+		WakeBody(theBody.index);
+		WriteBack(*body);
+	}
+}
+
+float PhysicsWorld::GetRotation(const BodyHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body ? body->angle * 180.f / PI : 0.f;
+}
+
+void PhysicsWorld::SetVelocity(const BodyHandle& theBody, const sf::Vector2f& theVelocity)
+{
+	Body* body = Find(theBody);
+	if (body && body->type != BodyStatic)
+	{
+		body->velocity = theVelocity;
+		WakeBody(theBody.index);
+	}
+}
+
+sf::Vector2f PhysicsWorld::GetVelocity(const BodyHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body ? body->velocity : sf::Vector2f(0.f, 0.f);
+}
+
+void PhysicsWorld::SetAngularVelocity(const BodyHandle& theBody, float theVelocity)
+{
+	Body* body = Find(theBody);
+	if (body && body->type != BodyStatic && !body->fixedRotation)
+	{
+		body->angularVelocity = theVelocity * PI / 180.f;
+		WakeBody(theBody.index);
+	}
+}
+
+float PhysicsWorld::GetAngularVelocity(const BodyHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body ? body->angularVelocity * 180.f / PI : 0.f;
+}
+
+void PhysicsWorld::ApplyForce(const BodyHandle& theBody, const sf::Vector2f& theForce)
+{
+	Body* body = Find(theBody);
+	if (body && body->type == BodyDynamic)
+	{
+		body->force += theForce;
+		WakeBody(theBody.index);
+	}
+}
+
+void PhysicsWorld::ApplyImpulse(const BodyHandle& theBody, const sf::Vector2f& theImpulse, const sf::Vector2f& thePoint)
+{
+	Body* body = Find(theBody);
+	if (body && body->type == BodyDynamic)
+	{
+		body->velocity += theImpulse * body->inverseMass;
+		body->angularVelocity += body->inverseInertia * Cross(thePoint - body->position, theImpulse);
+		WakeBody(theBody.index);
+	}
+}
+
+void PhysicsWorld::Wake(const BodyHandle& theBody)
+{
+	if (Find(theBody))
+	{
+		WakeBody(theBody.index);
+	}
+}
+
+bool PhysicsWorld::IsAwake(const BodyHandle& theBody) const
+{
+	const Body* body = Find(theBody);
+	return body && body->awake;
+}
+
+bool PhysicsWorld::IsValid(const BodyHandle& theBody) const
+{
+	return Find(theBody) != NULL;
+}
+
+void PhysicsWorld::Update(sf::Time theElapsed)
+{
+	m_accumulator += theElapsed.asSeconds();
+
+	Uint32 steps = 0;
+	while (m_accumulator >= m_step && steps < MAX_STEPS)
+	{
+		Step();
+		m_accumulator -= m_step;
+		steps++;
+	}
+
+	// Si la simulación no da abasto se ralentiza en lugar de acumular
+	// cada vez más pasos pendientes
+	if (m_accumulator >= m_step)
+	{
+		m_accumulator = 0.f;
+	}
+
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		WriteBack(m_bodies[m_awake[i]]);
+	}
+}
+
+void PhysicsWorld::Step()
+{
+	const float step = m_step;
+
+	// Fuerzas
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		Body& body = m_bodies[m_awake[i]];
+		if (body.type == BodyDynamic)
+		{
+			body.velocity += (m_gravity + body.force * body.inverseMass) * step;
+			body.force = sf::Vector2f(0.f, 0.f);
+		}
+	}
+
+	// Choques
+	FindContacts();
+	for (size_t i = 0; i < m_woken.size(); i++)
+	{
+		WakeBody(m_woken[i]);
+	}
+	PrepareContacts();
+	for (Uint32 i = 0; i < m_iterations; i++)
+	{
+		SolveContacts();
+	}
+
+	// Posiciones
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		Body& body = m_bodies[m_awake[i]];
+		body.position += body.velocity * step;
+		body.angle += body.angularVelocity * step;
+	}
+
+	UpdateSleep();
+}
+
+void PhysicsWorld::Clear()
+{
+	// Se liberan las posiciones en lugar de vaciar m_bodies para conservar
+	// las generaciones y que los handles antiguos sigan siendo inválidos
+	for (size_t i = 0; i < m_bodies.size(); i++)
+	{
+		if (m_bodies[i].active)
+		{
+			Release(static_cast<Uint32>(i));
+		}
+	}
+	m_awake.clear();
+	m_sorted.clear();
+	m_resting.clear();
+	m_restingDirty = false;
+	m_restingWidth = 0.f;
+	m_contacts.clear();
+	m_previous.clear();
+	m_woken.clear();
+	m_accumulator = 0.f;
+}
+
+size_t PhysicsWorld::GetSize() const
+{
+	return m_bodies.size() - m_free.size();
+}
+
+size_t PhysicsWorld::GetAwakeCount() const
+{
+	return m_awake.size();
+}
+
+BodyHandle PhysicsWorld::CreateBody(ShapeType theShape, const sf::Vector2f& thePosition, BodyType theType)
+{
+	Uint32 index;
+	if (m_free.empty())
+	{
+		index = static_cast<Uint32>(m_bodies.size());
+		m_bodies.push_back(Body());
+		m_bodies.back().generation = 1;
+	}
+	else
+	{
+		index = m_free.back();
+		m_free.pop_back();
+	}
+
+	Body& body = m_bodies[index];
+	body.type = theType;
+	body.shape = theShape;
+	body.radius = 0.f;
+	body.count = 0;
+	body.position = thePosition;
+	body.angle = 0.f;
+	body.velocity = sf::Vector2f(0.f, 0.f);
+	body.angularVelocity = 0.f;
+	body.force = sf::Vector2f(0.f, 0.f);
+	body.density = 1.f;
+	body.friction = 0.4f;
+	body.restitution = 0.1f;
+	body.inverseMass = 0.f;
+	body.inverseInertia = 0.f;
+	body.fixedRotation = false;
+	body.bounds = sf::FloatRect();
+	body.graph = NULL;
+	body.offset = sf::Vector2f(0.f, 0.f);
+	body.sleepTime = 0.f;
+	body.island = index;
+	body.islandSleepTime = 0.f;
+	body.awake = false;
+	body.awakeIndex = 0;
+	body.active = true;
+
+	// Los estáticos empiezan en reposo y el resto despierto
+	if (theType == BodyStatic)
+	{
+		m_restingDirty = true;
+	}
+	else
+	{
+		WakeBody(index);
+	}
+
+	return BodyHandle(index, body.generation);
+}
+
+void PhysicsWorld::Release(Uint32 theIndex)
+{
+	Body& body = m_bodies[theIndex];
+	body.active = false;
+	body.awake = false;
+	body.graph = NULL;
+	// La generación 0 queda para los handles nulos
+	body.generation = (body.generation == 0xFFFFFFFF) ? 1 : body.generation + 1;
+	m_free.push_back(theIndex);
+}
+
+sf::Vector2f PhysicsWorld::SetVertices(Body& theBody, const std::vector<sf::Vector2f>& thePoints)
+{
+	// Centro de masas como media de los triángulos desde el primer vértice
+	sf::Vector2f centroid(0.f, 0.f);
+	float area = 0.f;
+	for (size_t i = 1; i + 1 < thePoints.size(); i++)
+	{
+		float triangle = Cross(thePoints[i] - thePoints[0], thePoints[i + 1] - thePoints[0]) / 2.f;
+		centroid += triangle * (thePoints[0] + thePoints[i] + thePoints[i + 1]) / 3.f;
+		area += triangle;
+	}
+	centroid = (std::fabs(area) > FLT_EPSILON) ? centroid / area : thePoints[0];
+
+	theBody.count = static_cast<Uint32>(thePoints.size());
+	for (Uint32 i = 0; i < theBody.count; i++)
+	{
+		theBody.vertices[i] = thePoints[i] - centroid;
+	}
+
+	// Las normales (y, -x) de cada cara tienen que apuntar hacia fuera
+	if (area < 0.f)
+	{
+		std::reverse(theBody.vertices, theBody.vertices + theBody.count);
+	}
+	for (Uint32 i = 0; i < theBody.count; i++)
+	{
+		sf::Vector2f edge = theBody.vertices[(i + 1) % theBody.count] - theBody.vertices[i];
+		theBody.normals[i] = Normalize(sf::Vector2f(edge.y, -edge.x));
+	}
+	if (theBody.count > 0 && Dot(theBody.normals[0], theBody.vertices[0]) < 0.f)
+	{
+		std::reverse(theBody.vertices, theBody.vertices + theBody.count);
+		for (Uint32 i = 0; i < theBody.count; i++)
+		{
+			sf::Vector2f edge = theBody.vertices[(i + 1) % theBody.count] - theBody.vertices[i];
+			theBody.normals[i] = Normalize(sf::Vector2f(edge.y, -edge.x));
+		}
+	}
+
+	return centroid;
+}
+
+BodyHandle PhysicsWorld::Attach(const BodyHandle& theBody, ra::Shape& theShape, const sf::Vector2f& theCenter)
+{
+	Body* body = Find(theBody);
+	if (body == NULL)
+	{
+		return theBody;
+	}
+
+	// El centro del cuerpo es el punto de la figura que queda en theCenter
+	// respecto a su origen una vez rotada
+	body->angle = theShape.getRotation() * PI / 180.f;
+	body->position = theShape.getPosition() + Rotate(theCenter, std::cos(body->angle), std::sin(body->angle));
+	body->graph = &theShape;
+	body->offset = theCenter;
+	m_restingDirty = m_restingDirty || !body->awake;
+	return theBody;
+}
+
+void PhysicsWorld::UpdateMass(Body& theBody)
+{
+	float mass = 0.f;
+	float inertia = 0.f;
+	if (theBody.shape == ShapeCircle)
+	{
+		mass = PI * theBody.radius * theBody.radius * theBody.density;
+		inertia = mass * theBody.radius * theBody.radius / 2.f;
+	}
+	else
+	{
+		for (Uint32 i = 0; i < theBody.count; i++)
+		{
+			const sf::Vector2f& first = theBody.vertices[i];
+			const sf::Vector2f& second = theBody.vertices[(i + 1) % theBody.count];
+			float cross = Cross(first, second);
+			mass += cross / 2.f;
+			inertia += cross / 12.f * (Dot(first, first) + Dot(first, second) + Dot(second, second));
+		}
+		mass = std::fabs(mass) * theBody.density;
+		inertia = std::fabs(inertia) * theBody.density;
+	}
+
+	bool dynamic = theBody.type == BodyDynamic;
+	theBody.inverseMass = (dynamic && mass > 0.f) ? 1.f / mass : 0.f;
+	theBody.inverseInertia = (dynamic && !theBody.fixedRotation && inertia > 0.f) ? 1.f / inertia : 0.f;
+}
+
+PhysicsWorld::Body* PhysicsWorld::Find(const BodyHandle& theBody)
+{
+	if (theBody.index >= m_bodies.size())
+	{
+		return NULL;
+	}
+	Body& body = m_bodies[theBody.index];
+	return (body.active && body.generation == theBody.generation) ? &body : NULL;
+}
+
+const PhysicsWorld::Body* PhysicsWorld::Find(const BodyHandle& theBody) const
+{
+	if (theBody.index >= m_bodies.size())
+	{
+		return NULL;
+	}
+	const Body& body = m_bodies[theBody.index];
+	return (body.active && body.generation == theBody.generation) ? &body : NULL;
+}
+
+void PhysicsWorld::WakeBody(Uint32 theIndex)
+{
+	Body& body = m_bodies[theIndex];
+	if (!body.active || body.awake || body.type == BodyStatic)
+	{
+		return;
+	}
+	body.awake = true;
+	body.sleepTime = 0.f;
+	body.awakeIndex = static_cast<Uint32>(m_awake.size());
+	m_awake.push_back(theIndex);
+	m_restingDirty = true;
+}
+
+sf::FloatRect PhysicsWorld::ComputeBounds(const Body& theBody) const
+{
+	// Los límites incluyen el margen de contacto
+	if (theBody.shape == ShapeCircle)
+	{
+		const float radius = theBody.radius + CONTACT_MARGIN;
+		return sf::FloatRect(theBody.position.x - radius, theBody.position.y - radius, 2.f * radius, 2.f * radius);
+	}
+
+	const float cosA = std::cos(theBody.angle);
+	const float sinA = std::sin(theBody.angle);
+	sf::Vector2f low(FLT_MAX, FLT_MAX);
+	sf::Vector2f high(-FLT_MAX, -FLT_MAX);
+	for (Uint32 i = 0; i < theBody.count; i++)
+	{
+		sf::Vector2f vertex = Rotate(theBody.vertices[i], cosA, sinA);
+		low.x = std::min(low.x, vertex.x);
+		low.y = std::min(low.y, vertex.y);
+		high.x = std::max(high.x, vertex.x);
+		high.y = std::max(high.y, vertex.y);
+	}
+	low -= sf::Vector2f(CONTACT_MARGIN, CONTACT_MARGIN);
+	high += sf::Vector2f(CONTACT_MARGIN, CONTACT_MARGIN);
+	return sf::FloatRect(theBody.position.x + low.x, theBody.position.y + low.y, high.x - low.x, high.y - low.y);
+}
+
+void PhysicsWorld::FindContacts()
+{
+	// Guardamos los contactos del paso anterior para empezar el solver con
+	// sus impulsos
+	m_previous.swap(m_contacts);
+	m_contacts.clear();
+	std::sort(m_previous.begin(), m_previous.end(), ContactLess<Contact>());
+	m_woken.clear();
+	if (m_restingDirty)
+	{
+		RebuildResting();
+	}
+
+	LeftEdgeLess<Body> less;
+	less.bodies = &m_bodies;
+
+	// Despiertos entre sí: barrido sobre el eje X como en CollisionWorld
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		Body& body = m_bodies[m_awake[i]];
+		body.bounds = ComputeBounds(body);
+	}
+	m_sorted = m_awake;
+	std::sort(m_sorted.begin(), m_sorted.end(), less);
+	for (size_t i = 0; i < m_sorted.size(); i++)
+	{
+		const sf::FloatRect& a = m_bodies[m_sorted[i]].bounds;
+		for (size_t j = i + 1; j < m_sorted.size() && m_bodies[m_sorted[j]].bounds.left < a.left + a.width; j++)
+		{
+			const sf::FloatRect& b = m_bodies[m_sorted[j]].bounds;
+			if (b.top < a.top + a.height && a.top < b.top + b.height)
+			{
+				Collide(m_sorted[i], m_sorted[j]);
+			}
+		}
+	}
+
+	// Despiertos contra estáticos y dormidos: los que están en reposo no se
+	// recorren, solo se buscan en su array ordenado
+	for (size_t i = 0; i < m_sorted.size(); i++)
+	{
+		const Body& body = m_bodies[m_sorted[i]];
+		const sf::FloatRect& a = body.bounds;
+		std::vector<Uint32>::const_iterator it = std::lower_bound(m_resting.begin(), m_resting.end(),
+			a.left - m_restingWidth, less);
+		for (; it != m_resting.end() && m_bodies[*it].bounds.left < a.left + a.width; it++)
+		{
+			const Body& resting = m_bodies[*it];
+			const sf::FloatRect& b = resting.bounds;
+			if (b.left + b.width <= a.left || b.top >= a.top + a.height || a.top >= b.top + b.height)
+			{
+				continue;
+			}
+			if (body.inverseMass == 0.f && resting.inverseMass == 0.f)
+			{
+				continue;
+			}
+
+			size_t count = m_contacts.size();
+			Collide(m_sorted[i], *it);
+			if (m_contacts.size() > count && resting.type != BodyStatic)
+			{
+				m_woken.push_back(*it);
+			}
+		}
+	}
+}
+
+void PhysicsWorld::Collide(Uint32 theFirst, Uint32 theSecond)
+{
+	const Body& first = m_bodies[theFirst];
+	const Body& second = m_bodies[theSecond];
+	if (first.inverseMass == 0.f && second.inverseMass == 0.f)
+	{
+		return;
+	}
+
+	// Con formas iguales la pareja va siempre en el mismo orden para que
+	// sus contactos se reconozcan en el paso siguiente
+	if (first.shape == second.shape && theFirst > theSecond)
+	{
+		std::swap(theFirst, theSecond);
+	}
+
+	if (first.shape == ShapeCircle && second.shape == ShapeCircle)
+	{
+		CollideCircles(theFirst, theSecond);
+	}
+	else if (first.shape == ShapePolygon && second.shape == ShapeCircle)
+	{
+		CollidePolygonCircle(theFirst, theSecond);
+	}
+	else if (first.shape == ShapeCircle && second.shape == ShapePolygon)
+	{
+		CollidePolygonCircle(theSecond, theFirst);
+	}
+	else
+	{
+		CollidePolygons(theFirst, theSecond);
+	}
+}
+
+void PhysicsWorld::CollideCircles(Uint32 theFirst, Uint32 theSecond)
+{
+	const Body& first = m_bodies[theFirst];
+	const Body& second = m_bodies[theSecond];
+	sf::Vector2f delta = second.position - first.position;
+	float radius = first.radius + second.radius;
+	float distanceSquared = LengthSquared(delta);
+	if (distanceSquared >= (radius + CONTACT_MARGIN) * (radius + CONTACT_MARGIN))
+	{
+		return;
+	}
+
+	float distance = std::sqrt(distanceSquared);
+	sf::Vector2f normal = (distance > FLT_EPSILON) ? delta / distance : sf::Vector2f(0.f, 1.f);
+	AddContact(theFirst, theSecond, normal, first.position + normal * first.radius, radius - distance);
+}
+
+void PhysicsWorld::CollidePolygonCircle(Uint32 thePolygon, Uint32 theCircle)
+{
+	const Body& polygon = m_bodies[thePolygon];
+	const Body& circle = m_bodies[theCircle];
+	const float cosA = std::cos(polygon.angle);
+	const float sinA = std::sin(polygon.angle);
+
+	// Centro del círculo en coordenadas locales del polígono
+	sf::Vector2f center = Unrotate(circle.position - polygon.position, cosA, sinA);
+
+	float separation = -FLT_MAX;
+	Uint32 face = 0;
+	for (Uint32 i = 0; i < polygon.count; i++)
+	{
+		float distance = Dot(polygon.normals[i], center - polygon.vertices[i]);
+		if (distance > circle.radius + CONTACT_MARGIN)
+		{
+			return;
+		}
+		if (distance > separation)
+		{
+			separation = distance;
+			face = i;
+		}
+	}
+
+	// Centro dentro del polígono: sale por la cara más cercana. La
+	// característica del contacto es la cara o el vértice que toca
+	if (separation < FLT_EPSILON)
+	{
+		sf::Vector2f normal = Rotate(polygon.normals[face], cosA, sinA);
+		AddContact(thePolygon, theCircle, normal, circle.position - normal * circle.radius,
+			circle.radius - separation, face);
+		return;
+	}
+
+	// Si el centro queda fuera del segmento de la cara toca en un vértice
+	const sf::Vector2f& first = polygon.vertices[face];
+	const sf::Vector2f& second = polygon.vertices[(face + 1) % polygon.count];
+	const sf::Vector2f* corner = NULL;
+	Uint32 vertex = face;
+	if (Dot(center - first, second - first) <= 0.f)
+	{
+		corner = &first;
+	}
+	else if (Dot(center - second, first - second) <= 0.f)
+	{
+		corner = &second;
+		vertex = (face + 1) % polygon.count;
+	}
+
+	if (corner)
+	{
+		sf::Vector2f delta = center - *corner;
+		float distanceSquared = LengthSquared(delta);
+		if (distanceSquared > (circle.radius + CONTACT_MARGIN) * (circle.radius + CONTACT_MARGIN))
+		{
+			return;
+		}
+		sf::Vector2f normal = Rotate(Normalize(delta), cosA, sinA);
+		AddContact(thePolygon, theCircle, normal, Rotate(*corner, cosA, sinA) + polygon.position,
+			circle.radius - std::sqrt(distanceSquared), MAX_VERTICES + vertex);
+		return;
+	}
+
+	sf::Vector2f normal = Rotate(polygon.normals[face], cosA, sinA);
+	AddContact(thePolygon, theCircle, normal, circle.position - normal * circle.radius, circle.radius - separation,
+		face);
+}
+
+void PhysicsWorld::CollidePolygons(Uint32 theFirst, Uint32 theSecond)
+{
+	const Body& first = m_bodies[theFirst];
+	const Body& second = m_bodies[theSecond];
+
+	// Teorema del eje separador con las caras de los dos polígonos
+	Uint32 faceFirst;
+	float penetrationFirst = FindAxisLeastPenetration(first, second, faceFirst);
+	if (penetrationFirst >= CONTACT_MARGIN)
+	{
+		return;
+	}
+	Uint32 faceSecond;
+	float penetrationSecond = FindAxisLeastPenetration(second, first, faceSecond);
+	if (penetrationSecond >= CONTACT_MARGIN)
+	{
+		return;
+	}
+
+	// La cara de referencia es la de menor penetración, con un margen para
+	// que no alterne entre pasos cuando son casi iguales
+	const Body* reference = &first;
+	const Body* incident = &second;
+	Uint32 face = faceFirst;
+	bool flip = false;
+	if (penetrationFirst < penetrationSecond * 0.95f + penetrationFirst * 0.01f)
+	{
+		reference = &second;
+		incident = &first;
+		face = faceSecond;
+		flip = true;
+	}
+
+	sf::Vector2f incidentFace[2];
+	FindIncidentFace(*reference, *incident, face, incidentFace);
+
+	const float cosR = std::cos(reference->angle);
+	const float sinR = std::sin(reference->angle);
+	sf::Vector2f v1 = Rotate(reference->vertices[face], cosR, sinR) + reference->position;
+	sf::Vector2f v2 = Rotate(reference->vertices[(face + 1) % reference->count], cosR, sinR) + reference->position;
+
+	// Recortamos la cara incidente por los lados de la de referencia
+	sf::Vector2f side = Normalize(v2 - v1);
+	sf::Vector2f normal(side.y, -side.x);
+	if (Clip(-side, -Dot(side, v1), incidentFace) < 2 || Clip(side, Dot(side, v2), incidentFace) < 2)
+	{
+		return;
+	}
+
+	// Solo cuentan los puntos que quedan detrás de la cara de referencia.
+	// Cada punto se identifica entre pasos por su orden a lo largo de la
+	// tangente del contacto: el vértice del que sale o la cara de referencia
+	// no sirven porque con caras alineadas cambian de un paso a otro
+	const float offset = Dot(normal, v1);
+	const sf::Vector2f contactNormal = flip ? -normal : normal;
+	const sf::Vector2f tangent(-contactNormal.y, contactNormal.x);
+	const Uint32 firstAlong = (Dot(tangent, incidentFace[0]) <= Dot(tangent, incidentFace[1])) ? 0 : 1;
+	for (Uint32 i = 0; i < 2; i++)
+	{
+		float separation = Dot(normal, incidentFace[i]) - offset;
+		if (separation <= CONTACT_MARGIN)
+		{
+			AddContact(theFirst, theSecond, contactNormal, incidentFace[i], -separation, i ^ firstAlong);
+		}
+	}
+}
+
+void PhysicsWorld::AddContact(Uint32 theFirst, Uint32 theSecond, const sf::Vector2f& theNormal,
+	const sf::Vector2f& thePoint, float thePenetration, Uint32 theFeature)
+{
+	Contact contact;
+	contact.first = theFirst;
+	contact.second = theSecond;
+	contact.feature = theFeature;
+	contact.normal = theNormal;
+	contact.point = thePoint;
+	contact.penetration = thePenetration;
+	contact.offsetFirst = sf::Vector2f(0.f, 0.f);
+	contact.offsetSecond = sf::Vector2f(0.f, 0.f);
+	contact.normalMass = 0.f;
+	contact.tangentMass = 0.f;
+	contact.friction = 0.f;
+	contact.bias = 0.f;
+	contact.normalImpulse = 0.f;
+	contact.tangentImpulse = 0.f;
+
+	// Si el mismo punto ya existía en el paso anterior heredamos sus
+	// impulsos (warm starting), así las pilas convergen en pocas pasadas
+	std::vector<Contact>::const_iterator previous = std::lower_bound(m_previous.begin(), m_previous.end(),
+		contact, ContactLess<Contact>());
+	if (previous != m_previous.end() && previous->first == theFirst && previous->second == theSecond &&
+		previous->feature == theFeature)
+	{
+		contact.normalImpulse = previous->normalImpulse;
+		contact.tangentImpulse = previous->tangentImpulse;
+	}
+
+	m_contacts.push_back(contact);
+}
+
+void PhysicsWorld::PrepareContacts()
+{
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		Contact& contact = m_contacts[i];
+		const Body& first = m_bodies[contact.first];
+		const Body& second = m_bodies[contact.second];
+
+		contact.offsetFirst = contact.point - first.position;
+		contact.offsetSecond = contact.point - second.position;
+
+		float normalFirst = Cross(contact.offsetFirst, contact.normal);
+		float normalSecond = Cross(contact.offsetSecond, contact.normal);
+		float normalMass = first.inverseMass + second.inverseMass +
+			first.inverseInertia * normalFirst * normalFirst + second.inverseInertia * normalSecond * normalSecond;
+		contact.normalMass = (normalMass > 0.f) ? 1.f / normalMass : 0.f;
+
+		sf::Vector2f tangent(-contact.normal.y, contact.normal.x);
+		float tangentFirst = Cross(contact.offsetFirst, tangent);
+		float tangentSecond = Cross(contact.offsetSecond, tangent);
+		float tangentMass = first.inverseMass + second.inverseMass +
+			first.inverseInertia * tangentFirst * tangentFirst + second.inverseInertia * tangentSecond * tangentSecond;
+		contact.tangentMass = (tangentMass > 0.f) ? 1.f / tangentMass : 0.f;
+
+		contact.friction = std::sqrt(first.friction * second.friction);
+
+		// Corrección de la penetración (Baumgarte) y rebote si el choque es
+		// lo bastante rápido. Si aún no se tocan solo se impide que se
+		// acerquen más de lo que les separa en este paso
+		if (contact.penetration < 0.f)
+		{
+			contact.bias = contact.penetration / m_step;
+		}
+		else
+		{
+			contact.bias = BAUMGARTE / m_step * std::max(0.f, contact.penetration - PENETRATION_SLOP);
+		}
+		sf::Vector2f relative = second.velocity + Cross(second.angularVelocity, contact.offsetSecond) -
+			first.velocity - Cross(first.angularVelocity, contact.offsetFirst);
+		float normalVelocity = Dot(relative, contact.normal);
+		if (normalVelocity < -RESTITUTION_THRESHOLD)
+		{
+			float restitution = std::max(first.restitution, second.restitution);
+			contact.bias = std::max(contact.bias, -restitution * normalVelocity);
+		}
+	}
+
+	// Aplicamos de entrada los impulsos heredados del paso anterior, después
+	// de calcular todos los rebotes con las velocidades sin tocar
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		const Contact& contact = m_contacts[i];
+		sf::Vector2f tangent(-contact.normal.y, contact.normal.x);
+		ApplyContactImpulse(contact, contact.normal * contact.normalImpulse + tangent * contact.tangentImpulse);
+	}
+}
+
+void PhysicsWorld::SolveContacts()
+{
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		Contact& contact = m_contacts[i];
+
+		// Los dos puntos de una pareja de polígonos van seguidos y se
+		// resuelven a la vez; uno detrás de otro el primero se lleva todo el
+		// impulso y hace girar al cuerpo, lo que acaba tumbando las pilas
+		if (i + 1 < m_contacts.size() && m_contacts[i + 1].first == contact.first &&
+			m_contacts[i + 1].second == contact.second && SolveNormals(contact, m_contacts[i + 1]))
+		{
+			SolveFriction(contact);
+			SolveFriction(m_contacts[i + 1]);
+			i++;
+			continue;
+		}
+
+		SolveNormal(contact);
+		SolveFriction(contact);
+	}
+}
+
+void PhysicsWorld::SolveNormal(Contact& theContact)
+{
+	Body& first = m_bodies[theContact.first];
+	Body& second = m_bodies[theContact.second];
+
+	// Impulso normal, acumulado y siempre de separación
+	sf::Vector2f relative = second.velocity + Cross(second.angularVelocity, theContact.offsetSecond) -
+		first.velocity - Cross(first.angularVelocity, theContact.offsetFirst);
+	float impulse = theContact.normalMass * (theContact.bias - Dot(relative, theContact.normal));
+	float previous = theContact.normalImpulse;
+	theContact.normalImpulse = std::max(previous + impulse, 0.f);
+	ApplyContactImpulse(theContact, theContact.normal * (theContact.normalImpulse - previous));
+}
+
+bool PhysicsWorld::SolveNormals(Contact& theFirst, Contact& theSecond)
+{
+	Body& first = m_bodies[theFirst.first];
+	Body& second = m_bodies[theFirst.second];
+	const sf::Vector2f& normal = theFirst.normal;
+
+	// Matriz de masas efectivas de los dos puntos
+	float firstA = Cross(theFirst.offsetFirst, normal);
+	float firstB = Cross(theFirst.offsetSecond, normal);
+	float secondA = Cross(theSecond.offsetFirst, normal);
+	float secondB = Cross(theSecond.offsetSecond, normal);
+	float mass = first.inverseMass + second.inverseMass;
+	float k11 = mass + first.inverseInertia * firstA * firstA + second.inverseInertia * firstB * firstB;
+	float k22 = mass + first.inverseInertia * secondA * secondA + second.inverseInertia * secondB * secondB;
+	float k12 = mass + first.inverseInertia * firstA * secondA + second.inverseInertia * firstB * secondB;
+	float determinant = k11 * k22 - k12 * k12;
+
+	// Si los puntos están casi en el mismo sitio la matriz no se puede
+	// invertir con precisión y se resuelven por separado
+	if (k11 * k11 >= 1000.f * determinant)
+	{
+		return false;
+	}
+
+	// Buscamos impulsos acumulados x >= 0 con velocidad normal final
+	// v = K * x + b >= 0 y x * v = 0 para cada punto, probando los cuatro
+	// casos: los dos empujan, solo el primero, solo el segundo o ninguno
+	sf::Vector2f relative = second.velocity + Cross(second.angularVelocity, theFirst.offsetSecond) -
+		first.velocity - Cross(first.angularVelocity, theFirst.offsetFirst);
+	float b1 = Dot(relative, normal) - theFirst.bias;
+	relative = second.velocity + Cross(second.angularVelocity, theSecond.offsetSecond) -
+		first.velocity - Cross(first.angularVelocity, theSecond.offsetFirst);
+	float b2 = Dot(relative, normal) - theSecond.bias;
+
+	const float a1 = theFirst.normalImpulse;
+	const float a2 = theSecond.normalImpulse;
+	b1 -= k11 * a1 + k12 * a2;
+	b2 -= k12 * a1 + k22 * a2;
+
+	float x1 = (k12 * b2 - k22 * b1) / determinant;
+	float x2 = (k12 * b1 - k11 * b2) / determinant;
+	if (x1 < 0.f || x2 < 0.f)
+	{
+		x1 = -b1 / k11;
+		x2 = 0.f;
+		if (x1 < 0.f || k12 * x1 + b2 < 0.f)
+		{
+			x1 = 0.f;
+			x2 = -b2 / k22;
+			if (x2 < 0.f || k12 * x2 + b1 < 0.f)
+			{
+				x2 = 0.f;
+				if (b1 < 0.f || b2 < 0.f)
+				{
+					// No hay solución con estos casos, se deja como está
+					return true;
+				}
+			}
+		}
+	}
+
+	theFirst.normalImpulse = x1;
+	theSecond.normalImpulse = x2;
+	ApplyContactImpulse(theFirst, normal * (x1 - a1));
+	ApplyContactImpulse(theSecond, normal * (x2 - a2));
+	return true;
+}
+
+void PhysicsWorld::SolveFriction(Contact& theContact)
+{
+	Body& first = m_bodies[theContact.first];
+	Body& second = m_bodies[theContact.second];
+
+	// Rozamiento, limitado por el impulso normal acumulado
+	sf::Vector2f relative = second.velocity + Cross(second.angularVelocity, theContact.offsetSecond) -
+		first.velocity - Cross(first.angularVelocity, theContact.offsetFirst);
+	sf::Vector2f tangent(-theContact.normal.y, theContact.normal.x);
+	float impulse = -theContact.tangentMass * Dot(relative, tangent);
+	float limit = theContact.friction * theContact.normalImpulse;
+	float previous = theContact.tangentImpulse;
+	theContact.tangentImpulse = std::max(-limit, std::min(previous + impulse, limit));
+	ApplyContactImpulse(theContact, tangent * (theContact.tangentImpulse - previous));
+}
+
+void PhysicsWorld::ApplyContactImpulse(const Contact& theContact, const sf::Vector2f& theImpulse)
+{
+	Body& first = m_bodies[theContact.first];
+	Body& second = m_bodies[theContact.second];
+	first.velocity -= theImpulse * first.inverseMass;
+	first.angularVelocity -= first.inverseInertia * Cross(theContact.offsetFirst, theImpulse);
+	second.velocity += theImpulse * second.inverseMass;
+	second.angularVelocity += second.inverseInertia * Cross(theContact.offsetSecond, theImpulse);
+}
+
+void PhysicsWorld::UpdateSleep()
+{
+	// Cada cuerpo despierto empieza siendo su propia isla
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		Body& body = m_bodies[m_awake[i]];
+		bool still = LengthSquared(body.velocity) < SLEEP_LINEAR_VELOCITY * SLEEP_LINEAR_VELOCITY &&
+			std::fabs(body.angularVelocity) < SLEEP_ANGULAR_VELOCITY;
+		body.sleepTime = still ? body.sleepTime + m_step : 0.f;
+		body.island = m_awake[i];
+		body.islandSleepTime = body.sleepTime;
+	}
+
+	// Los contactos entre cuerpos dinámicos unen islas; los estáticos y
+	// cinemáticos no las propagan
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		const Contact& contact = m_contacts[i];
+		if (m_bodies[contact.first].type != BodyDynamic || m_bodies[contact.second].type != BodyDynamic)
+		{
+			continue;
+		}
+		Uint32 first = FindIsland(contact.first);
+		Uint32 second = FindIsland(contact.second);
+		if (first != second)
+		{
+			m_bodies[second].island = first;
+			m_bodies[first].islandSleepTime = std::min(m_bodies[first].islandSleepTime,
+				m_bodies[second].islandSleepTime);
+		}
+	}
+
+	// Una isla duerme entera cuando su cuerpo más inquieto lleva el tiempo
+	// suficiente quieto
+	size_t count = 0;
+	for (size_t i = 0; i < m_awake.size(); i++)
+	{
+		Body& body = m_bodies[m_awake[i]];
+		if (m_bodies[FindIsland(m_awake[i])].islandSleepTime < TIME_TO_SLEEP)
+		{
+			body.awakeIndex = static_cast<Uint32>(count);
+			m_awake[count++] = m_awake[i];
+			continue;
+		}
+		body.awake = false;
+		body.velocity = sf::Vector2f(0.f, 0.f);
+		body.angularVelocity = 0.f;
+		WriteBack(body);
+		m_restingDirty = true;
+	}
+	m_awake.resize(count);
+}
+
+Uint32 PhysicsWorld::FindIsland(Uint32 theIndex)
+{
+	Uint32 root = theIndex;
+	while (m_bodies[root].island != root)
+	{
+		root = m_bodies[root].island;
+	}
+
+	// Acortamos el camino para las siguientes búsquedas
+	while (m_bodies[theIndex].island != root)
+	{
+		Uint32 next = m_bodies[theIndex].island;
+		m_bodies[theIndex].island = root;
+		theIndex = next;
+	}
+	return root;
+}
+
+void PhysicsWorld::RebuildResting()
+{
+	m_resting.clear();
+	m_restingWidth = 0.f;
+	for (size_t i = 0; i < m_bodies.size(); i++)
+	{
+		Body& body = m_bodies[i];
+		if (body.active && !body.awake)
+		{
+			body.bounds = ComputeBounds(body);
+			m_restingWidth = std::max(m_restingWidth, body.bounds.width);
+			m_resting.push_back(static_cast<Uint32>(i));
+		}
+	}
+
+	LeftEdgeLess<Body> less;
+	less.bodies = &m_bodies;
+	std::sort(m_resting.begin(), m_resting.end(), less);
+	m_restingDirty = false;
+}
+
+void PhysicsWorld::WriteBack(const Body& theBody) const
+{
+	if (theBody.graph == NULL)
+	{
+		return;
+	}
+	const float cosA = std::cos(theBody.angle);
+	const float sinA = std::sin(theBody.angle);
+	theBody.graph->setRotation(theBody.angle * 180.f / PI);
+	theBody.graph->setPosition(theBody.position - Rotate(theBody.offset, cosA, sinA));
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/PostProcess.hpp>
+#include <RAGE/Core/RenderStats.hpp>
+
+namespace ra
+{
+
+PostProcess* PostProcess::ms_instance = 0;
+
+PostProcess::PostProcess()
+	: m_app(ra::App::Instance())
+	, m_passes()
+	, m_freeTargets()
+	, m_size(0, 0)
+	, m_scene(NULL)
+{
+	m_app->log << "PostProcess::ctor()" << std::endl;
+}
+
+PostProcess::~PostProcess()
+{
+	Cleanup();
+	m_app->log << "PostProcess::dtor()" << std::endl;
+}
+
+PostProcess* PostProcess::Instance()
+{
+	if(ms_instance == 0)
+	{
+		ms_instance = new PostProcess();
+	}
+	return ms_instance;
+}
+
+void PostProcess::Release()
+{
+	if(ms_instance)
+	{
+		delete ms_instance;
+	}
+	ms_instance = 0;
+}
+
+bool PostProcess::AddPass(const std::string& theName, const std::string& theFilename, PassScale theScale)
+{
+	if (!sf::Shader::isAvailable())
+	{
+		m_app->log << "[error] PostProcess::AddPass() la tarjeta gráfica no soporta shaders, se ignora el paso "
+			<< theName << std::endl;
+		return false;
+	}
+
+	sf::Shader* shader = new sf::Shader();
+	if (!shader->loadFromFile(theFilename, sf::Shader::Fragment))
+	{
+		m_app->log << "[error] PostProcess::AddPass() no se ha podido cargar el shader " << theFilename << std::endl;
+		delete shader;
+		return false;
+	}
+
+	Pass* pass = FindPass(theName);
+	if (pass != NULL)
+	{
+		delete pass->shader;
+		pass->shader = shader;
+		pass->scale = theScale;
+		return true;
+	}
+
+	Pass newPass;
+	newPass.name = theName;
+	newPass.shader = shader;
+	newPass.scale = theScale;
+	newPass.enabled = true;
+	m_passes.push_back(newPass);
+
+	return true;
+}
+
+void PostProcess::RemovePass(const std::string& theName)
+{
+	std::vector<Pass>::iterator it;
+	for (it = m_passes.begin(); it != m_passes.end(); it++)
+	{
+		if (it->name == theName)
+		{
+			delete it->shader;
+			m_passes.erase(it);
+			return;
+		}
+	}
+}
+
+void PostProcess::SetPassEnabled(const std::string& theName, bool theEnabled)
+{
+	Pass* pass = FindPass(theName);
+	if (pass == NULL)
+	{
+		m_app->log << "[warn] PostProcess::SetPassEnabled() no existe el paso " << theName << std::endl;
+		return;
+	}
+	pass->enabled = theEnabled;
+}
+
+bool PostProcess::IsPassEnabled(const std::string& theName) const
+{
+	const Pass* pass = FindPass(theName);
+	return pass != NULL && pass->enabled;
+}
+
+void PostProcess::SetPassScale(const std::string& theName, PassScale theScale)
+{
+	Pass* pass = FindPass(theName);
+	if (pass != NULL)
+	{
+		pass->scale = theScale;
+	}
+}
+
+sf::Shader* PostProcess::GetShader(const std::string& theName)
+{
+	Pass* pass = FindPass(theName);
+	return (pass != NULL) ? pass->shader : NULL;
+}
+
+bool PostProcess::IsActive() const
+{
+	for (size_t i = 0; i < m_passes.size(); i++)
+	{
+		if (m_passes[i].enabled)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+sf::RenderTarget& PostProcess::GetRenderTarget()
+{
+	if (m_scene != NULL)
+	{
+		return *m_scene;
+	}
+	return m_app->window;
+}
+
+void PostProcess::Begin()
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	// Las texturas de un tamaño anterior de la ventana se descartan
+	sf::Vector2u size = m_app->window.getSize();
+	if (size != m_size)
+	{
+		ClearTargets();
+		m_size = size;
+	}
+
+	// Sin textura este frame se dibuja sin efectos, directamente en la ventana
+	m_scene = AcquireTarget(m_size);
+	if (m_scene == NULL)
+	{
+		return;
+	}
+	ra::RenderStats::SetView(*m_scene, m_app->window.getView());
+}
+
+void PostProcess::End()
+{
+	if (m_scene == NULL)
+	{
+		return;
+	}
+	m_scene->display();
+
+	// Buscamos el último paso activo, que dibuja directamente en la ventana
+	// si lo hace a resolución completa
+	size_t last = m_passes.size();
+	for (size_t i = 0; i < m_passes.size(); i++)
+	{
+		if (m_passes[i].enabled)
+		{
+			last = i;
+		}
+	}
+
+	// La vista por defecto de la ventana no cambia al redimensionarla, así
+	// que usamos una del tamaño actual
+	sf::View view = m_app->window.getView();
+	ra::RenderStats::SetView(m_app->window, sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(m_size.x),
+		static_cast<float>(m_size.y))));
+
+	sf::RenderTexture* source = m_scene;
+	for (size_t i = 0; i < m_passes.size(); i++)
+	{
+		const Pass& pass = m_passes[i];
+		if (!pass.enabled)
+		{
+			continue;
+		}
+
+		sf::Vector2u sourceSize = source->getSize();
+		pass.shader->setParameter("texture", sf::Shader::CurrentTexture);
+		pass.shader->setParameter("textureSize", static_cast<float>(sourceSize.x), static_cast<float>(sourceSize.y));
+
+		if (i == last && pass.scale == PassFull)
+		{
+			DrawTexture(source->getTexture(), m_app->window, pass.shader);
+			RecycleTarget(source);
+			source = NULL;
+			break;
+		}
+
+		// Alternamos entre texturas: la salida de este paso es la entrada del
+		// siguiente y la anterior vuelve al pool
+		sf::Vector2u size(std::max(m_size.x / pass.scale, 1u), std::max(m_size.y / pass.scale, 1u));
+		sf::RenderTexture* target = AcquireTarget(size);
+		if (target == NULL)
+		{
+			// Sin textura para este paso nos saltamos el resto de la cadena y
+			// llevamos a la ventana lo que ya tenemos
+			break;
+		}
+		ra::RenderStats::SetView(*target, target->getDefaultView());
+		DrawTexture(source->getTexture(), *target, pass.shader);
+		target->display();
+		RecycleTarget(source);
+		source = target;
+	}
+
+	// El último paso era a resolución reducida o la cadena se ha cortado, lo
+	// ampliamos a la ventana
+	if (source != NULL)
+	{
+		DrawTexture(source->getTexture(), m_app->window, NULL);
+		RecycleTarget(source);
+	}
+
+	ra::RenderStats::SetView(m_app->window, view);
+	m_scene = NULL;
+}
+
+void PostProcess::Cleanup()
+{
+	if (m_scene != NULL)
+	{
+		RecycleTarget(m_scene);
+		m_scene = NULL;
+	}
+	ClearTargets();
+
+	std::vector<Pass>::iterator it;
+	for (it = m_passes.begin(); it != m_passes.end(); it++)
+	{
+		delete it->shader;
+	}
+	m_passes.clear();
+}
+
+PostProcess::Pass* PostProcess::FindPass(const std::string& theName)
+{
+	for (size_t i = 0; i < m_passes.size(); i++)
+	{
+		if (m_passes[i].name == theName)
+		{
+			return &m_passes[i];
+		}
+	}
+	return NULL;
+}
+
+const PostProcess::Pass* PostProcess::FindPass(const std::string& theName) const
+{
+	for (size_t i = 0; i < m_passes.size(); i++)
+	{
+		if (m_passes[i].name == theName)
+		{
+			return &m_passes[i];
+		}
+	}
+	return NULL;
+}
+
+sf::RenderTexture* PostProcess::AcquireTarget(const sf::Vector2u& theSize)
+{
+	std::vector<sf::RenderTexture*>::iterator it;
+	for (it = m_freeTargets.begin(); it != m_freeTargets.end(); it++)
+	{
+		if ((*it)->getSize() == theSize)
+		{
+			sf::RenderTexture* target = *it;
+			m_freeTargets.erase(it);
+			return target;
+		}
+	}
+
+	sf::RenderTexture* target = new sf::RenderTexture();
+	if (!target->create(theSize.x, theSize.y))
+	{
+		m_app->log << "[error] PostProcess::AcquireTarget() no se ha podido crear la textura ("
+			<< theSize.x << ", " << theSize.y << ")" << std::endl;
+		delete target;
+		return NULL;
+	}
+	// Los pasos a resolución reducida se amplían con filtrado
+	target->setSmooth(true);
+
+	return target;
+}
+
+void PostProcess::RecycleTarget(sf::RenderTexture* theTarget)
+{
+	m_freeTargets.push_back(theTarget);
+}
+
+void PostProcess::ClearTargets()
+{
+	std::vector<sf::RenderTexture*>::iterator it;
+	for (it = m_freeTargets.begin(); it != m_freeTargets.end(); it++)
+	{
+		delete *it;
+	}
+	m_freeTargets.clear();
+}
+
+void PostProcess::DrawTexture(const sf::Texture& theTexture, sf::RenderTarget& theTarget, sf::Shader* theShader)
+{
+	sf::Vector2u textureSize = theTexture.getSize();
+	sf::Vector2u targetSize = theTarget.getSize();
+
+	sf::Sprite sprite(theTexture);
+	sprite.setScale(static_cast<float>(targetSize.x) / textureSize.x,
+		static_cast<float>(targetSize.y) / textureSize.y);
+	ra::RenderStats::Draw(theTarget, sprite, sf::RenderStates(theShader));
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <RAGE/Core/RenderStats.hpp>
+
+namespace
+{
+	/// Suma de los contadores de muchos frames
+	struct RenderTotals
+	{
+		ra::Uint64 drawCalls;
+		ra::Uint64 vertices;
+		ra::Uint64 primitives;
+		ra::Uint64 textureBinds;
+		ra::Uint64 viewChanges;
+		ra::Uint64 shaderSwitches;
+		ra::Uint64 drawn;
+		ra::Uint64 culled;
+	};
+
+	/// Contadores del frame que se está dibujando
+	ra::RenderCounters s_current = ra::RenderCounters();
+	/// Contadores del último frame terminado
+	ra::RenderCounters s_frame = ra::RenderCounters();
+	/// Suma y máximo de los frames terminados, para el informe
+	RenderTotals s_total = RenderTotals();
+	ra::RenderCounters s_peak = ra::RenderCounters();
+	/// Frames terminados
+	ra::Uint32 s_frameCount = 0;
+	/// Textura y shader del último dibujado
+	const sf::Texture* s_texture = NULL;
+	const sf::Shader* s_shader = NULL;
+
+	/// Número de primitivas que forman theCount vértices
+	ra::Uint32 CountPrimitives(unsigned int theCount, sf::PrimitiveType theType)
+	{
+		switch (theType)
+		{
+		case sf::Points:
+			return theCount;
+		case sf::Lines:
+			return theCount / 2;
+		case sf::LinesStrip:
+			return (theCount > 1) ? theCount - 1 : 0;
+		case sf::Triangles:
+			return theCount / 3;
+		case sf::TrianglesStrip:
+		case sf::TrianglesFan:
+			return (theCount > 2) ? theCount - 2 : 0;
+		case sf::Quads:
+			return theCount / 4;
+		default:
+			return 0;
+		}
+	}
+
+	void AddDraw(unsigned int theCount, sf::PrimitiveType theType, const sf::RenderStates& theStates)
+	{
+		s_current.drawCalls++;
+		s_current.vertices += theCount;
+		s_current.primitives += CountPrimitives(theCount, theType);
+
+		// Sin textura no se enlaza ninguna, pero la siguiente vuelve a hacerlo
+		if (theStates.texture != s_texture && theStates.texture != NULL)
+		{
+			s_current.textureBinds++;
+		}
+		s_texture = theStates.texture;
+
+		if (theStates.shader != s_shader)
+		{
+			s_current.shaderSwitches++;
+		}
+		s_shader = theStates.shader;
+	}
+
+	void Accumulate(ra::Uint64& theTotal, ra::Uint32& thePeak, ra::Uint32 theValue)
+	{
+		theTotal += theValue;
+		thePeak = std::max(thePeak, theValue);
+	}
+
+	void WriteCounter(std::ostream& theStream, const char* theName, ra::Uint64 theTotal, ra::Uint32 thePeak)
+	{
+		theStream << "  " << theName << ": " << (theTotal / s_frameCount) << " (máx " << thePeak << ")"
+			<< std::endl;
+	}
+}
+
+namespace ra
+{
+
+void RenderStats::Draw(sf::RenderTarget& theTarget, const sf::Vertex* theVertices, unsigned int theCount,
+	sf::PrimitiveType theType, const sf::RenderStates& theStates)
+{
+	AddDraw(theCount, theType, theStates);
+	theTarget.draw(theVertices, theCount, theType, theStates);
+}
+
+void RenderStats::Draw(sf::RenderTarget& theTarget, const sf::VertexArray& theVertices,
+	const sf::RenderStates& theStates)
+{
+	AddDraw(theVertices.getVertexCount(), theVertices.getPrimitiveType(), theStates);
+	theTarget.draw(theVertices, theStates);
+}
+
+void RenderStats::Draw(sf::RenderTarget& theTarget, const sf::Sprite& theSprite,
+	const sf::RenderStates& theStates)
+{
+	// sf::Sprite sustituye la textura de los estados por la suya
+	if (theSprite.getTexture() != NULL)
+	{
+		sf::RenderStates states(theStates);
+		states.texture = theSprite.getTexture();
+		AddDraw(4, sf::Quads, states);
+	}
+	theTarget.draw(theSprite, theStates);
+}
+
+void RenderStats::SetView(sf::RenderTarget& theTarget, const sf::View& theView)
+{
+	const sf::View& current = theTarget.getView();
+	if (current.getCenter() != theView.getCenter() || current.getSize() != theView.getSize() ||
+		current.getRotation() != theView.getRotation() || current.getViewport() != theView.getViewport())
+	{
+		s_current.viewChanges++;
+	}
+	theTarget.setView(theView);
+}
+
+void RenderStats::AddSceneObjects(Uint32 theDrawn, Uint32 theCulled)
+{
+	s_current.drawn += theDrawn;
+	s_current.culled += theCulled;
+}
+
+void RenderStats::BeginFrame()
+{
+	s_current = RenderCounters();
+	s_texture = NULL;
+	s_shader = NULL;
+}
+
+void RenderStats::EndFrame()
+{
+	s_frame = s_current;
+	s_frameCount++;
+
+	Accumulate(s_total.drawCalls, s_peak.drawCalls, s_frame.drawCalls);
+	Accumulate(s_total.vertices, s_peak.vertices, s_frame.vertices);
+	Accumulate(s_total.primitives, s_peak.primitives, s_frame.primitives);
+	Accumulate(s_total.textureBinds, s_peak.textureBinds, s_frame.textureBinds);
+	Accumulate(s_total.viewChanges, s_peak.viewChanges, s_frame.viewChanges);
+	Accumulate(s_total.shaderSwitches, s_peak.shaderSwitches, s_frame.shaderSwitches);
+	Accumulate(s_total.drawn, s_peak.drawn, s_frame.drawn);
+	Accumulate(s_total.culled, s_peak.culled, s_frame.culled);
+}
+
+const RenderCounters& RenderStats::GetFrame()
+{
+	return s_frame;
+}
+
+Uint32 RenderStats::GetFrameCount()
+{
+	return s_frameCount;
+}
+
+void RenderStats::Reset()
+{
+	s_total = RenderTotals();
+	s_peak = RenderCounters();
+	s_frameCount = 0;
+}
+
+void RenderStats::Report(std::ostream& theStream)
+{
+	if (s_frameCount == 0)
+	{
+		theStream << "RenderStats::Report() no se ha dibujado ningún frame" << std::endl;
+		return;
+	}
+
+	theStream << "RenderStats::Report() media por frame en " << s_frameCount << " frames" << std::endl;
+	WriteCounter(theStream, "llamadas de dibujado", s_total.drawCalls, s_peak.drawCalls);
+	WriteCounter(theStream, "vértices", s_total.vertices, s_peak.vertices);
+	WriteCounter(theStream, "primitivas", s_total.primitives, s_peak.primitives);
+	WriteCounter(theStream, "cambios de textura", s_total.textureBinds, s_peak.textureBinds);
+	WriteCounter(theStream, "cambios de vista", s_total.viewChanges, s_peak.viewChanges);
+	WriteCounter(theStream, "cambios de shader", s_total.shaderSwitches, s_peak.shaderSwitches);
+	WriteCounter(theStream, "objetos dibujados", s_total.drawn, s_peak.drawn);
+	WriteCounter(theStream, "objetos descartados", s_total.culled, s_peak.culled);
+}
+
+} // namespace ra
\ No newline at end of file
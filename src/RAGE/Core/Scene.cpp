@@ -1,25 +1,44 @@
+#include <algorithm>
+#include <cmath>
 #include <RAGE/Core/Scene.hpp>
 #include <RAGE/Core/SceneGraph.hpp>
+#include <RAGE/Core/GraphPool.hpp>
 #include <RAGE/Core/Camera.hpp>
+#include <RAGE/Core/RenderStats.hpp>
 
 namespace ra
 {
 
 struct ObjectZComparator
 {
-	bool operator()(const ra::SceneGraph* o1, const ra::SceneGraph* o2) const
+	template <class ENTRY>
+	bool operator()(const ENTRY& o1, const ENTRY& o2) const
     {
-		return o1->GetZOrder() < o2->GetZOrder();
+		return o1.graph->GetZOrder() < o2.graph->GetZOrder();
     }
 };
 
+struct LayerZComparator
+{
+	template <class LAYER>
+	bool operator()(const LAYER& l1, const LAYER& l2) const
+	{
+		return l1.minZ < l2.minZ;
+	}
+};
+
 Scene::Scene(SceneID theID)
-	: m_ID(theID)
+	: m_camera(ra::Camera::Instance())
+	, m_ID(theID)
+	, m_cleanup(false)
 	, m_init(false)
+	, m_initProgress(0.0f)
 	, m_paused(false)
-	, m_cleanup(false)
 	, m_colorBack(0, 0, 0)
-	, m_camera(ra::Camera::Instance())
+	, m_drawBelow(false)
+	, m_updateBelow(false)
+	, m_blockInput(true)
+	, m_postProcessed(true)
 {
 	m_app = ra::App::Instance();
 	m_app->log << "Scene::ctor() con ID: " << theID << " creada" << std::endl;
@@ -27,6 +46,10 @@ Scene::Scene(SceneID theID)
 
 Scene::~Scene()
 {
+	for (size_t i = 0; i < m_layers.size(); i++)
+	{
+		ClearCache(m_layers[i]);
+	}
 	m_app->log << "Scene::dtor() con ID: " << GetID() << " eliminada" << std::endl;
 }
 
@@ -45,11 +68,65 @@ const bool Scene::IsPaused() const
 	return m_paused;
 }
 
+void Scene::SetDrawBelow(bool theValue)
+{
+	m_drawBelow = theValue;
+}
+
+const bool Scene::IsDrawingBelow() const
+{
+	return m_drawBelow;
+}
+
+void Scene::SetUpdateBelow(bool theValue)
+{
+	m_updateBelow = theValue;
+}
+
+const bool Scene::IsUpdatingBelow() const
+{
+	return m_updateBelow;
+}
+
+void Scene::SetBlockInput(bool theValue)
+{
+	m_blockInput = theValue;
+}
+
+const bool Scene::IsBlockingInput() const
+{
+	return m_blockInput;
+}
+
+void Scene::SetPostProcessed(bool theValue)
+{
+	m_postProcessed = theValue;
+}
+
+bool Scene::IsPostProcessed() const
+{
+	return m_postProcessed;
+}
+
 void Scene::SetBackgroundColor(const sf::Color &theColor)
 {
 	m_colorBack = theColor;
 }
 
+void Scene::Preload()
+{
+}
+
+void Scene::PreloadAsset(ra::AssetType theType, const std::string& theName)
+{
+	m_preloadAssets.push_back(std::make_pair(theType, theName));
+}
+
+float Scene::InitStep(sf::Time /*theBudget*/)
+{
+	return 1.0f;
+}
+
 void Scene::Init()
 {
 	this->m_init = true;
@@ -57,43 +134,451 @@ void Scene::Init()
 
 void Scene::Draw()
 {
-	// Establecemos el color de fondo
-	m_app->window.clear(m_colorBack);
+	sf::RenderTarget& target = m_app->GetRenderTarget();
 
-	// Ordenamos la lista de objetos en base a su Z
-	m_sceneGraph.sort(ObjectZComparator());
+	// Establecemos el color de fondo, salvo que se dibuje sobre otra escena
+	if (!m_drawBelow)
+	{
+		target.clear(m_colorBack);
+	}
 
-	// Recorremos la lista de Actores de la escena para dibujarla
-	std::list<ra::SceneGraph*>::const_iterator element;
-	for(element = m_sceneGraph.begin(); element != m_sceneGraph.end(); element++)
+	// Descartamos los objetos quitados, resolvemos los de los pools y
+	// olvidamos los destruidos
+	size_t count = 0;
+	for (size_t i = 0; i < m_sceneGraph.size(); i++)
 	{
-		ra::SceneGraph* object = *element;
+		GraphEntry& entry = m_sceneGraph[i];
+		if (!m_quitGraphs.empty() && m_quitGraphs.count(GetKey(entry)) > 0)
+		{
+			continue;
+		}
+		if (entry.pool != NULL)
+		{
+			entry.graph = entry.pool->GetGraph(entry.index, entry.generation);
+			if (entry.graph == NULL)
+			{
+				m_graphKeys.erase(GetKey(entry));
+				continue;
+			}
+		}
+		m_sceneGraph[count++] = entry;
+	}
+	m_sceneGraph.resize(count);
+	m_quitGraphs.clear();
 
-		if (object->IsVisible() && m_camera->GetRect().intersects(object->getGlobalBounds()))
+	// Ordenamos la lista de objetos en base a su Z. De un frame a otro casi
+	// no cambia, así que la ordenación por inserción es casi lineal, estable
+	// y no pide memoria
+	ObjectZComparator comparator;
+	for (size_t i = 1; i < count; i++)
+	{
+		if (!comparator(m_sceneGraph[i], m_sceneGraph[i - 1]))
+		{
+			continue;
+		}
+		GraphEntry entry = m_sceneGraph[i];
+		size_t j = i;
+		while (j > 0 && comparator(entry, m_sceneGraph[j - 1]))
 		{
-			m_app->window.draw(*object);
+			m_sceneGraph[j] = m_sceneGraph[j - 1];
+			j--;
 		}
+		m_sceneGraph[j] = entry;
 	}
+
+	// La lista ordenada se comparte entre la cámara principal y las propias
+	// de la escena, que la recorren una detrás de otra recortando con su
+	// vista y dibujando en su viewport
+	DrawCamera(target, *m_camera);
+	for (size_t i = 0; i < m_cameras.size(); i++)
+	{
+		DrawCamera(target, *m_cameras[i]);
+	}
+
+	// Dejamos la vista de la cámara principal para las escenas de encima
+	ra::RenderStats::SetView(target, *m_camera);
 }
 
 void Scene::AddGraph(ra::SceneGraph& theGraph)
 {
-	std::list<ra::SceneGraph*>::const_iterator it;
-	it = std::find(m_sceneGraph.begin(), m_sceneGraph.end(), &theGraph);
-	if (it == m_sceneGraph.end())
-		m_sceneGraph.push_back(&theGraph);
+	GraphEntry entry;
+	entry.graph = &theGraph;
+	entry.pool = NULL;
+	entry.index = 0;
+	entry.generation = 0;
+	InsertGraph(entry);
 }
 
 void Scene::QuitGraph(ra::SceneGraph& theGraph)
 {
-	m_sceneGraph.remove(&theGraph);
+	GraphEntry entry;
+	entry.graph = &theGraph;
+	entry.pool = NULL;
+	entry.index = 0;
+	entry.generation = 0;
+	RemoveGraph(entry);
 }
 
 void Scene::DeleteGraph(ra::SceneGraph& theGraph)
 {
-	m_sceneGraph.remove(&theGraph);
+	QuitGraph(theGraph);
 	delete &theGraph;
 }
 
+void Scene::AddGraph(const ra::GraphHandle& theHandle)
+{
+	ra::SceneGraph* graph = theHandle.pool->GetGraph(theHandle.index, theHandle.generation);
+	if (graph == NULL)
+	{
+		m_app->log << "[warn] Scene::AddGraph() el objeto del pool ya fue destruido" << std::endl;
+		return;
+	}
+
+	GraphEntry entry;
+	entry.graph = graph;
+	entry.pool = theHandle.pool;
+	entry.index = theHandle.index;
+	entry.generation = theHandle.generation;
+	InsertGraph(entry);
+}
+
+void Scene::QuitGraph(const ra::GraphHandle& theHandle)
+{
+	GraphEntry entry;
+	entry.graph = NULL;
+	entry.pool = theHandle.pool;
+	entry.index = theHandle.index;
+	entry.generation = theHandle.generation;
+	RemoveGraph(entry);
+}
+
+void Scene::DeleteGraph(const ra::GraphHandle& theHandle)
+{
+	QuitGraph(theHandle);
+	theHandle.pool->DestroyGraph(theHandle.index, theHandle.generation);
+}
+
+void Scene::SetLayer(const std::string& theName, ra::Int32 theMinZ, ra::Int32 theMaxZ,
+	const sf::Vector2f& theParallax)
+{
+	Layer* layer = FindLayer(theName);
+	if (layer == NULL)
+	{
+		Layer newLayer;
+		newLayer.name = theName;
+		newLayer.cached = false;
+		newLayer.texture = NULL;
+		newLayer.dirty = true;
+		m_layers.push_back(newLayer);
+		layer = &m_layers.back();
+	}
+
+	layer->minZ = theMinZ;
+	layer->maxZ = theMaxZ;
+	layer->parallax = theParallax;
+	layer->dirty = true;
+
+	std::sort(m_layers.begin(), m_layers.end(), LayerZComparator());
+}
+
+void Scene::RemoveLayer(const std::string& theName)
+{
+	for (size_t i = 0; i < m_layers.size(); i++)
+	{
+		if (m_layers[i].name == theName)
+		{
+			ClearCache(m_layers[i]);
+			m_layers.erase(m_layers.begin() + i);
+			return;
+		}
+	}
+}
+
+void Scene::SetLayerCached(const std::string& theName, bool theCached)
+{
+	Layer* layer = FindLayer(theName);
+	if (layer == NULL)
+	{
+		m_app->log << "[warn] Scene::SetLayerCached() no existe la capa " << theName << std::endl;
+		return;
+	}
+
+	layer->cached = theCached;
+	ClearCache(*layer);
+}
+
+void Scene::InvalidateLayer(const std::string& theName)
+{
+	Layer* layer = FindLayer(theName);
+	if (layer == NULL)
+	{
+		return;
+	}
+
+	layer->dirty = true;
+}
+
+void Scene::AddCamera(ra::Camera& theCamera)
+{
+	if (&theCamera == m_camera)
+	{
+		m_app->log << "[warn] Scene::AddCamera() la cámara principal ya dibuja la escena" << std::endl;
+		return;
+	}
+	if (std::find(m_cameras.begin(), m_cameras.end(), &theCamera) == m_cameras.end())
+	{
+		m_cameras.push_back(&theCamera);
+	}
+}
+
+void Scene::RemoveCamera(ra::Camera& theCamera)
+{
+	std::vector<ra::Camera*>::iterator it = std::find(m_cameras.begin(), m_cameras.end(), &theCamera);
+	if (it == m_cameras.end())
+	{
+		return;
+	}
+	m_cameras.erase(it);
+}
+
+bool Scene::GraphKey::operator<(const GraphKey& theRight) const
+{
+	if (owner != theRight.owner)
+	{
+		return owner < theRight.owner;
+	}
+	return (index != theRight.index) ? index < theRight.index : generation < theRight.generation;
+}
+
+Scene::GraphKey Scene::GetKey(const GraphEntry& theEntry)
+{
+	GraphKey key;
+	if (theEntry.pool != NULL)
+	{
+		key.owner = theEntry.pool;
+	}
+	else
+	{
+		key.owner = theEntry.graph;
+	}
+	key.index = theEntry.index;
+	key.generation = theEntry.generation;
+	return key;
+}
+
+void Scene::InsertGraph(const GraphEntry& theEntry)
+{
+	const GraphKey key = GetKey(theEntry);
+	if (!m_graphKeys.insert(key).second)
+	{
+		return;
+	}
+
+	// Si se quitó en este frame su entrada sigue en la lista y basta con
+	// conservarla
+	if (m_quitGraphs.erase(key) == 0)
+	{
+		m_sceneGraph.push_back(theEntry);
+	}
+}
+
+void Scene::RemoveGraph(const GraphEntry& theEntry)
+{
+	const GraphKey key = GetKey(theEntry);
+	if (m_graphKeys.erase(key) > 0)
+	{
+		m_quitGraphs.insert(key);
+	}
+}
+
+Scene::Layer* Scene::FindLayer(const std::string& theName)
+{
+	for (size_t i = 0; i < m_layers.size(); i++)
+	{
+		if (m_layers[i].name == theName)
+		{
+			return &m_layers[i];
+		}
+	}
+	return NULL;
+}
+
+Scene::Layer* Scene::GetLayerAt(ra::Int32 theZ)
+{
+	for (size_t i = 0; i < m_layers.size(); i++)
+	{
+		if (theZ < m_layers[i].minZ)
+		{
+			break;
+		}
+		if (theZ <= m_layers[i].maxZ)
+		{
+			return &m_layers[i];
+		}
+	}
+	return NULL;
+}
+
+sf::View Scene::GetLayerView(const Layer& theLayer, const ra::Camera& theCamera) const
+{
+	// Con factor 0 la capa se ve como con la cámara en su posición inicial,
+	// así que su contenido se coloca en coordenadas de su viewport
+	sf::Vector2f origin = theCamera.GetDefaultCenter();
+	sf::Vector2f offset = theCamera.getCenter() - origin;
+
+	sf::View view(theCamera);
+	view.setCenter(origin.x + offset.x * theLayer.parallax.x, origin.y + offset.y * theLayer.parallax.y);
+	return view;
+}
+
+void Scene::ClearCache(Layer& theLayer)
+{
+	delete theLayer.texture;
+	theLayer.texture = NULL;
+	theLayer.bounds.clear();
+	theLayer.dirty = true;
+}
+
+void Scene::DrawCamera(sf::RenderTarget& theTarget, const ra::Camera& theCamera)
+{
+	// Con la lista ordenada los objetos de una capa quedan seguidos, así que
+	// la recorremos por tramos y cada tramo establece su vista una sola vez
+	size_t first = 0;
+	while (first < m_sceneGraph.size())
+	{
+		Layer* layer = GetLayerAt(m_sceneGraph[first].graph->GetZOrder());
+		size_t last = first + 1;
+		while (last < m_sceneGraph.size() && GetLayerAt(m_sceneGraph[last].graph->GetZOrder()) == layer)
+		{
+			last++;
+		}
+
+		if (layer == NULL)
+		{
+			DrawRange(theTarget, theCamera, theCamera.GetRect(), first, last);
+		}
+		else if (layer->cached)
+		{
+			DrawCached(theTarget, *layer, GetLayerView(*layer, theCamera), first, last);
+		}
+		else
+		{
+			sf::View view = GetLayerView(*layer, theCamera);
+			DrawRange(theTarget, view, GetViewRect(view), first, last);
+		}
+
+		first = last;
+	}
+}
+
+sf::FloatRect Scene::GetViewRect(const sf::View& theView) const
+{
+	return sf::FloatRect(theView.getCenter().x - theView.getSize().x / 2.0f,
+		theView.getCenter().y - theView.getSize().y / 2.0f, theView.getSize().x, theView.getSize().y);
+}
+
+void Scene::DrawRange(sf::RenderTarget& theTarget, const sf::View& theView, const sf::FloatRect& theRect,
+	size_t theFirst, size_t theLast)
+{
+	ra::RenderStats::SetView(theTarget, theView);
+
+	// Cada tramo se recorta con el rectángulo de su propia vista, calculado
+	// una vez por tramo y no por objeto
+	ra::Uint32 drawn = 0;
+	for (size_t i = theFirst; i < theLast; i++)
+	{
+		ra::SceneGraph* object = m_sceneGraph[i].graph;
+
+		if (object->IsVisible() && theRect.intersects(object->getGlobalBounds()))
+		{
+			theTarget.draw(*object);
+			drawn++;
+		}
+	}
+	ra::RenderStats::AddSceneObjects(drawn, static_cast<ra::Uint32>(theLast - theFirst) - drawn);
+}
+
+void Scene::DrawCached(sf::RenderTarget& theTarget, Layer& theLayer, const sf::View& theView,
+	size_t theFirst, size_t theLast)
+{
+	// El contenido ha cambiado si algún objeto tiene otros límites o ha
+	// cambiado su visibilidad; de paso calculamos la zona que ocupan
+	bool changed = theLayer.dirty || theLayer.bounds.size() != theLast - theFirst;
+	theLayer.bounds.resize(theLast - theFirst);
+	float left = 0.f;
+	float top = 0.f;
+	float right = 0.f;
+	float bottom = 0.f;
+	bool empty = true;
+	for (size_t i = theFirst; i < theLast; i++)
+	{
+		ra::SceneGraph* object = m_sceneGraph[i].graph;
+		sf::FloatRect bounds = object->IsVisible() ? object->getGlobalBounds() : sf::FloatRect();
+		if (bounds != theLayer.bounds[i - theFirst])
+		{
+			theLayer.bounds[i - theFirst] = bounds;
+			changed = true;
+		}
+		if (bounds.width > 0.f && bounds.height > 0.f)
+		{
+			left = empty ? bounds.left : std::min(left, bounds.left);
+			top = empty ? bounds.top : std::min(top, bounds.top);
+			right = empty ? bounds.left + bounds.width : std::max(right, bounds.left + bounds.width);
+			bottom = empty ? bounds.top + bounds.height : std::max(bottom, bounds.top + bounds.height);
+			empty = false;
+		}
+	}
+	if (empty)
+	{
+		return;
+	}
+
+	if (changed)
+	{
+		// La textura cubre la zona de los objetos ajustada a píxeles enteros
+		sf::FloatRect rect(std::floor(left), std::floor(top), 0.0f, 0.0f);
+		rect.width = std::ceil(right) - rect.left;
+		rect.height = std::ceil(bottom) - rect.top;
+		sf::Vector2u size(static_cast<unsigned int>(rect.width), static_cast<unsigned int>(rect.height));
+		if (theLayer.texture == NULL || theLayer.texture->getSize() != size)
+		{
+			delete theLayer.texture;
+			theLayer.texture = new sf::RenderTexture();
+			if (!theLayer.texture->create(size.x, size.y))
+			{
+				m_app->log << "[error] Scene::DrawCached() no se ha podido crear la textura de la capa "
+					<< theLayer.name << std::endl;
+				delete theLayer.texture;
+				theLayer.texture = NULL;
+			}
+		}
+
+		if (theLayer.texture != NULL)
+		{
+			theLayer.texture->clear(sf::Color::Transparent);
+			DrawRange(*theLayer.texture, sf::View(rect), rect, theFirst, theLast);
+			theLayer.texture->display();
+			theLayer.textureRect = rect;
+		}
+		theLayer.dirty = false;
+	}
+
+	// Sin textura, por ejemplo si la capa es mayor de lo que admite la
+	// tarjeta, se dibuja como una capa normal
+	if (theLayer.texture == NULL)
+	{
+		DrawRange(theTarget, theView, GetViewRect(theView), theFirst, theLast);
+		return;
+	}
+
+	ra::RenderStats::SetView(theTarget, theView);
+	if (GetViewRect(theView).intersects(theLayer.textureRect))
+	{
+		sf::Sprite sprite(theLayer.texture->getTexture());
+		sprite.setPosition(theLayer.textureRect.left, theLayer.textureRect.top);
+		ra::RenderStats::Draw(theTarget, sprite);
+	}
+}
+
 
 }; // namespace ra
\ No newline at end of file
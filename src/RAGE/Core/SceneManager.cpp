@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <limits>
 #include <RAGE/Core/SceneManager.hpp>
 #include <RAGE/Core/App.hpp>
+#include <RAGE/Core/AssetManager.hpp>
+#include <RAGE/Core/Camera.hpp>
+#include <RAGE/Core/PostProcess.hpp>
 #include <RAGE/Core/Scene.hpp>
 
 
@@ -11,8 +16,12 @@ SceneManager* SceneManager::ms_instance = 0;
 SceneManager::SceneManager() :
 	m_app(NULL),
 	mActiveScene(NULL),
+	mNextScene(""),
 	mInactivesScenes(),
-	mNextScene("")
+	mLoadingScenes(),
+	mSceneStack(),
+	mPushScene(""),
+	mPopCount(0)
 {
 	m_app = ra::App::Instance();
 	m_app->log << "SceneManager::ctor()" << std::endl;
@@ -53,10 +62,16 @@ void SceneManager::AddScene(Scene* theScene)
 			return;
 	}
 
-	// Si no existe la aadimos a la lista
+	// Si no existe la añadimos a la lista. Una escena sin inicializar
+	// empieza sus etapas desde el principio aunque ya se hubiera precargado
+	// en parte
+	if (!theScene->IsInitComplete())
+	{
+		theScene->m_initProgress = 0.0f;
+	}
 	mInactivesScenes[theScene->GetID()] = theScene;
 
-	m_app->log << "SceneManager::AddScene() Aadida escena con ID=" 
+	m_app->log << "SceneManager::AddScene() Añadida escena con ID=" 
 		<< theScene->GetID() << std::endl;
 }
 
@@ -84,16 +99,22 @@ void SceneManager::ChangeScene(SceneID theSceneID)
 {
 
 	mNextScene = "";
-	if (mActiveScene != NULL)
-		mInactivesScenes[mActiveScene->GetID()] = mActiveScene;
+
+	// Todas las escenas de la pila vuelven a la lista de inactivas
+	std::vector<Scene*>::iterator it;
+	for (it = mSceneStack.begin(); it != mSceneStack.end(); it++)
+	{
+		mInactivesScenes[(*it)->GetID()] = *it;
+	}
+	mSceneStack.clear();
+
 	mActiveScene = mInactivesScenes[theSceneID];
 	mInactivesScenes.erase(theSceneID);
+	mLoadingScenes.erase(theSceneID);
+	mSceneStack.push_back(mActiveScene);
 
 	// Inicializamos la escena si no lo esta
-	if (!mActiveScene->IsInitComplete())
-	{
-		mActiveScene->Init();
-	}
+	CompleteInit(mActiveScene);
 
 	mActiveScene->Active();
 
@@ -110,14 +131,15 @@ void SceneManager::RemoveScene(SceneID theSceneID)
 			<< it->first << std::endl;
 		it->second->Cleanup();
 		delete it->second;
+		mLoadingScenes.erase(it->first);
 		mInactivesScenes.erase(it);
 		return;
 	}
 
-	if (theSceneID == mActiveScene->GetID())
+	if (FindScene(theSceneID) != NULL)
 	{
-		m_app->log << "SceneManager::RemoveScene() la escena con ID=" << mActiveScene->GetID() 
-			<< "esta activa y no se puede eliminar" << std::endl;
+		m_app->log << "SceneManager::RemoveScene() la escena con ID=" << theSceneID 
+			<< "esta en la pila y no se puede eliminar" << std::endl;
 		return;
 	}
 
@@ -137,6 +159,76 @@ void SceneManager::RemoveAllInactiveScene()
 		delete it->second;
 		mInactivesScenes.erase(it++);
 	}
+	mLoadingScenes.clear();
+}
+
+void SceneManager::PreloadScene(SceneID theSceneID)
+{
+	std::map<SceneID, Scene*>::const_iterator it = mInactivesScenes.find(theSceneID);
+	if (it == mInactivesScenes.end())
+	{
+		m_app->log << "SceneManager::PreloadScene() No existe ninguna escena inactiva con ID=" 
+			<< theSceneID << std::endl;
+		return;
+	}
+
+	Scene* scene = it->second;
+	if (scene->IsInitComplete() || mLoadingScenes.find(theSceneID) != mLoadingScenes.end())
+	{
+		return;
+	}
+
+	// La escena declara sus recursos y los pedimos al hilo de carga
+	scene->m_preloadAssets.clear();
+	scene->Preload();
+
+	ra::AssetManager* assetManager = ra::AssetManager::Instance();
+	std::vector<std::pair<ra::AssetType, std::string> >::const_iterator asset;
+	for (asset = scene->m_preloadAssets.begin(); asset != scene->m_preloadAssets.end(); asset++)
+	{
+		assetManager->LoadAsync(asset->first, asset->second);
+	}
+
+	mLoadingScenes.insert(theSceneID);
+
+	m_app->log << "SceneManager::PreloadScene() Precargando escena con ID=" << theSceneID 
+		<< " (" << scene->m_preloadAssets.size() << " recursos)" << std::endl;
+}
+
+float SceneManager::GetLoadProgress(SceneID theSceneID) const
+{
+	Scene* scene = FindScene(theSceneID);
+	if (scene == NULL)
+	{
+		return 0.0f;
+	}
+
+	if (scene->IsInitComplete())
+	{
+		return 1.0f;
+	}
+
+	// Cada recurso cuenta como un paso y la inicialización por etapas como
+	// el último, que avanza según lo que devuelve InitStep()
+	ra::AssetManager* assetManager = ra::AssetManager::Instance();
+	size_t total = scene->m_preloadAssets.size() + 1;
+	size_t done = 0;
+	std::vector<std::pair<ra::AssetType, std::string> >::const_iterator asset;
+	for (asset = scene->m_preloadAssets.begin(); asset != scene->m_preloadAssets.end(); asset++)
+	{
+		if (!assetManager->IsPending(asset->first, asset->second))
+		{
+			done++;
+		}
+	}
+
+	return (static_cast<float>(done) + scene->m_initProgress) / static_cast<float>(total);
+}
+
+bool SceneManager::IsSceneReady(SceneID theSceneID) const
+{
+	Scene* scene = FindScene(theSceneID);
+	return scene != NULL && scene->IsInitComplete();
 }
 
 void SceneManager::RemoveAllScene()
@@ -144,30 +236,117 @@ void SceneManager::RemoveAllScene()
 	// Eliminamos todas las escenas inactivas
 	RemoveAllInactiveScene();
 
-	if (mActiveScene != NULL)
+	// Eliminamos las escenas de la pila, la activa incluida
+	while (!mSceneStack.empty())
 	{
-		// Eliminamos la escena activa
+		Scene* scene = mSceneStack.back();
+		mSceneStack.pop_back();
 		m_app->log << "SceneManager::RemoveAllScene() Eliminada escena con ID=" 
-			<< mActiveScene->GetID() << std::endl;
-		mActiveScene->Cleanup();
-		delete mActiveScene;
-		mActiveScene = NULL;
+			<< scene->GetID() << std::endl;
+		scene->Cleanup();
+		delete scene;
 	}
+	mActiveScene = NULL;
 }
 
-void SceneManager::EventScene(sf::Event theEvent)
+void SceneManager::PushScene(SceneID theSceneID)
 {
-	mActiveScene->Event(theEvent);
+	std::map<SceneID, Scene*>::const_iterator it = mInactivesScenes.find(theSceneID);
+	if (it == mInactivesScenes.end())
+	{
+		m_app->log << "SceneManager::PushScene() No existe ninguna escena inactiva con ID=" 
+			<< theSceneID << std::endl;
+		return;
+	}
+
+	mPushScene = theSceneID;
+}
+
+void SceneManager::PopScene()
+{
+	if (mSceneStack.size() <= mPopCount + 1)
+	{
+		m_app->log << "SceneManager::PopScene() No se puede desapilar la escena de la base" << std::endl;
+		return;
+	}
+
+	mPopCount++;
+}
+
+void SceneManager::EventScene(const sf::Event& theEvent)
+{
+	// El evento baja por la pila hasta la primera escena que lo bloquea
+	std::vector<Scene*>::reverse_iterator it;
+	for (it = mSceneStack.rbegin(); it != mSceneStack.rend(); it++)
+	{
+		(*it)->Event(theEvent);
+		if ((*it)->IsBlockingInput())
+		{
+			break;
+		}
+	}
 }
 
 void SceneManager::UpdateScene()
 {
-	mActiveScene->Update();
+	// Las escenas tapadas por completo no se actualizan
+	size_t first = GetFirstVisibleScene();
+	size_t top = mSceneStack.size() - 1;
+	size_t index = top;
+	while (index > first && mSceneStack[index]->IsUpdatingBelow())
+	{
+		index--;
+	}
+
+	for (; index <= top; index++)
+	{
+		mSceneStack[index]->Update();
+	}
+}
+
+void SceneManager::UpdateCameras()
+{
+	for (size_t index = GetFirstVisibleScene(); index < mSceneStack.size(); index++)
+	{
+		const std::vector<ra::Camera*>& cameras = mSceneStack[index]->m_cameras;
+		for (size_t i = 0; i < cameras.size(); i++)
+		{
+			cameras[i]->Update();
+		}
+	}
 }
 
 void SceneManager::DrawScene()
 {
-	mActiveScene->Draw();
+	size_t first = GetFirstVisibleScene();
+
+	// Si la escena de la base dibuja por debajo no hay nada que la limpie
+	if (mSceneStack[first]->IsDrawingBelow())
+	{
+		m_app->GetRenderTarget().clear();
+	}
+
+	// Dibujamos de abajo a arriba, sin capturas de la pantalla. La cadena
+	// de postprocesado se aplica antes de la primera escena que no pasa por
+	// ella, que junto con las de encima dibuja ya en la ventana
+	for (size_t index = first; index < mSceneStack.size(); index++)
+	{
+		if (!mSceneStack[index]->IsPostProcessed())
+		{
+			ra::PostProcess::Instance()->End();
+		}
+		mSceneStack[index]->Draw();
+	}
+}
+
+size_t SceneManager::GetFirstVisibleScene() const
+{
+	size_t index = mSceneStack.size() - 1;
+	while (index > 0 && mSceneStack[index]->IsDrawingBelow())
+	{
+		index--;
+	}
+	return index;
 }
 
 void SceneManager::ResumeScene()
@@ -180,6 +359,140 @@ void SceneManager::PauseScene()
 	mActiveScene->Pause();
 }
 
+void SceneManager::UpdatePreload(sf::Time theBudget)
+{
+	ra::AssetManager* assetManager = ra::AssetManager::Instance();
+
+	std::set<SceneID>::iterator it;
+	for (it = mLoadingScenes.begin(); it != mLoadingScenes.end(); it++)
+	{
+		Scene* scene = mInactivesScenes[*it];
+
+		// Comprobamos si quedan recursos por cargar
+		bool pending = false;
+		std::vector<std::pair<ra::AssetType, std::string> >::const_iterator asset;
+		for (asset = scene->m_preloadAssets.begin(); asset != scene->m_preloadAssets.end(); asset++)
+		{
+			if (assetManager->IsPending(asset->first, asset->second))
+			{
+				pending = true;
+				break;
+			}
+		}
+
+		if (!pending)
+		{
+			// Los recursos ya están en caché, la inicialización no espera a
+			// disco. Cada frame da un paso de InitStep() y, cuando termina, el
+			// Init() final ocupa un frame propio
+			if (scene->m_initProgress < 1.0f)
+			{
+				scene->m_initProgress = std::min(std::max(scene->InitStep(theBudget), 0.0f), 1.0f);
+				return;
+			}
+
+			if (!scene->IsInitComplete())
+			{
+				scene->Init();
+			}
+			m_app->log << "SceneManager::UpdatePreload() Escena con ID=" << *it 
+				<< " preparada" << std::endl;
+			mLoadingScenes.erase(it);
+			return;
+		}
+	}
+}
+
+void SceneManager::HandleStackChanges()
+{
+	// Primero desapilamos, las escenas vuelven a la lista de inactivas
+	bool changed = mPopCount > 0;
+	while (mPopCount > 0 && mSceneStack.size() > 1)
+	{
+		Scene* scene = mSceneStack.back();
+		mSceneStack.pop_back();
+		mInactivesScenes[scene->GetID()] = scene;
+		mPopCount--;
+
+		m_app->log << "SceneManager::HandleStackChanges() Desapilada escena con ID=" 
+			<< scene->GetID() << std::endl;
+	}
+	mPopCount = 0;
+
+	if (mPushScene != "")
+	{
+		std::map<SceneID, Scene*>::iterator it = mInactivesScenes.find(mPushScene);
+		if (it != mInactivesScenes.end())
+		{
+			Scene* scene = it->second;
+			mInactivesScenes.erase(it);
+			mLoadingScenes.erase(mPushScene);
+			mSceneStack.push_back(scene);
+
+			// Inicializamos la escena si no lo esta
+			CompleteInit(scene);
+
+			m_app->log << "SceneManager::HandleStackChanges() Apilada escena con ID=" 
+				<< mPushScene << std::endl;
+		}
+		mPushScene = "";
+		changed = true;
+	}
+
+	// La escena de la cima pasa a ser la activa
+	if (changed && !mSceneStack.empty())
+	{
+		mActiveScene = mSceneStack.back();
+		mActiveScene->Active();
+	}
+}
+
+void SceneManager::CompleteInit(Scene* theScene)
+{
+	if (theScene->IsInitComplete())
+	{
+		return;
+	}
+
+	// Sin tiempo de precarga los pasos se dan seguidos y sin límite de
+	// tiempo. Si un paso no avanza dejamos de llamar a InitStep() para no
+	// bloquear el cambio de escena
+	const sf::Time unlimited = sf::microseconds(std::numeric_limits<sf::Int64>::max());
+	while (theScene->m_initProgress < 1.0f)
+	{
+		float progress = std::min(std::max(theScene->InitStep(unlimited), 0.0f), 1.0f);
+		if (progress <= theScene->m_initProgress)
+		{
+			m_app->log << "[warn] SceneManager::CompleteInit() InitStep() de la escena con ID="
+				<< theScene->GetID() << " no avanza, se pasa a Init()" << std::endl;
+			break;
+		}
+		theScene->m_initProgress = progress;
+	}
+	theScene->m_initProgress = 1.0f;
+	theScene->Init();
+}
+
+Scene* SceneManager::FindScene(SceneID theSceneID) const
+{
+	std::vector<Scene*>::const_iterator it;
+	for (it = mSceneStack.begin(); it != mSceneStack.end(); it++)
+	{
+		if ((*it)->GetID() == theSceneID)
+		{
+			return *it;
+		}
+	}
+
+	std::map<SceneID, Scene*>::const_iterator inactive = mInactivesScenes.find(theSceneID);
+	if (inactive != mInactivesScenes.end())
+	{
+		return inactive->second;
+	}
+
+	return NULL;
+}
+
 bool SceneManager::HandleChangeScene()
 {
 	if (mNextScene == "")
@@ -0,0 +1,331 @@
+#include <sstream>
+#include <iomanip>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/ScreenCapture.hpp>
+
+namespace ra
+{
+
+ScreenCapture* ScreenCapture::ms_instance = 0;
+
+ScreenCapture::ScreenCapture()
+	: m_app(ra::App::Instance())
+	, m_freeTextures()
+	, m_captures()
+	, m_readbacks()
+	, m_images()
+	, m_frame(0)
+	, m_nextTicket(1)
+	, m_recordPrefix("")
+	, m_recordCount(0)
+	, m_recording(false)
+	, m_droppedFrames(0)
+	, m_writeJobs()
+	, m_writeMutex()
+	, m_writer(&ScreenCapture::WriterLoop, this)
+	, m_writerRunning(false)
+{
+	m_app->log << "ScreenCapture::ctor()" << std::endl;
+}
+
+ScreenCapture::~ScreenCapture()
+{
+	Cleanup();
+	m_app->log << "ScreenCapture::dtor()" << std::endl;
+}
+
+ScreenCapture* ScreenCapture::Instance()
+{
+	if(ms_instance == 0)
+	{
+		ms_instance = new ScreenCapture();
+	}
+	return ms_instance;
+}
+
+void ScreenCapture::Release()
+{
+	if(ms_instance)
+	{
+		delete ms_instance;
+	}
+	ms_instance = 0;
+}
+
+const sf::Texture* ScreenCapture::Capture(const std::string& theName)
+{
+	// Si ya existe una captura con ese nombre reciclamos su textura
+	std::map<std::string, sf::Texture*>::iterator it = m_captures.find(theName);
+	if (it != m_captures.end())
+	{
+		RecycleTexture(it->second);
+		m_captures.erase(it);
+	}
+
+	// Copiamos la ventana en la GPU, sin lectura a CPU
+	sf::Texture* texture = AcquireTexture();
+	texture->update(m_app->window);
+
+	m_captures[theName] = texture;
+
+	return texture;
+}
+
+const sf::Texture* ScreenCapture::GetCapture(const std::string& theName) const
+{
+	std::map<std::string, sf::Texture*>::const_iterator it = m_captures.find(theName);
+	if (it != m_captures.end())
+	{
+		return it->second;
+	}
+
+	m_app->log << "[warn] ScreenCapture::GetCapture() no existe la captura " << theName << std::endl;
+	return NULL;
+}
+
+void ScreenCapture::DeleteCapture(const std::string& theName)
+{
+	std::map<std::string, sf::Texture*>::iterator it = m_captures.find(theName);
+	if (it != m_captures.end())
+	{
+		RecycleTexture(it->second);
+		m_captures.erase(it);
+	}
+}
+
+ra::Uint32 ScreenCapture::RequestReadback()
+{
+	ra::Uint32 ticket = m_nextTicket++;
+
+	// El identificador 0 está reservado para los pantallazos
+	if (m_nextTicket == 0)
+	{
+		m_nextTicket = 1;
+	}
+
+	QueueReadback(ticket, "");
+
+	return ticket;
+}
+
+bool ScreenCapture::GetReadback(ra::Uint32 theTicket, sf::Image& theImage)
+{
+	std::map<ra::Uint32, sf::Image*>::iterator it = m_images.find(theTicket);
+	if (it == m_images.end())
+	{
+		return false;
+	}
+
+	theImage = *it->second;
+	delete it->second;
+	m_images.erase(it);
+
+	return true;
+}
+
+void ScreenCapture::TakeScreenshot(const std::string& theFilename)
+{
+	QueueReadback(0, theFilename);
+}
+
+void ScreenCapture::StartRecording(const std::string& thePrefix)
+{
+	m_recordPrefix = thePrefix;
+	m_recordCount = 0;
+	m_droppedFrames = 0;
+	m_recording = true;
+
+	m_app->log << "ScreenCapture::StartRecording() grabando en " << thePrefix << std::endl;
+}
+
+void ScreenCapture::StopRecording()
+{
+	if (m_recording)
+	{
+		m_recording = false;
+		m_app->log << "ScreenCapture::StopRecording() " << m_recordCount << " frames grabados, "
+			<< m_droppedFrames << " descartados" << std::endl;
+	}
+}
+
+bool ScreenCapture::IsRecording() const
+{
+	return m_recording;
+}
+
+void ScreenCapture::Update()
+{
+	m_frame++;
+
+	// Resolvemos las lecturas de frames anteriores, la GPU ya ha terminado
+	// la copia. SFML 2.0 no tiene pixel buffers, así que copyToImage() lee
+	// de forma síncrona en este hilo
+	std::vector<Readback>::iterator it = m_readbacks.begin();
+	while (it != m_readbacks.end())
+	{
+		if (it->frame >= m_frame)
+		{
+			it++;
+			continue;
+		}
+
+		sf::Image* image = new sf::Image(it->texture->copyToImage());
+		RecycleTexture(it->texture);
+
+		if (it->filename.empty())
+		{
+			m_images[it->ticket] = image;
+		}
+		else
+		{
+			WriteJob job;
+			job.image = image;
+			job.filename = it->filename;
+
+			sf::Lock lock(m_writeMutex);
+			m_writeJobs.push_back(job);
+
+			// Lanzamos el hilo de escritura si no está en marcha
+			if (!m_writerRunning)
+			{
+				m_writerRunning = true;
+				m_writer.launch();
+			}
+		}
+
+		it = m_readbacks.erase(it);
+	}
+
+	// Capturamos el frame actual si estamos grabando y el hilo de escritura
+	// va al día; si no, descartamos el frame para no crecer sin límite
+	if (m_recording)
+	{
+		if (GetPendingWrites() >= MAX_PENDING_FRAMES)
+		{
+			if (m_droppedFrames == 0)
+			{
+				m_app->log << "[warn] ScreenCapture::Update() la escritura no da abasto, se descartan frames"
+					<< std::endl;
+			}
+			m_droppedFrames++;
+		}
+		else
+		{
+			std::ostringstream filename;
+			filename << m_recordPrefix << std::setw(6) << std::setfill('0') << m_recordCount << ".png";
+			TakeScreenshot(filename.str());
+			m_recordCount++;
+		}
+	}
+}
+
+void ScreenCapture::Cleanup()
+{
+	// Esperamos a que el hilo de escritura vacíe la cola
+	m_writer.wait();
+
+	std::vector<Readback>::iterator readIt;
+	for (readIt = m_readbacks.begin(); readIt != m_readbacks.end(); readIt++)
+	{
+		delete readIt->texture;
+	}
+	m_readbacks.clear();
+
+	std::map<ra::Uint32, sf::Image*>::iterator imgIt;
+	for (imgIt = m_images.begin(); imgIt != m_images.end(); imgIt++)
+	{
+		delete imgIt->second;
+	}
+	m_images.clear();
+
+	std::map<std::string, sf::Texture*>::iterator capIt;
+	for (capIt = m_captures.begin(); capIt != m_captures.end(); capIt++)
+	{
+		delete capIt->second;
+	}
+	m_captures.clear();
+
+	std::vector<sf::Texture*>::iterator texIt;
+	for (texIt = m_freeTextures.begin(); texIt != m_freeTextures.end(); texIt++)
+	{
+		delete *texIt;
+	}
+	m_freeTextures.clear();
+
+	m_recording = false;
+}
+
+sf::Texture* ScreenCapture::AcquireTexture()
+{
+	sf::Vector2u size = m_app->window.getSize();
+
+	while (!m_freeTextures.empty())
+	{
+		sf::Texture* texture = m_freeTextures.back();
+		m_freeTextures.pop_back();
+
+		// Las texturas de un tamaño anterior de la ventana se descartan
+		if (texture->getSize() == size)
+		{
+			return texture;
+		}
+		delete texture;
+	}
+
+	sf::Texture* texture = new sf::Texture();
+	if (!texture->create(size.x, size.y))
+	{
+		m_app->log << "[error] ScreenCapture::AcquireTexture() no se ha podido crear la textura ("
+			<< size.x << ", " << size.y << ")" << std::endl;
+	}
+
+	return texture;
+}
+
+void ScreenCapture::RecycleTexture(sf::Texture* theTexture)
+{
+	m_freeTextures.push_back(theTexture);
+}
+
+void ScreenCapture::QueueReadback(ra::Uint32 theTicket, const std::string& theFilename)
+{
+	Readback readback;
+	readback.texture = AcquireTexture();
+	readback.texture->update(m_app->window);
+	readback.frame = m_frame;
+	readback.ticket = theTicket;
+	readback.filename = theFilename;
+
+	m_readbacks.push_back(readback);
+}
+
+size_t ScreenCapture::GetPendingWrites()
+{
+	sf::Lock lock(m_writeMutex);
+	return m_readbacks.size() + m_writeJobs.size();
+}
+
+void ScreenCapture::WriterLoop()
+{
+	while (true)
+	{
+		WriteJob job;
+		{
+			sf::Lock lock(m_writeMutex);
+			if (m_writeJobs.empty())
+			{
+				// Sin trabajo pendiente el hilo termina, Update() lo relanza
+				m_writerRunning = false;
+				return;
+			}
+			job = m_writeJobs.front();
+			m_writeJobs.pop_front();
+		}
+
+		// La codificación de la imagen es lenta, se hace fuera del bloqueo
+		job.image->saveToFile(job.filename);
+		delete job.image;
+	}
+}
+
+} // namespace ra
\ No newline at end of file
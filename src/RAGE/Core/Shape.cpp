@@ -29,6 +29,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/System/Err.hpp>
 #include <RAGE/Core/Shape.hpp>
+#include <RAGE/Core/RenderStats.hpp>
 #include <cmath>
 
 
@@ -207,13 +208,13 @@ void Shape::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
     // Render the inside
     states.texture = m_texture;
-    target.draw(m_vertices, states);
+    ra::RenderStats::Draw(target, m_vertices, states);
 
     // Render the outline
     if (m_outlineThickness != 0)
     {
         states.texture = NULL;
-        target.draw(m_outlineVertices, states);
+        ra::RenderStats::Draw(target, m_outlineVertices, states);
     }
 }
 
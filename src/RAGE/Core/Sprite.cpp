@@ -4,6 +4,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <RAGE/Core/Sprite.hpp>
+#include <RAGE/Core/RenderStats.hpp>
 #include <cstdlib>
 
 
@@ -116,7 +117,7 @@ void Sprite::draw(sf::RenderTarget& target, sf::RenderStates states) const
     {
         states.transform *= getTransform();
         states.texture = m_texture;
-        target.draw(m_vertices, 4, sf::Quads, states);
+        ra::RenderStats::Draw(target, m_vertices, 4, sf::Quads, states);
     }
 }
 
@@ -1,261 +1,986 @@
-#include <sstream>
-#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <limits>
+#include <vector>
 #include <RAGE/Core/StringUtil.hpp>
 #include <RAGE/Core/Core_types.hpp>
 
 namespace ra
 {
-  std::string ConvertBool(const bool theBoolean)
+  /// Two character pairs for every value from 00 to 99
+  static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  /// Powers of ten that are exact in a double
+  static const double DOUBLE_POWERS[] =
+  {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  /// Powers of ten that are exact in a float
+  static const float FLOAT_POWERS[] =
+  {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+  };
+
+  /// Powers of ten that fit in 32 bits
+  static const Uint32 UINT32_POWERS[] =
+  {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+  };
+
+  /// Normalized 10^k for k = -348, -340, ..., 340 as high and low halves of
+  /// the 64 bit significand and the binary exponent, used by Grisu2
+  struct CachedPower
+  {
+    Uint32 high;
+    Uint32 low;
+    Int32 exponent;
+  };
+  static const CachedPower CACHED_POWERS[] =
+  {
+    {0xFA8FD5A0, 0x081C0288, -1220}, {0xBAAEE17F, 0xA23EBF76, -1193}, {0x8B16FB20, 0x3055AC76, -1166},
+    {0xCF42894A, 0x5DCE35EA, -1140}, {0x9A6BB0AA, 0x55653B2D, -1113}, {0xE61ACF03, 0x3D1A45DF, -1087},
+    {0xAB70FE17, 0xC79AC6CA, -1060}, {0xFF77B1FC, 0xBEBCDC4F, -1034}, {0xBE5691EF, 0x416BD60C, -1007},
+    {0x8DD01FAD, 0x907FFC3C, -980}, {0xD3515C28, 0x31559A83, -954}, {0x9D71AC8F, 0xADA6C9B5, -927},
+    {0xEA9C2277, 0x23EE8BCB, -901}, {0xAECC4991, 0x4078536D, -874}, {0x823C1279, 0x5DB6CE57, -847},
+    {0xC2109436, 0x4DFB5637, -821}, {0x9096EA6F, 0x3848984F, -794}, {0xD77485CB, 0x25823AC7, -768},
+    {0xA086CFCD, 0x97BF97F4, -741}, {0xEF340A98, 0x172AACE5, -715}, {0xB23867FB, 0x2A35B28E, -688},
+    {0x84C8D4DF, 0xD2C63F3B, -661}, {0xC5DD4427, 0x1AD3CDBA, -635}, {0x936B9FCE, 0xBB25C996, -608},
+    {0xDBAC6C24, 0x7D62A584, -582}, {0xA3AB6658, 0x0D5FDAF6, -555}, {0xF3E2F893, 0xDEC3F126, -529},
+    {0xB5B5ADA8, 0xAAFF80B8, -502}, {0x87625F05, 0x6C7C4A8B, -475}, {0xC9BCFF60, 0x34C13053, -449},
+    {0x964E858C, 0x91BA2655, -422}, {0xDFF97724, 0x70297EBD, -396}, {0xA6DFBD9F, 0xB8E5B88F, -369},
+    {0xF8A95FCF, 0x88747D94, -343}, {0xB9447093, 0x8FA89BCF, -316}, {0x8A08F0F8, 0xBF0F156B, -289},
+    {0xCDB02555, 0x653131B6, -263}, {0x993FE2C6, 0xD07B7FAC, -236}, {0xE45C10C4, 0x2A2B3B06, -210},
+    {0xAA242499, 0x697392D3, -183}, {0xFD87B5F2, 0x8300CA0E, -157}, {0xBCE50864, 0x92111AEB, -130},
+    {0x8CBCCC09, 0x6F5088CC, -103}, {0xD1B71758, 0xE219652C, -77}, {0x9C400000, 0x00000000, -50},
+    {0xE8D4A510, 0x00000000, -24}, {0xAD78EBC5, 0xAC620000, 3}, {0x813F3978, 0xF8940984, 30},
+    {0xC097CE7B, 0xC90715B3, 56}, {0x8F7E32CE, 0x7BEA5C70, 83}, {0xD5D238A4, 0xABE98068, 109},
+    {0x9F4F2726, 0x179A2245, 136}, {0xED63A231, 0xD4C4FB27, 162}, {0xB0DE6538, 0x8CC8ADA8, 189},
+    {0x83C7088E, 0x1AAB65DB, 216}, {0xC45D1DF9, 0x42711D9A, 242}, {0x924D692C, 0xA61BE758, 269},
+    {0xDA01EE64, 0x1A708DEA, 295}, {0xA26DA399, 0x9AEF774A, 322}, {0xF209787B, 0xB47D6B85, 348},
+    {0xB454E4A1, 0x79DD1877, 375}, {0x865B8692, 0x5B9BC5C2, 402}, {0xC83553C5, 0xC8965D3D, 428},
+    {0x952AB45C, 0xFA97A0B3, 455}, {0xDE469FBD, 0x99A05FE3, 481}, {0xA59BC234, 0xDB398C25, 508},
+    {0xF6C69A72, 0xA3989F5C, 534}, {0xB7DCBF53, 0x54E9BECE, 561}, {0x88FCF317, 0xF22241E2, 588},
+    {0xCC20CE9B, 0xD35C78A5, 614}, {0x98165AF3, 0x7B2153DF, 641}, {0xE2A0B5DC, 0x971F303A, 667},
+    {0xA8D9D153, 0x5CE3B396, 694}, {0xFB9B7CD9, 0xA4A7443C, 720}, {0xBB764C4C, 0xA7A44410, 747},
+    {0x8BAB8EEF, 0xB6409C1A, 774}, {0xD01FEF10, 0xA657842C, 800}, {0x9B10A4E5, 0xE9913129, 827},
+    {0xE7109BFB, 0xA19C0C9D, 853}, {0xAC2820D9, 0x623BF429, 880}, {0x80444B5E, 0x7AA7CF85, 907},
+    {0xBF21E440, 0x03ACDD2D, 933}, {0x8E679C2F, 0x5E44FF8F, 960}, {0xD433179D, 0x9C8CB841, 986},
+    {0x9E19DB92, 0xB4E31BA9, 1013}, {0xEB96BF6E, 0xBADF77D9, 1039}, {0xAF87023B, 0x9BF0EE6B, 1066}
+  };
+
+  /// Most significant digits kept in the mantissa of a parsed number
+  static const Uint32 MAX_MANTISSA_DIGITS = 19;
+
+  /// Decimal number found by ScanNumber before converting it
+  struct DecimalNumber
+  {
+    Uint64 mantissa;    ///< Significant digits found
+    Int32 exponent;     ///< Power of ten to apply to the mantissa
+    bool negative;      ///< Number starts with '-'
+    bool truncated;     ///< Non zero digits were dropped from the mantissa
+    bool infinity;      ///< Number is inf or infinity
+    bool nan;           ///< Number is nan
+  };
+
+  static bool IsDigit(const char theCharacter)
   {
-    // Use StringStream class to convert theBoolean to a string
-    std::stringstream anResult;
+    return theCharacter >= '0' && theCharacter <= '9';
+  }
+
+  static bool IsSpace(const char theCharacter)
+  {
+    return theCharacter == ' ' || (theCharacter >= '\t' && theCharacter <= '\r');
+  }
+
+  static char ToLower(const char theCharacter)
+  {
+    return (theCharacter >= 'A' && theCharacter <= 'Z') ?
+      static_cast<char>(theCharacter - 'A' + 'a') : theCharacter;
+  }
 
-    // Add theBoolean to the stringstream
-    if(theBoolean)
+  static size_t CopyChars(char* theBuffer, const size_t theSize,
+      const char* theChars, const size_t theLength)
+  {
+    // Make sure there is room for the null terminator
+    if(theLength >= theSize)
     {
-      anResult << "true";
+      return 0;
+    }
+
+    memcpy(theBuffer, theChars, theLength);
+    theBuffer[theLength] = '\0';
+
+    return theLength;
+  }
+
+  template <class TYPE>
+  static size_t FormatDigits(char* theBuffer, const size_t theSize,
+      TYPE theNumber, const bool theNegative)
+  {
+    // Write the digits backwards from the end of a buffer large enough for
+    // the longest 64 bit value, two at a time
+    char anDigits[24];
+    char* anCursor = anDigits + sizeof(anDigits);
+    while(theNumber >= 100)
+    {
+      const Uint32 anPair = static_cast<Uint32>(theNumber % 100) * 2;
+      theNumber /= 100;
+      *--anCursor = DIGIT_PAIRS[anPair + 1];
+      *--anCursor = DIGIT_PAIRS[anPair];
+    }
+    if(theNumber >= 10)
+    {
+      const Uint32 anPair = static_cast<Uint32>(theNumber) * 2;
+      *--anCursor = DIGIT_PAIRS[anPair + 1];
+      *--anCursor = DIGIT_PAIRS[anPair];
     }
     else
     {
-      anResult << "false";
+      *--anCursor = static_cast<char>('0' + theNumber);
+    }
+    if(theNegative)
+    {
+      *--anCursor = '-';
     }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return CopyChars(theBuffer, theSize, anCursor,
+      static_cast<size_t>(anDigits + sizeof(anDigits) - anCursor));
   }
 
-  std::string ConvertColor(const sf::Color theColor)
+  template <class TYPE>
+  static const char* ParseDigits(const char* theFirst, const char* theLast,
+      const TYPE theMaximum, TYPE& theResult)
   {
-    // Use StringStream class to convert theColor to a string
-    std::stringstream anResult;
+    TYPE anResult = 0;
+    const char* anCursor = theFirst;
+    for(; anCursor != theLast && IsDigit(*anCursor); ++anCursor)
+    {
+      const TYPE anDigit = static_cast<TYPE>(*anCursor - '0');
 
-    // Add theColor to the stringstream
-    anResult << theColor.r << ", ";
-    anResult << theColor.g << ", ";
-    anResult << theColor.b << ", ";
-    anResult << theColor.a;
+      // Fail if the value does not fit in theMaximum allowed
+      if(anResult > (theMaximum - anDigit) / 10)
+      {
+        return theFirst;
+      }
+      anResult = anResult * 10 + anDigit;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    // Only store the result if at least one digit was found
+    if(anCursor != theFirst)
+    {
+      theResult = anResult;
+    }
+
+    return anCursor;
   }
 
-  std::string ConvertDouble(const double theDouble)
+  template <class TYPE, class UNSIGNED>
+  static const char* ParseSigned(const char* theFirst, const char* theLast, TYPE& theResult)
   {
-    // Use StringStream class to convert theDouble to a string
-    std::stringstream anResult;
+    const bool anNegative = (theFirst != theLast && *theFirst == '-');
+    const char* anDigits = anNegative ? theFirst + 1 : theFirst;
 
-    // Add theDouble to the stringstream
-    anResult << theDouble;
+    // The magnitude of the smallest negative value is one more than the maximum
+    const UNSIGNED anMaximum = static_cast<UNSIGNED>(std::numeric_limits<TYPE>::max()) +
+      (anNegative ? 1 : 0);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    UNSIGNED anMagnitude = 0;
+    const char* anEnd = ParseDigits<UNSIGNED>(anDigits, theLast, anMaximum, anMagnitude);
+    if(anEnd == anDigits)
+    {
+      return theFirst;
+    }
+
+    // Negate in unsigned arithmetic so the smallest value does not overflow
+    theResult = anNegative ? static_cast<TYPE>(0 - anMagnitude) : static_cast<TYPE>(anMagnitude);
+
+    return anEnd;
   }
 
-  std::string ConvertFloat(const float theFloat)
+  static const char* MatchNoCase(const char* theFirst, const char* theLast, const char* theWord)
   {
-    // Use StringStream class to convert theFloat to a string
-    std::stringstream anResult;
+    const char* anCursor = theFirst;
+    for(; *theWord != '\0'; ++theWord, ++anCursor)
+    {
+      if(anCursor == theLast || ToLower(*anCursor) != *theWord)
+      {
+        return theFirst;
+      }
+    }
+    return anCursor;
+  }
+
+  static bool IsWordNoCase(const char* theFirst, const char* theLast, const char* theWord)
+  {
+    return theFirst != theLast && MatchNoCase(theFirst, theLast, theWord) == theLast;
+  }
+
+  static const char* ScanNumber(const char* theFirst, const char* theLast, DecimalNumber& theNumber)
+  {
+    theNumber.mantissa = 0;
+    theNumber.exponent = 0;
+    theNumber.negative = false;
+    theNumber.truncated = false;
+    theNumber.infinity = false;
+    theNumber.nan = false;
+
+    const char* anCursor = theFirst;
+    if(anCursor != theLast && *anCursor == '-')
+    {
+      theNumber.negative = true;
+      ++anCursor;
+    }
+
+    // Look for inf, infinity and nan first
+    const char* anWord = MatchNoCase(anCursor, theLast, "inf");
+    if(anWord != anCursor)
+    {
+      theNumber.infinity = true;
+      const char* anInfinity = MatchNoCase(anWord, theLast, "inity");
+      return anInfinity;
+    }
+    anWord = MatchNoCase(anCursor, theLast, "nan");
+    if(anWord != anCursor)
+    {
+      theNumber.nan = true;
+      return anWord;
+    }
+
+    // Keep the first significant digits in the mantissa and count the rest
+    // in the exponent; leading zeros are not significant
+    Uint32 anSignificant = 0;
+    bool anDigits = false;
+    for(; anCursor != theLast && IsDigit(*anCursor); ++anCursor)
+    {
+      anDigits = true;
+      if(anSignificant < MAX_MANTISSA_DIGITS)
+      {
+        theNumber.mantissa = theNumber.mantissa * 10 + (*anCursor - '0');
+        if(theNumber.mantissa != 0)
+        {
+          anSignificant++;
+        }
+      }
+      else
+      {
+        theNumber.exponent++;
+        theNumber.truncated |= (*anCursor != '0');
+      }
+    }
+    if(anCursor != theLast && *anCursor == '.')
+    {
+      for(++anCursor; anCursor != theLast && IsDigit(*anCursor); ++anCursor)
+      {
+        anDigits = true;
+        if(anSignificant < MAX_MANTISSA_DIGITS)
+        {
+          theNumber.mantissa = theNumber.mantissa * 10 + (*anCursor - '0');
+          theNumber.exponent--;
+          if(theNumber.mantissa != 0)
+          {
+            anSignificant++;
+          }
+        }
+        else
+        {
+          theNumber.truncated |= (*anCursor != '0');
+        }
+      }
+    }
+    if(!anDigits)
+    {
+      return theFirst;
+    }
 
-    // Add theFloat to the stringstream
-    anResult << theFloat;
+    // The exponent is only used if digits follow the 'e'
+    if(anCursor != theLast && (*anCursor == 'e' || *anCursor == 'E'))
+    {
+      const char* anExponent = anCursor + 1;
+      bool anNegative = false;
+      if(anExponent != theLast && (*anExponent == '-' || *anExponent == '+'))
+      {
+        anNegative = (*anExponent == '-');
+        ++anExponent;
+      }
+      if(anExponent != theLast && IsDigit(*anExponent))
+      {
+        // Clamp huge exponents, they overflow or underflow anyway
+        Int32 anValue = 0;
+        for(; anExponent != theLast && IsDigit(*anExponent); ++anExponent)
+        {
+          if(anValue < 100000)
+          {
+            anValue = anValue * 10 + (*anExponent - '0');
+          }
+        }
+        theNumber.exponent += anNegative ? -anValue : anValue;
+        anCursor = anExponent;
+      }
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return anCursor;
   }
 
-  std::string ConvertInt8(const Int8 theNumber)
+  static double ParseFallback(const char* theFirst, const char* theLast)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    // strtod uses the decimal point of the current locale, so copy the
+    // number replacing '.' before handing it over
+    const char anPoint = localeconv()->decimal_point[0];
+    const size_t anLength = static_cast<size_t>(theLast - theFirst);
+    char anStack[64];
+    std::vector<char> anHeap;
+    char* anBuffer = anStack;
+    if(anLength >= sizeof(anStack))
+    {
+      anHeap.resize(anLength + 1);
+      anBuffer = &anHeap[0];
+    }
+    for(size_t i = 0; i < anLength; i++)
+    {
+      anBuffer[i] = (theFirst[i] == '.') ? anPoint : theFirst[i];
+    }
+    anBuffer[anLength] = '\0';
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+    return strtod(anBuffer, NULL);
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  static size_t FormatSpecial(char* theBuffer, const size_t theSize, const double theDouble)
+  {
+    if(theDouble != theDouble)
+    {
+      return CopyChars(theBuffer, theSize, "nan", 3);
+    }
+    return theDouble < 0.0 ? CopyChars(theBuffer, theSize, "-inf", 4) :
+      CopyChars(theBuffer, theSize, "inf", 3);
   }
 
-  std::string ConvertInt16(const Int16 theNumber)
+  /// Binary floating point value f * 2^e with a 64 bit significand
+  struct DiyFp
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    Uint64 f;   ///< Significand
+    Int32 e;    ///< Binary exponent
+  };
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  static DiyFp MakeDiyFp(const Uint64 theSignificand, const Int32 theExponent)
+  {
+    DiyFp anResult;
+    anResult.f = theSignificand;
+    anResult.e = theExponent;
+    return anResult;
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  static DiyFp Normalize(DiyFp theValue)
+  {
+    const Uint64 anTopBit = static_cast<Uint64>(1) << 63;
+    while((theValue.f & anTopBit) == 0)
+    {
+      theValue.f <<= 1;
+      theValue.e--;
+    }
+    return theValue;
   }
 
-  std::string ConvertInt32(const Int32 theNumber)
+  static DiyFp Multiply(const DiyFp& theLeft, const DiyFp& theRight)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    // Upper 64 bits of the 128 bit product, rounded, from 32 bit halves
+    const Uint64 anMask = 0xFFFFFFFF;
+    const Uint64 a = theLeft.f >> 32;
+    const Uint64 b = theLeft.f & anMask;
+    const Uint64 c = theRight.f >> 32;
+    const Uint64 d = theRight.f & anMask;
+    const Uint64 ac = a * c;
+    const Uint64 bc = b * c;
+    const Uint64 ad = a * d;
+    const Uint64 bd = b * d;
+    Uint64 anMiddle = (bd >> 32) + (ad & anMask) + (bc & anMask);
+    anMiddle += static_cast<Uint64>(1) << 31;
+    return MakeDiyFp(ac + (ad >> 32) + (bc >> 32) + (anMiddle >> 32), theLeft.e + theRight.e + 64);
+  }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  static DiyFp GetCachedPower(const Int32 theExponent, Int32& theDecimalExponent)
+  {
+    // Pick the power of ten that brings the product into [2^-60, 2^-32]
+    const double anK = (-61 - theExponent) * 0.30102999566398114 + 347;
+    Int32 anIndex = static_cast<Int32>(anK);
+    if(anK - anIndex > 0.0)
+    {
+      anIndex++;
+    }
+    anIndex = (anIndex >> 3) + 1;
+    theDecimalExponent = -(-348 + anIndex * 8);
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    const CachedPower& anPower = CACHED_POWERS[anIndex];
+    return MakeDiyFp((static_cast<Uint64>(anPower.high) << 32) | anPower.low, anPower.exponent);
   }
 
-  std::string ConvertInt64(const Int64 theNumber)
+  static void GrisuRound(char* theDigits, const Int32 theLength, const Uint64 theDelta,
+      Uint64 theRest, const Uint64 theTenKappa, const Uint64 theDistance)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    // Move the last digit towards the exact value while it stays inside
+    // the rounding interval
+    while(theRest < theDistance && theDelta - theRest >= theTenKappa &&
+      (theRest + theTenKappa < theDistance ||
+       theDistance - theRest > theRest + theTenKappa - theDistance))
+    {
+      theDigits[theLength - 1]--;
+      theRest += theTenKappa;
+    }
+  }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  static Int32 DigitGen(const DiyFp& theValue, const DiyFp& theUpper, Uint64 theDelta,
+      char* theDigits, Int32& theDecimalExponent)
+  {
+    const DiyFp anOne = MakeDiyFp(static_cast<Uint64>(1) << -theUpper.e, theUpper.e);
+    const Uint64 anDistance = theUpper.f - theValue.f;
+    Uint32 anIntegral = static_cast<Uint32>(theUpper.f >> -anOne.e);
+    Uint64 anFraction = theUpper.f & (anOne.f - 1);
+
+    Int32 anKappa = 1;
+    while(anKappa < 10 && anIntegral >= UINT32_POWERS[anKappa])
+    {
+      anKappa++;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    // Integral digits, stopping as soon as the rest fits in the interval
+    Int32 anLength = 0;
+    while(anKappa > 0)
+    {
+      const Uint32 anPower = UINT32_POWERS[anKappa - 1];
+      const Uint32 anDigit = anIntegral / anPower;
+      anIntegral %= anPower;
+      if(anDigit != 0 || anLength != 0)
+      {
+        theDigits[anLength++] = static_cast<char>('0' + anDigit);
+      }
+      anKappa--;
+
+      const Uint64 anRest = (static_cast<Uint64>(anIntegral) << -anOne.e) + anFraction;
+      if(anRest <= theDelta)
+      {
+        theDecimalExponent += anKappa;
+        GrisuRound(theDigits, anLength, theDelta, anRest,
+          static_cast<Uint64>(UINT32_POWERS[anKappa]) << -anOne.e, anDistance);
+        return anLength;
+      }
+    }
+
+    // Fractional digits
+    while(true)
+    {
+      anFraction *= 10;
+      theDelta *= 10;
+      const char anDigit = static_cast<char>(anFraction >> -anOne.e);
+      if(anDigit != 0 || anLength != 0)
+      {
+        theDigits[anLength++] = static_cast<char>('0' + anDigit);
+      }
+      anFraction &= anOne.f - 1;
+      anKappa--;
+      if(anFraction < theDelta)
+      {
+        theDecimalExponent += anKappa;
+        const Int32 anIndex = -anKappa;
+        GrisuRound(theDigits, anLength, theDelta, anFraction, anOne.f,
+          anIndex < 10 ? anDistance * UINT32_POWERS[anIndex] : 0);
+        return anLength;
+      }
+    }
   }
 
-  std::string ConvertIntRect(const sf::IntRect theRect)
+  static Int32 Grisu2(const Uint64 theSignificand, const Int32 theExponent,
+      const bool theLowerCloser, char* theDigits, Int32& theDecimalExponent)
+  {
+    // Grisu2 by Florian Loitsch: the shortest digits inside the interval of
+    // values that round to the same binary number, one pass and no bignums.
+    // The interval is shrunk by one unit on each side so the result always
+    // parses back to the same value, which costs the shortest result for a
+    // very small fraction of inputs
+    const DiyFp anValue = Normalize(MakeDiyFp(theSignificand, theExponent));
+    const DiyFp anUpper = Normalize(MakeDiyFp((theSignificand << 1) + 1, theExponent - 1));
+    DiyFp anLower = theLowerCloser ? MakeDiyFp((theSignificand << 2) - 1, theExponent - 2) :
+      MakeDiyFp((theSignificand << 1) - 1, theExponent - 1);
+    anLower.f <<= anLower.e - anUpper.e;
+    anLower.e = anUpper.e;
+
+    const DiyFp anPower = GetCachedPower(anUpper.e, theDecimalExponent);
+    const DiyFp anScaled = Multiply(anValue, anPower);
+    DiyFp anScaledUpper = Multiply(anUpper, anPower);
+    DiyFp anScaledLower = Multiply(anLower, anPower);
+    anScaledLower.f++;
+    anScaledUpper.f--;
+
+    return DigitGen(anScaled, anScaledUpper, anScaledUpper.f - anScaledLower.f, theDigits,
+      theDecimalExponent);
+  }
+
+  static size_t FormatShortest(char* theBuffer, const size_t theSize, const bool theNegative,
+      const Uint64 theSignificand, const Int32 theExponent, const bool theLowerCloser)
+  {
+    char anTemp[FORMAT_BUFFER_SIZE];
+    char* anCursor = anTemp;
+    if(theNegative)
+    {
+      *anCursor++ = '-';
+    }
+    if(theSignificand == 0)
+    {
+      *anCursor++ = '0';
+      return CopyChars(theBuffer, theSize, anTemp, static_cast<size_t>(anCursor - anTemp));
+    }
+
+    // The value is theDigits * 10^anExponent
+    char anDigits[20];
+    Int32 anExponent = 0;
+    const Int32 anLength = Grisu2(theSignificand, theExponent, theLowerCloser, anDigits, anExponent);
+    const Int32 anPoint = anLength + anExponent;
+
+    if(anExponent >= 0 && anPoint <= 17)
+    {
+      // Integer: 1200
+      memcpy(anCursor, anDigits, anLength);
+      anCursor += anLength;
+      for(Int32 i = 0; i < anExponent; i++)
+      {
+        *anCursor++ = '0';
+      }
+    }
+    else if(anPoint > 0 && anPoint <= 17)
+    {
+      // Point inside the digits: 12.34
+      memcpy(anCursor, anDigits, anPoint);
+      anCursor += anPoint;
+      *anCursor++ = '.';
+      memcpy(anCursor, anDigits + anPoint, anLength - anPoint);
+      anCursor += anLength - anPoint;
+    }
+    else if(anPoint > -5 && anPoint <= 0)
+    {
+      // Small fraction: 0.001234
+      *anCursor++ = '0';
+      *anCursor++ = '.';
+      for(Int32 i = anPoint; i < 0; i++)
+      {
+        *anCursor++ = '0';
+      }
+      memcpy(anCursor, anDigits, anLength);
+      anCursor += anLength;
+    }
+    else
+    {
+      // Scientific notation: 1.234e-07
+      *anCursor++ = anDigits[0];
+      if(anLength > 1)
+      {
+        *anCursor++ = '.';
+        memcpy(anCursor, anDigits + 1, anLength - 1);
+        anCursor += anLength - 1;
+      }
+      *anCursor++ = 'e';
+      Int32 anScientific = anPoint - 1;
+      *anCursor++ = anScientific < 0 ? '-' : '+';
+      anScientific = anScientific < 0 ? -anScientific : anScientific;
+      if(anScientific < 10)
+      {
+        *anCursor++ = '0';
+      }
+      anCursor += FormatDigits<Uint32>(anCursor, sizeof(anTemp) - (anCursor - anTemp),
+        static_cast<Uint32>(anScientific), false);
+    }
+
+    return CopyChars(theBuffer, theSize, anTemp, static_cast<size_t>(anCursor - anTemp));
+  }
+
+  static size_t FormatSeparator(char* theBuffer)
   {
-    // Use StringStream class to convert theRect to a string
-    std::stringstream anResult;
+    theBuffer[0] = ',';
+    theBuffer[1] = ' ';
+    return 2;
+  }
 
-    // Add theRect to the stringstream
-    anResult << theRect.top << ", ";
-    anResult << theRect.left << ", ";
-    anResult << theRect.width << ", ";
-    anResult << theRect.height;
+  static const char* SkipSpaces(const char* theFirst, const char* theLast)
+  {
+    while(theFirst != theLast && IsSpace(*theFirst))
+    {
+      ++theFirst;
+    }
+    return theFirst;
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  size_t FormatInt32(char* theBuffer, const size_t theSize, const Int32 theNumber)
+  {
+    // Take the magnitude in unsigned arithmetic so the smallest value works
+    const Uint32 anMagnitude = theNumber < 0 ?
+      0 - static_cast<Uint32>(theNumber) : static_cast<Uint32>(theNumber);
+    return FormatDigits<Uint32>(theBuffer, theSize, anMagnitude, theNumber < 0);
   }
 
-  std::string ConvertUint8(const Uint8 theNumber)
+  size_t FormatInt64(char* theBuffer, const size_t theSize, const Int64 theNumber)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    // Take the magnitude in unsigned arithmetic so the smallest value works
+    const Uint64 anMagnitude = theNumber < 0 ?
+      0 - static_cast<Uint64>(theNumber) : static_cast<Uint64>(theNumber);
+    return FormatDigits<Uint64>(theBuffer, theSize, anMagnitude, theNumber < 0);
+  }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  size_t FormatUint32(char* theBuffer, const size_t theSize, const Uint32 theNumber)
+  {
+    return FormatDigits<Uint32>(theBuffer, theSize, theNumber, false);
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  size_t FormatUint64(char* theBuffer, const size_t theSize, const Uint64 theNumber)
+  {
+    return FormatDigits<Uint64>(theBuffer, theSize, theNumber, false);
   }
 
-  std::string ConvertUint16(const Uint16 theNumber)
+  size_t FormatDouble(char* theBuffer, const size_t theSize, const double theDouble)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    if(theDouble != theDouble || theDouble - theDouble != 0.0)
+    {
+      return FormatSpecial(theBuffer, theSize, theDouble);
+    }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+    // Split the IEEE 754 bits into sign, exponent and significand
+    Uint64 anBits;
+    memcpy(&anBits, &theDouble, sizeof(anBits));
+    const Uint64 anHidden = static_cast<Uint64>(1) << 52;
+    const Int32 anBiased = static_cast<Int32>((anBits >> 52) & 0x7FF);
+    Uint64 anSignificand = anBits & (anHidden - 1);
+    Int32 anExponent = -1074;
+    if(anBiased != 0)
+    {
+      anSignificand += anHidden;
+      anExponent = anBiased - 1075;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    // At a power of two the next value down is half as far as the next up
+    return FormatShortest(theBuffer, theSize, (anBits >> 63) != 0, anSignificand, anExponent,
+      anSignificand == anHidden);
   }
 
-  std::string ConvertUint32(const Uint32 theNumber)
+  size_t FormatFloat(char* theBuffer, const size_t theSize, const float theFloat)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    if(theFloat != theFloat || theFloat - theFloat != 0.0f)
+    {
+      return FormatSpecial(theBuffer, theSize, theFloat);
+    }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+    // Same as FormatDouble with the float layout, so the interval and the
+    // digits are those of the float and not of the wider double
+    Uint32 anBits;
+    memcpy(&anBits, &theFloat, sizeof(anBits));
+    const Uint32 anHidden = static_cast<Uint32>(1) << 23;
+    const Int32 anBiased = static_cast<Int32>((anBits >> 23) & 0xFF);
+    Uint32 anSignificand = anBits & (anHidden - 1);
+    Int32 anExponent = -149;
+    if(anBiased != 0)
+    {
+      anSignificand += anHidden;
+      anExponent = anBiased - 150;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    return FormatShortest(theBuffer, theSize, (anBits >> 31) != 0, anSignificand, anExponent,
+      anSignificand == anHidden);
   }
 
-  std::string ConvertUint64(const Uint64 theNumber)
+  const char* ParseInt32(const char* theFirst, const char* theLast, Int32& theResult)
   {
-    // Use StringStream class to convert theNumber to a string
-    std::stringstream anResult;
+    return ParseSigned<Int32, Uint32>(theFirst, theLast, theResult);
+  }
 
-    // Add theNumber to the stringstream
-    anResult << theNumber;
+  const char* ParseInt64(const char* theFirst, const char* theLast, Int64& theResult)
+  {
+    return ParseSigned<Int64, Uint64>(theFirst, theLast, theResult);
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  const char* ParseUint32(const char* theFirst, const char* theLast, Uint32& theResult)
+  {
+    return ParseDigits<Uint32>(theFirst, theLast, std::numeric_limits<Uint32>::max(), theResult);
   }
 
-  std::string ConvertVector2f(const sf::Vector2f theVector)
+  const char* ParseUint64(const char* theFirst, const char* theLast, Uint64& theResult)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    return ParseDigits<Uint64>(theFirst, theLast, std::numeric_limits<Uint64>::max(), theResult);
+  }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
+  const char* ParseDouble(const char* theFirst, const char* theLast, double& theResult)
+  {
+    DecimalNumber anNumber;
+    const char* anEnd = ScanNumber(theFirst, theLast, anNumber);
+    if(anEnd == theFirst)
+    {
+      return theFirst;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    double anResult = 0.0;
+    if(anNumber.nan)
+    {
+      anResult = std::numeric_limits<double>::quiet_NaN();
+    }
+    else if(anNumber.infinity)
+    {
+      anResult = std::numeric_limits<double>::infinity();
+    }
+    else if(anNumber.mantissa == 0)
+    {
+      anResult = 0.0;
+    }
+    else if(!anNumber.truncated && anNumber.mantissa <= (Uint64(1) << 53) &&
+      anNumber.exponent >= -22 && anNumber.exponent <= 22)
+    {
+      // Both the mantissa and the power of ten are exact doubles, so a
+      // single multiplication or division gives the correctly rounded value
+      anResult = static_cast<double>(anNumber.mantissa);
+      if(anNumber.exponent < 0)
+      {
+        anResult /= DOUBLE_POWERS[-anNumber.exponent];
+      }
+      else
+      {
+        anResult *= DOUBLE_POWERS[anNumber.exponent];
+      }
+    }
+    else
+    {
+      // strtod takes care of the sign itself
+      theResult = ParseFallback(theFirst, anEnd);
+      return anEnd;
+    }
+
+    theResult = anNumber.negative ? -anResult : anResult;
+
+    return anEnd;
   }
 
-  std::string ConvertVector2i(const sf::Vector2i theVector)
+  const char* ParseFloat(const char* theFirst, const char* theLast, float& theResult)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    DecimalNumber anNumber;
+    const char* anEnd = ScanNumber(theFirst, theLast, anNumber);
+    if(anEnd == theFirst)
+    {
+      return theFirst;
+    }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
+    float anResult = 0.f;
+    if(anNumber.nan)
+    {
+      anResult = std::numeric_limits<float>::quiet_NaN();
+    }
+    else if(anNumber.infinity)
+    {
+      anResult = std::numeric_limits<float>::infinity();
+    }
+    else if(anNumber.mantissa == 0)
+    {
+      anResult = 0.f;
+    }
+    else if(!anNumber.truncated && anNumber.mantissa <= (Uint64(1) << 24) &&
+      anNumber.exponent >= -10 && anNumber.exponent <= 10)
+    {
+      // Same exact fast path as ParseDouble using float arithmetic
+      anResult = static_cast<float>(anNumber.mantissa);
+      if(anNumber.exponent < 0)
+      {
+        anResult /= FLOAT_POWERS[-anNumber.exponent];
+      }
+      else
+      {
+        anResult *= FLOAT_POWERS[anNumber.exponent];
+      }
+    }
+    else
+    {
+      // strtod takes care of the sign itself
+      theResult = static_cast<float>(ParseFallback(theFirst, anEnd));
+      return anEnd;
+    }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+    theResult = anNumber.negative ? -anResult : anResult;
+
+    return anEnd;
   }
 
-  std::string ConvertVector2u(const sf::Vector2u theVector)
+  std::string ConvertBool(const bool theBoolean)
+  {
+    return theBoolean ? "true" : "false";
+  }
+
+  std::string ConvertColor(const sf::Color theColor)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    // Write each component as a number, not as a character
+    char anBuffer[4 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatUint32(anBuffer, sizeof(anBuffer), theColor.r);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatUint32(anBuffer + anLength, sizeof(anBuffer) - anLength, theColor.g);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatUint32(anBuffer + anLength, sizeof(anBuffer) - anLength, theColor.b);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatUint32(anBuffer + anLength, sizeof(anBuffer) - anLength, theColor.a);
+
+    return std::string(anBuffer, anLength);
+  }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y;
+  std::string ConvertDouble(const double theDouble)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatDouble(anBuffer, sizeof(anBuffer), theDouble));
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  std::string ConvertFloat(const float theFloat)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatFloat(anBuffer, sizeof(anBuffer), theFloat));
   }
 
-  std::string ConvertVector3f(const sf::Vector3f theVector)
+  std::string ConvertInt8(const Int8 theNumber)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    // Write the number, not the character
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatInt32(anBuffer, sizeof(anBuffer), theNumber));
+  }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y << ", ";
-    anResult << theVector.z;
+  std::string ConvertInt16(const Int16 theNumber)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatInt32(anBuffer, sizeof(anBuffer), theNumber));
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  std::string ConvertInt32(const Int32 theNumber)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatInt32(anBuffer, sizeof(anBuffer), theNumber));
   }
 
-  std::string ConvertVector3i(const sf::Vector3i theVector)
+  std::string ConvertInt64(const Int64 theNumber)
   {
-    // Use StringStream class to convert theVector to a string
-    std::stringstream anResult;
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatInt64(anBuffer, sizeof(anBuffer), theNumber));
+  }
 
-    // Add theVector to the stringstream
-    anResult << theVector.x << ", ";
-    anResult << theVector.y << ", ";
-    anResult << theVector.z;
+  std::string ConvertIntRect(const sf::IntRect theRect)
+  {
+    // Use the same left, top, width, height order ParseIntRect expects
+    char anBuffer[4 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatInt32(anBuffer, sizeof(anBuffer), theRect.left);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theRect.top);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theRect.width);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theRect.height);
+
+    return std::string(anBuffer, anLength);
+  }
 
-    // Return the string result created by stringstream
-    return anResult.str();
+  std::string ConvertUint8(const Uint8 theNumber)
+  {
+    // Write the number, not the character
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatUint32(anBuffer, sizeof(anBuffer), theNumber));
   }
 
-  bool ParseBool(std::string theValue, const bool theDefault)
+  std::string ConvertUint16(const Uint16 theNumber)
   {
-    bool anResult = theDefault;
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatUint32(anBuffer, sizeof(anBuffer), theNumber));
+  }
 
-    // First convert theValue provided into lower case
-    std::transform(theValue.begin(), theValue.end(), theValue.begin(), tolower);
+  std::string ConvertUint32(const Uint32 theNumber)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatUint32(anBuffer, sizeof(anBuffer), theNumber));
+  }
+
+  std::string ConvertUint64(const Uint64 theNumber)
+  {
+    char anBuffer[FORMAT_BUFFER_SIZE];
+    return std::string(anBuffer, FormatUint64(anBuffer, sizeof(anBuffer), theNumber));
+  }
 
-    // Look for true/1/on results
-    if(theValue == "true" || theValue == "1" || theValue == "on")
+  std::string ConvertVector2f(const sf::Vector2f theVector)
+  {
+    char anBuffer[2 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatFloat(anBuffer, sizeof(anBuffer), theVector.x);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatFloat(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.y);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  std::string ConvertVector2i(const sf::Vector2i theVector)
+  {
+    char anBuffer[2 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatInt32(anBuffer, sizeof(anBuffer), theVector.x);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.y);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  std::string ConvertVector2u(const sf::Vector2u theVector)
+  {
+    char anBuffer[2 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatUint32(anBuffer, sizeof(anBuffer), theVector.x);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatUint32(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.y);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  std::string ConvertVector3f(const sf::Vector3f theVector)
+  {
+    char anBuffer[3 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatFloat(anBuffer, sizeof(anBuffer), theVector.x);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatFloat(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.y);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatFloat(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.z);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  std::string ConvertVector3i(const sf::Vector3i theVector)
+  {
+    char anBuffer[3 * FORMAT_BUFFER_SIZE];
+    size_t anLength = FormatInt32(anBuffer, sizeof(anBuffer), theVector.x);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.y);
+    anLength += FormatSeparator(anBuffer + anLength);
+    anLength += FormatInt32(anBuffer + anLength, sizeof(anBuffer) - anLength, theVector.z);
+
+    return std::string(anBuffer, anLength);
+  }
+
+  bool ParseBool(const std::string& theValue, const bool theDefault)
+  {
+    bool anResult = theDefault;
+
+    // Look for true/1/on results ignoring the case, without copying theValue
+    const char* anFirst = theValue.c_str();
+    const char* anLast = anFirst + theValue.size();
+    if(IsWordNoCase(anFirst, anLast, "true") ||
+        IsWordNoCase(anFirst, anLast, "1") ||
+        IsWordNoCase(anFirst, anLast, "on"))
     {
       anResult = true;
     }
 
     // Look for false results
-    if(theValue == "false" || theValue == "0" || theValue == "off")
+    if(IsWordNoCase(anFirst, anLast, "false") ||
+        IsWordNoCase(anFirst, anLast, "0") ||
+        IsWordNoCase(anFirst, anLast, "off"))
     {
       anResult = false;
     }
@@ -264,7 +989,7 @@ namespace ra
     return anResult;
   }
 
-  sf::Color ParseColor(const std::string theValue, const sf::Color theDefault)
+  sf::Color ParseColor(const std::string& theValue, const sf::Color theDefault)
   {
     sf::Color anResult = theDefault;
 
@@ -301,79 +1026,81 @@ namespace ra
     return anResult;
   }
 
-  double ParseDouble(const std::string theValue, const double theDefault)
+  double ParseDouble(const std::string& theValue, const double theDefault)
   {
     double anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to a double floating point number
-    iss >> anResult;
+    ParseDouble(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  float ParseFloat(const std::string theValue, const float theDefault)
+  float ParseFloat(const std::string& theValue, const float theDefault)
   {
     float anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to a floating point number
-    iss >> anResult;
+    ParseFloat(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  Int8 ParseInt8(const std::string theValue, const Int8 theDefault)
+  Int8 ParseInt8(const std::string& theValue, const Int8 theDefault)
   {
-    Int8 anResult = theDefault;
-    std::istringstream iss(theValue);
-
-    // Convert the string to a signed 8 bit integer
-    iss >> anResult;
+    // Convert the string to a number, not a character, and check its range
+    Int32 anResult = ParseInt32(theValue, theDefault);
+    if(anResult < std::numeric_limits<Int8>::min() || anResult > std::numeric_limits<Int8>::max())
+    {
+      anResult = theDefault;
+    }
 
     // Return the result found or theDefault assigned above
-    return anResult;
+    return static_cast<Int8>(anResult);
   }
 
-  Int16 ParseInt16(const std::string theValue, const Int16 theDefault)
+  Int16 ParseInt16(const std::string& theValue, const Int16 theDefault)
   {
-    Int16 anResult = theDefault;
-    std::istringstream iss(theValue);
-
-    // Convert the string to a signed 16 bit integer
-    iss >> anResult;
+    // Convert the string to a signed 16 bit integer and check its range
+    Int32 anResult = ParseInt32(theValue, theDefault);
+    if(anResult < std::numeric_limits<Int16>::min() || anResult > std::numeric_limits<Int16>::max())
+    {
+      anResult = theDefault;
+    }
 
     // Return the result found or theDefault assigned above
-    return anResult;
+    return static_cast<Int16>(anResult);
   }
 
-  Int32 ParseInt32(const std::string theValue, const Int32 theDefault)
+  Int32 ParseInt32(const std::string& theValue, const Int32 theDefault)
   {
     Int32 anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to a signed 32 bit integer
-    iss >> anResult;
+    ParseInt32(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  Int64 ParseInt64(const std::string theValue, const Int64 theDefault)
+  Int64 ParseInt64(const std::string& theValue, const Int64 theDefault)
   {
     Int64 anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to a signed 64 bit integer
-    iss >> anResult;
+    ParseInt64(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  sf::IntRect ParseIntRect(const std::string theValue, const sf::IntRect theDefault)
+  sf::IntRect ParseIntRect(const std::string& theValue, const sf::IntRect theDefault)
   {
     sf::IntRect anResult = theDefault;
 
@@ -408,55 +1135,57 @@ namespace ra
     return anResult;
   }
 
-  Uint8 ParseUint8(const std::string theValue, const Uint8 theDefault)
+  Uint8 ParseUint8(const std::string& theValue, const Uint8 theDefault)
   {
-    Uint8 anResult = theDefault;
-    std::istringstream iss(theValue);
-
-    // Convert the string to an unsigned 8 bit integer
-    iss >> anResult;
+    // Convert the string to a number, not a character, and check its range
+    Uint32 anResult = ParseUint32(theValue, theDefault);
+    if(anResult > std::numeric_limits<Uint8>::max())
+    {
+      anResult = theDefault;
+    }
 
     // Return the result found or theDefault assigned above
-    return anResult;
+    return static_cast<Uint8>(anResult);
   }
 
-  Uint16 ParseUint16(const std::string theValue, const Uint16 theDefault)
+  Uint16 ParseUint16(const std::string& theValue, const Uint16 theDefault)
   {
-    Uint16 anResult = theDefault;
-    std::istringstream iss(theValue);
-
-    // Convert the string to an unsigned 16 bit integer
-    iss >> anResult;
+    // Convert the string to an unsigned 16 bit integer and check its range
+    Uint32 anResult = ParseUint32(theValue, theDefault);
+    if(anResult > std::numeric_limits<Uint16>::max())
+    {
+      anResult = theDefault;
+    }
 
     // Return the result found or theDefault assigned above
-    return anResult;
+    return static_cast<Uint16>(anResult);
   }
 
-  Uint32 ParseUint32(const std::string theValue, const Uint32 theDefault)
+  Uint32 ParseUint32(const std::string& theValue, const Uint32 theDefault)
   {
     Uint32 anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to an unsigned 32 bit integer
-    iss >> anResult;
+    ParseUint32(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  Uint64 ParseUint64(const std::string theValue, const Uint64 theDefault)
+  Uint64 ParseUint64(const std::string& theValue, const Uint64 theDefault)
   {
     Uint64 anResult = theDefault;
-    std::istringstream iss(theValue);
+    const char* anLast = theValue.c_str() + theValue.size();
 
     // Convert the string to an unsigned 64 bit integer
-    iss >> anResult;
+    ParseUint64(SkipSpaces(theValue.c_str(), anLast), anLast, anResult);
 
     // Return the result found or theDefault assigned above
     return anResult;
   }
 
-  sf::Vector2f ParseVector2f(const std::string theValue, const sf::Vector2f theDefault)
+  sf::Vector2f ParseVector2f(const std::string& theValue, const sf::Vector2f theDefault)
   {
     sf::Vector2f anResult = theDefault;
 
@@ -476,7 +1205,7 @@ namespace ra
     return anResult;
   }
 
-  sf::Vector2i ParseVector2i(const std::string theValue, const sf::Vector2i theDefault)
+  sf::Vector2i ParseVector2i(const std::string& theValue, const sf::Vector2i theDefault)
   {
     sf::Vector2i anResult = theDefault;
 
@@ -496,7 +1225,7 @@ namespace ra
     return anResult;
   }
 
-  sf::Vector2u ParseVector2u(const std::string theValue, const sf::Vector2u theDefault)
+  sf::Vector2u ParseVector2u(const std::string& theValue, const sf::Vector2u theDefault)
   {
     sf::Vector2u anResult = theDefault;
 
@@ -516,7 +1245,7 @@ namespace ra
     return anResult;
   }
 
-  sf::Vector3f ParseVector3f(const std::string theValue, const sf::Vector3f theDefault)
+  sf::Vector3f ParseVector3f(const std::string& theValue, const sf::Vector3f theDefault)
   {
     sf::Vector3f anResult = theDefault;
 
@@ -544,7 +1273,7 @@ namespace ra
     return anResult;
   }
 
-  sf::Vector3i ParseVector3i(const std::string theValue, const sf::Vector3i theDefault)
+  sf::Vector3i ParseVector3i(const std::string& theValue, const sf::Vector3i theDefault)
   {
     sf::Vector3i anResult = theDefault;
 
@@ -4,6 +4,8 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <RAGE/Core/Text.hpp>
+#include <RAGE/Core/MemoryTracker.hpp>
+#include <RAGE/Core/RenderStats.hpp>
 #include <cassert>
 
 
@@ -193,7 +195,7 @@ void Text::draw(sf::RenderTarget& target, sf::RenderStates states) const
     {
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
-        target.draw(m_vertices, states);
+        ra::RenderStats::Draw(target, m_vertices, states);
     }
 }
 
@@ -201,6 +203,9 @@ void Text::draw(sf::RenderTarget& target, sf::RenderStates states) const
 ////////////////////////////////////////////////////////////
 void Text::updateGeometry()
 {
+    // The vertices and the glyphs rendered by the font count as Text memory
+    MemoryScope scope(MemoryText);
+
     // Clear the previous geometry
     m_vertices.clear();
     m_bounds = sf::FloatRect();
@@ -0,0 +1,606 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <RAGE/Core/App.hpp>
+#include <RAGE/Core/TileGrid.hpp>
+
+namespace
+{
+	/// Margen para que los bordes que solo se tocan no cuenten como solapados
+	const float EDGE_EPSILON = 0.001f;
+
+	/// Bits de volteo que Tiled guarda en la parte alta de cada gid
+	const ra::Uint32 GID_FLIP_MASK = 0xE0000000;
+
+	/// Etiqueta de un fichero XML, sin validar
+	struct XmlTag
+	{
+		std::string name;
+		std::map<std::string, std::string> attributes;
+		/// Verdadero si es una etiqueta de cierre </name>
+		bool closing;
+		/// Verdadero si se cierra a sí misma <name/>
+		bool empty;
+	};
+
+	/**
+	 * Lee la siguiente etiqueta a partir de thePosition y deja thePosition
+	 * justo después de ella. Se salta la declaración y los comentarios
+	 */
+	bool NextTag(const std::string& theText, size_t& thePosition, XmlTag& theTag)
+	{
+		while (true)
+		{
+			size_t start = theText.find('<', thePosition);
+			if (start == std::string::npos)
+			{
+				return false;
+			}
+			if (theText.compare(start, 4, "<!--") == 0)
+			{
+				size_t end = theText.find("-->", start);
+				thePosition = (end == std::string::npos) ? theText.size() : end + 3;
+				continue;
+			}
+			size_t end = theText.find('>', start);
+			if (end == std::string::npos)
+			{
+				return false;
+			}
+			thePosition = end + 1;
+			if (theText[start + 1] == '?' || theText[start + 1] == '!')
+			{
+				continue;
+			}
+
+			std::string body = theText.substr(start + 1, end - start - 1);
+			theTag.attributes.clear();
+			theTag.closing = !body.empty() && body[0] == '/';
+			theTag.empty = !body.empty() && body[body.size() - 1] == '/';
+			if (theTag.closing)
+			{
+				body.erase(0, 1);
+			}
+			if (theTag.empty)
+			{
+				body.erase(body.size() - 1);
+			}
+
+			size_t i = body.find_first_of(" \t\r\n");
+			theTag.name = body.substr(0, i);
+			while (i != std::string::npos && i < body.size())
+			{
+				size_t nameStart = body.find_first_not_of(" \t\r\n", i);
+				size_t equals = body.find('=', nameStart);
+				if (nameStart == std::string::npos || equals == std::string::npos)
+				{
+					break;
+				}
+				size_t quote = body.find_first_of("\"'", equals);
+				if (quote == std::string::npos)
+				{
+					break;
+				}
+				size_t quoteEnd = body.find(body[quote], quote + 1);
+				if (quoteEnd == std::string::npos)
+				{
+					break;
+				}
+				std::string name = body.substr(nameStart, equals - nameStart);
+				name.erase(name.find_last_not_of(" \t\r\n") + 1);
+				theTag.attributes[name] = body.substr(quote + 1, quoteEnd - quote - 1);
+				i = quoteEnd + 1;
+			}
+			return true;
+		}
+	}
+
+	std::string GetAttribute(const XmlTag& theTag, const std::string& theName)
+	{
+		std::map<std::string, std::string>::const_iterator it = theTag.attributes.find(theName);
+		return (it != theTag.attributes.end()) ? it->second : std::string();
+	}
+
+	float GetFloatAttribute(const XmlTag& theTag, const std::string& theName)
+	{
+		return static_cast<float>(std::atof(GetAttribute(theTag, theName).c_str()));
+	}
+
+	ra::Uint32 GetUintAttribute(const XmlTag& theTag, const std::string& theName)
+	{
+		return static_cast<ra::Uint32>(std::strtoul(GetAttribute(theTag, theName).c_str(), NULL, 10));
+	}
+
+	/// Lee los gids de una capa en CSV
+	void ReadCsv(const std::string& theText, std::vector<ra::Uint32>& theGids)
+	{
+		std::string text = theText;
+		std::replace(text.begin(), text.end(), ',', ' ');
+		std::istringstream stream(text);
+		ra::Uint32 gid;
+		while (stream >> gid)
+		{
+			theGids.push_back(gid);
+		}
+	}
+
+	/// Lee los gids de una capa en base64 sin comprimir, enteros little endian
+	void ReadBase64(const std::string& theText, std::vector<ra::Uint32>& theGids)
+	{
+		static const std::string DIGITS =
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		std::vector<unsigned char> bytes;
+		ra::Uint32 buffer = 0;
+		int bits = 0;
+		for (size_t i = 0; i < theText.size(); i++)
+		{
+			size_t value = DIGITS.find(theText[i]);
+			if (value == std::string::npos)
+			{
+				// Espacios, saltos de línea y relleno
+				continue;
+			}
+			buffer = (buffer << 6) | static_cast<ra::Uint32>(value);
+			bits += 6;
+			if (bits >= 8)
+			{
+				bits -= 8;
+				bytes.push_back(static_cast<unsigned char>((buffer >> bits) & 0xFF));
+			}
+		}
+
+		for (size_t i = 0; i + 3 < bytes.size(); i += 4)
+		{
+			theGids.push_back(bytes[i] | (bytes[i + 1] << 8) | (bytes[i + 2] << 16) |
+				(static_cast<ra::Uint32>(bytes[i + 3]) << 24));
+		}
+	}
+
+	ra::Int32 ToCell(float theValue, float theTileSize)
+	{
+		return static_cast<ra::Int32>(std::floor(theValue / theTileSize));
+	}
+}
+
+namespace ra
+{
+
+TileGrid::TileGrid()
+	: m_width(0)
+	, m_height(0)
+	, m_tileSize(0.f, 0.f)
+	, m_bits()
+{
+}
+
+void TileGrid::Create(Uint32 theWidth, Uint32 theHeight, const sf::Vector2f& theTileSize)
+{
+	m_width = theWidth;
+	m_height = theHeight;
+	m_tileSize = theTileSize;
+	m_bits.assign((theWidth * theHeight + 31) / 32, 0);
+}
+
+bool TileGrid::LoadFromTmx(const std::string& theFilename, const std::string& theLayer)
+{
+	ra::App* app = ra::App::Instance();
+
+	std::ifstream file(theFilename.c_str(), std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		app->log << "[error] TileGrid::LoadFromTmx() " << theFilename
+			<< " no se ha podido abrir" << std::endl;
+		return false;
+	}
+	std::ostringstream stream;
+	stream << file.rdbuf();
+	const std::string text = stream.str();
+
+	Clear();
+
+	// Los tilesets van antes que las capas, pero los gids sólidos se aplican
+	// al final por si el fichero no sigue ese orden
+	std::set<Uint32> solidGids;
+	std::vector<Uint32> gids;
+	std::vector<sf::FloatRect> rects;
+	Uint32 firstGid = 1;
+	Uint32 tileGid = 0;
+	bool inLayer = false;
+	bool inGroup = false;
+	bool found = false;
+
+	XmlTag tag;
+	size_t position = 0;
+	while (NextTag(text, position, tag))
+	{
+		if (tag.closing)
+		{
+			if (tag.name == "layer")
+			{
+				inLayer = false;
+			}
+			else if (tag.name == "objectgroup")
+			{
+				inGroup = false;
+			}
+			else if (tag.name == "tile")
+			{
+				tileGid = 0;
+			}
+			continue;
+		}
+
+		if (tag.name == "map")
+		{
+			Create(GetUintAttribute(tag, "width"), GetUintAttribute(tag, "height"),
+				sf::Vector2f(GetFloatAttribute(tag, "tilewidth"), GetFloatAttribute(tag, "tileheight")));
+		}
+		else if (tag.name == "tileset")
+		{
+			firstGid = GetUintAttribute(tag, "firstgid");
+		}
+		else if (tag.name == "tile" && inLayer)
+		{
+			gids.push_back(GetUintAttribute(tag, "gid"));
+		}
+		else if (tag.name == "tile")
+		{
+			tileGid = tag.empty ? 0 : firstGid + GetUintAttribute(tag, "id");
+		}
+		else if (tag.name == "property" && tileGid != 0 && GetAttribute(tag, "name") == "solid")
+		{
+			std::string value = GetAttribute(tag, "value");
+			if (value == "1" || value == "true")
+			{
+				solidGids.insert(tileGid);
+			}
+		}
+		else if (tag.name == "layer" && !tag.empty && !found && GetAttribute(tag, "name") == theLayer)
+		{
+			inLayer = true;
+			found = true;
+		}
+		else if (tag.name == "data" && inLayer && !tag.empty)
+		{
+			std::string encoding = GetAttribute(tag, "encoding");
+			if (!GetAttribute(tag, "compression").empty())
+			{
+				// No enlazamos zlib: el mapa se tiene que guardar sin comprimir
+				app->log << "[error] TileGrid::LoadFromTmx() " << theFilename << " capa="
+					<< theLayer << " comprimida con " << GetAttribute(tag, "compression")
+					<< ", guárdala en CSV o base64 sin comprimir" << std::endl;
+				Clear();
+				return false;
+			}
+			if (!encoding.empty())
+			{
+				size_t end = text.find('<', position);
+				std::string data = text.substr(position, end - position);
+				if (encoding == "csv")
+				{
+					ReadCsv(data, gids);
+				}
+				else
+				{
+					ReadBase64(data, gids);
+				}
+				position = end;
+			}
+		}
+		else if (tag.name == "objectgroup" && !tag.empty && !found && GetAttribute(tag, "name") == theLayer)
+		{
+			inGroup = true;
+			found = true;
+		}
+		else if (tag.name == "object" && inGroup)
+		{
+			// Los objetos con tile se colocan por su esquina inferior
+			sf::FloatRect rect(GetFloatAttribute(tag, "x"), GetFloatAttribute(tag, "y"),
+				GetFloatAttribute(tag, "width"), GetFloatAttribute(tag, "height"));
+			if (!GetAttribute(tag, "gid").empty())
+			{
+				rect.top -= rect.height;
+			}
+			if (rect.width > 0.f && rect.height > 0.f)
+			{
+				rects.push_back(rect);
+			}
+		}
+	}
+
+	if (!found || m_width == 0 || m_height == 0 || m_tileSize.x <= 0.f || m_tileSize.y <= 0.f)
+	{
+		app->log << "[error] TileGrid::LoadFromTmx() " << theFilename
+			<< " no tiene la capa " << theLayer << std::endl;
+		Clear();
+		return false;
+	}
+
+	size_t count = std::min(gids.size(), static_cast<size_t>(m_width) * m_height);
+	for (size_t i = 0; i < count; i++)
+	{
+		Uint32 gid = gids[i] & ~GID_FLIP_MASK;
+		if (gid != 0 && (solidGids.empty() || solidGids.count(gid) > 0))
+		{
+			SetSolid(static_cast<Int32>(i % m_width), static_cast<Int32>(i / m_width), true);
+		}
+	}
+	for (size_t i = 0; i < rects.size(); i++)
+	{
+		SetSolid(rects[i], true);
+	}
+
+	app->log << "TileGrid " << theFilename << " capa=" << theLayer << " "
+		<< m_width << "x" << m_height << std::endl;
+	return true;
+}
+
+void TileGrid::SetSolid(Int32 theX, Int32 theY, bool theSolid)
+{
+	if (theX < 0 || theY < 0 || static_cast<Uint32>(theX) >= m_width || static_cast<Uint32>(theY) >= m_height)
+	{
+		return;
+	}
+	Uint32 index = static_cast<Uint32>(theY) * m_width + static_cast<Uint32>(theX);
+	if (theSolid)
+	{
+		m_bits[index >> 5] |= (1u << (index & 31));
+	}
+	else
+	{
+		m_bits[index >> 5] &= ~(1u << (index & 31));
+	}
+}
+
+void TileGrid::SetSolid(const sf::FloatRect& theRect, bool theSolid)
+{
+	if (m_width == 0 || m_height == 0)
+	{
+		return;
+	}
+	Int32 left = std::max(ToCell(theRect.left + EDGE_EPSILON, m_tileSize.x), 0);
+	Int32 right = std::min(ToCell(theRect.left + theRect.width - EDGE_EPSILON, m_tileSize.x),
+		static_cast<Int32>(m_width) - 1);
+	Int32 top = std::max(ToCell(theRect.top + EDGE_EPSILON, m_tileSize.y), 0);
+	Int32 bottom = std::min(ToCell(theRect.top + theRect.height - EDGE_EPSILON, m_tileSize.y),
+		static_cast<Int32>(m_height) - 1);
+	for (Int32 y = top; y <= bottom; y++)
+	{
+		for (Int32 x = left; x <= right; x++)
+		{
+			SetSolid(x, y, theSolid);
+		}
+	}
+}
+
+bool TileGrid::IsSolid(Int32 theX, Int32 theY) const
+{
+	if (theX < 0 || theY < 0 || static_cast<Uint32>(theX) >= m_width || static_cast<Uint32>(theY) >= m_height)
+	{
+		return false;
+	}
+	Uint32 index = static_cast<Uint32>(theY) * m_width + static_cast<Uint32>(theX);
+	return (m_bits[index >> 5] & (1u << (index & 31))) != 0;
+}
+
+bool TileGrid::IsSolid(const sf::FloatRect& theRect) const
+{
+	if (m_width == 0 || m_height == 0)
+	{
+		return false;
+	}
+	Int32 left = ToCell(theRect.left + EDGE_EPSILON, m_tileSize.x);
+	Int32 right = ToCell(theRect.left + theRect.width - EDGE_EPSILON, m_tileSize.x);
+	Int32 top = ToCell(theRect.top + EDGE_EPSILON, m_tileSize.y);
+	Int32 bottom = ToCell(theRect.top + theRect.height - EDGE_EPSILON, m_tileSize.y);
+	for (Int32 x = left; x <= right; x++)
+	{
+		if (IsLineSolid(0, x, top, bottom))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+sf::Vector2i TileGrid::GetCell(const sf::Vector2f& thePoint) const
+{
+	if (m_width == 0 || m_height == 0)
+	{
+		return sf::Vector2i(0, 0);
+	}
+	return sf::Vector2i(ToCell(thePoint.x, m_tileSize.x), ToCell(thePoint.y, m_tileSize.y));
+}
+
+TileSweep TileGrid::Sweep(const sf::FloatRect& theBox, const sf::Vector2f& theDelta) const
+{
+	TileSweep result;
+	result.delta.x = SweepAxis(theBox, theDelta.x, 0);
+	result.hitX = result.delta.x != theDelta.x;
+
+	// El movimiento vertical parte de la posición horizontal ya resuelta
+	sf::FloatRect box = theBox;
+	box.left += result.delta.x;
+	result.delta.y = SweepAxis(box, theDelta.y, 1);
+	result.hitY = result.delta.y != theDelta.y;
+
+	return result;
+}
+
+bool TileGrid::RayCast(const sf::Vector2f& theFrom, const sf::Vector2f& theTo, TileRayHit& theHit) const
+{
+	if (m_width == 0 || m_height == 0)
+	{
+		return false;
+	}
+
+	const float origin[2] = { theFrom.x, theFrom.y };
+	const float direction[2] = { theTo.x - theFrom.x, theTo.y - theFrom.y };
+	const float tileSize[2] = { m_tileSize.x, m_tileSize.y };
+	const Int32 count[2] = { static_cast<Int32>(m_width), static_cast<Int32>(m_height) };
+	Int32 cell[2] = { ToCell(theFrom.x, m_tileSize.x), ToCell(theFrom.y, m_tileSize.y) };
+
+	if (IsSolid(cell[0], cell[1]))
+	{
+		theHit.cell = sf::Vector2i(cell[0], cell[1]);
+		theHit.point = theFrom;
+		theHit.normal = sf::Vector2f(0.f, 0.f);
+		theHit.fraction = 0.f;
+		return true;
+	}
+
+	// Fracción del segmento en la que se cruza el siguiente borde de cada
+	// eje y lo que avanza la fracción al cruzar una celda entera
+	Int32 step[2];
+	float next[2];
+	float advance[2];
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (std::fabs(direction[axis]) < 1e-12f)
+		{
+			step[axis] = 0;
+			next[axis] = 2.f;
+			advance[axis] = 0.f;
+			continue;
+		}
+		step[axis] = (direction[axis] > 0.f) ? 1 : -1;
+		float edge = (cell[axis] + (step[axis] > 0 ? 1 : 0)) * tileSize[axis];
+		next[axis] = (edge - origin[axis]) / direction[axis];
+		advance[axis] = tileSize[axis] / std::fabs(direction[axis]);
+	}
+
+	while (true)
+	{
+		int axis = (next[0] < next[1]) ? 0 : 1;
+		float fraction = next[axis];
+		if (fraction > 1.f)
+		{
+			return false;
+		}
+		cell[axis] += step[axis];
+		next[axis] += advance[axis];
+
+		// Si sale del mapa alejándose ya no puede volver a entrar
+		if ((step[axis] < 0 && cell[axis] < 0) || (step[axis] > 0 && cell[axis] >= count[axis]))
+		{
+			return false;
+		}
+
+		if (IsSolid(cell[0], cell[1]))
+		{
+			theHit.cell = sf::Vector2i(cell[0], cell[1]);
+			theHit.point = sf::Vector2f(origin[0] + direction[0] * fraction, origin[1] + direction[1] * fraction);
+			theHit.normal = (axis == 0) ? sf::Vector2f(-static_cast<float>(step[0]), 0.f) :
+				sf::Vector2f(0.f, -static_cast<float>(step[1]));
+			theHit.fraction = fraction;
+			return true;
+		}
+	}
+}
+
+bool TileGrid::HasLineOfSight(const sf::Vector2f& theFrom, const sf::Vector2f& theTo) const
+{
+	TileRayHit hit;
+	return !RayCast(theFrom, theTo, hit);
+}
+
+Uint32 TileGrid::GetWidth() const
+{
+	return m_width;
+}
+
+Uint32 TileGrid::GetHeight() const
+{
+	return m_height;
+}
+
+const sf::Vector2f& TileGrid::GetTileSize() const
+{
+	return m_tileSize;
+}
+
+sf::FloatRect TileGrid::GetBounds() const
+{
+	return sf::FloatRect(0.f, 0.f, m_width * m_tileSize.x, m_height * m_tileSize.y);
+}
+
+void TileGrid::Clear()
+{
+	m_width = 0;
+	m_height = 0;
+	m_tileSize = sf::Vector2f(0.f, 0.f);
+	m_bits.clear();
+}
+
+float TileGrid::SweepAxis(const sf::FloatRect& theBox, float theDelta, int theAxis) const
+{
+	if (theDelta == 0.f || m_width == 0 || m_height == 0)
+	{
+		return theDelta;
+	}
+
+	const float tile = (theAxis == 0) ? m_tileSize.x : m_tileSize.y;
+	const float otherTile = (theAxis == 0) ? m_tileSize.y : m_tileSize.x;
+	const Int32 count = static_cast<Int32>((theAxis == 0) ? m_width : m_height);
+	const Int32 otherCount = static_cast<Int32>((theAxis == 0) ? m_height : m_width);
+	const float low = (theAxis == 0) ? theBox.left : theBox.top;
+	const float high = low + ((theAxis == 0) ? theBox.width : theBox.height);
+	const float otherLow = (theAxis == 0) ? theBox.top : theBox.left;
+	const float otherHigh = otherLow + ((theAxis == 0) ? theBox.height : theBox.width);
+
+	// Celdas que ocupa el rectángulo en el otro eje
+	Int32 first = std::max(ToCell(otherLow + EDGE_EPSILON, otherTile), 0);
+	Int32 last = std::min(ToCell(otherHigh - EDGE_EPSILON, otherTile), otherCount - 1);
+	if (first > last)
+	{
+		return theDelta;
+	}
+
+	// Solo se miran las líneas que el borde delantero cruza en este
+	// movimiento; la que ya ocupa se ignora para no quedar atrapado
+	if (theDelta > 0.f)
+	{
+		Int32 from = std::max(ToCell(high - EDGE_EPSILON, tile) + 1, 0);
+		Int32 to = std::min(ToCell(high + theDelta - EDGE_EPSILON, tile), count - 1);
+		for (Int32 line = from; line <= to; line++)
+		{
+			if (IsLineSolid(theAxis, line, first, last))
+			{
+				return std::max(std::min(theDelta, line * tile - high), 0.f);
+			}
+		}
+	}
+	else
+	{
+		Int32 from = std::min(ToCell(low + EDGE_EPSILON, tile) - 1, count - 1);
+		Int32 to = std::max(ToCell(low + theDelta + EDGE_EPSILON, tile), 0);
+		for (Int32 line = from; line >= to; line--)
+		{
+			if (IsLineSolid(theAxis, line, first, last))
+			{
+				return std::min(std::max(theDelta, (line + 1) * tile - low), 0.f);
+			}
+		}
+	}
+
+	return theDelta;
+}
+
+bool TileGrid::IsLineSolid(int theAxis, Int32 theLine, Int32 theFirst, Int32 theLast) const
+{
+	for (Int32 i = theFirst; i <= theLast; i++)
+	{
+		if ((theAxis == 0) ? IsSolid(theLine, i) : IsSolid(i, theLine))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace ra
\ No newline at end of file
@@ -0,0 +1,404 @@
+#include <algorithm>
+#include <cmath>
+#include <RAGE/Core/Sprite.hpp>
+#include <RAGE/Core/Text.hpp>
+#include <RAGE/Core/Shape.hpp>
+#include <RAGE/Core/TweenManager.hpp>
+
+namespace
+{
+	const float PI = 3.14159265f;
+
+	/// Las curvas que se pasan del destino pueden salirse del rango
+	sf::Uint8 MakeChannel(float theValue)
+	{
+		return static_cast<sf::Uint8>(std::min(std::max(theValue, 0.f), 255.f) + 0.5f);
+	}
+
+	sf::Color MakeColor(const float* theValues)
+	{
+		return sf::Color(MakeChannel(theValues[0]), MakeChannel(theValues[1]),
+			MakeChannel(theValues[2]), MakeChannel(theValues[3]));
+	}
+
+	void StoreColor(const sf::Color& theColor, float* theValues)
+	{
+		theValues[0] = theColor.r;
+		theValues[1] = theColor.g;
+		theValues[2] = theColor.b;
+		theValues[3] = theColor.a;
+	}
+
+	float BounceOut(float theRatio)
+	{
+		if (theRatio < 1.f / 2.75f)
+		{
+			return 7.5625f * theRatio * theRatio;
+		}
+		if (theRatio < 2.f / 2.75f)
+		{
+			theRatio -= 1.5f / 2.75f;
+			return 7.5625f * theRatio * theRatio + 0.75f;
+		}
+		if (theRatio < 2.5f / 2.75f)
+		{
+			theRatio -= 2.25f / 2.75f;
+			return 7.5625f * theRatio * theRatio + 0.9375f;
+		}
+		theRatio -= 2.625f / 2.75f;
+		return 7.5625f * theRatio * theRatio + 0.984375f;
+	}
+}
+
+namespace ra
+{
+
+TweenManager::TweenManager()
+	: m_tweens()
+	, m_free()
+	, m_active(0)
+{
+}
+
+TweenHandle TweenManager::MoveTo(sf::Transformable& theTarget, const sf::Vector2f& thePosition,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4] = { thePosition.x, thePosition.y, 0.f, 0.f };
+	return Start(PropertyPosition, theTarget, to, theDuration, theEasing);
+}
+
+TweenHandle TweenManager::ScaleTo(sf::Transformable& theTarget, const sf::Vector2f& theScale,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4] = { theScale.x, theScale.y, 0.f, 0.f };
+	return Start(PropertyScale, theTarget, to, theDuration, theEasing);
+}
+
+TweenHandle TweenManager::RotateTo(sf::Transformable& theTarget, float theAngle,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4] = { theAngle, 0.f, 0.f, 0.f };
+	return Start(PropertyRotation, theTarget, to, theDuration, theEasing);
+}
+
+TweenHandle TweenManager::ColorTo(ra::Sprite& theTarget, const sf::Color& theColor,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4];
+	StoreColor(theColor, to);
+	TweenHandle handle = Start(PropertySpriteColor, theTarget, to, theDuration, theEasing);
+	m_tweens[handle.index].sprite = &theTarget;
+	return handle;
+}
+
+TweenHandle TweenManager::ColorTo(ra::Text& theTarget, const sf::Color& theColor,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4];
+	StoreColor(theColor, to);
+	TweenHandle handle = Start(PropertyTextColor, theTarget, to, theDuration, theEasing);
+	m_tweens[handle.index].text = &theTarget;
+	return handle;
+}
+
+TweenHandle TweenManager::ColorTo(ra::Shape& theTarget, const sf::Color& theColor,
+	sf::Time theDuration, Easing theEasing)
+{
+	float to[4];
+	StoreColor(theColor, to);
+	TweenHandle handle = Start(PropertyShapeColor, theTarget, to, theDuration, theEasing);
+	m_tweens[handle.index].shape = &theTarget;
+	return handle;
+}
+
+void TweenManager::SetDelay(const TweenHandle& theHandle, sf::Time theDelay)
+{
+	Tween* tween = Find(theHandle);
+	if (tween && !tween->started)
+	{
+		tween->delay = theDelay.asSeconds();
+	}
+}
+
+void TweenManager::SetRepeat(const TweenHandle& theHandle, Int32 theCount, bool theYoyo)
+{
+	Tween* tween = Find(theHandle);
+	if (tween)
+	{
+		tween->repeat = theCount;
+		tween->yoyo = theYoyo;
+	}
+}
+
+void TweenManager::Cancel(const TweenHandle& theHandle)
+{
+	if (Find(theHandle))
+	{
+		Release(theHandle.index);
+	}
+}
+
+void TweenManager::Cancel(const sf::Transformable& theTarget)
+{
+	for (size_t i = 0; i < m_tweens.size(); i++)
+	{
+		if (m_tweens[i].active && m_tweens[i].target == &theTarget)
+		{
+			Release(static_cast<Uint32>(i));
+		}
+	}
+}
+
+bool TweenManager::IsActive(const TweenHandle& theHandle) const
+{
+	return Find(theHandle) != NULL;
+}
+
+void TweenManager::Update(sf::Time theElapsed)
+{
+	float elapsed = theElapsed.asSeconds();
+
+	for (size_t i = 0; i < m_tweens.size(); i++)
+	{
+		Tween& tween = m_tweens[i];
+		if (!tween.active)
+		{
+			continue;
+		}
+
+		tween.elapsed += elapsed;
+		if (tween.elapsed < tween.delay)
+		{
+			continue;
+		}
+
+		// El valor inicial es el que tenga el objeto al terminar el retardo
+		if (!tween.started)
+		{
+			Read(tween);
+			tween.started = true;
+		}
+
+		float time = tween.elapsed - tween.delay;
+		if (time < tween.duration)
+		{
+			Apply(tween, Ease(tween.easing, time / tween.duration));
+			continue;
+		}
+
+		Apply(tween, 1.f);
+		if (tween.repeat == 0)
+		{
+			Release(static_cast<Uint32>(i));
+			continue;
+		}
+
+		// Empezamos otra pasada conservando el tiempo sobrante
+		if (tween.repeat > 0)
+		{
+			tween.repeat--;
+		}
+		if (tween.yoyo)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				float from = tween.from[j];
+				tween.from[j] = tween.to[j];
+				tween.to[j] = from;
+			}
+		}
+		tween.elapsed = tween.delay + std::fmod(time - tween.duration, tween.duration);
+	}
+}
+
+void TweenManager::Clear()
+{
+	for (size_t i = 0; i < m_tweens.size(); i++)
+	{
+		if (m_tweens[i].active)
+		{
+			Release(static_cast<Uint32>(i));
+		}
+	}
+}
+
+size_t TweenManager::GetSize() const
+{
+	return m_active;
+}
+
+float TweenManager::Ease(Easing theEasing, float theRatio)
+{
+	float t = theRatio;
+	switch (theEasing)
+	{
+	case EaseInQuad:
+		return t * t;
+	case EaseOutQuad:
+		return t * (2.f - t);
+	case EaseInOutQuad:
+		return (t < 0.5f) ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t;
+	case EaseInCubic:
+		return t * t * t;
+	case EaseOutCubic:
+		t -= 1.f;
+		return t * t * t + 1.f;
+	case EaseInOutCubic:
+		if (t < 0.5f)
+		{
+			return 4.f * t * t * t;
+		}
+		t = 2.f * t - 2.f;
+		return 0.5f * t * t * t + 1.f;
+	case EaseInSine:
+		return 1.f - std::cos(t * PI * 0.5f);
+	case EaseOutSine:
+		return std::sin(t * PI * 0.5f);
+	case EaseInOutSine:
+		return 0.5f * (1.f - std::cos(t * PI));
+	case EaseOutBack:
+		t -= 1.f;
+		return t * t * (2.70158f * t + 1.70158f) + 1.f;
+	case EaseOutBounce:
+		return BounceOut(t);
+	case EaseOutElastic:
+		if (t <= 0.f || t >= 1.f)
+		{
+			return t;
+		}
+		return std::pow(2.f, -10.f * t) * std::sin((t - 0.075f) * 2.f * PI / 0.3f) + 1.f;
+	default:
+		return t;
+	}
+}
+
+TweenHandle TweenManager::Start(Property theProperty, sf::Transformable& theTarget,
+	const float* theTo, sf::Time theDuration, Easing theEasing)
+{
+	Uint32 index;
+	if (m_free.empty())
+	{
+		index = static_cast<Uint32>(m_tweens.size());
+		m_tweens.push_back(Tween());
+		m_tweens.back().generation = 1;
+	}
+	else
+	{
+		index = m_free.back();
+		m_free.pop_back();
+	}
+
+	Tween& tween = m_tweens[index];
+	tween.property = theProperty;
+	tween.target = &theTarget;
+	tween.sprite = NULL;
+	tween.text = NULL;
+	tween.shape = NULL;
+	for (int i = 0; i < 4; i++)
+	{
+		tween.from[i] = 0.f;
+		tween.to[i] = theTo[i];
+	}
+	tween.elapsed = 0.f;
+	tween.delay = 0.f;
+	// Una duración nula termina en el primer Update()
+	tween.duration = std::max(theDuration.asSeconds(), 0.000001f);
+	tween.easing = theEasing;
+	tween.repeat = 0;
+	tween.yoyo = false;
+	tween.started = false;
+	tween.active = true;
+	m_active++;
+
+	return TweenHandle(index, tween.generation);
+}
+
+TweenManager::Tween* TweenManager::Find(const TweenHandle& theHandle)
+{
+	if (theHandle.index >= m_tweens.size())
+	{
+		return NULL;
+	}
+	Tween& tween = m_tweens[theHandle.index];
+	return (tween.active && tween.generation == theHandle.generation) ? &tween : NULL;
+}
+
+const TweenManager::Tween* TweenManager::Find(const TweenHandle& theHandle) const
+{
+	if (theHandle.index >= m_tweens.size())
+	{
+		return NULL;
+	}
+	const Tween& tween = m_tweens[theHandle.index];
+	return (tween.active && tween.generation == theHandle.generation) ? &tween : NULL;
+}
+
+void TweenManager::Release(Uint32 theIndex)
+{
+	Tween& tween = m_tweens[theIndex];
+	tween.active = false;
+	// La generación 0 queda para los handles nulos
+	tween.generation = (tween.generation == 0xFFFFFFFF) ? 1 : tween.generation + 1;
+	m_free.push_back(theIndex);
+	m_active--;
+}
+
+void TweenManager::Read(Tween& theTween)
+{
+	switch (theTween.property)
+	{
+	case PropertyPosition:
+		theTween.from[0] = theTween.target->getPosition().x;
+		theTween.from[1] = theTween.target->getPosition().y;
+		break;
+	case PropertyScale:
+		theTween.from[0] = theTween.target->getScale().x;
+		theTween.from[1] = theTween.target->getScale().y;
+		break;
+	case PropertyRotation:
+		theTween.from[0] = theTween.target->getRotation();
+		break;
+	case PropertySpriteColor:
+		StoreColor(theTween.sprite->getColor(), theTween.from);
+		break;
+	case PropertyTextColor:
+		StoreColor(theTween.text->getColor(), theTween.from);
+		break;
+	case PropertyShapeColor:
+		StoreColor(theTween.shape->getFillColor(), theTween.from);
+		break;
+	}
+}
+
+void TweenManager::Apply(const Tween& theTween, float theRatio)
+{
+	float value[4];
+	for (int i = 0; i < 4; i++)
+	{
+		value[i] = theTween.from[i] + (theTween.to[i] - theTween.from[i]) * theRatio;
+	}
+
+	switch (theTween.property)
+	{
+	case PropertyPosition:
+		theTween.target->setPosition(value[0], value[1]);
+		break;
+	case PropertyScale:
+		theTween.target->setScale(value[0], value[1]);
+		break;
+	case PropertyRotation:
+		theTween.target->setRotation(value[0]);
+		break;
+	case PropertySpriteColor:
+		theTween.sprite->setColor(MakeColor(value));
+		break;
+	case PropertyTextColor:
+		theTween.text->setColor(MakeColor(value));
+		break;
+	case PropertyShapeColor:
+		theTween.shape->setFillColor(MakeColor(value));
+		break;
+	}
+}
+
+} // namespace ra
\ No newline at end of file
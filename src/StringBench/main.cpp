@@ -0,0 +1,372 @@
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+#include <RAGE/Core.hpp>
+
+namespace
+{
+	/// Valores de cada tipo que se convierten en cada vuelta
+	const unsigned int VALUE_COUNT = 100000;
+	/// Vueltas sobre todos los valores de cada prueba
+	const unsigned int ROUNDS = 5;
+
+	/// Valores de prueba y su texto
+	struct BenchData
+	{
+		std::vector<ra::Int32> ints;
+		std::vector<float> floats;
+		std::vector<double> doubles;
+		std::vector<std::string> intTexts;
+		std::vector<std::string> floatTexts;
+		std::vector<std::string> doubleTexts;
+	};
+
+	/// Prueba que recorre todos los valores y acumula algo en theSink para que
+	/// el compilador no la elimine
+	typedef void (*BenchFunc)(const BenchData& theData, ra::Uint64& theSink);
+
+	/// Una conversión medida con las tres implementaciones
+	struct BenchCase
+	{
+		const char* name;
+		BenchFunc old;
+		BenchFunc string;
+		BenchFunc buffer;
+	};
+
+	// Conversiones anteriores a StringUtil con Format y Parse, copiadas tal cual
+	// para comparar
+
+	std::string OldConvertInt32(const ra::Int32 theNumber)
+	{
+		std::stringstream anResult;
+		anResult << theNumber;
+		return anResult.str();
+	}
+
+	std::string OldConvertFloat(const float theFloat)
+	{
+		std::stringstream anResult;
+		anResult << theFloat;
+		return anResult.str();
+	}
+
+	std::string OldConvertDouble(const double theDouble)
+	{
+		std::stringstream anResult;
+		anResult << theDouble;
+		return anResult.str();
+	}
+
+	ra::Int32 OldParseInt32(const std::string theValue, const ra::Int32 theDefault)
+	{
+		ra::Int32 anResult = theDefault;
+		std::istringstream iss(theValue);
+		iss >> anResult;
+		return anResult;
+	}
+
+	float OldParseFloat(const std::string theValue, const float theDefault)
+	{
+		float anResult = theDefault;
+		std::istringstream iss(theValue);
+		iss >> anResult;
+		return anResult;
+	}
+
+	double OldParseDouble(const std::string theValue, const double theDefault)
+	{
+		double anResult = theDefault;
+		std::istringstream iss(theValue);
+		iss >> anResult;
+		return anResult;
+	}
+
+	// Int32 a texto
+
+	void FormatInt32Old(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.ints.size(); i++)
+		{
+			theSink += OldConvertInt32(theData.ints[i]).size();
+		}
+	}
+
+	void FormatInt32String(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.ints.size(); i++)
+		{
+			theSink += ra::ConvertInt32(theData.ints[i]).size();
+		}
+	}
+
+	void FormatInt32Buffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		char anBuffer[ra::FORMAT_BUFFER_SIZE];
+		for (size_t i = 0; i < theData.ints.size(); i++)
+		{
+			theSink += ra::FormatInt32(anBuffer, sizeof(anBuffer), theData.ints[i]);
+		}
+	}
+
+	// Float a texto
+
+	void FormatFloatOld(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.floats.size(); i++)
+		{
+			theSink += OldConvertFloat(theData.floats[i]).size();
+		}
+	}
+
+	void FormatFloatString(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.floats.size(); i++)
+		{
+			theSink += ra::ConvertFloat(theData.floats[i]).size();
+		}
+	}
+
+	void FormatFloatBuffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		char anBuffer[ra::FORMAT_BUFFER_SIZE];
+		for (size_t i = 0; i < theData.floats.size(); i++)
+		{
+			theSink += ra::FormatFloat(anBuffer, sizeof(anBuffer), theData.floats[i]);
+		}
+	}
+
+	// Double a texto
+
+	void FormatDoubleOld(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.doubles.size(); i++)
+		{
+			theSink += OldConvertDouble(theData.doubles[i]).size();
+		}
+	}
+
+	void FormatDoubleString(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.doubles.size(); i++)
+		{
+			theSink += ra::ConvertDouble(theData.doubles[i]).size();
+		}
+	}
+
+	void FormatDoubleBuffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		char anBuffer[ra::FORMAT_BUFFER_SIZE];
+		for (size_t i = 0; i < theData.doubles.size(); i++)
+		{
+			theSink += ra::FormatDouble(anBuffer, sizeof(anBuffer), theData.doubles[i]);
+		}
+	}
+
+	// Texto a Int32
+
+	void ParseInt32Old(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.intTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint32>(OldParseInt32(theData.intTexts[i], 0));
+		}
+	}
+
+	void ParseInt32String(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.intTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint32>(ra::ParseInt32(theData.intTexts[i], 0));
+		}
+	}
+
+	void ParseInt32Buffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.intTexts.size(); i++)
+		{
+			const std::string& anText = theData.intTexts[i];
+			ra::Int32 anResult = 0;
+			ra::ParseInt32(anText.data(), anText.data() + anText.size(), anResult);
+			theSink += static_cast<ra::Uint32>(anResult);
+		}
+	}
+
+	// Texto a float
+
+	void ParseFloatOld(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.floatTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint64>(OldParseFloat(theData.floatTexts[i], 0.0f) != 0.0f);
+		}
+	}
+
+	void ParseFloatString(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.floatTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint64>(ra::ParseFloat(theData.floatTexts[i], 0.0f) != 0.0f);
+		}
+	}
+
+	void ParseFloatBuffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.floatTexts.size(); i++)
+		{
+			const std::string& anText = theData.floatTexts[i];
+			float anResult = 0.0f;
+			ra::ParseFloat(anText.data(), anText.data() + anText.size(), anResult);
+			theSink += static_cast<ra::Uint64>(anResult != 0.0f);
+		}
+	}
+
+	// Texto a double
+
+	void ParseDoubleOld(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.doubleTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint64>(OldParseDouble(theData.doubleTexts[i], 0.0) != 0.0);
+		}
+	}
+
+	void ParseDoubleString(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.doubleTexts.size(); i++)
+		{
+			theSink += static_cast<ra::Uint64>(ra::ParseDouble(theData.doubleTexts[i], 0.0) != 0.0);
+		}
+	}
+
+	void ParseDoubleBuffer(const BenchData& theData, ra::Uint64& theSink)
+	{
+		for (size_t i = 0; i < theData.doubleTexts.size(); i++)
+		{
+			const std::string& anText = theData.doubleTexts[i];
+			double anResult = 0.0;
+			ra::ParseDouble(anText.data(), anText.data() + anText.size(), anResult);
+			theSink += static_cast<ra::Uint64>(anResult != 0.0);
+		}
+	}
+
+	/// Generador congruencial lineal, para que los valores sean los mismos en
+	/// todas las plataformas
+	ra::Uint32 NextRandom(ra::Uint32& theState)
+	{
+		theState = theState * 1664525 + 1013904223;
+		return theState;
+	}
+
+	/// Rellena theData con valores parecidos a los de un archivo de
+	/// configuración: enteros de todos los tamaños y decimales de 0.001 a 100000
+	void FillData(BenchData& theData)
+	{
+		ra::Uint32 anState = 12345;
+		for (unsigned int i = 0; i < VALUE_COUNT; i++)
+		{
+			const ra::Int32 anInt = static_cast<ra::Int32>(NextRandom(anState)) >> (NextRandom(anState) % 31);
+			const double anUnit = NextRandom(anState) / 4294967296.0;
+			const double anScale = 0.001 * static_cast<double>(1 << (NextRandom(anState) % 27));
+			const double anDouble = (anUnit - 0.5) * anScale;
+
+			theData.ints.push_back(anInt);
+			theData.floats.push_back(static_cast<float>(anDouble));
+			theData.doubles.push_back(anDouble);
+			theData.intTexts.push_back(ra::ConvertInt32(anInt));
+			theData.floatTexts.push_back(ra::ConvertFloat(static_cast<float>(anDouble)));
+			theData.doubleTexts.push_back(ra::ConvertDouble(anDouble));
+		}
+	}
+
+	/// Nanosegundos por conversión de theFunc, con la mejor de ROUNDS vueltas
+	double Measure(BenchFunc theFunc, const BenchData& theData, ra::Uint64& theSink)
+	{
+		sf::Int64 anBest = 0;
+		for (unsigned int i = 0; i < ROUNDS; i++)
+		{
+			sf::Clock anClock;
+			theFunc(theData, theSink);
+			const sf::Int64 anElapsed = anClock.getElapsedTime().asMicroseconds();
+			if (i == 0 || anElapsed < anBest)
+			{
+				anBest = anElapsed;
+			}
+		}
+		return static_cast<double>(anBest) * 1000.0 / VALUE_COUNT;
+	}
+
+	/// Cuenta los valores que no vuelven al mismo número tras Format y Parse
+	unsigned int CountRoundTripErrors(const BenchData& theData)
+	{
+		unsigned int anErrors = 0;
+		char anBuffer[ra::FORMAT_BUFFER_SIZE];
+		for (unsigned int i = 0; i < VALUE_COUNT; i++)
+		{
+			const size_t anFloatLength = ra::FormatFloat(anBuffer, sizeof(anBuffer), theData.floats[i]);
+			float anFloat = 0.0f;
+			ra::ParseFloat(anBuffer, anBuffer + anFloatLength, anFloat);
+			if (anFloat != theData.floats[i])
+			{
+				anErrors++;
+			}
+
+			const size_t anDoubleLength = ra::FormatDouble(anBuffer, sizeof(anBuffer), theData.doubles[i]);
+			double anDouble = 0.0;
+			ra::ParseDouble(anBuffer, anBuffer + anDoubleLength, anDouble);
+			if (anDouble != theData.doubles[i])
+			{
+				anErrors++;
+			}
+		}
+		return anErrors;
+	}
+}
+
+int main()
+{
+	const BenchCase anCases[] =
+	{
+		{ "Int32 a texto ", FormatInt32Old, FormatInt32String, FormatInt32Buffer },
+		{ "float a texto ", FormatFloatOld, FormatFloatString, FormatFloatBuffer },
+		{ "double a texto", FormatDoubleOld, FormatDoubleString, FormatDoubleBuffer },
+		{ "texto a Int32 ", ParseInt32Old, ParseInt32String, ParseInt32Buffer },
+		{ "texto a float ", ParseFloatOld, ParseFloatString, ParseFloatBuffer },
+		{ "texto a double", ParseDoubleOld, ParseDoubleString, ParseDoubleBuffer }
+	};
+
+	// Preparamos los valores
+	BenchData anData;
+	FillData(anData);
+
+	std::cout << "StringBench: " << VALUE_COUNT << " valores, mejor de " << ROUNDS
+		<< " vueltas, ns por conversión" << std::endl;
+	std::cout << "              " << std::setw(14) << "stringstream" << std::setw(13) << "std::string"
+		<< std::setw(8) << "char*" << std::endl;
+	std::cout.setf(std::ios::fixed);
+	std::cout.precision(1);
+
+	// Medimos cada conversión con la versión anterior, las funciones con
+	// std::string y las funciones sobre un buffer
+	ra::Uint64 anSink = 0;
+	for (size_t i = 0; i < sizeof(anCases) / sizeof(anCases[0]); i++)
+	{
+		const double anOld = Measure(anCases[i].old, anData, anSink);
+		const double anString = Measure(anCases[i].string, anData, anSink);
+		const double anBuffer = Measure(anCases[i].buffer, anData, anSink);
+		std::cout << anCases[i].name << std::setw(14) << anOld << std::setw(13) << anString
+			<< std::setw(8) << anBuffer << "  x" << (anBuffer > 0.0 ? anOld / anBuffer : 0.0) << std::endl;
+	}
+
+	// Comprobamos que los decimales vuelven al mismo valor
+	const unsigned int anErrors = CountRoundTripErrors(anData);
+	std::cout << "Valores que no vuelven igual tras Format y Parse: " << anErrors << std::endl;
+
+	// Evitamos que el compilador elimine las pruebas
+	std::cout << "(" << anSink << ")" << std::endl;
+
+	return (anErrors == 0) ? ra::StatusNoError : ra::StatusError;
+}
\ No newline at end of file
@@ -4,7 +4,8 @@
 #include <iostream> // Quitar
 
 SceneMain::SceneMain(ra::SceneID theID) :
-	ra::Scene(theID)
+	ra::Scene(theID),
+	minimap(NULL)
 {
 }
 
@@ -20,6 +21,7 @@ void SceneMain::Init()
 	sm = ra::SceneManager::Instance();
 	am = ra::AssetManager::Instance();
 	cam = ra::Camera::Instance();
+	input = ra::Input::Instance();
 	am->SetPath("Data");
 
 	this->SetBackgroundColor(sf::Color(180, 200, 255));
@@ -33,17 +35,62 @@ void SceneMain::Init()
 	b.setFillColor(sf::Color(0, 0, 255));
 
 	c.setRadius(50);
-	c.setOrigin(c.getRadius(), c.getRadius());
-	c.setPosition(0, 0);
+	// El origen en la base deja el suelo fijo al escalarlo con el pulso, así
+	// el círculo crece hacia arriba en lugar de hundirse en las colisiones
+	c.setOrigin(c.getRadius(), 2.f * c.getRadius());
+	c.setPosition(600, 0);
 	c.setFillColor(sf::Color(0, 255, 0));
 
 	this->AddGraph(a);
 	this->AddGraph(b);
 	this->AddGraph(c);
 
+	// El cielo se desplaza a la quinta parte que la cámara y, como no cambia,
+	// se guarda en textura entre frames
+	sky.setTexture(*am->GetTexture("tarde.jpg"));
+	sky.SetZOrder(-10);
+	this->AddGraph(sky);
+	this->SetLayer("fondo", -100, -1, sf::Vector2f(0.2f, 0.2f));
+	this->SetLayerCached("fondo", true);
+
 	time = 0.0f;
 
+	// El círculo verde cae sobre las colisiones del mapa de plataformas
+	grid.LoadFromTmx(am->GetPath() + "plat.tmx", "colisiones");
+	fallSpeed = 0.0f;
+
+	// Minimapa en la esquina superior derecha que sigue al círculo verde. Se
+	// crea aquí, con la ventana ya abierta, y solo dibuja esta escena
+	minimap = new ra::Camera();
+	minimap->SetViewport(sf::FloatRect(0.75f, 0.0f, 0.25f, 0.25f));
+	minimap->SetZoom(0.125f);
+	minimap->LockToMap(grid);
+	minimap->ConnectToGraph(c);
+	this->AddCamera(*minimap);
+
+	// Panel con los contadores de dibujado de cada frame
+	app->ShowRenderStats(am->GetFont("segoeui.ttf"));
+
+	// Los dos círculos avanzan 2000 píxeles en 10 segundos
+	tweens.MoveTo(a, sf::Vector2f(2100.f, 100.f), sf::seconds(10.f));
+	tweens.MoveTo(b, sf::Vector2f(2100.f, 250.f), sf::seconds(10.f), ra::EaseInOutSine);
+	ra::TweenHandle pulse = tweens.ScaleTo(c, sf::Vector2f(1.5f, 1.5f), sf::seconds(1.f), ra::EaseInOutQuad);
+	tweens.SetRepeat(pulse, ra::TweenManager::REPEAT_FOREVER, true);
+
+	// Desenfoque a media resolución para el menú de pausa, apagado hasta pausar
+	if (ra::PostProcess::Instance()->AddPass("pausa", am->GetPath() + "desenfoque.frag", ra::PassHalf))
+	{
+		ra::PostProcess::Instance()->SetPassEnabled("pausa", false);
+	}
+
+	// Acciones de movimiento de la cámara, definidas en input.cfg
+	left = input->GetActionID("left");
+	right = input->GetActionID("right");
+	up = input->GetActionID("up");
+	down = input->GetActionID("down");
+
 	sm->AddScene(new SceneMenu("Menu"));
+	sm->PreloadScene("Menu");
 }
 
 void SceneMain::Active()
@@ -55,32 +102,38 @@ void SceneMain::Update()
 	time += app->GetUpdateTime().asSeconds();
 
 	std::cout << time << std::endl;
-	
-	if (time <= 10.0f)
+
+	tweens.Update(app->GetUpdateTime());
+
+	float elapsed = app->GetUpdateTime().asSeconds();
+	fallSpeed += 600.f * elapsed;
+	// Los límites globales incluyen la escala del pulso
+	ra::TileSweep sweep = grid.Sweep(c.getGlobalBounds(), sf::Vector2f(0.f, fallSpeed * elapsed));
+	c.move(sweep.delta);
+	if (sweep.hitY)
 	{
-		a.move(200*app->GetUpdateTime().asSeconds(), 0);
-		b.move(200*app->GetUpdateTime().asSeconds(), 0);
+		fallSpeed = 0.0f;
 	}
 
-	/*if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
+	if (input->IsActionDown(left))
 	{
 		cam->move(-5.f, 0.f);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
+	if (input->IsActionDown(right))
 	{
 		cam->move(5.f, 0.f);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
+	if (input->IsActionDown(up))
 	{
 		cam->move(0.f, -5.f);
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+	if (input->IsActionDown(down))
 	{
 		cam->move(0.f, 5.f);
-	}*/
+	}
 }
 
-void SceneMain::Event(sf::Event theEvent)
+void SceneMain::Event(const sf::Event& theEvent)
 {
 	if (theEvent.type == sf::Event::KeyPressed && theEvent.key.code == sf::Keyboard::Space)
 	{
@@ -96,20 +149,22 @@ void SceneMain::Resume()
 void SceneMain::Pause()
 {
 	std::cout << "Pausa" << std::endl;
-	sm->SetActiveScene("Menu");
-
-	sf::Texture *t = new sf::Texture();
-	t->create(app->window.getSize().x, app->window.getSize().y); 
-	t->update(app->window);
-
-	am->DeleteTexture("captura");
-	am->GetTexture("captura", t);
-
-	/*am->DeleteTexture("captura");
-	sf::Image *cap_img = new sf::Image(app->window.capture());
-	am->GetTextureFromImage("captura", cap_img);*/
+	if (ra::PostProcess::Instance()->GetShader("pausa") != NULL)
+	{
+		ra::PostProcess::Instance()->SetPassEnabled("pausa", true);
+	}
+	sm->PushScene("Menu");
 }
 
 void SceneMain::Cleanup()
 {
+	tweens.Clear();
+	grid.Clear();
+
+	if (minimap != NULL)
+	{
+		this->RemoveCamera(*minimap);
+		delete minimap;
+		minimap = NULL;
+	}
 }
\ No newline at end of file
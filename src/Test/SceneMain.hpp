@@ -15,7 +15,7 @@ public:
 
 	void Update() ;
 
-	void Event(sf::Event theEvent) ;
+	void Event(const sf::Event& theEvent) ;
 
 	void Resume();
 
@@ -28,9 +28,19 @@ private:
 	ra::SceneManager* sm;
 	ra::AssetManager* am;
 	ra::Camera* cam;
+	ra::Camera* minimap;
+	ra::Input* input;
+	ra::ActionID left;
+	ra::ActionID right;
+	ra::ActionID up;
+	ra::ActionID down;
 	ra::CircleShape a;
 	ra::CircleShape b;
 	ra::CircleShape c;
+	ra::Sprite sky;
+	ra::TweenManager tweens;
+	ra::TileGrid grid;
+	float fallSpeed;
 
 	float time;
 }; // SceneMain
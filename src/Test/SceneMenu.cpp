@@ -11,6 +11,11 @@ SceneMenu::~SceneMenu()
 {
 }
 
+void SceneMenu::Preload()
+{
+	PreloadAsset(ra::AssetFont, "segoeui.ttf");
+}
+
 void SceneMenu::Init()
 {
 	Scene::Init();
@@ -20,7 +25,14 @@ void SceneMenu::Init()
 	am = ra::AssetManager::Instance();
 	cam = ra::Camera::Instance();
 
-	this->SetBackgroundColor(sf::Color(125, 255, 200));
+	// El menú se dibuja sobre la escena principal, que se desenfoca debajo
+	// mientras el menú queda nítido
+	this->SetDrawBelow(true);
+	this->SetPostProcessed(false);
+
+	back.setSize(sf::Vector2f(static_cast<float>(app->window.getSize().x), 
+		static_cast<float>(app->window.getSize().y)));
+	back.setFillColor(sf::Color(125, 255, 200, 150));
 
 	pause.setFont(*am->GetFont("segoeui.ttf"));
 	pause.setCharacterSize(50);
@@ -30,13 +42,12 @@ void SceneMenu::Init()
 	pause.setColor(sf::Color::Magenta);
 	pause.SetZOrder(10);
 
+	this->AddGraph(back);
 	this->AddGraph(pause);
 }
 
 void SceneMenu::Active()
 {
-	back.setTexture(*am->GetTexture("captura"));
-	this->AddGraph(back);
 }
 
 void SceneMenu::Update()
@@ -44,7 +55,7 @@ void SceneMenu::Update()
 	//std::cout << app->GetTotalTime().asSeconds() << std::endl; 
 }
 
-void SceneMenu::Event(sf::Event theEvent)
+void SceneMenu::Event(const sf::Event& theEvent)
 {
 	if (theEvent.type == sf::Event::KeyPressed && theEvent.key.code == sf::Keyboard::Space)
 	{
@@ -55,7 +66,11 @@ void SceneMenu::Event(sf::Event theEvent)
 void SceneMenu::Resume()
 {
 	std::cout << "Resume" << std::endl;
-	sm->SetActiveScene("Main");
+	if (ra::PostProcess::Instance()->GetShader("pausa") != NULL)
+	{
+		ra::PostProcess::Instance()->SetPassEnabled("pausa", false);
+	}
+	sm->PopScene();
 }
 
 void SceneMenu::Pause()
@@ -9,13 +9,15 @@ public:
 	SceneMenu(ra::SceneID theID);
 	~SceneMenu();
 
+	void Preload();
+
 	void Init() ;
 
 	void Active();
 
 	void Update() ;
 
-	void Event(sf::Event theEvent) ;
+	void Event(const sf::Event& theEvent) ;
 
 	void Resume();
 
@@ -29,7 +31,7 @@ private:
 	ra::AssetManager* am;
 	ra::Camera* cam;
 	ra::Text pause;
-	ra::Sprite back;
+	ra::RectangleShape back;
 }; // SceneMain
 
 #endif // SCENE_MENU
\ No newline at end of file
@@ -3,22 +3,25 @@
 
 int main(int argc, char **argv)
 {
-	// Creamos un cdigo de error
+	// Creamos un código de error
 	int anExitCode = ra::StatusNoError;
 
-	// Creamos la aplicacin
+	// Creamos la aplicación
 	ra::App *anApp = ra::App::Instance();
 
 	// Registramos la ruta del ejecutable
 	anApp->RegisterExecutableDir(argc, argv);
 
+	// Opciones de grabación y reproducción de la entrada
+	anApp->ParseArguments(argc, argv);
+
 	// Establecemos la escena inicial
 	anApp->SetFirstScene(new SceneMain("Main"));
 
-	// Ponemos en marcha la aplicacin
+	// Ponemos en marcha la aplicación
 	anExitCode = anApp->Run();
 
-	// Eliminamos la aplicacin
+	// Eliminamos la aplicación
 	anApp->Release();
 	// Anulamos el puntero
 	anApp = 0;